@@ -0,0 +1,220 @@
+#ifndef MAGNIFYING_GLASS_ANTIALIASED_ELLIPSE_SHAPE_H
+#define MAGNIFYING_GLASS_ANTIALIASED_ELLIPSE_SHAPE_H
+
+#include "mglass/shape.h"   // Shape
+#include <utility>          // std::forward
+#include <algorithm>        // std::min, std::max
+
+
+namespace mglass::shapes
+{
+    namespace detail
+    {
+        // The columns of the row of pixels y (the strip [y; y + 1]) which intersect an ellipse
+        //  and the ones which are entirely inside it.
+        struct AntialiasedEllipseRow final
+        {
+            // [begin; end) intersect the ellipse (some of them can have zero area of the intersection)
+            int_type begin;
+            int_type end;
+            // [interiorBegin; interiorEnd) are inside the ellipse, the range is inside [begin; end)
+            int_type interiorBegin;
+            int_type interiorEnd;
+        };
+
+        // returns the columns of the row `y` for the ellipse with the `center` and the semi-axes `a`, `b`
+        [[nodiscard]] AntialiasedEllipseRow getAntialiasedEllipseRow(
+            Point<float_type> center,
+            float_type a,
+            float_type b,
+            int_type y) noexcept;
+
+        // Returns the area of the intersection of the pixel (`x`; `y`) (the square [x; x + 1] x [y; y + 1])
+        //  and the ellipse with the `center` and the semi-axes `a`, `b`.
+        [[nodiscard]] float_type getEllipsePixelCoverage(
+            Point<float_type> center,
+            float_type a,
+            float_type b,
+            int_type x,
+            int_type y) noexcept;
+
+
+        class AntialiasedEllipseRastrContext final : public RasterizationContextBase<AntialiasedEllipseRastrContext>
+        {
+            // for accessing to getRasterizedPointImpl(), getPixelDensityImpl() from base
+            friend struct RasterizationContextBase<AntialiasedEllipseRastrContext>;
+
+        public:
+            AntialiasedEllipseRastrContext(Point<int_type> rasterizedPoint, float_type coverage) noexcept
+                : rasterizedPoint_(rasterizedPoint)
+                , coverage_(coverage)
+            {}
+
+        private: // RasterizationContextBase<AntialiasedEllipseRastrContext> implementation
+            Point<int_type> getRasterizedPointImpl() const noexcept { return rasterizedPoint_; }
+            float_type getPixelDensityImpl() const noexcept { return coverage_; }
+
+        private:
+            Point<int_type> rasterizedPoint_;
+            float_type coverage_;
+        };
+
+
+        class AntialiasedEllipseRastrSpan final : public RasterizationSpanBase<AntialiasedEllipseRastrSpan>
+        {
+            // for accessing to get*Impl() from base
+            friend struct RasterizationSpanBase<AntialiasedEllipseRastrSpan>;
+
+        public:
+            AntialiasedEllipseRastrSpan(
+                int_type y,
+                int_type xBegin,
+                int_type xEnd,
+                int_type interiorBegin,
+                int_type interiorEnd,
+                Point<float_type> center,
+                float_type a,
+                float_type b
+            ) noexcept
+                : y_(y)
+                , xBegin_(xBegin)
+                , xEnd_(xEnd)
+                , interiorBegin_(interiorBegin)
+                , interiorEnd_(interiorEnd)
+                , center_(center)
+                , a_(a)
+                , b_(b)
+            {}
+
+            // the pixels [getInteriorBegin(); getInteriorEnd()) are entirely inside the ellipse (their densities are 1)
+            [[nodiscard]] int_type getInteriorBegin() const noexcept { return interiorBegin_; }
+            [[nodiscard]] int_type getInteriorEnd() const noexcept { return interiorEnd_; }
+
+        private: // RasterizationSpanBase<AntialiasedEllipseRastrSpan> implementation
+            int_type getYImpl() const noexcept { return y_; }
+            int_type getXBeginImpl() const noexcept { return xBegin_; }
+            int_type getXEndImpl() const noexcept { return xEnd_; }
+
+            float_type getPixelDensityAtImpl(int_type x) const noexcept
+            {
+                // the area is calculated only for the pixels of the edge
+                if ( (x >= interiorBegin_) && (x < interiorEnd_) )
+                    return 1;
+
+                return getEllipsePixelCoverage(center_, a_, b_, x, y_);
+            }
+
+        private:
+            int_type y_;
+            int_type xBegin_;
+            int_type xEnd_;
+            int_type interiorBegin_;
+            int_type interiorEnd_;
+            Point<float_type> center_;
+            float_type a_;
+            float_type b_;
+        };
+    } // namespace detail
+
+
+    // The AntialiasedEllipse class is an ellipse whose pixels have the densities equal to
+    //  the exact areas of their intersections with the ellipse.
+    // Unlike Ellipse it rasterizes all the pixels intersecting the ellipse (not only the ones whose centers are inside it).
+    // The areas are calculated analytically for the pixels of the edge only, so the cost is proportional to the perimeter.
+    class AntialiasedEllipse : public Shape<AntialiasedEllipse, detail::AntialiasedEllipseRastrContext>
+    {
+        friend struct Shape<AntialiasedEllipse, detail::AntialiasedEllipseRastrContext>;
+
+    public:
+        using RasterizationSpan = detail::AntialiasedEllipseRastrSpan;
+
+    public: // ctors/dtor
+        // if xAxis is not inside the range [0; +inf) or yAxis is not inside the range [0; +inf),
+        //  behaviour of other methods is undefined
+        explicit AntialiasedEllipse(
+            Point<float_type> center = {0, 0},
+            float_type xAxis = 0,
+            float_type yAxis = 0) noexcept;
+
+        ~AntialiasedEllipse() noexcept = default;
+
+    public: // comparison
+        [[nodiscard]] bool operator==(const AntialiasedEllipse& rhs) const noexcept
+        {
+            return (center_ == rhs.center_) && (xAxisLength_ == rhs.xAxisLength_) && (yAxisLength_ == rhs.yAxisLength_);
+        }
+
+    protected:
+        Point<float_type> center_;
+        float_type xAxisLength_;
+        float_type yAxisLength_;
+
+    private: // Shape<AntialiasedEllipse> implementation
+        [[nodiscard]] ShapeRectArea getBoundsImpl() const noexcept;
+
+        [[nodiscard]] BlockCoverage classifyBlockImpl(const IntegralRectArea& block) const noexcept;
+
+        template<typename ConsumerFunctor>
+        void rasterizeOntoImpl(IntegralRectArea rect, ConsumerFunctor&& consumer) const
+        {
+            rasterizeSpansOntoImpl(rect, [&consumer](const detail::AntialiasedEllipseRastrSpan& span) {
+                const int_type y = span.getY();
+
+                for (int_type x = span.getXBegin(); x < span.getXEnd(); ++x)
+                {
+                    (void)std::forward<ConsumerFunctor>(consumer)(
+                        detail::AntialiasedEllipseRastrContext{ { x, y }, span.getPixelDensityAt(x) }
+                    );
+                }
+            });
+        }
+
+        template<typename ConsumerFunctor>
+        void rasterizeSpansOntoImpl(IntegralRectArea rect, ConsumerFunctor&& consumer) const
+        {
+            if ((rect.width < 1) || (rect.height < 1))
+                return;
+
+            const float_type a = xAxisLength_ / 2;
+            const float_type b = yAxisLength_ / 2;
+
+            // (also handles NaN)
+            if (!(a > 0) || !(b > 0))
+                return;
+
+            const IntegralRectArea thisIntegralBounds = getShapeIntegralBounds(*this);
+
+            const int_type xMin = (std::max)(rect.topLeft.x, thisIntegralBounds.topLeft.x);
+            const int_type xEnd = (std::min)(
+                rect.topLeft.x + static_cast<int_type>(rect.width),
+                thisIntegralBounds.topLeft.x + static_cast<int_type>(thisIntegralBounds.width)
+            );
+
+            // only the rows inside both the bounds and `rect` are visited
+            const int_type yStart = (std::min)(rect.topLeft.y, thisIntegralBounds.topLeft.y);
+            const int_type yEnd = (std::max)(
+                rect.topLeft.y - static_cast<int_type>(rect.height),
+                thisIntegralBounds.topLeft.y - static_cast<int_type>(thisIntegralBounds.height)
+            );
+
+            for (int_type y = yStart; y > yEnd; --y)
+            {
+                const detail::AntialiasedEllipseRow row = detail::getAntialiasedEllipseRow(center_, a, b, y);
+
+                const int_type spanBegin = (std::max)(row.begin, xMin);
+                const int_type spanEnd = (std::min)(row.end, xEnd);
+
+                if (spanBegin < spanEnd)
+                {
+                    (void)std::forward<ConsumerFunctor>(consumer)(
+                        detail::AntialiasedEllipseRastrSpan{
+                            y, spanBegin, spanEnd, row.interiorBegin, row.interiorEnd, center_, a, b
+                        }
+                    );
+                }
+            }
+        }
+    };
+} // namespace mglass::shapes
+
+#endif // ndef MAGNIFYING_GLASS_ANTIALIASED_ELLIPSE_SHAPE_H
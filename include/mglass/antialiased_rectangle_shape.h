@@ -0,0 +1,197 @@
+#ifndef MAGNIFYING_GLASS_ANTIALIASED_RECTANGLE_SHAPE_H
+#define MAGNIFYING_GLASS_ANTIALIASED_RECTANGLE_SHAPE_H
+
+#include "mglass/shape.h"   // Shape
+#include <utility>          // std::forward
+#include <algorithm>        // std::min, std::max
+
+
+namespace mglass::shapes
+{
+    namespace detail
+    {
+        // The pixels of an axis which intersect the range [first; last] of a rectangle
+        //  and the ones which are entirely inside it.
+        struct AntialiasedRectangleAxis final
+        {
+            // [begin; end) intersect the range, [interiorBegin; interiorEnd) are inside it
+            int_type begin;
+            int_type end;
+            int_type interiorBegin;
+            int_type interiorEnd;
+
+            // returns the length of the intersection of the pixel [`pixel`; `pixel` + 1] and the range [`first`; `last`]
+            [[nodiscard]] static float_type getCoverageOf(const int_type pixel, const float_type first, const float_type last) noexcept
+            {
+                const float_type coverage = (std::min)(static_cast<float_type>(pixel + 1), last)
+                                          - (std::max)(static_cast<float_type>(pixel), first);
+
+                return (std::min)((std::max)(coverage, float_type{0}), float_type{1});
+            }
+
+            [[nodiscard]] static AntialiasedRectangleAxis calculateFor(float_type first, float_type last) noexcept;
+        };
+
+
+        class AntialiasedRectangleRastrContext final : public RasterizationContextBase<AntialiasedRectangleRastrContext>
+        {
+            // for accessing to getRasterizedPointImpl(), getPixelDensityImpl() from base
+            friend struct RasterizationContextBase<AntialiasedRectangleRastrContext>;
+
+        public:
+            AntialiasedRectangleRastrContext(Point<int_type> rasterizedPoint, float_type coverage) noexcept
+                : rasterizedPoint_(rasterizedPoint)
+                , coverage_(coverage)
+            {}
+
+        private: // RasterizationContextBase<AntialiasedRectangleRastrContext> implementation
+            Point<int_type> getRasterizedPointImpl() const noexcept { return rasterizedPoint_; }
+            float_type getPixelDensityImpl() const noexcept { return coverage_; }
+
+        private:
+            Point<int_type> rasterizedPoint_;
+            float_type coverage_;
+        };
+
+
+        class AntialiasedRectangleRastrSpan final : public RasterizationSpanBase<AntialiasedRectangleRastrSpan>
+        {
+            // for accessing to get*Impl() from base
+            friend struct RasterizationSpanBase<AntialiasedRectangleRastrSpan>;
+
+        public:
+            AntialiasedRectangleRastrSpan(
+                int_type y,
+                int_type xBegin,
+                int_type xEnd,
+                int_type interiorBegin,
+                int_type interiorEnd,
+                float_type left,
+                float_type right,
+                float_type rowCoverage) noexcept
+                : y_(y)
+                , xBegin_(xBegin)
+                , xEnd_(xEnd)
+                , interiorBegin_(interiorBegin)
+                , interiorEnd_(interiorEnd)
+                , left_(left)
+                , right_(right)
+                , rowCoverage_(rowCoverage)
+            {}
+
+        private: // RasterizationSpanBase<AntialiasedRectangleRastrSpan> implementation
+            int_type getYImpl() const noexcept { return y_; }
+            int_type getXBeginImpl() const noexcept { return xBegin_; }
+            int_type getXEndImpl() const noexcept { return xEnd_; }
+
+            float_type getPixelDensityAtImpl(int_type x) const noexcept
+            {
+                const float_type columnCoverage = ( (x >= interiorBegin_) && (x < interiorEnd_) )
+                    ? 1
+                    : AntialiasedRectangleAxis::getCoverageOf(x, left_, right_);
+
+                return columnCoverage * rowCoverage_;
+            }
+
+        private:
+            int_type y_;
+            int_type xBegin_;
+            int_type xEnd_;
+            int_type interiorBegin_;
+            int_type interiorEnd_;
+            float_type left_;
+            float_type right_;
+            // the coverage of the row, it is 1 for the rows inside the rectangle
+            float_type rowCoverage_;
+        };
+    } // namespace detail
+
+
+    // The AntialiasedRectangle class is a rectangle whose pixels have the densities equal to
+    //  the exact areas of their intersections with the rectangle.
+    // Unlike Rectangle it rasterizes all the pixels intersecting the rectangle (not only the ones whose centers are inside it).
+    class AntialiasedRectangle : public Shape<AntialiasedRectangle, detail::AntialiasedRectangleRastrContext>
+    {
+        friend struct Shape<AntialiasedRectangle, detail::AntialiasedRectangleRastrContext>;
+
+    public:
+        using RasterizationSpan = detail::AntialiasedRectangleRastrSpan;
+
+    public: // ctors/dtor
+        explicit AntialiasedRectangle(
+            Point<float_type> center = {0, 0},
+            float_type width = 0,
+            float_type height = 0) noexcept;
+
+        ~AntialiasedRectangle() noexcept = default;
+
+    public: // comparison
+        [[nodiscard]] bool operator==(const AntialiasedRectangle& rhs) const noexcept
+        {
+            return (center_ == rhs.center_) && (width_ == rhs.width_) && (height_ == rhs.height_);
+        }
+
+    protected:
+        Point<float_type> center_;
+        float_type width_;
+        float_type height_;
+
+    private: // Shape<AntialiasedRectangle> implementation
+        [[nodiscard]] ShapeRectArea getBoundsImpl() const noexcept;
+
+        [[nodiscard]] BlockCoverage classifyBlockImpl(const IntegralRectArea& block) const noexcept;
+
+        template<typename ConsumerFunctor>
+        void rasterizeOntoImpl(IntegralRectArea rect, ConsumerFunctor&& consumer) const
+        {
+            rasterizeSpansOntoImpl(rect, [&consumer](const detail::AntialiasedRectangleRastrSpan& span) {
+                const int_type y = span.getY();
+
+                for (int_type x = span.getXBegin(); x < span.getXEnd(); ++x)
+                {
+                    (void)std::forward<ConsumerFunctor>(consumer)(
+                        detail::AntialiasedRectangleRastrContext{ { x, y }, span.getPixelDensityAt(x) }
+                    );
+                }
+            });
+        }
+
+        template<typename ConsumerFunctor>
+        void rasterizeSpansOntoImpl(IntegralRectArea rect, ConsumerFunctor&& consumer) const
+        {
+            if ((rect.width < 1) || (rect.height < 1))
+                return;
+
+            const ShapeRectArea bounds = getBoundsImpl();
+            const float_type bottom = bounds.topLeft.y - bounds.height;
+
+            const auto columns = detail::AntialiasedRectangleAxis::calculateFor(bounds.topLeft.x, bounds.topLeft.x + bounds.width);
+            const auto rows = detail::AntialiasedRectangleAxis::calculateFor(bottom, bounds.topLeft.y);
+
+            const int_type xBegin = (std::max)(columns.begin, rect.topLeft.x);
+            const int_type xEnd = (std::min)(columns.end, rect.topLeft.x + static_cast<int_type>(rect.width));
+
+            if (xBegin >= xEnd)
+                return;
+
+            const int_type yStart = (std::min)(rows.end - 1, rect.topLeft.y);
+            const int_type yEnd = (std::max)(rows.begin, rect.topLeft.y - static_cast<int_type>(rect.height) + 1);
+
+            for (int_type y = yStart; y >= yEnd; --y)
+            {
+                const float_type rowCoverage = ( (y >= rows.interiorBegin) && (y < rows.interiorEnd) )
+                    ? 1
+                    : detail::AntialiasedRectangleAxis::getCoverageOf(y, bottom, bounds.topLeft.y);
+
+                (void)std::forward<ConsumerFunctor>(consumer)(
+                    detail::AntialiasedRectangleRastrSpan{
+                        y, xBegin, xEnd, columns.interiorBegin, columns.interiorEnd,
+                        bounds.topLeft.x, bounds.topLeft.x + bounds.width, rowCoverage
+                    }
+                );
+            }
+        }
+    };
+} // namespace mglass::shapes
+
+#endif // ndef MAGNIFYING_GLASS_ANTIALIASED_RECTANGLE_SHAPE_H
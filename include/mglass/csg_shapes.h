@@ -0,0 +1,408 @@
+#ifndef MAGNIFYING_GLASS_CSG_SHAPES_H
+#define MAGNIFYING_GLASS_CSG_SHAPES_H
+
+#include "mglass/primitives.h"          // Point, IntegralRectArea, getIntersectionOf, int_type, size_type, float_type
+#include "mglass/shape.h"               // Shape, ShapeRectArea, BlockCoverage, getShapeIntegralBounds, detail::isEqualityComparable
+#include "mglass/rasterized_spans.h"    // RasterizedPointContext, RasterizedSpan
+#include <algorithm>                    // std::min, std::max, std::is_sorted, std::stable_sort
+#include <limits>                       // std::numeric_limits
+#include <memory>                       // std::shared_ptr, std::make_shared
+#include <type_traits>                  // std::enable_if_t
+#include <utility>                      // std::forward, std::move
+#include <vector>                       // std::vector
+
+
+// Constructive solid geometry: shapes which are unions, intersections or differences of two shapes.
+namespace mglass::shapes
+{
+    enum class BooleanOperation
+    {
+        Union,          // the pixels of any operand, the density of a pixel is the maximum of the operands' ones
+        Intersection,   // the pixels of both operands, the density of a pixel is the minimum of the operands' ones
+        Difference      // the pixels of the first operand which are not covered fully by the second one,
+                        //  the density of a pixel is min(the first operand's one, 1 - the second operand's one)
+    };
+
+
+    namespace detail
+    {
+        // The spans of an operand of BooleanShape ordered by decreasing y and then by increasing x.
+        class OperandSpans final
+        {
+        public:
+            struct Span final
+            {
+                int_type y;
+                int_type xBegin;
+                int_type xEnd;
+                size_type valuesOffset; // the density of the pixel x is getValues()[valuesOffset + x - xBegin]
+            };
+
+        public:
+            // rasterizes the spans of the `shape` inside the `area`
+            template<typename ShapeImpl, typename RastrCtx>
+            void assign(const Shape<ShapeImpl, RastrCtx>& shape, const IntegralRectArea& area)
+            {
+                spans_.clear();
+                values_.clear();
+
+                shape.rasterizeSpansOnto(area, [this](const auto& span) {
+                    const int_type xBegin = span.getXBegin();
+                    const int_type xEnd = span.getXEnd();
+
+                    spans_.push_back({ span.getY(), xBegin, xEnd, values_.size() });
+
+                    values_.resize(values_.size() + static_cast<size_type>(xEnd - xBegin));
+                    span.getPixelDensitiesOf(xBegin, xEnd, values_.data() + spans_.back().valuesOffset);
+                });
+
+                // shapes are not required to emit the spans in order
+                const auto isBefore = [](const Span& lhs, const Span& rhs) {
+                    return (lhs.y > rhs.y) || ( (lhs.y == rhs.y) && (lhs.xBegin < rhs.xBegin) );
+                };
+
+                if (!std::is_sorted(spans_.begin(), spans_.end(), isBefore))
+                    std::stable_sort(spans_.begin(), spans_.end(), isBefore);
+            }
+
+            [[nodiscard]] const std::vector<Span>& getSpans() const noexcept { return spans_; }
+            [[nodiscard]] const std::vector<float_type>& getValues() const noexcept { return values_; }
+
+        private:
+            std::vector<Span> spans_;
+            std::vector<float_type> values_;
+        };
+
+
+        // Calls `consumer`(xBegin, xEnd, firstDensities, secondDensities) for the pieces [xBegin; xEnd) of a row
+        //  covered by the same operands from left to right, the densities of the operand not covering a piece
+        //  are nullptr. The spans of each operand must be ordered by x and must not overlap.
+        // The count of the pieces is linear in the count of the spans.
+        template<typename ConsumerFunctor>
+        void mergeOperandRows(
+            const OperandSpans::Span* first,
+            const OperandSpans::Span* const firstEnd,
+            const float_type* const firstValues,
+            const OperandSpans::Span* second,
+            const OperandSpans::Span* const secondEnd,
+            const float_type* const secondValues,
+            ConsumerFunctor&& consumer)
+        {
+            constexpr int_type none = (std::numeric_limits<int_type>::max)();
+
+            // the pixels to the left of x are processed
+            int_type x = (std::numeric_limits<int_type>::min)();
+
+            while ((first != firstEnd) || (second != secondEnd))
+            {
+                const int_type firstBegin = (first != firstEnd) ? (std::max)(first->xBegin, x) : none;
+                const int_type secondBegin = (second != secondEnd) ? (std::max)(second->xBegin, x) : none;
+
+                const float_type* const firstDensities = (first != firstEnd)
+                    ? firstValues + first->valuesOffset + (firstBegin - first->xBegin)
+                    : nullptr;
+                const float_type* const secondDensities = (second != secondEnd)
+                    ? secondValues + second->valuesOffset + (secondBegin - second->xBegin)
+                    : nullptr;
+
+                if (firstBegin < secondBegin)
+                {
+                    x = (std::min)(first->xEnd, secondBegin);
+                    consumer(firstBegin, x, firstDensities, nullptr);
+                }
+                else if (secondBegin < firstBegin)
+                {
+                    x = (std::min)(second->xEnd, firstBegin);
+                    consumer(secondBegin, x, nullptr, secondDensities);
+                }
+                else
+                {
+                    x = (std::min)(first->xEnd, second->xEnd);
+                    consumer(firstBegin, x, firstDensities, secondDensities);
+                }
+
+                if ((first != firstEnd) && (first->xEnd == x))
+                    ++first;
+                if ((second != secondEnd) && (second->xEnd == x))
+                    ++second;
+            }
+        }
+    } // namespace detail
+
+
+    // The BooleanShape class is the result of the `Operation` (see BooleanOperation) on two shapes
+    //  of the types First and Second (e.g. a ring is Difference<Ellipse, Ellipse>).
+    // The operands are not moved, the result has the pixels where they are rasterized.
+    //
+    // The operands are rasterized to the spans of each row once and the rows are combined by merging their spans,
+    //  so the cost is the cost of the rasterization of the operands plus the linear merging
+    //  (the pixels are not checked against both shapes one by one).
+    template<BooleanOperation Operation, typename First, typename Second>
+    class BooleanShape : public Shape<BooleanShape<Operation, First, Second>, mglass::detail::RasterizedPointContext>
+    {
+        friend struct Shape<BooleanShape<Operation, First, Second>, mglass::detail::RasterizedPointContext>;
+
+    public:
+        using RasterizationSpan = mglass::detail::RasterizedSpan<float_type>;
+
+        // the operands are immutable, so the copies of a shape share them
+        struct Operands final
+        {
+            First first;
+            Second second;
+
+            // the operands are compared by their values if both of their types have operator==
+            template<typename FirstT = First,
+                     typename = std::enable_if_t<mglass::detail::isEqualityComparable<FirstT> &&
+                                                 mglass::detail::isEqualityComparable<Second>>>
+            [[nodiscard]] bool operator==(const Operands& rhs) const noexcept
+            {
+                return (first == rhs.first) && (second == rhs.second);
+            }
+        };
+
+    public: // ctors/dtor
+        BooleanShape(First first, Second second)
+            : operands_(std::make_shared<const Operands>(Operands{ std::move(first), std::move(second) }))
+        {}
+
+        ~BooleanShape() noexcept = default;
+
+    public: // getters
+        [[nodiscard]] const First& getFirst() const noexcept { return operands_->first; }
+        [[nodiscard]] const Second& getSecond() const noexcept { return operands_->second; }
+
+        [[nodiscard]] const Operands& getOutline() const noexcept { return *operands_; }
+        // the operands shared by the copies of the shape. ShapeMaskCache compares them by their values
+        //  if the types of both operands have operator== (e.g. Ellipse, Rectangle or another BooleanShape of them),
+        //  otherwise only the copies of the same shape share the masks
+        [[nodiscard]] const std::shared_ptr<const Operands>& getSharedOutline() const noexcept { return operands_; }
+
+    public: // comparison
+        template<typename FirstT = First,
+                 typename = std::enable_if_t<mglass::detail::isEqualityComparable<FirstT> &&
+                                             mglass::detail::isEqualityComparable<Second>>>
+        [[nodiscard]] bool operator==(const BooleanShape& rhs) const noexcept
+        {
+            return (operands_ == rhs.operands_) || (*operands_ == *rhs.operands_);
+        }
+
+    protected:
+        std::shared_ptr<const Operands> operands_;
+
+    private: // Shape<BooleanShape> implementation
+        [[nodiscard]] ShapeRectArea getBoundsImpl() const noexcept
+        {
+            const ShapeRectArea firstBounds = getFirst().getBounds();
+
+            if constexpr (Operation == BooleanOperation::Difference)
+            {
+                return firstBounds;
+            }
+            else
+            {
+                const ShapeRectArea secondBounds = getSecond().getBounds();
+
+                const float_type firstRight = firstBounds.topLeft.x + firstBounds.width;
+                const float_type firstBottom = firstBounds.topLeft.y - firstBounds.height;
+                const float_type secondRight = secondBounds.topLeft.x + secondBounds.width;
+                const float_type secondBottom = secondBounds.topLeft.y - secondBounds.height;
+
+                float_type left = 0, top = 0, right = 0, bottom = 0;
+
+                if constexpr (Operation == BooleanOperation::Union)
+                {
+                    left = (std::min)(firstBounds.topLeft.x, secondBounds.topLeft.x);
+                    top = (std::max)(firstBounds.topLeft.y, secondBounds.topLeft.y);
+                    right = (std::max)(firstRight, secondRight);
+                    bottom = (std::min)(firstBottom, secondBottom);
+                }
+                else
+                {
+                    left = (std::max)(firstBounds.topLeft.x, secondBounds.topLeft.x);
+                    top = (std::min)(firstBounds.topLeft.y, secondBounds.topLeft.y);
+                    // the bounds of the disjoint operands are empty
+                    right = (std::max)((std::min)(firstRight, secondRight), left);
+                    bottom = (std::min)((std::max)(firstBottom, secondBottom), top);
+                }
+
+                return { { left, top }, right - left, top - bottom };
+            }
+        }
+
+        [[nodiscard]] BlockCoverage classifyBlockImpl(const IntegralRectArea& block) const noexcept
+        {
+            const BlockCoverage first = getFirst().classifyBlock(block);
+            const BlockCoverage second = getSecond().classifyBlock(block);
+
+            if constexpr (Operation == BooleanOperation::Union)
+            {
+                if ((first == BlockCoverage::Inside) || (second == BlockCoverage::Inside))
+                    return BlockCoverage::Inside;
+                if ((first == BlockCoverage::Outside) && (second == BlockCoverage::Outside))
+                    return BlockCoverage::Outside;
+            }
+            else if constexpr (Operation == BooleanOperation::Intersection)
+            {
+                if ((first == BlockCoverage::Inside) && (second == BlockCoverage::Inside))
+                    return BlockCoverage::Inside;
+                if ((first == BlockCoverage::Outside) || (second == BlockCoverage::Outside))
+                    return BlockCoverage::Outside;
+            }
+            else
+            {
+                if ((first == BlockCoverage::Inside) && (second == BlockCoverage::Outside))
+                    return BlockCoverage::Inside;
+                if ((first == BlockCoverage::Outside) || (second == BlockCoverage::Inside))
+                    return BlockCoverage::Outside;
+            }
+
+            return BlockCoverage::Edge;
+        }
+
+        template<typename ConsumerFunctor>
+        void rasterizeOntoImpl(IntegralRectArea rect, ConsumerFunctor&& consumer) const
+        {
+            rasterizeSpansOntoImpl(rect, [&consumer](const RasterizationSpan& span) {
+                for (int_type x = span.getXBegin(); x < span.getXEnd(); ++x)
+                {
+                    (void)std::forward<ConsumerFunctor>(consumer)(
+                        mglass::detail::RasterizedPointContext{ { x, span.getY() }, span.getPixelDensityAt(x) }
+                    );
+                }
+            });
+        }
+
+        template<typename ConsumerFunctor>
+        void rasterizeSpansOntoImpl(IntegralRectArea rect, ConsumerFunctor&& consumer) const
+        {
+            using OperandSpan = detail::OperandSpans::Span;
+
+            const IntegralRectArea area = getIntersectionOf(getShapeIntegralBounds(*this), rect);
+            if ((area.width < 1) || (area.height < 1))
+                return;
+
+            detail::OperandSpans first;
+            detail::OperandSpans second;
+
+            first.assign(getFirst(), area);
+            if ( (Operation != BooleanOperation::Union) && first.getSpans().empty() )
+                return;
+
+            second.assign(getSecond(), area);
+
+            const std::vector<OperandSpan>& firstSpans = first.getSpans();
+            const std::vector<OperandSpan>& secondSpans = second.getSpans();
+
+            // the spans of the current row and the densities of their pixels
+            std::vector<OperandSpan> rowSpans;
+            std::vector<float_type> rowValues;
+
+            size_type firstIndex = 0;
+            size_type secondIndex = 0;
+
+            while ((firstIndex < firstSpans.size()) || (secondIndex < secondSpans.size()))
+            {
+                // the topmost row having the spans of any operand
+                const int_type y = (std::max)(
+                    (firstIndex < firstSpans.size()) ? firstSpans[firstIndex].y : (std::numeric_limits<int_type>::min)(),
+                    (secondIndex < secondSpans.size()) ? secondSpans[secondIndex].y : (std::numeric_limits<int_type>::min)()
+                );
+
+                const size_type firstRowBegin = firstIndex;
+                while ((firstIndex < firstSpans.size()) && (firstSpans[firstIndex].y == y))
+                    ++firstIndex;
+
+                const size_type secondRowBegin = secondIndex;
+                while ((secondIndex < secondSpans.size()) && (secondSpans[secondIndex].y == y))
+                    ++secondIndex;
+
+                rowSpans.clear();
+                rowValues.clear();
+
+                detail::mergeOperandRows(
+                    firstSpans.data() + firstRowBegin, firstSpans.data() + firstIndex, first.getValues().data(),
+                    secondSpans.data() + secondRowBegin, secondSpans.data() + secondIndex, second.getValues().data(),
+                    [&](const int_type xBegin, const int_type xEnd, const float_type* firstDensities, const float_type* secondDensities) {
+                        if (!isIncluded(firstDensities != nullptr, secondDensities != nullptr))
+                            return;
+
+                        for (int_type i = 0; i < xEnd - xBegin; ++i)
+                        {
+                            if (isExcludedPixel(secondDensities, i))
+                                continue;
+
+                            // the adjacent pixels are joined into a single span
+                            const int_type x = xBegin + i;
+                            if (rowSpans.empty() || (rowSpans.back().xEnd != x))
+                                rowSpans.push_back({ y, x, x, rowValues.size() });
+
+                            ++rowSpans.back().xEnd;
+                            rowValues.push_back(combineDensities(firstDensities, secondDensities, i));
+                        }
+                    }
+                );
+
+                for (const OperandSpan& span : rowSpans)
+                {
+                    (void)std::forward<ConsumerFunctor>(consumer)(
+                        RasterizationSpan{ span.y, span.xBegin, span.xEnd, rowValues.data() + span.valuesOffset }
+                    );
+                }
+            }
+        }
+
+    private:
+        // returns true if the pixels covered by the operands (`inFirst`, `inSecond`) are the pixels of this
+        [[nodiscard]] static constexpr bool isIncluded(const bool inFirst, const bool inSecond) noexcept
+        {
+            if constexpr (Operation == BooleanOperation::Union)
+                return (inFirst || inSecond);
+            else if constexpr (Operation == BooleanOperation::Intersection)
+                return (inFirst && inSecond);
+            else
+                return inFirst;
+        }
+
+        // returns true if the i-th pixel of an included piece (see mergeOperandRows) is not the pixel of this
+        //  (the pixels of Difference covered by the second operand with the density 1 are dropped)
+        [[nodiscard]] static bool isExcludedPixel(const float_type* const secondDensities, const int_type i) noexcept
+        {
+            if constexpr (Operation == BooleanOperation::Difference)
+                return (secondDensities != nullptr) && (secondDensities[i] >= 1);
+            else
+                return false;
+        }
+
+        // returns the density of the i-th pixel of an included piece (see mergeOperandRows)
+        [[nodiscard]] static float_type combineDensities(
+            const float_type* const firstDensities,
+            const float_type* const secondDensities,
+            const int_type i) noexcept
+        {
+            if (firstDensities == nullptr)
+                return secondDensities[i];
+            if (secondDensities == nullptr)
+                return firstDensities[i];
+
+            if constexpr (Operation == BooleanOperation::Union)
+                return (std::max)(firstDensities[i], secondDensities[i]);
+            else if constexpr (Operation == BooleanOperation::Intersection)
+                return (std::min)(firstDensities[i], secondDensities[i]);
+            else
+                return (std::min)(firstDensities[i], 1 - secondDensities[i]);
+        }
+    };
+
+
+    template<typename First, typename Second>
+    using Union = BooleanShape<BooleanOperation::Union, First, Second>;
+
+    template<typename First, typename Second>
+    using Intersection = BooleanShape<BooleanOperation::Intersection, First, Second>;
+
+    template<typename First, typename Second>
+    using Difference = BooleanShape<BooleanOperation::Difference, First, Second>;
+} // namespace mglass::shapes
+
+#endif // ndef MAGNIFYING_GLASS_CSG_SHAPES_H
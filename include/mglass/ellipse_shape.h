@@ -1,14 +1,28 @@
 #ifndef MAGNIFYING_GLASS_ELLIPSE_SHAPE_H
 #define MAGNIFYING_GLASS_ELLIPSE_SHAPE_H
 
-#include "mglass/shape.h"   // Shape
-#include <utility>          // std::forward
+#include "mglass/shape.h"               // Shape
+#include "mglass/falloff_profile.h"     // FalloffProfile
+#include <utility>                      // std::forward
+#include <algorithm>                    // std::min, std::max
+#include <cmath>                        // std::floor, std::ceil, std::sqrt
 
 
 namespace mglass::shapes
 {
     namespace detail
     {
+        // Writes the normalized distances u = 1 - (x^2 / a^2 + y^2 / b^2) of the pixels [`xBegin`; `xEnd`) of a row
+        //  into `distances` (see EllipseRastrSpan), 8 (AVX2) or 4 (SSE4.1) pixels are calculated at once if SIMD is enabled.
+        void getEllipseNormalizedDistances(
+            float_type centerX,
+            float_type a2Inversed,
+            float_type y2divb2,
+            int_type xBegin,
+            int_type xEnd,
+            float_type* distances) noexcept;
+
+
         class EllipseRastrContext final : public RasterizationContextBase<EllipseRastrContext>
         {
             // for accessing to getRasterizedPointImpl(), getPixelDensityImpl() from base
@@ -19,12 +33,14 @@ namespace mglass::shapes
                 Point<int_type> rasterizedPoint,
                 float_type x2,
                 float_type a2Inversed,
-                float_type y2divb2
+                float_type y2divb2,
+                const FalloffProfile* falloff
             ) noexcept
                 : rasterizedPoint_(rasterizedPoint)
                 , x2_(x2)
                 , a2Inversed_(a2Inversed)
                 , y2divb2_(y2divb2)
+                , falloff_(falloff)
             {}
 
         private: // RasterizationContextBase<EllipseRastrContext> implementation
@@ -35,7 +51,7 @@ namespace mglass::shapes
                 using namespace literals;
 
                 const float_type result = x2_ * a2Inversed_ + y2divb2_;
-                return 1_flt - (result * result) * (result * result);
+                return falloff_->getDensityAt(1_flt - result);
             }
 
         private:
@@ -43,6 +59,75 @@ namespace mglass::shapes
             float_type x2_;
             float_type a2Inversed_;
             float_type y2divb2_;
+            const FalloffProfile* falloff_;
+        };
+
+
+        class EllipseRastrSpan final : public RasterizationSpanBase<EllipseRastrSpan>
+        {
+            // for accessing to get*Impl() from base
+            friend struct RasterizationSpanBase<EllipseRastrSpan>;
+
+        public:
+            EllipseRastrSpan(
+                int_type y,
+                int_type xBegin,
+                int_type xEnd,
+                float_type centerX,
+                float_type a2Inversed,
+                float_type y2divb2,
+                const FalloffProfile* falloff
+            ) noexcept
+                : y_(y)
+                , xBegin_(xBegin)
+                , xEnd_(xEnd)
+                , centerX_(centerX)
+                , a2Inversed_(a2Inversed)
+                , y2divb2_(y2divb2)
+                , falloff_(falloff)
+            {}
+
+            // returns x^2 for the pixel `xUnaligned` (see EllipseRastrContext)
+            [[nodiscard]] float_type getX2At(int_type xUnaligned) const noexcept
+            {
+                using namespace literals;
+
+                // +0.5 is for moving to the pixel's center
+                const float_type x = (static_cast<float_type>(xUnaligned) + 0.5_flt) - centerX_;
+                return x * x;
+            }
+
+            [[nodiscard]] float_type getA2Inversed() const noexcept { return a2Inversed_; }
+            [[nodiscard]] float_type getY2DivB2() const noexcept { return y2divb2_; }
+            [[nodiscard]] const FalloffProfile* getFalloffProfile() const noexcept { return falloff_; }
+
+        private: // RasterizationSpanBase<EllipseRastrSpan> implementation
+            int_type getYImpl() const noexcept { return y_; }
+            int_type getXBeginImpl() const noexcept { return xBegin_; }
+            int_type getXEndImpl() const noexcept { return xEnd_; }
+
+            float_type getPixelDensityAtImpl(int_type x) const noexcept
+            {
+                using namespace literals;
+
+                const float_type result = getX2At(x) * a2Inversed_ + y2divb2_;
+                return falloff_->getDensityAt(1_flt - result);
+            }
+
+            void getPixelDensitiesOfImpl(int_type xBegin, int_type xEnd, float_type* densities) const noexcept
+            {
+                getEllipseNormalizedDistances(centerX_, a2Inversed_, y2divb2_, xBegin, xEnd, densities);
+                falloff_->getDensitiesAt(densities, static_cast<size_type>(xEnd - xBegin));
+            }
+
+        private:
+            int_type y_;
+            int_type xBegin_;
+            int_type xEnd_;
+            float_type centerX_;
+            float_type a2Inversed_;
+            float_type y2divb2_;
+            const FalloffProfile* falloff_;
         };
     } // namespace detail
 
@@ -51,26 +136,69 @@ namespace mglass::shapes
     {
         friend struct Shape<Ellipse, detail::EllipseRastrContext>;
 
+    public:
+        using RasterizationSpan = detail::EllipseRastrSpan;
+
     public: // ctors/dtor
         // if xAxis is not inside the range [0; +inf) or yAxis is not inside the range [0; +inf),
         //  behaviour of other methods is undefined
+        // the `falloff` must outlive the ellipse (the built-in profiles live until the program exits)
         explicit Ellipse(
             Point<float_type> center = {0, 0},
             float_type xAxis = 0,
-            float_type yAxis = 0) noexcept;
+            float_type yAxis = 0,
+            const FalloffProfile& falloff = FalloffProfile::quartic()) noexcept;
+
+        // rejects the temporary profiles which would be destroyed before the ellipse is used
+        Ellipse(
+            Point<float_type> center,
+            float_type xAxis,
+            float_type yAxis,
+            const FalloffProfile&& falloff) = delete;
 
         ~Ellipse() noexcept = default;
 
+    public: // getters
+        [[nodiscard]] const FalloffProfile& getFalloffProfile() const noexcept { return *falloff_; }
+
+    public: // comparison
+        // the profiles are compared by their identifiers (see FalloffProfile::getId)
+        [[nodiscard]] bool operator==(const Ellipse& rhs) const noexcept
+        {
+            return (center_ == rhs.center_) && (xAxisLength_ == rhs.xAxisLength_) && (yAxisLength_ == rhs.yAxisLength_) &&
+                   (falloff_->getId() == rhs.falloff_->getId());
+        }
+
     protected:
         Point<float_type> center_;
         float_type xAxisLength_;
         float_type yAxisLength_;
+        const FalloffProfile* falloff_;
 
     private: // Shape<Ellipse> implementation
         [[nodiscard]] ShapeRectArea getBoundsImpl() const noexcept;
 
+        [[nodiscard]] BlockCoverage classifyBlockImpl(const IntegralRectArea& block) const noexcept;
+
         template<typename ConsumerFunctor>
         void rasterizeOntoImpl(IntegralRectArea rect, ConsumerFunctor&& consumer) const
+        {
+            rasterizeSpansOntoImpl(rect, [&consumer](const detail::EllipseRastrSpan& span) {
+                const int_type y = span.getY();
+
+                for (int_type x = span.getXBegin(); x < span.getXEnd(); ++x)
+                {
+                    (void)std::forward<ConsumerFunctor>(consumer)(
+                        detail::EllipseRastrContext{
+                            { x, y }, span.getX2At(x), span.getA2Inversed(), span.getY2DivB2(), span.getFalloffProfile()
+                        }
+                    );
+                }
+            });
+        }
+
+        template<typename ConsumerFunctor>
+        void rasterizeSpansOntoImpl(IntegralRectArea rect, ConsumerFunctor&& consumer) const
         {
             using namespace literals;
 
@@ -91,9 +219,6 @@ namespace mglass::shapes
             const auto rectYMin = rect.topLeft.y - static_cast<int_type>(rect.height - 1);
             const auto rectYMax = rect.topLeft.y;
 
-            // TODO: optimize the algorithm:
-            //  1. find for every y the exact range [xMin, xMax] for which every point (x, y) is inside the ellipse
-
             // a^2 == (xAxisLength_ / 2) ^ 2
             const auto a2 = (xAxisLength_ * xAxisLength_) / 4;
             const auto a2Inversed = 1_flt / a2;
@@ -101,19 +226,30 @@ namespace mglass::shapes
             const auto b2 = (yAxisLength_ * yAxisLength_) / 4;
             const auto b2Inversed = 1_flt / b2;
 
-            const auto xStart = thisIntegralBounds.topLeft.x;
-            const auto xEnd = thisIntegralBounds.topLeft.x + static_cast<int_type>(thisIntegralBounds.width);
+            // the inclusive range of the bounds
+            const auto xMin = thisIntegralBounds.topLeft.x;
+            const auto xMax = thisIntegralBounds.topLeft.x + static_cast<int_type>(thisIntegralBounds.width - 1);
 
-            const auto yStart = thisIntegralBounds.topLeft.y;
-            const auto yEnd = thisIntegralBounds.topLeft.y - static_cast<int_type>(thisIntegralBounds.height);
+            // only the rows inside both the bounds and `rect` are visited
+            const auto yStart = (std::min)(thisIntegralBounds.topLeft.y, rectYMax);
+            const auto yEnd = (std::max)(thisIntegralBounds.topLeft.y - static_cast<int_type>(thisIntegralBounds.height), rectYMin - 1);
+
+            // x^2 of a pixel's center grows while the pixel moves away from the center column,
+            //  so the pixels of a row which are inside the ellipse always form a single run containing the center column
+            const auto xCenter = (std::min)( (std::max)(static_cast<int_type>(std::floor(center_.x)), xMin), xMax );
+
+            const auto getX2At = [cx = center_.x](int_type xUnaligned) {
+                // +0.5 is for moving to the pixel's center
+                const float_type x = (static_cast<float_type>(xUnaligned) + 0.5_flt) - cx;
+                return x * x;
+            };
+
+            // the inclusive range of the run at the previous row (the run is empty if runLeft > runRight)
+            int_type runLeft = xCenter + 1;
+            int_type runRight = xCenter;
 
             for (int_type yUnaligned = yStart; yUnaligned > yEnd; --yUnaligned)
             {
-                if (yUnaligned < rectYMin)
-                    break;
-                if (yUnaligned > rectYMax)
-                    continue;
-
                 // b^2 * x^2 + a^2 * y^2 <= a^2 * b^2
                 // equals to
                 // b^2 * x^2 + a^2(y^2 - b^2) <= 0
@@ -133,26 +269,52 @@ namespace mglass::shapes
 
                 const float_type rightPart = a2 - a2 * y2divb2;
 
-                for (int_type xUnaligned = xStart; xUnaligned < xEnd; ++xUnaligned)
+                // (also handles NaN of the degenerate ellipses)
+                if (!(getX2At(xCenter) <= rightPart))
+                {
+                    runLeft = xCenter + 1;
+                    runRight = xCenter;
+                    continue;
+                }
+
+                // The ends of the run are moved from their positions at the previous row one pixel at a time
+                //  while the decision (x^2 <= rightPart at the pixel's center) says they have to be moved
+                //  (it's the same approach as the midpoint algorithm has).
+                // So the total count of the steps is proportional to the perimeter of the ellipse.
+                // If the previous row has no run (the first row or the rows at the ends of the y-axis)
+                //  the ends are estimated by the exact solution of the equation.
+                if (runLeft > runRight)
+                {
+                    const float_type halfRunLength = std::sqrt(rightPart);
+                    const float_type leftEstimate = std::ceil(center_.x - 0.5_flt - halfRunLength);
+                    const float_type rightEstimate = std::floor(center_.x - 0.5_flt + halfRunLength);
+
+                    runLeft = static_cast<int_type>(
+                        (std::min)( (std::max)(leftEstimate, static_cast<float_type>(xMin)), static_cast<float_type>(xCenter) )
+                    );
+                    runRight = static_cast<int_type>(
+                        (std::max)( (std::min)(rightEstimate, static_cast<float_type>(xMax)), static_cast<float_type>(xCenter) )
+                    );
+                }
+
+                while ((runRight < xMax) && (getX2At(runRight + 1) <= rightPart))
+                    ++runRight;
+                while (!(getX2At(runRight) <= rightPart))
+                    --runRight;
+
+                while ((runLeft > xMin) && (getX2At(runLeft - 1) <= rightPart))
+                    --runLeft;
+                while (!(getX2At(runLeft) <= rightPart))
+                    ++runLeft;
+
+                const int_type spanBegin = (std::max)(runLeft, rectXMin);
+                const int_type spanEnd = (std::min)(runRight, rectXMax) + 1;
+
+                if (spanBegin < spanEnd)
                 {
-                    if (xUnaligned > rectXMax)
-                        break;
-                    if (xUnaligned < rectXMin)
-                        continue;
-
-                    // +0.5 is for moving to the pixel's center
-                    const float_type x = (static_cast<float_type>(xUnaligned) + 0.5_flt) - center_.x;
-                    const float_type x2 = x * x;
-
-                    if (x2 <= rightPart)
-                    {
-                        float_type pointDensity = x2 * a2Inversed + y2divb2;
-                        pointDensity = 1_flt - (pointDensity * pointDensity) * (pointDensity * pointDensity);
-
-                        (void)std::forward<ConsumerFunctor>(consumer)(
-                            detail::EllipseRastrContext{ { xUnaligned, yUnaligned }, x2, a2Inversed, y2divb2 }
-                        );
-                    }
+                    (void)std::forward<ConsumerFunctor>(consumer)(
+                        detail::EllipseRastrSpan{ yUnaligned, spanBegin, spanEnd, center_.x, a2Inversed, y2divb2, falloff_ }
+                    );
                 }
             }
         }
@@ -0,0 +1,98 @@
+#ifndef MAGNIFYING_GLASS_EXECUTORS_H
+#define MAGNIFYING_GLASS_EXECUTORS_H
+
+#include "mglass/primitives.h"  // size_type
+#include <functional>           // std::function
+#include <vector>               // std::vector
+#include <thread>               // std::thread
+#include <mutex>                // std::mutex
+#include <condition_variable>   // std::condition_variable
+#include <atomic>               // std::atomic
+
+
+namespace mglass
+{
+    // The Executor class is an interface of the objects which run independent tasks on behalf of mglass algorithms
+    //  (e.g. the magnifiers render the bands of rows of the destination image as such tasks).
+    // Implement it to plug your own thread pool into mglass.
+    class Executor
+    {
+    public: // ctors/dtor
+        virtual ~Executor() noexcept = default;
+
+    public:
+        // Calls `task`(i) for each i inside the range [0; `tasksCount`) (in any order, possibly concurrently)
+        //  and returns when all calls have finished.
+        // `task` must not throw exceptions.
+        virtual void parallelFor(size_type tasksCount, const std::function<void(size_type taskIndex)>& task) = 0;
+
+    public: // getters
+        // the maximum number of tasks which can be executed simultaneously (>= 1)
+        [[nodiscard]] virtual size_type getConcurrency() const noexcept = 0;
+    };
+
+
+    // Runs all tasks one-by-one at the calling thread.
+    class SequentialExecutor final : public Executor
+    {
+    public:
+        void parallelFor(size_type tasksCount, const std::function<void(size_type taskIndex)>& task) override;
+
+    public: // getters
+        [[nodiscard]] size_type getConcurrency() const noexcept override { return 1; }
+    };
+
+
+    // The ThreadPool class runs tasks on a fixed set of worker threads and at the thread calling parallelFor.
+    // Threads take the next not started task of the current parallelFor call as soon as they finish the previous one,
+    //  so threads which got cheap tasks help to finish the expensive ones.
+    //
+    // Only one parallelFor call is executed at a time, concurrent calls wait for the previous ones.
+    // Calling parallelFor of a pool from a task run by the same pool leads to deadlock.
+    class ThreadPool final : public Executor
+    {
+    public: // ctors/dtor
+        // Creates the pool with `workerThreadsCount` threads in addition to the thread calling parallelFor.
+        // throws std::system_error if a thread could not be started
+        explicit ThreadPool(size_type workerThreadsCount = getDefaultWorkerThreadsCount()) noexcept(false);
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        ~ThreadPool() noexcept override;
+
+    public:
+        void parallelFor(size_type tasksCount, const std::function<void(size_type taskIndex)>& task) override;
+
+    public: // getters
+        [[nodiscard]] size_type getConcurrency() const noexcept override { return workers_.size() + 1; }
+
+        // std::thread::hardware_concurrency() - 1 or 0 if the hardware concurrency is unknown
+        [[nodiscard]] static size_type getDefaultWorkerThreadsCount() noexcept;
+
+    private:
+        void workerLoop() noexcept;
+        void runTasks(const std::function<void(size_type)>& task, size_type tasksCount) noexcept;
+
+    private:
+        // serializes parallelFor calls
+        std::mutex jobMutex_;
+
+        // guards all fields below except nextTask_
+        std::mutex mutex_;
+        std::condition_variable jobStarted_;
+        std::condition_variable jobFinished_;
+
+        const std::function<void(size_type)>* task_ = nullptr;
+        size_type tasksCount_ = 0;
+        size_type jobGeneration_ = 0;
+        size_type busyWorkersCount_ = 0;
+        bool stopRequested_ = false;
+
+        std::atomic<size_type> nextTask_{0};
+
+        std::vector<std::thread> workers_;
+    };
+} // namespace mglass
+
+#endif // ndef MAGNIFYING_GLASS_EXECUTORS_H
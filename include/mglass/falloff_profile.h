@@ -0,0 +1,166 @@
+#ifndef MAGNIFYING_GLASS_FALLOFF_PROFILE_H
+#define MAGNIFYING_GLASS_FALLOFF_PROFILE_H
+
+#include "mglass/primitives.h"  // float_type, size_type
+#include <algorithm>            // std::min, std::max
+#include <array>                // std::array
+#include <cstdint>              // std::uint32_t, std::uint64_t
+#include <cstring>              // std::memcpy
+#include <limits>               // std::numeric_limits
+
+
+namespace mglass
+{
+    // The FalloffProfile class defines densities of the pixels of a shape near its edges
+    //  (see RasterizationContextBase::getPixelDensity).
+    //
+    // A profile is a function of the normalized distance u from the edge of a shape to its pixel:
+    //  u == 0 at the edge and u == 1 at the center. The function is tabulated once,
+    //  so the shapes look densities up instead of evaluating the function for each pixel.
+    //
+    // The shapes define u as follows:
+    //  * Ellipse:      u = 1 - (x^2 / a^2 + y^2 / b^2), (x; y) is relative to the center
+    //  * Rectangle:    u = (1 - 2|x| / width) * (1 - 2|y| / height), (x; y) is relative to the center
+    //
+    // The table has the same count of entries for each octave [2^-(k+1); 2^-k) of u,
+    //  so the profiles which are steep near the edge (like fifthRoot) are tabulated precisely enough.
+    // The index of an entry is taken from the bits of u (the exponent and the high bits of the mantissa)
+    //  and the densities are linearly interpolated between the entries.
+    class FalloffProfile final
+    {
+        static_assert(std::numeric_limits<float_type>::is_iec559 && (sizeof(float_type) == sizeof(std::uint32_t)),
+                      "the table is indexed by the bits of IEEE-754 single precision values");
+
+    public:
+        // u inside the range [2^-octavesCount; 1] is tabulated, the densities of less u are
+        //  linearly interpolated between the ones at 0 and at 2^-octavesCount
+        static constexpr int octavesCount = 32;
+        // each octave has 2^stepsPerOctaveLog2 entries
+        static constexpr int stepsPerOctaveLog2 = 7;
+        static constexpr size_type tableSize = size_type{octavesCount} << stepsPerOctaveLog2;
+
+    public: // ctors/dtor
+        // Tabulates the `densityOf`(u) function, its values are clamped to the range [0; 1].
+        template<typename DensityFunction>
+        [[nodiscard]] static FalloffProfile fromFunction(const DensityFunction& densityOf);
+
+    public: // built-in profiles
+        // density = u
+        [[nodiscard]] static const FalloffProfile& linear();
+        // density = 3u^2 - 2u^3
+        [[nodiscard]] static const FalloffProfile& smoothstep();
+        // the gaussian bell exp(-(1 - u)^2 / (2 * 0.4^2)) scaled to be 0 at the edge and 1 at the center
+        [[nodiscard]] static const FalloffProfile& gaussian();
+        // density = 1 - (1 - u)^4 (the default one of Ellipse)
+        [[nodiscard]] static const FalloffProfile& quartic();
+        // density = u^(1/5) (the default one of Rectangle)
+        [[nodiscard]] static const FalloffProfile& fifthRoot();
+
+    public: // getters
+        // Returns the identifier of the profile: the profiles with the same identifier have the same densities
+        //  (the copies of a profile share its identifier, each call of fromFunction creates a new one).
+        // Unlike the addresses, the identifiers are never reused, so they can identify the profiles
+        //  outliving them (see ShapeMaskCache).
+        [[nodiscard]] std::uint64_t getId() const noexcept { return id_; }
+
+        // Returns the least u such that the density is exactly 1 for each u inside the range [u; 1]
+        //  or a value greater than 1 if the density at the center is less than 1.
+        // The pixels of a shape farther than it from the edge do not need alpha-blending (see BlockCoverage).
+        [[nodiscard]] float_type getSolidDistance() const noexcept { return solidDistance_; }
+
+        // Returns the density at the normalized distance `u`, `u` is clamped to the range [0; 1].
+        [[nodiscard]] float_type getDensityAt(float_type u) const noexcept
+        {
+            u = (std::min)(u, float_type{1});
+
+            // (also handles NaN)
+            if (!(u >= minTabulatedU))
+            {
+                const float_type fraction = (std::max)(u, float_type{0}) * (1 / minTabulatedU);
+                return densityAtZero_ + (table_[0].density - densityAtZero_) * fraction;
+            }
+
+            std::uint32_t bits;
+            std::memcpy(&bits, &u, sizeof(bits));
+
+            // the bits of u grow linearly inside an octave, so the low bits are the fraction between the entries
+            const std::uint32_t position = bits - minTabulatedUBits;
+            const std::uint32_t index = position >> fractionBits;
+            const float_type fraction = static_cast<float_type>(position & fractionMask) * (1.0f / (1U << fractionBits));
+
+            const Entry& entry = table_[index];
+            return entry.density + entry.delta * fraction;
+        }
+
+        // Replaces each of the `count` normalized distances of `values` by its density.
+        // The densities are the same as the ones of getDensityAt, but they are looked up via SIMD if it is enabled.
+        void getDensitiesAt(float_type* values, size_type count) const noexcept;
+
+    private:
+        static constexpr float_type minTabulatedU = 1.0f / static_cast<float_type>(std::uint64_t{1} << octavesCount);
+        // the bits of minTabulatedU: the biased exponent of 2^-octavesCount and the zero mantissa
+        static constexpr std::uint32_t minTabulatedUBits = std::uint32_t{127 - octavesCount} << 23;
+        // the count of the low bits of the mantissa which are not a part of the index
+        static constexpr int fractionBits = 23 - stepsPerOctaveLog2;
+        static constexpr std::uint32_t fractionMask = (1U << fractionBits) - 1;
+
+        struct Entry final
+        {
+            float_type density;
+            // the difference between the densities of the next entry and this one
+            float_type delta;
+        };
+
+    private:
+        FalloffProfile() = default;
+
+        // returns a new identifier of a profile (the identifiers start from 1)
+        [[nodiscard]] static std::uint64_t makeId() noexcept;
+
+    private:
+        std::uint64_t id_ = 0;
+        float_type densityAtZero_ = 0;
+        float_type solidDistance_ = 2;
+        // the entry i is the density at u with the bits (minTabulatedUBits + (i << fractionBits)),
+        //  the last entry is the density at 1 (u == 1 has the index tableSize)
+        std::array<Entry, tableSize + 1> table_{};
+    };
+
+
+    template<typename DensityFunction>
+    FalloffProfile FalloffProfile::fromFunction(const DensityFunction& densityOf)
+    {
+        const auto densityAt = [&densityOf](const float_type u) {
+            const auto density = static_cast<float_type>(densityOf(static_cast<double>(u)));
+            return (std::min)((std::max)(density, float_type{0}), float_type{1});
+        };
+
+        FalloffProfile result;
+        result.id_ = makeId();
+        result.densityAtZero_ = densityAt(0);
+
+        for (size_type i = 0; i <= tableSize; ++i)
+        {
+            const std::uint32_t bits = minTabulatedUBits + (static_cast<std::uint32_t>(i) << fractionBits);
+
+            float_type u;
+            std::memcpy(&u, &bits, sizeof(u));
+
+            result.table_[i] = { densityAt(u), 0 };
+        }
+
+        for (size_type i = 0; i < tableSize; ++i)
+            result.table_[i].delta = result.table_[i + 1].density - result.table_[i].density;
+
+        // the densities between the entries equal 1 only if both the entries are 1
+        for (size_type i = tableSize + 1; (i > 0) && (result.table_[i - 1].density == 1); --i)
+        {
+            const std::uint32_t bits = minTabulatedUBits + (static_cast<std::uint32_t>(i - 1) << fractionBits);
+            std::memcpy(&result.solidDistance_, &bits, sizeof(result.solidDistance_));
+        }
+
+        return result;
+    }
+} // namespace mglass
+
+#endif // ndef MAGNIFYING_GLASS_FALLOFF_PROFILE_H
@@ -0,0 +1,297 @@
+#ifndef MAGNIFYING_GLASS_FIXED_ELLIPSE_SHAPE_H
+#define MAGNIFYING_GLASS_FIXED_ELLIPSE_SHAPE_H
+
+#include "mglass/primitives.h"          // Point, IntegralRectArea, int_type, size_type, float_type
+#include "mglass/shape.h"               // Shape, ShapeRectArea, BlockCoverage
+#include "mglass/rasterized_spans.h"    // RasterizedPointContext, RasterizedSpan
+#include <algorithm>                    // std::max, std::min
+#include <array>                        // std::array
+#include <cstdint>                      // std::uint8_t
+#include <utility>                      // std::forward
+#include <vector>                       // std::vector
+
+
+namespace mglass::shapes
+{
+    namespace detail
+    {
+        // The pixels of the rows of the ellipse inscribed into the box of Width x Height pixels.
+        // The inclusion of the pixels is calculated exactly (in integers): the doubled coordinates of the centers
+        //  of the pixels relative to the center of the box are dx = (2 * column + 1 - Width) and dy = (Height - 2 * row - 1),
+        //  so the ellipse equation x^2 / (Width / 2)^2 + y^2 / (Height / 2)^2 <= 1 takes the integral form
+        //  dx^2 * Height^2 + dy^2 * Width^2 <= Width^2 * Height^2.
+        template<size_type Width, size_type Height>
+        struct FixedEllipseRows final
+        {
+            // the pixels [xBegin; xEnd) of a row (relative to the left side of the box) are inside the ellipse
+            struct Run final
+            {
+                int_type xBegin;
+                int_type xEnd;
+            };
+
+            std::array<Run, Height> rows;
+        };
+
+        // The densities of the pixels of the ellipse (see FixedEllipseRows): the ones of FalloffProfile::quartic()
+        //  at the normalized distances u of the pixels (see Ellipse) stored as 8-bit coverages.
+        template<size_type Width, size_type Height>
+        struct FixedEllipseCoverages final
+        {
+            // the coverages of the pixels [solidBegin; solidEnd) of a row are 255 (the range is empty if there are no such pixels)
+            struct SolidRun final
+            {
+                int_type solidBegin;
+                int_type solidEnd;
+            };
+
+            std::array<SolidRun, Height> rows;
+            // the coverage of the pixel (column; row) of the box is coverages[row * Width + column]
+            std::vector<std::uint8_t> coverages;
+        };
+
+        template<size_type Width, size_type Height>
+        [[nodiscard]] constexpr FixedEllipseRows<Width, Height> calculateFixedEllipseRows() noexcept
+        {
+            using wide_int = long long;
+
+            constexpr auto w2 = static_cast<wide_int>(Width) * static_cast<wide_int>(Width);
+            constexpr auto h2 = static_cast<wide_int>(Height) * static_cast<wide_int>(Height);
+
+            FixedEllipseRows<Width, Height> result{};
+
+            // a row takes O(log(Width)) steps, so the table stays far below the limits of constant evaluation
+            for (size_type row = 0; row < Height; ++row)
+            {
+                const wide_int dy = static_cast<wide_int>(Height) - 2 * static_cast<wide_int>(row) - 1;
+                const wide_int bound = w2 * (h2 - dy * dy);
+
+                // the greatest k inside the range [0; Width] such that k^2 * Height^2 <= bound
+                wide_int low = 0;
+                wide_int high = static_cast<wide_int>(Width);
+                while (low < high)
+                {
+                    const wide_int middle = (low + high + 1) / 2;
+                    if (middle * middle * h2 <= bound)
+                        low = middle;
+                    else
+                        high = middle - 1;
+                }
+
+                // dx has the parity of (Width + 1)
+                const wide_int dxMax = ((low + static_cast<wide_int>(Width) + 1) % 2 == 0) ? low : (low - 1);
+
+                result.rows[row] = (dxMax < 0)
+                    ? typename FixedEllipseRows<Width, Height>::Run{ 0, 0 }
+                    : typename FixedEllipseRows<Width, Height>::Run{
+                        static_cast<int_type>((static_cast<wide_int>(Width) - 1 - dxMax) / 2),
+                        static_cast<int_type>((static_cast<wide_int>(Width) - 1 + dxMax) / 2 + 1)
+                    };
+            }
+
+            return result;
+        }
+
+        // the rows are calculated once per size at compile time
+        template<size_type Width, size_type Height>
+        inline constexpr FixedEllipseRows<Width, Height> fixedEllipseRows = calculateFixedEllipseRows<Width, Height>();
+
+        template<size_type Width, size_type Height>
+        [[nodiscard]] FixedEllipseCoverages<Width, Height> calculateFixedEllipseCoverages()
+        {
+            const double w2 = static_cast<double>(Width) * static_cast<double>(Width);
+            const double h2 = static_cast<double>(Height) * static_cast<double>(Height);
+
+            FixedEllipseCoverages<Width, Height> result{};
+            result.coverages.resize(Width * Height);
+
+            for (size_type row = 0; row < Height; ++row)
+            {
+                const auto& run = fixedEllipseRows<Width, Height>.rows[row];
+                auto& solidRun = result.rows[row];
+                solidRun = { 0, 0 };
+
+                const double dy = static_cast<double>(Height) - 2 * static_cast<double>(row) - 1;
+
+                // the solid pixels of a row form a single run around the center
+                bool hasSolidPixels = false;
+
+                for (int_type x = run.xBegin; x < run.xEnd; ++x)
+                {
+                    const double dx = 2 * static_cast<double>(x) + 1 - static_cast<double>(Width);
+
+                    // the density 1 - (1 - u)^4 == 1 - s^4, where s == 1 - u is the left part of the equation
+                    const double s = (dx * dx * h2 + dy * dy * w2) / (w2 * h2);
+                    const double density = 1 - (s * s) * (s * s);
+                    const auto coverage = static_cast<std::uint8_t>(density * 255 + 0.5);
+
+                    result.coverages[row * Width + static_cast<size_type>(x)] = coverage;
+
+                    if (coverage == 255)
+                    {
+                        if (!hasSolidPixels)
+                            solidRun.solidBegin = x;
+                        solidRun.solidEnd = x + 1;
+                        hasSolidPixels = true;
+                    }
+                }
+            }
+
+            return result;
+        }
+
+        // the coverages are calculated once per size at the first use
+        template<size_type Width, size_type Height>
+        [[nodiscard]] const FixedEllipseCoverages<Width, Height>& getFixedEllipseCoverages()
+        {
+            static const FixedEllipseCoverages<Width, Height> coverages = calculateFixedEllipseCoverages<Width, Height>();
+            return coverages;
+        }
+    } // namespace detail
+
+
+    // The FixedEllipse class is the ellipse inscribed into the box of Width x Height pixels
+    //  whose top left pixel is placed at `topLeft`.
+    // The spans of its rows are calculated at compile time (see detail::FixedEllipseRows) and the 8-bit coverages
+    //  of its pixels are calculated once per size (see detail::FixedEllipseCoverages), so rasterizing it only
+    //  looks the precalculated runs up: there is no setup cost and the loops are bounded by the compile-time size.
+    // The pixels are the ones of Ellipse{ center, Width, Height } (up to the rounding of the float arithmetic
+    //  at the edges) for the center of the box, the densities are the ones of FalloffProfile::quartic().
+    template<size_type Width, size_type Height>
+    class FixedEllipse : public Shape<FixedEllipse<Width, Height>, mglass::detail::RasterizedPointContext>
+    {
+        static_assert( (Width > 0) && (Height > 0), "the size of FixedEllipse must not be zero" );
+
+        friend struct Shape<FixedEllipse<Width, Height>, mglass::detail::RasterizedPointContext>;
+
+    public:
+        using RasterizationSpan = mglass::detail::RasterizedSpan<std::uint8_t>;
+
+        static constexpr size_type width = Width;
+        static constexpr size_type height = Height;
+
+    public: // ctors/dtor
+        explicit constexpr FixedEllipse(const Point<int_type> topLeft = {0, 0}) noexcept
+            : topLeft_(topLeft)
+        {}
+
+        ~FixedEllipse() noexcept = default;
+
+    public: // getters
+        [[nodiscard]] constexpr Point<int_type> getTopLeft() const noexcept { return topLeft_; }
+
+        [[nodiscard]] constexpr Point<float_type> getCenter() const noexcept
+        {
+            return {
+                static_cast<float_type>(topLeft_.x) + static_cast<float_type>(Width) / 2,
+                static_cast<float_type>(topLeft_.y) + 1 - static_cast<float_type>(Height) / 2
+            };
+        }
+
+    public: // comparison
+        [[nodiscard]] constexpr bool operator==(const FixedEllipse& rhs) const noexcept { return (topLeft_ == rhs.topLeft_); }
+
+    protected:
+        Point<int_type> topLeft_;
+
+    private: // Shape<FixedEllipse> implementation
+        [[nodiscard]] ShapeRectArea getBoundsImpl() const noexcept
+        {
+            // getShapeIntegralBounds of these bounds is the box
+            return {
+                { static_cast<float_type>(topLeft_.x), static_cast<float_type>(topLeft_.y) },
+                static_cast<float_type>(Width - 1),
+                static_cast<float_type>(Height - 1)
+            };
+        }
+
+        [[nodiscard]] BlockCoverage classifyBlockImpl(const IntegralRectArea& block) const noexcept
+        {
+            if ((block.width < 1) || (block.height < 1))
+                return BlockCoverage::Outside;
+
+            const auto& coverages = detail::getFixedEllipseCoverages<Width, Height>();
+
+            // `block` relative to the top left corner of the box
+            const int_type blockXBegin = block.topLeft.x - topLeft_.x;
+            const int_type blockXEnd = blockXBegin + static_cast<int_type>(block.width);
+            const int_type blockRowBegin = topLeft_.y - block.topLeft.y;
+            const int_type blockRowEnd = blockRowBegin + static_cast<int_type>(block.height);
+
+            const int_type rowBegin = (std::max)(blockRowBegin, int_type{0});
+            const int_type rowEnd = (std::min)(blockRowEnd, static_cast<int_type>(Height));
+
+            // the rows of the block outside of the box have no pixels
+            bool isSolid = (rowBegin == blockRowBegin) && (rowEnd == blockRowEnd);
+            bool isEmpty = true;
+
+            for (int_type row = rowBegin; row < rowEnd; ++row)
+            {
+                const auto rowIndex = static_cast<size_type>(row);
+                const auto& run = detail::fixedEllipseRows<Width, Height>.rows[rowIndex];
+                const auto& solidRun = coverages.rows[rowIndex];
+
+                if ((run.xBegin < blockXEnd) && (blockXBegin < run.xEnd))
+                    isEmpty = false;
+                if ((blockXBegin < solidRun.solidBegin) || (solidRun.solidEnd < blockXEnd))
+                    isSolid = false;
+            }
+
+            if (isEmpty)
+                return BlockCoverage::Outside;
+
+            return isSolid ? BlockCoverage::Inside : BlockCoverage::Edge;
+        }
+
+        template<typename ConsumerFunctor>
+        void rasterizeOntoImpl(IntegralRectArea rect, ConsumerFunctor&& consumer) const
+        {
+            rasterizeSpansOntoImpl(rect, [&consumer](const RasterizationSpan& span) {
+                for (int_type x = span.getXBegin(); x < span.getXEnd(); ++x)
+                {
+                    (void)std::forward<ConsumerFunctor>(consumer)(
+                        mglass::detail::RasterizedPointContext{ { x, span.getY() }, span.getPixelDensityAt(x) }
+                    );
+                }
+            });
+        }
+
+        template<typename ConsumerFunctor>
+        void rasterizeSpansOntoImpl(IntegralRectArea rect, ConsumerFunctor&& consumer) const
+        {
+            if ((rect.width < 1) || (rect.height < 1))
+                return;
+
+            const auto& coverages = detail::getFixedEllipseCoverages<Width, Height>();
+
+            // `rect` relative to the top left corner of the box
+            const int_type rectXBegin = rect.topLeft.x - topLeft_.x;
+            const int_type rectXEnd = rectXBegin + static_cast<int_type>(rect.width);
+            const int_type rectRowBegin = topLeft_.y - rect.topLeft.y;
+
+            const int_type rowBegin = (std::max)(rectRowBegin, int_type{0});
+            const int_type rowEnd = (std::min)(rectRowBegin + static_cast<int_type>(rect.height), static_cast<int_type>(Height));
+
+            for (int_type row = rowBegin; row < rowEnd; ++row)
+            {
+                const auto rowIndex = static_cast<size_type>(row);
+                const auto& run = detail::fixedEllipseRows<Width, Height>.rows[rowIndex];
+
+                const int_type xBegin = (std::max)(run.xBegin, rectXBegin);
+                const int_type xEnd = (std::min)(run.xEnd, rectXEnd);
+
+                if (xBegin >= xEnd)
+                    continue;
+
+                (void)std::forward<ConsumerFunctor>(consumer)(RasterizationSpan{
+                    topLeft_.y - row,
+                    xBegin + topLeft_.x,
+                    xEnd + topLeft_.x,
+                    coverages.coverages.data() + rowIndex * Width + static_cast<size_type>(xBegin)
+                });
+            }
+        }
+    };
+} // namespace mglass::shapes
+
+#endif // ndef MAGNIFYING_GLASS_FIXED_ELLIPSE_SHAPE_H
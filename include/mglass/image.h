@@ -75,6 +75,10 @@ namespace mglass
         // Sets color of each existing pixel of this to `color`.
         void fill(ARGB color);
 
+        // Returns pointer to the first pixel of the row `y`. Pixels of a row are stored contiguously.
+        // Behaviour is undefined if y is not inside the range [0; getHeight()).
+        [[nodiscard]] ARGB* getRowData(size_type y) noexcept;
+
     public: // comparison
         bool operator==(const Image& rhs) const noexcept;
         bool operator!=(const Image& rhs) const noexcept;
@@ -86,6 +90,9 @@ namespace mglass
         // Behaviour is undefined if x is not inside the range [0; getWidth()) or y is not inside the range [0; getHeight()).
         [[nodiscard]] ARGB getPixelAt(size_type x, size_type y) const;
 
+        // Behaviour is undefined if y is not inside the range [0; getHeight()).
+        [[nodiscard]] const ARGB* getRowData(size_type y) const noexcept;
+
         void saveToPNGStream(std::ostream& stream) const;
 
         // throws std::runtime_error if it is failed to save this to the file at `filePath`
@@ -0,0 +1,285 @@
+#ifndef MAGNIFYING_GLASS_IMAGE_SPAN_H
+#define MAGNIFYING_GLASS_IMAGE_SPAN_H
+
+#include "mglass/primitives.h"  // size_type
+#include "mglass/image.h"       // ARGB, Image
+#include <algorithm>            // std::min
+#include <cstddef>              // std::ptrdiff_t
+#include <cstdint>              // std::uint8_t
+
+
+namespace mglass
+{
+    // The ImageSpan class is a non-owning read-only view of pixels of some image
+    //  (e.g. of an mglass::Image, of a part of it or of a foreign buffer).
+    // Pixels of a row are stored contiguously, the first pixels of adjacent rows are `rowStride` pixels away.
+    // The view uses the same coordinate system as mglass::Image does.
+    // Optionally the view can have a replicated border, i.e. `replicatedBorder` readable pixels around each side
+    //  of it which are copies of the nearest pixels of the view (see mglass::PreparedSource).
+    //
+    // The viewed pixels must outlive the view.
+    class ImageSpan final
+    {
+    public: // ctors/dtor
+        constexpr ImageSpan() noexcept = default;
+
+        // If `width` or `height` is 0, the view is empty.
+        // If `rowStride` < `width`, behaviour is undefined.
+        constexpr ImageSpan(const ARGB* data, size_type width, size_type height, size_type rowStride) noexcept
+            : data_(data)
+            , width_(height > 0 ? width : 0)
+            , height_(width_ > 0 ? height : 0)
+            , rowStride_(rowStride)
+        {}
+
+        // The same as the one above, but the view has the replicated border of `replicatedBorder` pixels.
+        // If the pixels around the view are not readable or are not copies of the nearest pixels of the view,
+        //  behaviour is undefined.
+        constexpr ImageSpan(
+            const ARGB* data,
+            size_type width,
+            size_type height,
+            size_type rowStride,
+            size_type replicatedBorder) noexcept
+            : ImageSpan(data, width, height, rowStride)
+        {
+            replicatedBorder_ = replicatedBorder;
+        }
+
+        // views all pixels of the `image`
+        ImageSpan(const Image& image) noexcept // NOLINT(google-explicit-constructor)
+            : ImageSpan(
+                (image.getHeight() > 0) ? image.getRowData(0) : nullptr,
+                image.getWidth(),
+                image.getHeight(),
+                image.getWidth())
+        {}
+
+    public: // getters
+        [[nodiscard]] constexpr size_type getWidth() const noexcept { return width_; }
+        [[nodiscard]] constexpr size_type getHeight() const noexcept { return height_; }
+
+        // distance (in pixels) between the first pixels of adjacent rows
+        [[nodiscard]] constexpr size_type getRowStride() const noexcept { return rowStride_; }
+
+        // the number of pixels around each side of this which replicate the nearest pixels of this
+        [[nodiscard]] constexpr size_type getReplicatedBorder() const noexcept { return replicatedBorder_; }
+
+        // Behaviour is undefined if y is not inside the range [0; getHeight()).
+        [[nodiscard]] constexpr const ARGB* getRowData(size_type y) const noexcept
+        {
+            return data_ + y * rowStride_;
+        }
+
+        // The same as getRowData, but rows of the replicated border can be accessed too.
+        // Behaviour is undefined if y is not inside the range [-getReplicatedBorder(); getHeight() + getReplicatedBorder()).
+        [[nodiscard]] constexpr const ARGB* getBorderedRowData(std::ptrdiff_t y) const noexcept
+        {
+            return data_ + y * static_cast<std::ptrdiff_t>(rowStride_);
+        }
+
+        // Behaviour is undefined if x is not inside the range [0; getWidth()) or y is not inside the range [0; getHeight()).
+        [[nodiscard]] constexpr ARGB getPixelAt(size_type x, size_type y) const noexcept
+        {
+            return getRowData(y)[x];
+        }
+
+        // Returns the view of the area of this with the top left pixel (`x`, `y`) and the size `width` x `height`.
+        // The area is clipped by the bounds of this.
+        // The returned view has no replicated border (the pixels around it are the real neighbors of the area).
+        [[nodiscard]] constexpr ImageSpan getSubSpan(size_type x, size_type y, size_type width, size_type height) const noexcept
+        {
+            if ((x >= width_) || (y >= height_))
+                return {};
+
+            return {
+                getRowData(y) + x,
+                (std::min)(width, width_ - x),
+                (std::min)(height, height_ - y),
+                rowStride_
+            };
+        }
+
+    private:
+        const ARGB* data_ = nullptr;
+        size_type width_ = 0;
+        size_type height_ = 0;
+        size_type rowStride_ = 0;
+        size_type replicatedBorder_ = 0;
+    };
+
+
+    // Memory layouts of 32-bit pixels (the order of the channels' bytes in memory)
+    enum class PixelFormat
+    {
+        ARGB,   // the same layout as mglass::ARGB has
+        BGRA,   // e.g. QImage::Format_ARGB32 on little-endian platforms or 32-bit Windows DIBs
+        RGBA    // e.g. OpenGL's GL_RGBA/GL_UNSIGNED_BYTE textures
+    };
+
+
+    namespace detail
+    {
+        // offsets of the channels' bytes inside a pixel of the Format
+        template<PixelFormat Format>
+        struct PixelLayout;
+
+        template<>
+        struct PixelLayout<PixelFormat::ARGB>
+        {
+            static constexpr size_type a = 0, r = 1, g = 2, b = 3;
+        };
+
+        template<>
+        struct PixelLayout<PixelFormat::BGRA>
+        {
+            static constexpr size_type b = 0, g = 1, r = 2, a = 3;
+        };
+
+        template<>
+        struct PixelLayout<PixelFormat::RGBA>
+        {
+            static constexpr size_type r = 0, g = 1, b = 2, a = 3;
+        };
+
+
+        template<PixelFormat Format>
+        void storePixel(std::uint8_t* const dst, const ARGB color) noexcept
+        {
+            using Layout = PixelLayout<Format>;
+
+            dst[Layout::a] = color.a;
+            dst[Layout::r] = color.r;
+            dst[Layout::g] = color.g;
+            dst[Layout::b] = color.b;
+        }
+
+        template<PixelFormat Format>
+        [[nodiscard]] ARGB loadPixel(const std::uint8_t* const src) noexcept
+        {
+            using Layout = PixelLayout<Format>;
+
+            return { src[Layout::a], src[Layout::r], src[Layout::g], src[Layout::b] };
+        }
+    } // namespace detail
+
+
+    // The MutableImageSpan class is a non-owning writable view of 32-bit pixels of some image of the specified format
+    //  (e.g. of an mglass::Image, of a framebuffer, of a QImage or of a shared memory frame).
+    // Pixels of a row are stored contiguously, the first pixels of adjacent rows are `rowStrideBytes` bytes away.
+    // The view uses the same coordinate system as mglass::Image does.
+    //
+    // The viewed pixels must outlive the view.
+    class MutableImageSpan final
+    {
+    public:
+        static constexpr size_type bytesPerPixel = 4;
+
+    public: // ctors/dtor
+        constexpr MutableImageSpan() noexcept = default;
+
+        // If `width` or `height` is 0, the view is empty.
+        // If `rowStrideBytes` < `width` * bytesPerPixel, behaviour is undefined.
+        constexpr MutableImageSpan(
+            void* data,
+            size_type width,
+            size_type height,
+            size_type rowStrideBytes,
+            PixelFormat format) noexcept
+            : data_(static_cast<std::uint8_t*>(data))
+            , width_(height > 0 ? width : 0)
+            , height_(width_ > 0 ? height : 0)
+            , rowStrideBytes_(rowStrideBytes)
+            , format_(format)
+        {}
+
+        // views all pixels of the `image`
+        MutableImageSpan(Image& image) noexcept // NOLINT(google-explicit-constructor)
+            : MutableImageSpan(
+                (image.getHeight() > 0) ? image.getRowData(0) : nullptr,
+                image.getWidth(),
+                image.getHeight(),
+                image.getWidth() * sizeof(ARGB),
+                PixelFormat::ARGB)
+        {
+            static_assert(sizeof(ARGB) == bytesPerPixel, "mglass::ARGB is expected to have no padding");
+        }
+
+    public: // modifiers
+        // Behaviour is undefined if x is not inside the range [0; getWidth()) or y is not inside the range [0; getHeight()).
+        void setPixelAt(size_type x, size_type y, ARGB color) const noexcept
+        {
+            std::uint8_t* const dst = getRowData(y) + x * bytesPerPixel;
+
+            switch (format_)
+            {
+                case PixelFormat::ARGB: return detail::storePixel<PixelFormat::ARGB>(dst, color);
+                case PixelFormat::BGRA: return detail::storePixel<PixelFormat::BGRA>(dst, color);
+                case PixelFormat::RGBA: return detail::storePixel<PixelFormat::RGBA>(dst, color);
+            }
+        }
+
+        // Sets color of each pixel of this to `color`.
+        void fill(ARGB color) const noexcept
+        {
+            for (size_type y = 0; y < height_; ++y)
+                for (size_type x = 0; x < width_; ++x)
+                    setPixelAt(x, y, color);
+        }
+
+    public: // getters
+        [[nodiscard]] constexpr size_type getWidth() const noexcept { return width_; }
+        [[nodiscard]] constexpr size_type getHeight() const noexcept { return height_; }
+
+        // distance (in bytes) between the first pixels of adjacent rows
+        [[nodiscard]] constexpr size_type getRowStrideBytes() const noexcept { return rowStrideBytes_; }
+
+        [[nodiscard]] constexpr PixelFormat getFormat() const noexcept { return format_; }
+
+        // Behaviour is undefined if y is not inside the range [0; getHeight()).
+        [[nodiscard]] constexpr std::uint8_t* getRowData(size_type y) const noexcept
+        {
+            return data_ + y * rowStrideBytes_;
+        }
+
+        // Behaviour is undefined if x is not inside the range [0; getWidth()) or y is not inside the range [0; getHeight()).
+        [[nodiscard]] ARGB getPixelAt(size_type x, size_type y) const noexcept
+        {
+            const std::uint8_t* const src = getRowData(y) + x * bytesPerPixel;
+
+            switch (format_)
+            {
+                case PixelFormat::ARGB: return detail::loadPixel<PixelFormat::ARGB>(src);
+                case PixelFormat::BGRA: return detail::loadPixel<PixelFormat::BGRA>(src);
+                case PixelFormat::RGBA: return detail::loadPixel<PixelFormat::RGBA>(src);
+            }
+
+            return {};
+        }
+
+        // Returns the view of the area of this with the top left pixel (`x`, `y`) and the size `width` x `height`.
+        // The area is clipped by the bounds of this.
+        [[nodiscard]] constexpr MutableImageSpan getSubSpan(size_type x, size_type y, size_type width, size_type height) const noexcept
+        {
+            if ((x >= width_) || (y >= height_))
+                return {};
+
+            return {
+                getRowData(y) + x * bytesPerPixel,
+                (std::min)(width, width_ - x),
+                (std::min)(height, height_ - y),
+                rowStrideBytes_,
+                format_
+            };
+        }
+
+    private:
+        std::uint8_t* data_ = nullptr;
+        size_type width_ = 0;
+        size_type height_ = 0;
+        size_type rowStrideBytes_ = 0;
+        PixelFormat format_ = PixelFormat::ARGB;
+    };
+} // namespace mglass
+
+#endif // ndef MAGNIFYING_GLASS_IMAGE_SPAN_H
@@ -0,0 +1,84 @@
+#ifndef MAGNIFYING_GLASS_INTERPOLATORS_H
+#define MAGNIFYING_GLASS_INTERPOLATORS_H
+
+#include "mglass/primitives.h"  // float_type
+#include <algorithm>            // std::max
+#include <cmath>                // std::abs, std::sin
+
+
+// Interpolators are policies which tell the magnifiers how to calculate the color of a point between pixels
+//  (see mglass::magnifiers::nearestNeighborInterpolated).
+//
+// An Interpolator describes a separable filter and has:
+//  static constexpr int tapsCount;
+//      the number of pixels taken into account along each axis (2, 4 or 6);
+//  static float_type getWeightAt(float_type distance) noexcept;
+//      the weight of a pixel which center is `distance` pixels away from the point along an axis.
+//
+// The weights are precalculated once per magnification for each column and row in fixed-point,
+//  so getWeightAt is never called per pixel and does not have to be fast.
+namespace mglass::interpolators
+{
+    // Takes the pixel containing the point, i.e. disables interpolation.
+    struct Nearest final
+    {
+    };
+
+
+    // The colors of 2x2 pixels around the point are mixed linearly.
+    // It is the same filter as the one of mglass::magnifiers::detail::InterpolationInfo.
+    struct Bilinear final
+    {
+        static constexpr int tapsCount = 2;
+
+        [[nodiscard]] static float_type getWeightAt(const float_type distance) noexcept
+        {
+            return (std::max)(1 - std::abs(distance), 0.f);
+        }
+    };
+
+
+    // Cubic convolution of 4x4 pixels around the point (Keys' kernel with a = -0.5).
+    // Gives sharper images than Bilinear.
+    struct Bicubic final
+    {
+        static constexpr int tapsCount = 4;
+
+        [[nodiscard]] static float_type getWeightAt(const float_type distance) noexcept
+        {
+            constexpr float_type a = -0.5f;
+
+            const float_type x = std::abs(distance);
+
+            if (x < 1)
+                return ((a + 2) * x - (a + 3)) * x * x + 1;
+            if (x < 2)
+                return ((a * x - 5 * a) * x + 8 * a) * x - 4 * a;
+            return 0;
+        }
+    };
+
+
+    // Windowed sinc of 6x6 pixels around the point.
+    // Gives the sharpest images, but is the slowest one.
+    struct Lanczos3 final
+    {
+        static constexpr int tapsCount = 6;
+
+        [[nodiscard]] static float_type getWeightAt(const float_type distance) noexcept
+        {
+            constexpr double radius = 3;
+            constexpr double pi = 3.14159265358979323846;
+
+            const double x = std::abs(static_cast<double>(distance));
+
+            if (x < 1e-6)
+                return 1;
+            if (x >= radius)
+                return 0;
+            return static_cast<float_type>( radius * std::sin(pi * x) * std::sin(pi * x / radius) / (pi * pi * x * x) );
+        }
+    };
+} // namespace mglass::interpolators
+
+#endif // ndef MAGNIFYING_GLASS_INTERPOLATORS_H
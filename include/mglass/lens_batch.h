@@ -0,0 +1,212 @@
+#ifndef MAGNIFYING_GLASS_LENS_BATCH_H
+#define MAGNIFYING_GLASS_LENS_BATCH_H
+
+#include "mglass/primitives.h"      // Point, IntegralRectArea, getIntersectionOf, int_type, size_type, float_type
+#include "mglass/shape.h"           // getShapeIntegralBounds
+#include "mglass/image_span.h"      // ImageSpan, MutableImageSpan, PixelFormat
+#include "mglass/executors.h"       // Executor, SequentialExecutor
+#include "mglass/interpolators.h"   // interpolators::*
+#include "mglass/magnifiers.h"      // magnifiers::detail::Magnification, magnifiers::detail::magnifyArea
+#include <vector>                   // std::vector
+#include <type_traits>              // std::decay_t
+
+
+namespace mglass
+{
+    // The interpolation of the pixels of a Lens (see mglass/interpolators.h).
+    enum class LensFilter
+    {
+        Nearest,    // like mglass::magnifiers::nearestNeighbor
+        Bilinear,   // like mglass::magnifiers::nearestNeighborInterpolated<interpolators::Bilinear>
+        Bicubic,    // like mglass::magnifiers::nearestNeighborInterpolated<interpolators::Bicubic>
+        Lanczos3    // like mglass::magnifiers::nearestNeighborInterpolated<interpolators::Lanczos3>
+    };
+
+    // A shape of the type ShapeT magnified by mglass::magnifiers::magnifyLenses.
+    // If `scaleFactor` is not inside the range (0; +inf), behavior is undefined.
+    template<typename ShapeT>
+    struct Lens final
+    {
+        ShapeT shape;
+        float_type scaleFactor = 1;
+        LensFilter filter = LensFilter::Nearest;
+        bool enableAlphaBlending = false;
+    };
+
+
+    namespace detail
+    {
+        // The LensGrid class is a spatial index of the lenses magnified over an area: the area is split into
+        //  the uniform grid of square tiles and each tile lists the lenses whose areas overlap it.
+        // The lists are stored one after another in a single array.
+        class LensGrid final
+        {
+        public:
+            static constexpr size_type tileSize = 64;
+
+        public: // ctors/dtor
+            // `lensesAreas`[i] is the area of the i-th lens (the empty areas are skipped)
+            LensGrid(const IntegralRectArea& area, const std::vector<IntegralRectArea>& lensesAreas);
+
+        public:
+            [[nodiscard]] size_type getTilesCount() const noexcept { return columnsCount_ * rowsCount_; }
+
+            // the tiles are numbered from the left to the right and then from the top to the bottom
+            //  (the tiles at the right and the bottom edges of the area can be smaller)
+            [[nodiscard]] IntegralRectArea getTileArea(size_type tileIndex) const noexcept;
+
+            // calls `func`(lensIndex) for each lens overlapping the tile in increasing order of the indices
+            template<typename Functor>
+            void forEachLensOf(const size_type tileIndex, Functor&& func) const
+            {
+                for (size_type i = tilesOffsets_[tileIndex]; i < tilesOffsets_[tileIndex + 1]; ++i)
+                    func(lenses_[i]);
+            }
+
+        private:
+            IntegralRectArea area_;
+            size_type columnsCount_;
+            size_type rowsCount_;
+            // the lenses of the tile t are lenses_[tilesOffsets_[t]; tilesOffsets_[t + 1])
+            std::vector<size_type> tilesOffsets_;
+            std::vector<size_type> lenses_;
+        };
+    } // namespace detail
+} // namespace mglass
+
+
+namespace mglass::magnifiers
+{
+    namespace detail
+    {
+        // calls `func`(Interpolator{}) with the Interpolator of the `filter`
+        template<typename Functor>
+        decltype(auto) withInterpolatorOf(const LensFilter filter, Functor&& func)
+        {
+            switch (filter)
+            {
+                case LensFilter::Bilinear:
+                    return func(interpolators::Bilinear{});
+                case LensFilter::Bicubic:
+                    return func(interpolators::Bicubic{});
+                case LensFilter::Lanczos3:
+                    return func(interpolators::Lanczos3{});
+                case LensFilter::Nearest:
+                    break;
+            }
+
+            return func(interpolators::Nearest{});
+        }
+
+        template<PixelFormat DstFormat, typename ShapeT>
+        void magnifyLenses(
+            Executor& executor,
+            const std::vector<Lens<ShapeT>>& lenses,
+            const ImageSpan& imageSrc,
+            const Point<int_type> imageTopLeft,
+            const MutableImageSpan& imageDst,
+            const Point<int_type> dstTopLeft)
+        {
+            const IntegralRectArea imageSrcBounds{imageTopLeft, imageSrc.getWidth(), imageSrc.getHeight()};
+            const IntegralRectArea imageDstBounds{dstTopLeft, imageDst.getWidth(), imageDst.getHeight()};
+
+            // only the pixels of the destination over the source can be magnified
+            const IntegralRectArea area = getIntersectionOf(imageSrcBounds, imageDstBounds);
+            if ( (area.width < 1) || (area.height < 1) )
+                return;
+
+            // the setup of each lens is done once and shared by all the tiles it overlaps
+            std::vector<Magnification> magnifications(lenses.size());
+            std::vector<IntegralRectArea> lensesAreas(lenses.size());
+
+            for (size_type i = 0; i < lenses.size(); ++i)
+            {
+                const Lens<ShapeT>& lens = lenses[i];
+
+                const IntegralRectArea shapeIntegralBounds = getShapeIntegralBounds(lens.shape);
+                const IntegralRectArea dstArea = getIntersectionOf(shapeIntegralBounds, imageDstBounds);
+
+                lensesAreas[i] = getIntersectionOf(dstArea, area);
+                if ( (lensesAreas[i].width < 1) || (lensesAreas[i].height < 1) )
+                    continue;
+
+                magnifications[i] = withInterpolatorOf(lens.filter, [&](const auto interpolator) {
+                    return Magnification::calculateFor<std::decay_t<decltype(interpolator)>>(
+                        shapeIntegralBounds, dstArea, lens.scaleFactor, imageSrc, imageSrcBounds);
+                });
+            }
+
+            const mglass::detail::LensGrid grid{area, lensesAreas};
+
+            // the tiles do not overlap, so they can be rendered concurrently
+            executor.parallelFor(grid.getTilesCount(), [&](const size_type tileIndex) {
+                const IntegralRectArea tile = grid.getTileArea(tileIndex);
+
+                grid.forEachLensOf(tileIndex, [&](const size_type lensIndex) {
+                    const Lens<ShapeT>& lens = lenses[lensIndex];
+                    const IntegralRectArea lensTile = getIntersectionOf(lensesAreas[lensIndex], tile);
+
+                    withInterpolatorOf(lens.filter, [&](const auto interpolator) {
+                        using Interpolator = std::decay_t<decltype(interpolator)>;
+
+                        const Magnification& magnification = magnifications[lensIndex];
+
+                        if (lens.enableAlphaBlending)
+                            magnifyArea(lens.shape, lensTile, magnification.getConsumer<true, Interpolator, DstFormat>(
+                                imageSrc, imageSrcBounds, imageDst, dstTopLeft));
+                        else
+                            magnifyArea(lens.shape, lensTile, magnification.getConsumer<false, Interpolator, DstFormat>(
+                                imageSrc, imageSrcBounds, imageDst, dstTopLeft));
+                    });
+                });
+            });
+        }
+    } // namespace detail
+
+
+    // Magnifies each of the `lenses` over the `imageSrc` and composes them into the pixels viewed by `imageDst`
+    //  (no memory allocations are performed for the destination):
+    //  the pixel (x; y) of the coordinate system of the shapes is written at (x - `dstTopLeft`.x; `dstTopLeft`.y - y)
+    //  of `imageDst` (e.g. `dstTopLeft` == `imageTopLeft` puts the lenses over a copy of the `imageSrc`).
+    // The lenses are drawn in order, so the pixels of a lens replace the pixels of the previous lenses under it.
+    //  The pixels which are not magnified keep their values.
+    // The result is the same as the result of magnifying the lenses one by one into `imageDst` by the corresponding
+    //  functions of mglass::magnifiers with `fillWithTransparent` == false, but the setup is done once per lens
+    //  and `imageDst` is rendered by tiles (concurrently via the `executor`): a spatial index of the lenses
+    //  (see detail::LensGrid) lets each tile visit only the lenses overlapping it.
+    // If `imageSrc` and `imageDst` view the same pixels, behavior is undefined.
+    template<typename ShapeT>
+    void magnifyLenses(
+        Executor& executor,
+        const std::vector<Lens<ShapeT>>& lenses,
+        const ImageSpan& imageSrc,
+        const Point<int_type> imageTopLeft,
+        const MutableImageSpan& imageDst,
+        const Point<int_type> dstTopLeft)
+    {
+        switch (imageDst.getFormat())
+        {
+            case PixelFormat::ARGB:
+                return detail::magnifyLenses<PixelFormat::ARGB>(executor, lenses, imageSrc, imageTopLeft, imageDst, dstTopLeft);
+            case PixelFormat::BGRA:
+                return detail::magnifyLenses<PixelFormat::BGRA>(executor, lenses, imageSrc, imageTopLeft, imageDst, dstTopLeft);
+            case PixelFormat::RGBA:
+                return detail::magnifyLenses<PixelFormat::RGBA>(executor, lenses, imageSrc, imageTopLeft, imageDst, dstTopLeft);
+        }
+    }
+
+    // The same as above but runs at the calling thread only.
+    template<typename ShapeT>
+    void magnifyLenses(
+        const std::vector<Lens<ShapeT>>& lenses,
+        const ImageSpan& imageSrc,
+        const Point<int_type> imageTopLeft,
+        const MutableImageSpan& imageDst,
+        const Point<int_type> dstTopLeft)
+    {
+        SequentialExecutor executor;
+        magnifyLenses(executor, lenses, imageSrc, imageTopLeft, imageDst, dstTopLeft);
+    }
+} // namespace mglass::magnifiers
+
+#endif // ndef MAGNIFYING_GLASS_LENS_BATCH_H
@@ -0,0 +1,195 @@
+#ifndef MAGNIFYING_GLASS_MAGNIFIER_PLAN_H
+#define MAGNIFYING_GLASS_MAGNIFIER_PLAN_H
+
+#include "mglass/primitives.h"          // Point, IntegralRectArea, int_type, float_type
+#include "mglass/shape.h"               // Shape
+#include "mglass/rasterized_spans.h"    // detail::RasterizedSpans, detail::MovedRasterizedSpans
+#include "mglass/image.h"               // Image
+#include "mglass/image_span.h"          // ImageSpan, MutableImageSpan
+#include "mglass/executors.h"           // Executor, SequentialExecutor
+#include "mglass/interpolators.h"       // interpolators::*
+#include "mglass/magnifiers.h"          // magnifiers::*
+
+
+namespace mglass
+{
+    // The MagnifierPlan class is a shape rasterized once for magnifying it at many positions
+    //  (e.g. while a lens follows the cursor only the position of the shape changes between frames).
+    //
+    // The plan keeps the spans of the shape and the densities of their pixels (if alpha-blending is enabled),
+    //  so the magnifiers of the plan do not rasterize the shape again, they just move the spans by an integral offset.
+    // The result of magnifying the plan at `shapeOffset` is the same as the result of the corresponding function
+    //  of mglass::magnifiers for the shape moved by `shapeOffset` (for built-in shapes with integral or half-integral
+    //  centers; otherwise moving the shape can round its rasterization differently).
+    class MagnifierPlan final
+    {
+    public: // ctors/dtor
+        // the plan of an empty shape
+        MagnifierPlan() = default;
+
+        // Rasterizes the `shape`.
+        // If `scaleFactor` is not inside the range (0; +inf), behavior of the magnifiers is undefined.
+        template<typename ShapeImpl, typename RastrCtx>
+        MagnifierPlan(const Shape<ShapeImpl, RastrCtx>& shape, float_type scaleFactor, bool enableAlphaBlending = false);
+
+    public: // getters
+        [[nodiscard]] float_type getScaleFactor() const noexcept { return scaleFactor_; }
+        [[nodiscard]] bool isAlphaBlendingEnabled() const noexcept { return alphaBlendingIsEnabled_; }
+
+        // returns getShapeIntegralBounds of the shape moved by `shapeOffset`
+        [[nodiscard]] IntegralRectArea getIntegralBounds(Point<int_type> shapeOffset = {0, 0}) const noexcept
+        {
+            return spans_.getIntegralBounds(shapeOffset);
+        }
+
+    public: // magnifiers
+        // Magnifies the shape moved by `shapeOffset` like mglass::magnifiers::nearestNeighbor does.
+        void nearestNeighbor(
+            Executor& executor,
+            Point<int_type> shapeOffset,
+            const ImageSpan& imageSrc,
+            Point<int_type> imageTopLeft,
+            Image& imageDst) const;
+
+        // The same as above but runs at the calling thread only.
+        void nearestNeighbor(
+            Point<int_type> shapeOffset,
+            const ImageSpan& imageSrc,
+            Point<int_type> imageTopLeft,
+            Image& imageDst) const;
+
+        // Magnifies the shape moved by `shapeOffset` into the pixels viewed by `imageDst`
+        //  like mglass::magnifiers::nearestNeighbor does.
+        void nearestNeighbor(
+            Executor& executor,
+            Point<int_type> shapeOffset,
+            const ImageSpan& imageSrc,
+            Point<int_type> imageTopLeft,
+            const MutableImageSpan& imageDst,
+            Point<int_type> dstOffset,
+            bool fillWithTransparent = true) const;
+
+        // The same as above but runs at the calling thread only.
+        void nearestNeighbor(
+            Point<int_type> shapeOffset,
+            const ImageSpan& imageSrc,
+            Point<int_type> imageTopLeft,
+            const MutableImageSpan& imageDst,
+            Point<int_type> dstOffset,
+            bool fillWithTransparent = true) const;
+
+        // Magnifies the shape moved by `shapeOffset` like mglass::magnifiers::nearestNeighborInterpolated does.
+        template<typename Interpolator = interpolators::Bilinear>
+        void nearestNeighborInterpolated(
+            Executor& executor,
+            Point<int_type> shapeOffset,
+            const ImageSpan& imageSrc,
+            Point<int_type> imageTopLeft,
+            Image& imageDst) const;
+
+        // The same as above but runs at the calling thread only.
+        template<typename Interpolator = interpolators::Bilinear>
+        void nearestNeighborInterpolated(
+            Point<int_type> shapeOffset,
+            const ImageSpan& imageSrc,
+            Point<int_type> imageTopLeft,
+            Image& imageDst) const;
+
+        // Magnifies the shape moved by `shapeOffset` into the pixels viewed by `imageDst`
+        //  like mglass::magnifiers::nearestNeighborInterpolated does.
+        template<typename Interpolator = interpolators::Bilinear>
+        void nearestNeighborInterpolated(
+            Executor& executor,
+            Point<int_type> shapeOffset,
+            const ImageSpan& imageSrc,
+            Point<int_type> imageTopLeft,
+            const MutableImageSpan& imageDst,
+            Point<int_type> dstOffset,
+            bool fillWithTransparent = true) const;
+
+        // The same as above but runs at the calling thread only.
+        template<typename Interpolator = interpolators::Bilinear>
+        void nearestNeighborInterpolated(
+            Point<int_type> shapeOffset,
+            const ImageSpan& imageSrc,
+            Point<int_type> imageTopLeft,
+            const MutableImageSpan& imageDst,
+            Point<int_type> dstOffset,
+            bool fillWithTransparent = true) const;
+
+    private:
+        detail::RasterizedSpans<float_type> spans_;
+        float_type scaleFactor_ = 1;
+        bool alphaBlendingIsEnabled_ = false;
+    };
+
+
+    // ================================================================================================================
+    //  MagnifierPlan
+    // ================================================================================================================
+
+    template<typename ShapeImpl, typename RastrCtx>
+    MagnifierPlan::MagnifierPlan(
+        const Shape<ShapeImpl, RastrCtx>& shape,
+        const float_type scaleFactor,
+        const bool enableAlphaBlending)
+        : spans_(shape, enableAlphaBlending, [](const float_type density) { return density; })
+        , scaleFactor_(scaleFactor)
+        , alphaBlendingIsEnabled_(enableAlphaBlending)
+    {}
+
+    template<typename Interpolator>
+    void MagnifierPlan::nearestNeighborInterpolated(
+        Executor& executor,
+        const Point<int_type> shapeOffset,
+        const ImageSpan& imageSrc,
+        const Point<int_type> imageTopLeft,
+        Image& imageDst) const
+    {
+        magnifiers::nearestNeighborInterpolated<Interpolator>(
+            executor, detail::MovedRasterizedSpans<float_type>{spans_, shapeOffset}, scaleFactor_,
+            imageSrc, imageTopLeft, imageDst, alphaBlendingIsEnabled_);
+    }
+
+    template<typename Interpolator>
+    void MagnifierPlan::nearestNeighborInterpolated(
+        const Point<int_type> shapeOffset,
+        const ImageSpan& imageSrc,
+        const Point<int_type> imageTopLeft,
+        Image& imageDst) const
+    {
+        SequentialExecutor executor;
+        nearestNeighborInterpolated<Interpolator>(executor, shapeOffset, imageSrc, imageTopLeft, imageDst);
+    }
+
+    template<typename Interpolator>
+    void MagnifierPlan::nearestNeighborInterpolated(
+        Executor& executor,
+        const Point<int_type> shapeOffset,
+        const ImageSpan& imageSrc,
+        const Point<int_type> imageTopLeft,
+        const MutableImageSpan& imageDst,
+        const Point<int_type> dstOffset,
+        const bool fillWithTransparent) const
+    {
+        magnifiers::nearestNeighborInterpolated<Interpolator>(
+            executor, detail::MovedRasterizedSpans<float_type>{spans_, shapeOffset}, scaleFactor_,
+            imageSrc, imageTopLeft, imageDst, dstOffset, alphaBlendingIsEnabled_, fillWithTransparent);
+    }
+
+    template<typename Interpolator>
+    void MagnifierPlan::nearestNeighborInterpolated(
+        const Point<int_type> shapeOffset,
+        const ImageSpan& imageSrc,
+        const Point<int_type> imageTopLeft,
+        const MutableImageSpan& imageDst,
+        const Point<int_type> dstOffset,
+        const bool fillWithTransparent) const
+    {
+        SequentialExecutor executor;
+        nearestNeighborInterpolated<Interpolator>(
+            executor, shapeOffset, imageSrc, imageTopLeft, imageDst, dstOffset, fillWithTransparent);
+    }
+} // namespace mglass
+
+#endif // ndef MAGNIFYING_GLASS_MAGNIFIER_PLAN_H
@@ -4,7 +4,17 @@
 #include "mglass/primitives.h"
 #include "mglass/shape.h"
 #include "mglass/image.h"
-#include <cmath>                // std::floor
+#include "mglass/image_span.h"
+#include "mglass/executors.h"
+#include "mglass/interpolators.h"
+#include <algorithm>            // std::min, std::max
+#include <cmath>                // std::floor, std::lround, std::llround
+#include <cstdint>              // std::uint8_t, std::int16_t, std::int32_t
+#include <cstring>              // std::memcpy
+#include <array>                // std::array
+#include <vector>               // std::vector
+#include <type_traits>          // std::is_same_v, std::void_t
+#include <utility>              // std::declval
 #include <cassert>              // assert
 
 
@@ -24,9 +34,18 @@ namespace mglass::magnifiers
             Point<float_type> start,
             Point<float_type> end) noexcept;
 
+        // one-dimensional version of scaleVectorBy
+        [[nodiscard]] inline float_type scaleCoordinateBy(
+            const float_type scaleFactor,
+            const float_type start,
+            const float_type end) noexcept
+        {
+            return start + (end - start) * scaleFactor;
+        }
 
-        // This class encapsulates data and methods required for implementing the anti-aliasing effect
-        // TODO: abstract algorithms of interpolation (smth like 'interface Interpolator').
+
+        // This class encapsulates data and methods required for implementing the anti-aliasing effect.
+        // It is the floating point reference of interpolators::Bilinear, the magnifiers use AxisInterpolationTable.
         struct InterpolationInfo final
         {
             // how much parts of the neighbors pixels should be taken into account (range [0; 1])
@@ -48,122 +67,764 @@ namespace mglass::magnifiers
                 Point<float_type> pixelBottomLeft) noexcept;
 
             // applies `neighborsParts` to the pixel at `imageSrc`[`pixelPos`]
-            [[nodiscard]] ARGB applyTo(Point<size_type> pixelPos, const Image& imageSrc) const;
+            [[nodiscard]] ARGB applyTo(Point<size_type> pixelPos, const ImageSpan& imageSrc) const;
+        };
+
+
+        // The magnifiers interpolate in fixed-point arithmetic.
+        // Positions of the mapped points inside pixels are quantized to 1/interpolationPhasesCount of a pixel
+        //  and the weights of the pixels along each axis have interpolationWeightBits fractional bits,
+        //  so they fit signed 16-bit operands of multiply-adds (pmaddwd).
+        constexpr int interpolationWeightBits = 14;
+        constexpr std::int32_t interpolationPhasesCount = 256;
+
+        // weights of the taps (see AxisInterpolationTable) of the Interpolator for each phase of a point,
+        //  the weights of each phase sum to exactly (1 << interpolationWeightBits)
+        template<typename Interpolator>
+        using InterpolationWeights = std::array<std::array<std::int16_t, Interpolator::tapsCount>, interpolationPhasesCount>;
+
+        // Returns the weights of the Interpolator (they are calculated once per program run).
+        template<typename Interpolator>
+        [[nodiscard]] const InterpolationWeights<Interpolator>& getInterpolationWeights()
+        {
+            static_assert( (Interpolator::tapsCount == 2) || (Interpolator::tapsCount == 4) || (Interpolator::tapsCount == 6),
+                           "Interpolator::tapsCount must be 2, 4 or 6" );
+
+            static const InterpolationWeights<Interpolator> weights = [] {
+                constexpr int tapsCount = Interpolator::tapsCount;
+                constexpr std::int32_t one = std::int32_t{1} << interpolationWeightBits;
+
+                InterpolationWeights<Interpolator> result{};
+
+                for (size_type phase = 0; phase < result.size(); ++phase)
+                {
+                    // the tap (tapsCount / 2 - 1) is the pixel containing (point - 0.5), so its center is `phase` before the point
+                    double realWeights[tapsCount];
+                    double realWeightsSum = 0;
+
+                    for (int tap = 0; tap < tapsCount; ++tap)
+                    {
+                        const double distance = (tap - (tapsCount / 2 - 1)) - static_cast<double>(phase) / interpolationPhasesCount;
+
+                        realWeights[tap] = Interpolator::getWeightAt(static_cast<float_type>(distance));
+                        realWeightsSum += realWeights[tap];
+                    }
+
+                    // the weights are normalized and the rounding error is given to the largest one
+                    std::int32_t weightsSum = 0;
+                    int largestTap = 0;
+
+                    for (int tap = 0; tap < tapsCount; ++tap)
+                    {
+                        const auto weight = static_cast<std::int32_t>(std::lround(realWeights[tap] / realWeightsSum * one));
+
+                        result[phase][static_cast<size_type>(tap)] = static_cast<std::int16_t>(weight);
+                        weightsSum += weight;
+
+                        if (realWeights[tap] > realWeights[largestTap])
+                            largestTap = tap;
+                    }
+
+                    result[phase][static_cast<size_type>(largestTap)] =
+                        static_cast<std::int16_t>(result[phase][static_cast<size_type>(largestTap)] + one - weightsSum);
+                }
+
+                return result;
+            }();
+
+            return weights;
+        }
+
+        // Weights and pixels taken into account by the interpolation of the points onto which a range of coordinates
+        //  is mapped along one axis.
+        // An Interpolator takes into account tapsCount pixels along each axis (the taps of a point):
+        //  (tapsCount / 2) pixels up to the one containing (point - 0.5) and (tapsCount / 2) pixels after it.
+        // The weights of the taps along x and y depend only on the column and the row for the fixed scale factor
+        //  and center, so they are calculated once per column and once per row instead of once per pixel.
+        struct AxisInterpolationTable final
+        {
+            int_type begin;     // the coordinate described by the first elements of the arrays below
+            size_type length;   // the number of the described coordinates
+            int tapsCount;
+
+            // The weights of the taps (2j) and (2j + 1) of the coordinate c are
+            //  [2 * (j * length + c - begin)] and [2 * (j * length + c - begin) + 1],
+            //  so a pair of them is a 32-bit operand of a multiply-add.
+            std::vector<std::int16_t> weights;
+            // [i * length + c - begin] is the index inside the image of the tap i of the coordinate c
+            //  clamped by the bounds of the image and its replicated border (so it can be negative)
+            std::vector<std::int32_t> pixels;
+
+
+            // returns the weights of the pair `pairIndex` of the taps of the coordinate `begin`
+            [[nodiscard]] const std::int16_t* getWeightsOfPair(const int pairIndex) const noexcept
+            {
+                return weights.data() + static_cast<size_type>(pairIndex) * length * 2;
+            }
+
+            // returns the pixels of the tap `tapIndex` of the coordinate `begin`
+            [[nodiscard]] const std::int32_t* getPixelsOfTap(const int tapIndex) const noexcept
+            {
+                return pixels.data() + static_cast<size_type>(tapIndex) * length;
+            }
+
+
+            // Calculates the table of the Interpolator for each coordinate c inside the range [`begin`; `end`)
+            //  mapped onto scaleCoordinateBy(`scaleFactor`, `scaleCenter`, c).
+            // `imageStart` is the coordinate of the pixel 0 of the image which is `imageLength` pixels long along the axis,
+            //  if `isReversed` == true, pixels of the image go in decreasing order of the coordinates (like rows along y).
+            // Taps outside of the image are clamped by its bounds extended by `imageBorder` replicated pixels.
+            template<typename Interpolator>
+            [[nodiscard]] static AxisInterpolationTable calculateFor(
+                const float_type scaleFactor,
+                const float_type scaleCenter,
+                const int_type imageStart,
+                const size_type imageLength,
+                const size_type imageBorder,
+                const bool isReversed,
+                const int_type begin,
+                const int_type end)
+            {
+                constexpr int tapsCount = Interpolator::tapsCount;
+
+                const InterpolationWeights<Interpolator>& tapsWeights = getInterpolationWeights<Interpolator>();
+
+                AxisInterpolationTable result;
+                result.begin = begin;
+                result.length = static_cast<size_type>((std::max)(end - begin, int_type{0}));
+                result.tapsCount = tapsCount;
+                result.weights.resize(result.length * tapsCount);
+                result.pixels.resize(result.length * tapsCount);
+
+                // the border is not smaller than the taps around a point inside the image, so usually nothing is clamped
+                const auto firstPixel = -static_cast<long long>(imageBorder);
+                const auto lastPixel = static_cast<long long>(imageLength + imageBorder) - 1;
+
+                for (size_type i = 0; i < result.length; ++i)
+                {
+                    const auto coordinate = static_cast<float_type>(begin + static_cast<int_type>(i));
+                    const float_type point = scaleCoordinateBy(scaleFactor, scaleCenter, coordinate);
+
+                    // (point - 0.5) in fixed-point, the multiplication is exact in double
+                    const long long fixedPoint = std::llround(static_cast<double>(point) * interpolationPhasesCount)
+                                               - interpolationPhasesCount / 2;
+
+                    // floor division
+                    const long long pixel = (fixedPoint >= 0)
+                        ? (fixedPoint / interpolationPhasesCount)
+                        : -((-fixedPoint + interpolationPhasesCount - 1) / interpolationPhasesCount);
+                    const auto phase = static_cast<size_type>(fixedPoint - pixel * interpolationPhasesCount);
+
+                    for (int tap = 0; tap < tapsCount; ++tap)
+                    {
+                        const long long tapPixel = pixel + tap - (tapsCount / 2 - 1);
+                        const long long index = isReversed ? (imageStart - tapPixel) : (tapPixel - imageStart);
+
+                        const auto tapIndex = static_cast<size_type>(tap);
+                        result.pixels[tapIndex * result.length + i] =
+                            static_cast<std::int32_t>( (std::min)((std::max)(index, firstPixel), lastPixel) );
+                        result.weights[(tapIndex / 2 * result.length + i) * 2 + tapIndex % 2] = tapsWeights[phase][tapIndex];
+                    }
+                }
+
+                return result;
+            }
+        };
+
+        // The range [begin; end) of the coordinates of a shape which are mapped inside an image along an axis.
+        struct MappedRange final
+        {
+            int_type begin;
+            int_type end;
+
+
+            // Calculates the range of the coordinates c inside the range [`rangeBegin`; `rangeEnd`) for which
+            //  the pixel containing scaleCoordinateBy(`scaleFactor`, `scaleCenter`, c) is inside the image.
+            // `imageStart`, `imageLength` and `isReversed` are the same as the ones of AxisInterpolationTable::calculateFor.
+            [[nodiscard]] static MappedRange calculateFor(
+                const float_type scaleFactor,
+                const float_type scaleCenter,
+                const int_type imageStart,
+                const size_type imageLength,
+                const bool isReversed,
+                const int_type rangeBegin,
+                const int_type rangeEnd) noexcept
+            {
+                const auto isMappedInside = [&](const int_type coordinate) noexcept {
+                    const float_type point = scaleCoordinateBy(scaleFactor, scaleCenter, static_cast<float_type>(coordinate));
+                    const auto pixel = static_cast<int_type>(std::floor(point));
+                    const int_type index = isReversed ? (imageStart - pixel) : (pixel - imageStart);
+
+                    return ( (index >= 0) && (static_cast<size_type>(index) < imageLength) );
+                };
+
+                // pixels do not decrease while the coordinate grows,
+                //  so the coordinates mapped outside of the image can be only at the ends of the range
+                MappedRange result{rangeBegin, rangeEnd};
+                while ((result.begin < result.end) && !isMappedInside(result.begin))
+                    ++result.begin;
+                while ((result.begin < result.end) && !isMappedInside(result.end - 1))
+                    --result.end;
+
+                return result;
+            }
         };
 
+        // The columns of the pixels of a shape whose densities are 1 at each block row of an area
+        //  (see Shape::classifyBlock), alpha-blending does not change such pixels.
+        struct SolidColumns final
+        {
+            static constexpr size_type blockSize = 16;
 
-        // This functor receives coordinates of the point rasterized by a shape
-        //  and transforms its coordinates to coordinates on the `imageSrc`.
-        // Optionally performs alpha-blending and anti-aliasing according to template flags.
-        template<bool EnableAlphaBlending, bool EnableInterpolation>
+            // y of the top row of the first block row
+            int_type top;
+            // the columns of each block row (the ranges are empty if there are no such columns)
+            std::vector<MappedRange> blockRows;
+
+
+            // Classifies the blocks of the `area` and finds the columns covered by the Inside blocks at each block row.
+            // Only the first run of the Inside blocks of a block row is taken (it is the only one for convex shapes).
+            template<typename ShapeImpl, typename RastrCtx>
+            [[nodiscard]] static SolidColumns calculateFor(const Shape<ShapeImpl, RastrCtx>& shape, const IntegralRectArea& area)
+            {
+                SolidColumns result{ area.topLeft.y, {} };
+                result.blockRows.reserve((area.height + blockSize - 1) / blockSize);
+
+                const int_type areaEnd = area.topLeft.x + static_cast<int_type>(area.width);
+
+                for (size_type rowBegin = 0; rowBegin < area.height; rowBegin += blockSize)
+                {
+                    const size_type blockHeight = (std::min)(blockSize, area.height - rowBegin);
+                    const int_type blockTop = area.topLeft.y - static_cast<int_type>(rowBegin);
+
+                    MappedRange columns{ areaEnd, areaEnd };
+
+                    for (int_type blockLeft = area.topLeft.x; blockLeft < areaEnd; blockLeft += static_cast<int_type>(blockSize))
+                    {
+                        const int_type blockRight = (std::min)(blockLeft + static_cast<int_type>(blockSize), areaEnd);
+                        const IntegralRectArea block{
+                            { blockLeft, blockTop },
+                            static_cast<size_type>(blockRight - blockLeft),
+                            blockHeight
+                        };
+
+                        if (shape.classifyBlock(block) == BlockCoverage::Inside)
+                        {
+                            if (columns.begin == areaEnd)
+                                columns.begin = blockLeft;
+                            columns.end = blockRight;
+                        }
+                        else if (columns.begin != areaEnd)
+                        {
+                            break;
+                        }
+                    }
+
+                    result.blockRows.push_back(columns);
+                }
+
+                return result;
+            }
+
+            // returns the columns of the block row which contains the row `y`
+            [[nodiscard]] MappedRange getAt(const int_type y) const noexcept
+            {
+                return blockRows[static_cast<size_type>(top - y) / blockSize];
+            }
+        };
+
+        // AxisInterpolationTable of the columns and the rows of a magnified area
+        struct InterpolationTables final
+        {
+            AxisInterpolationTable columns;
+            AxisInterpolationTable rows;
+        };
+
+        // For each x inside the range [`xBegin`; `xEnd`) interpolates TapsCount x TapsCount pixels of the `imageSrc`
+        //  around the point onto which the pixel (x; `y`) is mapped according to the `tables`
+        //  and writes the color to `result`[x - `xBegin`].
+        // All the channels (including alpha) are interpolated.
+        // All the points must be mapped inside the `imageSrc`.
+        //
+        // Processes 8 (if AVX2 is enabled at compile time) or 4 (if SSE4.1 is enabled) pixels at once.
+        // Only integer arithmetic is used, so results do not depend on the instruction set or the compiler.
+        // Defined for TapsCount = 2, 4 and 6.
+        template<int TapsCount>
+        void interpolateRow(
+            const ImageSpan& imageSrc,
+            const InterpolationTables& tables,
+            int_type y,
+            int_type xBegin,
+            int_type xEnd,
+            ARGB* result) noexcept;
+
+
+        // Describes how the pixels of a row of a shape are mapped onto a row of the `imageSrc`.
+        struct RowMapping final
+        {
+            const ImageSpan& imageSrc;
+            int_type imageSrcLeft;          // x coordinate of the first column of the `imageSrc`
+            size_type srcRow;               // the row of the `imageSrc` which contains the mapped points
+            float_type scaleFactor;         // x of a mapped point is scaleCoordinateBy(scaleFactor, scaleCenterX, x)
+            float_type scaleCenterX;
+        };
+
+        // For each x inside the range [`xBegin`; `xEnd`) copies the pixel of the `mapping`.imageSrc
+        //  onto which x is mapped (i.e. performs nearest neighbor magnification of a row)
+        //  and writes it in the DstFormat to the pixel (x - `xBegin`) of `dst`.
+        // All the points must be mapped inside the `mapping`.imageSrc.
+        //
+        // Processes 8 (if AVX2 is enabled at compile time) or 4 (if SSE4.1 is enabled) pixels at once.
+        // Defined for all the PixelFormat values.
+        template<PixelFormat DstFormat>
+        void copyNearestRow(const RowMapping& mapping, int_type xBegin, int_type xEnd, std::uint8_t* dst) noexcept;
+
+
+        // true if the spans of the type provide the 8-bit coverages of their pixels (see mglass::ShapeMask),
+        //  then alpha-blending uses the coverages instead of the densities
+        template<typename Span, typename = void>
+        constexpr bool spanHasPixelCoverages = false;
+
+        template<typename Span>
+        constexpr bool spanHasPixelCoverages<Span, std::void_t<decltype(std::declval<const Span&>().getPixelCoverages())>> = true;
+
+
+        // This functor receives spans of the points rasterized by a shape
+        //  and transforms their coordinates to coordinates on the `imageSrc`.
+        // Optionally performs alpha-blending according to the template flag
+        //  and interpolation according to the Interpolator (see mglass/interpolators.h).
+        // Pixels are written into `imageDst` in the DstFormat, the pixel (dstTopLeft.x; dstTopLeft.y)
+        //  of the shape is written at (0; 0) of `imageDst`.
+        template<bool EnableAlphaBlending, typename Interpolator, PixelFormat DstFormat>
         struct RasterizationConsumer
         {
+            static constexpr bool alphaBlendingEnabled = EnableAlphaBlending;
+            static constexpr bool interpolationEnabled = !std::is_same_v<Interpolator, interpolators::Nearest>;
+
+
             const float_type scaleFactor;
-            const Image& imageSrc;
+            const ImageSpan imageSrc;
             const IntegralRectArea imageSrcBounds;
-            Image& imageDst;
+            const MutableImageSpan imageDst;
             const Point<float_type> scaleCenter;
-            const IntegralRectArea shapeIntegralBounds;
+            const Point<int_type> dstTopLeft;
+            // the columns and the rows of the shape mapped inside the `imageSrc`
+            const MappedRange mappedColumns;
+            const MappedRange mappedRows;
+            // used only if interpolation is enabled
+            const InterpolationTables* const interpolationTables;
+            // used only if alpha-blending is enabled, all the pixels are blended if there are no solid columns
+            const SolidColumns* solidColumns = nullptr;
+
+
+            // The span written last (used only if both alpha-blending and interpolation are disabled).
+            // The functor is expected to be copied for each sequence of spans rasterized by one call.
+            struct WrittenSpan
+            {
+                size_type srcRow;
+                int_type xBegin;
+                int_type xEnd;
+                const std::uint8_t* dstRowData; // nullptr if there is no such span
+            } lastWrittenSpan = { 0, 0, 0, nullptr };
 
 
             template<typename Impl>
-            void operator()(const RasterizationContextBase<Impl>& rastrCtx) const
+            void operator()(const RasterizationSpanBase<Impl>& span)
             {
-                const auto rasterizePoint = rastrCtx.getRasterizedPoint();
+                const int_type y = span.getY();
 
-                const Point<float_type> srcPointFloat = detail::scaleVectorBy(
-                    scaleFactor,
-                    scaleCenter,
-                    pointCast<float_type>(rasterizePoint)
-                );
+                // the points mapped outside of the `imageSrc` are cut off by the precalculated ranges
+                const int_type xBegin = (std::max)(span.getXBegin(), mappedColumns.begin);
+                const int_type xEnd = (std::min)(span.getXEnd(), mappedColumns.end);
 
-                const Point<float_type> pixelStartFloat{ std::floor(srcPointFloat.x), std::floor(srcPointFloat.y) };
+                if ( (y < mappedRows.begin) || (y >= mappedRows.end) || (xBegin >= xEnd) )
+                    return;
 
-                auto pixelStartSigned = pointCast<int_type>(pixelStartFloat);
-                pixelStartSigned.x -= imageSrcBounds.topLeft.x;
-                pixelStartSigned.y = imageSrcBounds.topLeft.y - pixelStartSigned.y;
+                const float_type srcPointY = scaleCoordinateBy(scaleFactor, scaleCenter.y, static_cast<float_type>(y));
+                const int_type srcRowSigned = imageSrcBounds.topLeft.y - static_cast<int_type>(std::floor(srcPointY));
 
-                if ((pixelStartSigned.x < 0) || (pixelStartSigned.y < 0))
-                    return;
+                assert( (srcRowSigned >= 0) && (static_cast<size_type>(srcRowSigned) < imageSrc.getHeight()) );
 
-                const auto pixelStart = pointCast<size_type>(pixelStartSigned);
+                assert( (xBegin >= dstTopLeft.x) );
+                assert( (y <= dstTopLeft.y) );
 
-                if ((pixelStart.x >= imageSrc.getWidth()) || (pixelStart.y >= imageSrc.getHeight()))
-                    return;
+                const auto srcRow = static_cast<size_type>(srcRowSigned);
+                const auto dstRow = static_cast<size_type>(dstTopLeft.y - y);
 
-                const auto srcPixel = obtainSrcPixel(pixelStart, pixelStartFloat, srcPointFloat, rastrCtx);
+                assert( (static_cast<size_type>(xEnd - dstTopLeft.x) <= imageDst.getWidth()) );
+                assert( (dstRow < imageDst.getHeight()) );
 
-                assert( (rasterizePoint.x >= shapeIntegralBounds.topLeft.x) );
-                assert( (rasterizePoint.y <= shapeIntegralBounds.topLeft.y) );
+                std::uint8_t* const dstRowData = imageDst.getRowData(dstRow);
 
-                const auto dstX = static_cast<size_type>(rasterizePoint.x - shapeIntegralBounds.topLeft.x);
-                const auto dstY = static_cast<size_type>(shapeIntegralBounds.topLeft.y - rasterizePoint.y);
+                const RowMapping mapping{
+                    imageSrc,
+                    imageSrcBounds.topLeft.x,
+                    srcRow,
+                    scaleFactor,
+                    scaleCenter.x
+                };
 
-                assert( (dstX < imageDst.getWidth()) );
-                assert( (dstY < imageDst.getHeight()) );
+                if constexpr (!interpolationEnabled && !EnableAlphaBlending)
+                {
+                    // pixels are copied as-is, so they are written right into the destination
+                    const auto copyColumns = [&](const int_type begin, const int_type end) {
+                        if (begin < end)
+                            copyNearestRow<DstFormat>(mapping, begin, end, dstRowData + getDstOffsetOf(begin));
+                    };
+
+                    // the pixels of the rows mapped onto the same row of the `imageSrc` are the same,
+                    //  so the ones written for the previous span are duplicated
+                    const int_type duplicatedBegin = (std::max)(xBegin, lastWrittenSpan.xBegin);
+                    const int_type duplicatedEnd = (std::min)(xEnd, lastWrittenSpan.xEnd);
+
+                    if ( (lastWrittenSpan.dstRowData != nullptr) &&
+                         (lastWrittenSpan.srcRow == srcRow) &&
+                         (duplicatedBegin < duplicatedEnd) )
+                    {
+                        copyColumns(xBegin, duplicatedBegin);
+
+                        std::memcpy(
+                            dstRowData + getDstOffsetOf(duplicatedBegin),
+                            lastWrittenSpan.dstRowData + getDstOffsetOf(duplicatedBegin),
+                            static_cast<size_type>(duplicatedEnd - duplicatedBegin) * MutableImageSpan::bytesPerPixel
+                        );
+
+                        copyColumns(duplicatedEnd, xEnd);
+                    }
+                    else
+                    {
+                        copyColumns(xBegin, xEnd);
+                    }
+
+                    lastWrittenSpan = { srcRow, xBegin, xEnd, dstRowData };
+                }
+                else if constexpr (EnableAlphaBlending)
+                {
+                    // the pixels of the solid columns are not changed by alpha-blending, so they are just written
+                    int_type solidBegin = xEnd;
+                    int_type solidEnd = xEnd;
+
+                    if (solidColumns != nullptr)
+                    {
+                        const MappedRange solid = solidColumns->getAt(y);
+
+                        solidBegin = (std::min)( (std::max)(solid.begin, xBegin), xEnd );
+                        solidEnd = (std::max)( (std::min)(solid.end, xEnd), solidBegin );
+                    }
 
-                imageDst.setPixelAt(dstX, dstY, srcPixel);
+                    writeColumns<true>(span, mapping, y, dstRowData, xBegin, solidBegin);
+                    writeColumns<false>(span, mapping, y, dstRowData, solidBegin, solidEnd);
+                    writeColumns<true>(span, mapping, y, dstRowData, solidEnd, xEnd);
+                }
+                else
+                {
+                    writeColumns<false>(span, mapping, y, dstRowData, xBegin, xEnd);
+                }
             }
 
         private:
-            template<typename Impl>
-            [[nodiscard]] ARGB obtainSrcPixel(
-                const Point<size_type> pixelPos,
-                [[maybe_unused]] const Point<float_type> pixelPosFloat,
-                [[maybe_unused]] const Point<float_type> point,
-                [[maybe_unused]] const RasterizationContextBase<Impl>& rastrCtx) const
+            // Writes the pixels [`xBegin`; `xEnd`) of the `span` into the row `dstRowData` of the `imageDst`
+            //  applying alpha-blending if Blend == true.
+            template<bool Blend, typename Impl>
+            void writeColumns(
+                const RasterizationSpanBase<Impl>& span,
+                const RowMapping& mapping,
+                const int_type y,
+                std::uint8_t* const dstRowData,
+                const int_type xBegin,
+                const int_type xEnd) const noexcept
             {
-                ARGB result;
-
-                if constexpr (EnableInterpolation)
+                if constexpr (!Blend && !interpolationEnabled)
                 {
-                    result = InterpolationInfo::calculateFor(point, pixelPosFloat).applyTo(pixelPos, imageSrc);
+                    if (xBegin < xEnd)
+                        copyNearestRow<DstFormat>(mapping, xBegin, xEnd, dstRowData + getDstOffsetOf(xBegin));
                 }
                 else
                 {
-                    result = imageSrc.getPixelAt(pixelPos.x, pixelPos.y);
+                    // colors (and densities) are calculated by chunks to keep the buffers on the stack
+                    constexpr int_type chunkSize = 256;
+                    ARGB colors[chunkSize];
+                    // used only if alpha-blending uses the densities
+                    float_type densities[chunkSize];
+
+                    for (int_type chunkBegin = xBegin; chunkBegin < xEnd; chunkBegin += chunkSize)
+                    {
+                        const int_type chunkEnd = (std::min)(chunkBegin + chunkSize, xEnd);
+
+                        if constexpr (interpolationEnabled)
+                            interpolateRow<Interpolator::tapsCount>(imageSrc, *interpolationTables, y, chunkBegin, chunkEnd, colors);
+                        else
+                            copyNearestRow<PixelFormat::ARGB>(mapping, chunkBegin, chunkEnd, reinterpret_cast<std::uint8_t*>(colors));
+
+                        if constexpr (Blend && !spanHasPixelCoverages<Impl>)
+                            span.getPixelDensitiesOf(chunkBegin, chunkEnd, densities);
+
+                        for (int_type x = chunkBegin; x < chunkEnd; ++x)
+                            storePixelAt<Blend>(span, dstRowData, x, colors[x - chunkBegin], densities + (x - chunkBegin));
+                    }
+                }
+            }
+
+            // applies alpha-blending (if Blend == true) to the `color` of the pixel `x` of the `span`
+            //  and writes it into the row `dstRowData` of the `imageDst`
+            // (the `density` of the pixel is read only if the span has no coverages)
+            template<bool Blend, typename Impl>
+            void storePixelAt(
+                const RasterizationSpanBase<Impl>& span,
+                std::uint8_t* const dstRowData,
+                const int_type x,
+                ARGB color,
+                [[maybe_unused]] const float_type* const density) const noexcept
+            {
+                if constexpr (Blend && spanHasPixelCoverages<Impl>)
+                {
+                    const std::uint8_t* const coverages = static_cast<const Impl&>(span).getPixelCoverages();
+                    assert( (coverages != nullptr) );
+
+                    const unsigned coverage = coverages[x - span.getXBegin()];
+                    color.a = static_cast<std::uint8_t>((color.a * coverage + 127) / 255);
+                }
+                else if constexpr (Blend)
+                {
+                    color.a = static_cast<std::uint8_t>(static_cast<float_type>(color.a) * *density);
                 }
 
-                if constexpr (EnableAlphaBlending)
+                mglass::detail::storePixel<DstFormat>(dstRowData + getDstOffsetOf(x), color);
+            }
+
+            // returns the offset (in bytes) of the pixel `x` of the shape inside a row of the `imageDst`
+            [[nodiscard]] size_type getDstOffsetOf(const int_type x) const noexcept
+            {
+                return static_cast<size_type>(x - dstTopLeft.x) * MutableImageSpan::bytesPerPixel;
+            }
+        };
+
+
+        // The parameters of the magnification of a shape which do not depend on the part of the destination
+        //  being rendered, so they are calculated once and shared by all the bands (or tiles) of the destination.
+        struct Magnification final
+        {
+            float_type srcScaleFactor;
+            Point<float_type> scaleCenter;
+            // the columns and the rows of the shape mapped inside the source
+            MappedRange mappedColumns;
+            MappedRange mappedRows;
+            // empty if the Interpolator does not interpolate
+            InterpolationTables interpolationTables;
+
+
+            // Calculates the magnification of the pixels of the `dstArea` (a part of the `shapeIntegralBounds`)
+            //  of a shape scaled the `scaleFactor` times over the `imageSrc` placed at `imageSrcBounds`.
+            template<typename Interpolator>
+            [[nodiscard]] static Magnification calculateFor(
+                const IntegralRectArea& shapeIntegralBounds,
+                const IntegralRectArea& dstArea,
+                const float_type scaleFactor,
+                const ImageSpan& imageSrc,
+                const IntegralRectArea& imageSrcBounds)
+            {
+                Magnification result{};
+                result.srcScaleFactor = 1 / scaleFactor;
+                result.scaleCenter = restrictPointBy(imageSrcBounds, shapeIntegralBounds.getCenter());
+
+                const int_type columnsBegin = dstArea.topLeft.x;
+                const int_type columnsEnd = dstArea.topLeft.x + static_cast<int_type>(dstArea.width);
+                const int_type rowsBegin = dstArea.topLeft.y - static_cast<int_type>(dstArea.height) + 1;
+                const int_type rowsEnd = dstArea.topLeft.y + 1;
+
+                result.mappedColumns = MappedRange::calculateFor(
+                    result.srcScaleFactor, result.scaleCenter.x,
+                    imageSrcBounds.topLeft.x, imageSrc.getWidth(), false,
+                    columnsBegin, columnsEnd);
+                result.mappedRows = MappedRange::calculateFor(
+                    result.srcScaleFactor, result.scaleCenter.y,
+                    imageSrcBounds.topLeft.y, imageSrc.getHeight(), true,
+                    rowsBegin, rowsEnd);
+
+                if constexpr (!std::is_same_v<Interpolator, interpolators::Nearest>)
                 {
-                    result.a = static_cast<std::uint8_t>(static_cast<float_type>(result.a) * rastrCtx.getPixelDensity());
+                    result.interpolationTables.columns = AxisInterpolationTable::calculateFor<Interpolator>(
+                        result.srcScaleFactor, result.scaleCenter.x,
+                        imageSrcBounds.topLeft.x, imageSrc.getWidth(), imageSrc.getReplicatedBorder(), false,
+                        columnsBegin, columnsEnd);
+                    result.interpolationTables.rows = AxisInterpolationTable::calculateFor<Interpolator>(
+                        result.srcScaleFactor, result.scaleCenter.y,
+                        imageSrcBounds.topLeft.y, imageSrc.getHeight(), imageSrc.getReplicatedBorder(), true,
+                        rowsBegin, rowsEnd);
                 }
 
                 return result;
             }
+
+            // returns the consumer writing the magnified pixels into the `imageDst`
+            //  (the pixel `dstTopLeft` of the shape is written at (0; 0) of it)
+            // the consumer refers to the interpolation tables of this
+            template<bool EnableAlphaBlending, typename Interpolator, PixelFormat DstFormat>
+            [[nodiscard]] RasterizationConsumer<EnableAlphaBlending, Interpolator, DstFormat> getConsumer(
+                const ImageSpan& imageSrc,
+                const IntegralRectArea& imageSrcBounds,
+                const MutableImageSpan& imageDst,
+                const Point<int_type> dstTopLeft) const noexcept
+            {
+                return {
+                    srcScaleFactor,
+                    imageSrc,
+                    imageSrcBounds,
+                    imageDst,
+                    scaleCenter,
+                    dstTopLeft,
+                    mappedColumns,
+                    mappedRows,
+                    &interpolationTables
+                };
+            }
         };
 
+        // Magnifies the pixels of the `shape` inside the `area` (a part of the source)
+        //  by a copy of the `consumer` (see RasterizationConsumer).
+        template<typename Consumer, typename ShapeImpl, typename RastrCtx>
+        void magnifyArea(const Shape<ShapeImpl, RastrCtx>& shape, const IntegralRectArea& area, const Consumer& consumer)
+        {
+            if ( (area.width < 1) || (area.height < 1) )
+                return;
+
+            // each area has its own consumer's state
+            auto areaConsumer = consumer;
+
+            if constexpr (Consumer::alphaBlendingEnabled)
+            {
+                const auto solidColumns = SolidColumns::calculateFor(shape, area);
+                areaConsumer.solidColumns = &solidColumns;
 
-        template<bool EnableAlphaBlending, bool EnableInterpolating, typename ShapeImpl, typename RastrCtx>
+                shape.rasterizeSpansOnto(area, areaConsumer);
+            }
+            else
+            {
+                shape.rasterizeSpansOnto(area, areaConsumer);
+            }
+        }
+
+
+        // Splits rows of the `area` into bands and calls `renderBand`(band) for each of them via the `executor`.
+        // If the `executor` can not run tasks concurrently, `renderBand`(`area`) is called at the calling thread.
+        template<typename BandRenderer>
+        void forEachRowBandOf(Executor& executor, const IntegralRectArea& area, const BandRenderer& renderBand)
+        {
+            // bands are smaller than (rows / threads) so that threads which got cheap bands
+            //  (e.g. the ones near the top or bottom of an ellipse) can take more of them
+            constexpr size_type bandsPerThread = 4;
+            // but not too small to keep the overhead of a task negligible
+            constexpr size_type minRowsPerBand = 16;
+
+            const size_type concurrency = executor.getConcurrency();
+            const size_type bandsCount = (concurrency < 2)
+                ? 1
+                : (std::min)(concurrency * bandsPerThread, (area.height + minRowsPerBand - 1) / minRowsPerBand);
+
+            if (bandsCount < 2)
+                return renderBand(area);
+
+            executor.parallelFor(bandsCount, [&area, &renderBand, bandsCount](const size_type bandIndex) {
+                const size_type rowBegin = area.height * bandIndex / bandsCount;
+                const size_type rowEnd = area.height * (bandIndex + 1) / bandsCount;
+
+                renderBand(IntegralRectArea{
+                    { area.topLeft.x, area.topLeft.y - static_cast<int_type>(rowBegin) },
+                    area.width,
+                    rowEnd - rowBegin
+                });
+            });
+        }
+
+
+        template<bool EnableAlphaBlending, typename Interpolator, PixelFormat DstFormat, typename ShapeImpl, typename RastrCtx>
         void nearestNeighbor(
+            Executor& executor,
             const Shape<ShapeImpl, RastrCtx>& shape,
             float_type scaleFactor,
-            const Image& imageSrc,
+            const ImageSpan& imageSrc,
             Point<int_type> imageTopLeft,
-            Image& imageDst)
+            const MutableImageSpan& imageDst,
+            Point<int_type> dstOffset,
+            bool fillWithTransparent)
         {
             const IntegralRectArea shapeIntegralBounds = getShapeIntegralBounds(shape);
 
-            imageDst.setSize(shapeIntegralBounds.width, shapeIntegralBounds.height);
-            if ( (imageDst.getWidth() < 1) || (imageDst.getHeight() < 1) )
+            // the area of `imageDst` in the shape's coordinate system
+            const IntegralRectArea imageDstBounds{
+                { shapeIntegralBounds.topLeft.x - dstOffset.x, shapeIntegralBounds.topLeft.y + dstOffset.y },
+                imageDst.getWidth(),
+                imageDst.getHeight()
+            };
+
+            const IntegralRectArea dstArea = getIntersectionOf(shapeIntegralBounds, imageDstBounds);
+            if ( (dstArea.width < 1) || (dstArea.height < 1) )
                 return;
-            imageDst.fill(ARGB::transparent());
 
             const IntegralRectArea imageSrcBounds{imageTopLeft, imageSrc.getWidth(), imageSrc.getHeight()};
-            const auto scaleCenter = detail::restrictPointBy(imageSrcBounds, shapeIntegralBounds.getCenter());
-            const float_type srcScaleFactor = 1 / scaleFactor;
 
-            shape.rasterizeOnto(
-                imageSrcBounds,
-                RasterizationConsumer<EnableAlphaBlending, EnableInterpolating>{
-                    srcScaleFactor,
-                    imageSrc,
-                    imageSrcBounds,
-                    imageDst,
-                    scaleCenter,
-                    shapeIntegralBounds
+            const Magnification magnification = Magnification::calculateFor<Interpolator>(
+                shapeIntegralBounds, dstArea, scaleFactor, imageSrc, imageSrcBounds);
+            const auto consumer = magnification.getConsumer<EnableAlphaBlending, Interpolator, DstFormat>(
+                imageSrc, imageSrcBounds, imageDst, imageDstBounds.topLeft);
+
+            // rows of the destination do not depend on each other, so the bands can be rendered concurrently
+            forEachRowBandOf(executor, dstArea, [&](const IntegralRectArea& band) {
+                if (fillWithTransparent)
+                {
+                    imageDst.getSubSpan(
+                        static_cast<size_type>(band.topLeft.x - imageDstBounds.topLeft.x),
+                        static_cast<size_type>(imageDstBounds.topLeft.y - band.topLeft.y),
+                        band.width,
+                        band.height
+                    ).fill(ARGB::transparent());
                 }
-            );
+
+                magnifyArea(shape, getIntersectionOf(imageSrcBounds, band), consumer);
+            });
+        }
+
+        template<bool EnableAlphaBlending, typename Interpolator, typename ShapeImpl, typename RastrCtx>
+        void nearestNeighbor(
+            Executor& executor,
+            const Shape<ShapeImpl, RastrCtx>& shape,
+            float_type scaleFactor,
+            const ImageSpan& imageSrc,
+            Point<int_type> imageTopLeft,
+            const MutableImageSpan& imageDst,
+            Point<int_type> dstOffset,
+            bool fillWithTransparent)
+        {
+            switch (imageDst.getFormat())
+            {
+                case PixelFormat::ARGB:
+                    return nearestNeighbor<EnableAlphaBlending, Interpolator, PixelFormat::ARGB>(
+                        executor, shape, scaleFactor, imageSrc, imageTopLeft, imageDst, dstOffset, fillWithTransparent);
+                case PixelFormat::BGRA:
+                    return nearestNeighbor<EnableAlphaBlending, Interpolator, PixelFormat::BGRA>(
+                        executor, shape, scaleFactor, imageSrc, imageTopLeft, imageDst, dstOffset, fillWithTransparent);
+                case PixelFormat::RGBA:
+                    return nearestNeighbor<EnableAlphaBlending, Interpolator, PixelFormat::RGBA>(
+                        executor, shape, scaleFactor, imageSrc, imageTopLeft, imageDst, dstOffset, fillWithTransparent);
+            }
+        }
+
+        template<bool EnableAlphaBlending, typename Interpolator, typename ShapeImpl, typename RastrCtx>
+        void nearestNeighbor(
+            Executor& executor,
+            const Shape<ShapeImpl, RastrCtx>& shape,
+            float_type scaleFactor,
+            const ImageSpan& imageSrc,
+            Point<int_type> imageTopLeft,
+            Image& imageDst)
+        {
+            const IntegralRectArea shapeIntegralBounds = getShapeIntegralBounds(shape);
+
+            imageDst.setSize(shapeIntegralBounds.width, shapeIntegralBounds.height);
+
+            // `imageDst` is exactly under the shape's bounds, so it will be filled entirely
+            nearestNeighbor<EnableAlphaBlending, Interpolator, PixelFormat::ARGB>(
+                executor, shape, scaleFactor, imageSrc, imageTopLeft, imageDst, {0, 0}, true);
         }
     } // namespace detail
 
@@ -172,43 +833,179 @@ namespace mglass::magnifiers
     // Result will be written into `imageDst` buffer.
     // If `enableAlphaBlending` == true edges of the resulting image will be smoothed.
     // `imageDst` will have size is getShapeIntegralBounds(`shape`).width x getShapeIntegralBounds(`shape`).height.
-    // If `imageSrc` and `imageDst` point to the same object, behavior is undefined.
+    // `imageSrc` can be an mglass::Image, a view of any part of an image (see mglass::ImageSpan)
+    //  or an mglass::PreparedSource (which is faster to magnify many times).
+    // Bands of rows of `imageDst` are rendered concurrently via the `executor` (see mglass::ThreadPool),
+    //  the result does not depend on the `executor`.
+    // If `imageSrc` views pixels of `imageDst`, behavior is undefined.
     // If `scaleFactor` is not inside the range (0; +inf), behavior is undefined.
     template<typename ShapeImpl, typename RastrCtx>
     void nearestNeighbor(
+        Executor& executor,
         const Shape<ShapeImpl, RastrCtx>& shape,
         const float_type scaleFactor,
-        const Image& imageSrc,
+        const ImageSpan& imageSrc,
         const Point<int_type> imageTopLeft,
         Image& imageDst,
         const bool enableAlphaBlending = false)
     {
         if (enableAlphaBlending)
-            detail::nearestNeighbor<true, false>(shape, scaleFactor, imageSrc, imageTopLeft, imageDst);
+            detail::nearestNeighbor<true, interpolators::Nearest>(executor, shape, scaleFactor, imageSrc, imageTopLeft, imageDst);
         else
-            detail::nearestNeighbor<false, false>(shape, scaleFactor, imageSrc, imageTopLeft, imageDst);
+            detail::nearestNeighbor<false, interpolators::Nearest>(executor, shape, scaleFactor, imageSrc, imageTopLeft, imageDst);
+    }
+
+    // The same as above but runs at the calling thread only.
+    template<typename ShapeImpl, typename RastrCtx>
+    void nearestNeighbor(
+        const Shape<ShapeImpl, RastrCtx>& shape,
+        const float_type scaleFactor,
+        const ImageSpan& imageSrc,
+        const Point<int_type> imageTopLeft,
+        Image& imageDst,
+        const bool enableAlphaBlending = false)
+    {
+        SequentialExecutor executor;
+        nearestNeighbor(executor, shape, scaleFactor, imageSrc, imageTopLeft, imageDst, enableAlphaBlending);
+    }
+
+    // Scale the area of `imageSrc` bounded by `shape` the `scaleFactor` times.
+    // Result will be written into the pixels viewed by `imageDst` (no memory allocations are performed):
+    //  the top left pixel of getShapeIntegralBounds(`shape`) is written at (`dstOffset`.x; `dstOffset`.y) of `imageDst`
+    //  (`dstOffset` can be negative, the pixels which do not fit `imageDst` are skipped).
+    // If `fillWithTransparent` == true the area of `imageDst` under getShapeIntegralBounds(`shape`) is filled by
+    //  ARGB::transparent() first, otherwise the pixels which are not magnified keep their values.
+    // If `enableAlphaBlending` == true edges of the resulting image will be smoothed.
+    // Bands of rows of `imageDst` are rendered concurrently via the `executor` (see mglass::ThreadPool),
+    //  the result does not depend on the `executor`.
+    // If `imageSrc` and `imageDst` view the same pixels, behavior is undefined.
+    // If `scaleFactor` is not inside the range (0; +inf), behavior is undefined.
+    template<typename ShapeImpl, typename RastrCtx>
+    void nearestNeighbor(
+        Executor& executor,
+        const Shape<ShapeImpl, RastrCtx>& shape,
+        const float_type scaleFactor,
+        const ImageSpan& imageSrc,
+        const Point<int_type> imageTopLeft,
+        const MutableImageSpan& imageDst,
+        const Point<int_type> dstOffset,
+        const bool enableAlphaBlending = false,
+        const bool fillWithTransparent = true)
+    {
+        if (enableAlphaBlending)
+            detail::nearestNeighbor<true, interpolators::Nearest>(
+                executor, shape, scaleFactor, imageSrc, imageTopLeft, imageDst, dstOffset, fillWithTransparent);
+        else
+            detail::nearestNeighbor<false, interpolators::Nearest>(
+                executor, shape, scaleFactor, imageSrc, imageTopLeft, imageDst, dstOffset, fillWithTransparent);
+    }
+
+    // The same as above but runs at the calling thread only.
+    template<typename ShapeImpl, typename RastrCtx>
+    void nearestNeighbor(
+        const Shape<ShapeImpl, RastrCtx>& shape,
+        const float_type scaleFactor,
+        const ImageSpan& imageSrc,
+        const Point<int_type> imageTopLeft,
+        const MutableImageSpan& imageDst,
+        const Point<int_type> dstOffset,
+        const bool enableAlphaBlending = false,
+        const bool fillWithTransparent = true)
+    {
+        SequentialExecutor executor;
+        nearestNeighbor(
+            executor, shape, scaleFactor, imageSrc, imageTopLeft, imageDst, dstOffset, enableAlphaBlending, fillWithTransparent);
     }
 
     // Scale the area of `imageSrc` bounded by `shape` the `scaleFactor` times.
     // This function gives a better image then `nearestNeighbor` but it is slower.
+    // Colors of the pixels are interpolated by the Interpolator (see mglass/interpolators.h), e.g.
+    //  nearestNeighborInterpolated<mglass::interpolators::Bicubic>(...).
     // Result will be written into `imageDst` buffer.
     // If `enableAlphaBlending` == true edges of the resulting image will be smoothed.
     // `imageDst` will have size is getShapeIntegralBounds(`shape`).width x getShapeIntegralBounds(`shape`).height.
-    // If `imageSrc` and `imageDst` point to the same object, behavior is undefined.
+    // `imageSrc` can be an mglass::Image, a view of any part of an image (see mglass::ImageSpan)
+    //  or an mglass::PreparedSource (which is faster to magnify many times).
+    // Bands of rows of `imageDst` are rendered concurrently via the `executor` (see mglass::ThreadPool),
+    //  the result does not depend on the `executor`.
+    // If `imageSrc` views pixels of `imageDst`, behavior is undefined.
     // If `scaleFactor` is not inside the range (0; +inf), behavior is undefined.
-    template<typename ShapeImpl, typename RastrCtx>
+    template<typename Interpolator = interpolators::Bilinear, typename ShapeImpl, typename RastrCtx>
     void nearestNeighborInterpolated(
+        Executor& executor,
         const Shape<ShapeImpl, RastrCtx>& shape,
         const float_type scaleFactor,
-        const Image& imageSrc,
+        const ImageSpan& imageSrc,
         const Point<int_type> imageTopLeft,
         Image& imageDst,
         const bool enableAlphaBlending = false)
     {
         if (enableAlphaBlending)
-            detail::nearestNeighbor<true, true>(shape, scaleFactor, imageSrc, imageTopLeft, imageDst);
+            detail::nearestNeighbor<true, Interpolator>(executor, shape, scaleFactor, imageSrc, imageTopLeft, imageDst);
         else
-            detail::nearestNeighbor<false, true>(shape, scaleFactor, imageSrc, imageTopLeft, imageDst);
+            detail::nearestNeighbor<false, Interpolator>(executor, shape, scaleFactor, imageSrc, imageTopLeft, imageDst);
+    }
+
+    // The same as above but runs at the calling thread only.
+    template<typename Interpolator = interpolators::Bilinear, typename ShapeImpl, typename RastrCtx>
+    void nearestNeighborInterpolated(
+        const Shape<ShapeImpl, RastrCtx>& shape,
+        const float_type scaleFactor,
+        const ImageSpan& imageSrc,
+        const Point<int_type> imageTopLeft,
+        Image& imageDst,
+        const bool enableAlphaBlending = false)
+    {
+        SequentialExecutor executor;
+        nearestNeighborInterpolated<Interpolator>(executor, shape, scaleFactor, imageSrc, imageTopLeft, imageDst, enableAlphaBlending);
+    }
+
+    // Scale the area of `imageSrc` bounded by `shape` the `scaleFactor` times.
+    // This function gives a better image then `nearestNeighbor` but it is slower.
+    // Colors of the pixels are interpolated by the Interpolator (see mglass/interpolators.h), e.g.
+    //  nearestNeighborInterpolated<mglass::interpolators::Bicubic>(...).
+    // Result will be written into the pixels viewed by `imageDst` like the corresponding overload of
+    //  `nearestNeighbor` does.
+    // If `enableAlphaBlending` == true edges of the resulting image will be smoothed.
+    // Bands of rows of `imageDst` are rendered concurrently via the `executor` (see mglass::ThreadPool),
+    //  the result does not depend on the `executor`.
+    // If `imageSrc` and `imageDst` view the same pixels, behavior is undefined.
+    // If `scaleFactor` is not inside the range (0; +inf), behavior is undefined.
+    template<typename Interpolator = interpolators::Bilinear, typename ShapeImpl, typename RastrCtx>
+    void nearestNeighborInterpolated(
+        Executor& executor,
+        const Shape<ShapeImpl, RastrCtx>& shape,
+        const float_type scaleFactor,
+        const ImageSpan& imageSrc,
+        const Point<int_type> imageTopLeft,
+        const MutableImageSpan& imageDst,
+        const Point<int_type> dstOffset,
+        const bool enableAlphaBlending = false,
+        const bool fillWithTransparent = true)
+    {
+        if (enableAlphaBlending)
+            detail::nearestNeighbor<true, Interpolator>(
+                executor, shape, scaleFactor, imageSrc, imageTopLeft, imageDst, dstOffset, fillWithTransparent);
+        else
+            detail::nearestNeighbor<false, Interpolator>(
+                executor, shape, scaleFactor, imageSrc, imageTopLeft, imageDst, dstOffset, fillWithTransparent);
+    }
+
+    // The same as above but runs at the calling thread only.
+    template<typename Interpolator = interpolators::Bilinear, typename ShapeImpl, typename RastrCtx>
+    void nearestNeighborInterpolated(
+        const Shape<ShapeImpl, RastrCtx>& shape,
+        const float_type scaleFactor,
+        const ImageSpan& imageSrc,
+        const Point<int_type> imageTopLeft,
+        const MutableImageSpan& imageDst,
+        const Point<int_type> dstOffset,
+        const bool enableAlphaBlending = false,
+        const bool fillWithTransparent = true)
+    {
+        SequentialExecutor executor;
+        nearestNeighborInterpolated<Interpolator>(
+            executor, shape, scaleFactor, imageSrc, imageTopLeft, imageDst, dstOffset, enableAlphaBlending, fillWithTransparent);
     }
 } // namespace mglass::magnifiers
 
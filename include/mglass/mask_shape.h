@@ -0,0 +1,176 @@
+#ifndef MAGNIFYING_GLASS_MASK_SHAPE_H
+#define MAGNIFYING_GLASS_MASK_SHAPE_H
+
+#include "mglass/primitives.h"          // Point, IntegralRectArea, int_type, size_type, float_type
+#include "mglass/shape.h"               // Shape
+#include "mglass/image_span.h"          // ImageSpan
+#include "mglass/rasterized_spans.h"    // RasterizedPointContext, RasterizedSpan
+#include <algorithm>                    // std::max, std::min
+#include <cstdint>                      // std::uint8_t
+#include <memory>                       // std::shared_ptr
+#include <utility>                      // std::forward
+#include <vector>                       // std::vector
+
+
+namespace mglass::shapes
+{
+    // The MaskOutline class keeps the pixels of a bitmap mask as run-length encoded rows:
+    //  each row is a list of the runs of the pixels with non-zero coverages and the 8-bit coverages of them.
+    // Outlines are immutable, so the masks of the same outline share it (see Mask).
+    //
+    // The pixel (col, row) of the bitmap is at (col, -row) relative to the top left corner of the bitmap.
+    class MaskOutline final
+    {
+    public:
+        // The pixels [xBegin; xEnd) of a row (relative to the left side of the bitmap),
+        //  the coverage of the pixel x is getCoverages()[coveragesOffset + x - xBegin].
+        struct Run final
+        {
+            int_type xBegin;
+            int_type xEnd;
+            size_type coveragesOffset;
+        };
+
+    public: // ctors/dtor
+        // no pixels
+        MaskOutline() = default;
+
+        // the coverages of the pixels are the alpha channel of the `image`
+        explicit MaskOutline(const ImageSpan& image);
+
+        // Returns the outline of the 1-bit mask `width` x `height`, the pixels of the set bits are fully covered.
+        // The rows are packed by 8 pixels per byte starting from the most significant bit,
+        //  each row takes ((width + 7) / 8) bytes of the `packedBits`.
+        [[nodiscard]] static MaskOutline fromBits(size_type width, size_type height, const std::uint8_t* packedBits);
+
+    public: // getters
+        // The bounds of the covered pixels relative to the top left corner of the bitmap.
+        // If there are no covered pixels, the bounds are empty.
+        [[nodiscard]] const IntegralRectArea& getBounds() const noexcept { return bounds_; }
+
+        // the runs of the row (getBounds().topLeft.y - i) are [getRowRunsBegin(i); getRowRunsEnd(i))
+        [[nodiscard]] const Run* getRowRunsBegin(size_type i) const noexcept { return runs_.data() + rowsRuns_[i]; }
+        [[nodiscard]] const Run* getRowRunsEnd(size_type i) const noexcept { return runs_.data() + rowsRuns_[i + 1]; }
+
+        [[nodiscard]] const std::vector<std::uint8_t>& getCoverages() const noexcept { return coverages_; }
+
+    private:
+        // encodes the `coverages` of the `height` rows of `width` pixels
+        void assignRuns(const std::vector<std::uint8_t>& coverages, size_type width, size_type height);
+
+    private:
+        IntegralRectArea bounds_{ {0, 0}, 0, 0 };
+
+        // ordered by rows and then by xBegin
+        std::vector<Run> runs_;
+        // the runs of the i-th row of bounds_ are [rowsRuns_[i]; rowsRuns_[i + 1])
+        std::vector<size_type> rowsRuns_;
+        std::vector<std::uint8_t> coverages_;
+    };
+
+
+    // The Mask class is a bitmap mask (see MaskOutline) whose top left pixel is placed at `topLeft`.
+    // The densities of the pixels are their coverages, so the masks are rasterized the same way at any position.
+    //
+    // Only the runs of the covered pixels are visited, so the cost is proportional to the count of the runs
+    //  and the covered pixels rather than to the area of the bitmap.
+    class Mask : public Shape<Mask, mglass::detail::RasterizedPointContext>
+    {
+        friend struct Shape<Mask, mglass::detail::RasterizedPointContext>;
+
+    public:
+        using RasterizationSpan = mglass::detail::RasterizedSpan<std::uint8_t>;
+
+    public: // ctors/dtor
+        // no pixels
+        Mask();
+
+        // the coverages of the pixels are the alpha channel of the `image`
+        explicit Mask(const ImageSpan& image, Point<int_type> topLeft = {0, 0});
+
+        // `outline` must not be nullptr
+        Mask(Point<int_type> topLeft, std::shared_ptr<const MaskOutline> outline) noexcept;
+
+        ~Mask() noexcept = default;
+
+    public: // getters
+        [[nodiscard]] Point<int_type> getTopLeft() const noexcept { return topLeft_; }
+        [[nodiscard]] const MaskOutline& getOutline() const noexcept { return *outline_; }
+        // the outline shared by the copies of the shape (the shapes sharing it share the masks of ShapeMaskCache)
+        [[nodiscard]] const std::shared_ptr<const MaskOutline>& getSharedOutline() const noexcept { return outline_; }
+
+    protected:
+        Point<int_type> topLeft_;
+        std::shared_ptr<const MaskOutline> outline_;
+
+    private: // Shape<Mask> implementation
+        // getShapeIntegralBounds of these bounds are the bounds of the covered pixels
+        [[nodiscard]] ShapeRectArea getBoundsImpl() const noexcept;
+
+        template<typename ConsumerFunctor>
+        void rasterizeOntoImpl(IntegralRectArea rect, ConsumerFunctor&& consumer) const
+        {
+            rasterizeSpansOntoImpl(rect, [&consumer](const RasterizationSpan& span) {
+                for (int_type x = span.getXBegin(); x < span.getXEnd(); ++x)
+                {
+                    (void)std::forward<ConsumerFunctor>(consumer)(
+                        mglass::detail::RasterizedPointContext{ { x, span.getY() }, span.getPixelDensityAt(x) }
+                    );
+                }
+            });
+        }
+
+        template<typename ConsumerFunctor>
+        void rasterizeSpansOntoImpl(IntegralRectArea rect, ConsumerFunctor&& consumer) const
+        {
+            const IntegralRectArea& outlineBounds = outline_->getBounds();
+
+            if ((rect.width < 1) || (rect.height < 1) || (outlineBounds.height < 1))
+                return;
+
+            // `rect` relative to the top left corner of the bitmap
+            const int_type rectXBegin = rect.topLeft.x - topLeft_.x;
+            const int_type rectXEnd = rectXBegin + static_cast<int_type>(rect.width);
+            const int_type rectYTop = rect.topLeft.y - topLeft_.y;
+
+            const int_type boundsTop = outlineBounds.topLeft.y;
+
+            // the row i of the outline's bounds is at y = boundsTop - i
+            const int_type rowBegin = (std::max)(boundsTop - rectYTop, int_type{0});
+            const int_type rowEnd = (std::min)(
+                boundsTop - rectYTop + static_cast<int_type>(rect.height),
+                static_cast<int_type>(outlineBounds.height)
+            );
+
+            const std::uint8_t* const coverages = outline_->getCoverages().data();
+
+            for (int_type row = rowBegin; row < rowEnd; ++row)
+            {
+                const auto rowIndex = static_cast<size_type>(row);
+                const int_type y = topLeft_.y + boundsTop - row;
+
+                for (auto run = outline_->getRowRunsBegin(rowIndex); run != outline_->getRowRunsEnd(rowIndex); ++run)
+                {
+                    // the runs are ordered by xBegin, so the rest of the row is to the right of `rect`
+                    if (run->xBegin >= rectXEnd)
+                        break;
+
+                    const int_type xBegin = (std::max)(run->xBegin, rectXBegin);
+                    const int_type xEnd = (std::min)(run->xEnd, rectXEnd);
+
+                    if (xBegin >= xEnd)
+                        continue;
+
+                    (void)std::forward<ConsumerFunctor>(consumer)(RasterizationSpan{
+                        y,
+                        xBegin + topLeft_.x,
+                        xEnd + topLeft_.x,
+                        coverages + run->coveragesOffset + static_cast<size_type>(xBegin - run->xBegin)
+                    });
+                }
+            }
+        }
+    };
+} // namespace mglass::shapes
+
+#endif // ndef MAGNIFYING_GLASS_MASK_SHAPE_H
@@ -4,5 +4,8 @@
 #include "mglass/primitives.h"
 #include "mglass/shape.h"
 #include "mglass/image.h"
+#include "mglass/image_span.h"
+#include "mglass/prepared_source.h"
+#include "mglass/executors.h"
 
 #endif // ndef MAGNIFYING_GLASS_MGLASS_H
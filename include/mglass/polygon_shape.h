@@ -0,0 +1,243 @@
+#ifndef MAGNIFYING_GLASS_POLYGON_SHAPE_H
+#define MAGNIFYING_GLASS_POLYGON_SHAPE_H
+
+#include "mglass/shape.h"   // Shape
+#include <algorithm>        // std::min, std::max, std::remove_if
+#include <cmath>            // std::ceil
+#include <memory>           // std::shared_ptr
+#include <utility>          // std::forward
+#include <vector>           // std::vector
+
+
+namespace mglass::shapes
+{
+    // The PolygonOutline class keeps the vertices of a polygon relative to its center
+    //  and the table of its edges for the scanline rasterization.
+    // Outlines are immutable, so the polygons of the same outline share it (see Polygon).
+    class PolygonOutline final
+    {
+    public:
+        // A non-horizontal edge of the polygon (relative to the center).
+        struct Edge final
+        {
+            // the edge crosses the scanlines y inside the range [yBottom; yTop)
+            float_type yBottom;
+            float_type yTop;
+            float_type xAtBottom;
+            // dx / dy
+            float_type slope;
+
+            // returns x-coordinate of the point of the edge at the scanline `y`
+            [[nodiscard]] float_type getXAt(const float_type y) const noexcept
+            {
+                return xAtBottom + (y - yBottom) * slope;
+            }
+        };
+
+    public: // ctors/dtor
+        // The `vertices` are joined in order, the last one is joined with the first one.
+        // The polygon can be concave or self-intersecting, the pixels are inside it by the even-odd rule.
+        // If the coordinates of the vertices are not finite, behaviour of the polygons is undefined.
+        explicit PolygonOutline(std::vector<Point<float_type>> vertices);
+
+    public: // getters
+        [[nodiscard]] const std::vector<Point<float_type>>& getVertices() const noexcept { return vertices_; }
+
+        // the edges sorted by yTop (the topmost edges are the first ones)
+        [[nodiscard]] const std::vector<Edge>& getEdges() const noexcept { return edges_; }
+
+        // the bounds of the vertices relative to the center
+        [[nodiscard]] const ShapeRectArea& getBounds() const noexcept { return bounds_; }
+
+    private:
+        std::vector<Point<float_type>> vertices_;
+        std::vector<Edge> edges_;
+        ShapeRectArea bounds_;
+    };
+
+
+    namespace detail
+    {
+        class PolygonRastrContext final : public RasterizationContextBase<PolygonRastrContext>
+        {
+            // for accessing to getRasterizedPointImpl(), getPixelDensityImpl() from base
+            friend struct RasterizationContextBase<PolygonRastrContext>;
+
+        public:
+            explicit PolygonRastrContext(Point<int_type> rasterizedPoint) noexcept
+                : rasterizedPoint_(rasterizedPoint)
+            {}
+
+        private: // RasterizationContextBase<PolygonRastrContext> implementation
+            Point<int_type> getRasterizedPointImpl() const noexcept { return rasterizedPoint_; }
+            float_type getPixelDensityImpl() const noexcept { return 1; }
+
+        private:
+            Point<int_type> rasterizedPoint_;
+        };
+
+
+        class PolygonRastrSpan final : public RasterizationSpanBase<PolygonRastrSpan>
+        {
+            // for accessing to get*Impl() from base
+            friend struct RasterizationSpanBase<PolygonRastrSpan>;
+
+        public:
+            PolygonRastrSpan(int_type y, int_type xBegin, int_type xEnd) noexcept
+                : y_(y)
+                , xBegin_(xBegin)
+                , xEnd_(xEnd)
+            {}
+
+        private: // RasterizationSpanBase<PolygonRastrSpan> implementation
+            int_type getYImpl() const noexcept { return y_; }
+            int_type getXBeginImpl() const noexcept { return xBegin_; }
+            int_type getXEndImpl() const noexcept { return xEnd_; }
+            float_type getPixelDensityAtImpl([[maybe_unused]] int_type x) const noexcept { return 1; }
+
+        private:
+            int_type y_;
+            int_type xBegin_;
+            int_type xEnd_;
+        };
+    } // namespace detail
+
+
+    // The Polygon class is a polygon (see PolygonOutline) placed at the `center`.
+    // A pixel is rasterized if its center is inside the polygon, the densities of all the pixels are 1.
+    //
+    // The rows are rasterized by the scanline algorithm: the edges crossing a row are kept in the active edge table,
+    //  so the cost is proportional to the count of the edges and the rasterized pixels.
+    class Polygon : public Shape<Polygon, detail::PolygonRastrContext>
+    {
+        friend struct Shape<Polygon, detail::PolygonRastrContext>;
+
+    public:
+        using RasterizationSpan = detail::PolygonRastrSpan;
+
+    public: // ctors/dtor
+        // the `vertices` are relative to the `center`
+        explicit Polygon(
+            Point<float_type> center = {0, 0},
+            std::vector<Point<float_type>> vertices = {});
+
+        // `outline` must not be nullptr
+        Polygon(Point<float_type> center, std::shared_ptr<const PolygonOutline> outline) noexcept;
+
+        // Returns the regular polygon with `verticesCount` vertices inscribed into the ellipse
+        //  with the `center` and the axes `width`, `height` (the first vertex is at the top).
+        [[nodiscard]] static Polygon regular(
+            Point<float_type> center,
+            size_type verticesCount,
+            float_type width,
+            float_type height);
+
+        ~Polygon() noexcept = default;
+
+    public: // getters
+        [[nodiscard]] Point<float_type> getCenter() const noexcept { return center_; }
+        [[nodiscard]] const PolygonOutline& getOutline() const noexcept { return *outline_; }
+        // the outline shared by the copies of the shape (the shapes sharing it share the masks of ShapeMaskCache)
+        [[nodiscard]] const std::shared_ptr<const PolygonOutline>& getSharedOutline() const noexcept { return outline_; }
+
+    protected:
+        Point<float_type> center_;
+        std::shared_ptr<const PolygonOutline> outline_;
+
+    private: // Shape<Polygon> implementation
+        [[nodiscard]] ShapeRectArea getBoundsImpl() const noexcept;
+
+        template<typename ConsumerFunctor>
+        void rasterizeOntoImpl(IntegralRectArea rect, ConsumerFunctor&& consumer) const
+        {
+            rasterizeSpansOntoImpl(rect, [&consumer](const detail::PolygonRastrSpan& span) {
+                const int_type y = span.getY();
+
+                for (int_type x = span.getXBegin(); x < span.getXEnd(); ++x)
+                    (void)std::forward<ConsumerFunctor>(consumer)(detail::PolygonRastrContext{ { x, y } });
+            });
+        }
+
+        template<typename ConsumerFunctor>
+        void rasterizeSpansOntoImpl(IntegralRectArea rect, ConsumerFunctor&& consumer) const
+        {
+            using namespace literals;
+            using Edge = PolygonOutline::Edge;
+
+            if ((rect.width < 1) || (rect.height < 1))
+                return;
+
+            const IntegralRectArea thisIntegralBounds = getShapeIntegralBounds(*this);
+
+            const int_type xMin = (std::max)(rect.topLeft.x, thisIntegralBounds.topLeft.x);
+            const int_type xEnd = (std::min)(
+                rect.topLeft.x + static_cast<int_type>(rect.width),
+                thisIntegralBounds.topLeft.x + static_cast<int_type>(thisIntegralBounds.width)
+            );
+
+            // only the rows inside both the bounds and `rect` are visited
+            const int_type yStart = (std::min)(rect.topLeft.y, thisIntegralBounds.topLeft.y);
+            const int_type yEnd = (std::max)(
+                rect.topLeft.y - static_cast<int_type>(rect.height),
+                thisIntegralBounds.topLeft.y - static_cast<int_type>(thisIntegralBounds.height)
+            );
+
+            if (xMin >= xEnd)
+                return;
+
+            const std::vector<Edge>& edges = outline_->getEdges();
+            auto nextEdge = edges.begin();
+
+            // the active edge table: the edges crossing the current scanline
+            std::vector<const Edge*> activeEdges;
+            // x-coordinates of the points where the active edges cross the current scanline
+            std::vector<float_type> crossings;
+
+            for (int_type y = yStart; y > yEnd; --y)
+            {
+                // +0.5 is for moving to the pixel's center
+                const float_type scanline = (static_cast<float_type>(y) + 0.5_flt) - center_.y;
+
+                // the edges are sorted by their tops, so the ones reaching the scanline are added from the front
+                for (; (nextEdge != edges.end()) && (scanline < nextEdge->yTop); ++nextEdge)
+                    activeEdges.push_back(&*nextEdge);
+
+                // the edges ending above the scanline are removed
+                activeEdges.erase(
+                    std::remove_if(activeEdges.begin(), activeEdges.end(), [scanline](const Edge* edge) {
+                        return (scanline < edge->yBottom);
+                    }),
+                    activeEdges.end()
+                );
+
+                crossings.clear();
+                for (const Edge* edge : activeEdges)
+                {
+                    const float_type x = edge->getXAt(scanline) + center_.x;
+
+                    // insertion sort (the crossings of the adjacent scanlines are mostly in the same order)
+                    auto position = crossings.end();
+                    for (; (position != crossings.begin()) && (x < *(position - 1)); --position) {}
+
+                    crossings.insert(position, x);
+                }
+
+                // each pair of the crossings bounds a run inside the polygon (the count of the crossings is even)
+                for (size_type i = 0; i + 1 < crossings.size(); i += 2)
+                {
+                    // the pixels whose centers are inside the range [crossings[i]; crossings[i + 1])
+                    const auto runBegin = static_cast<int_type>(std::ceil(crossings[i] - 0.5_flt));
+                    const auto runEnd = static_cast<int_type>(std::ceil(crossings[i + 1] - 0.5_flt));
+
+                    const int_type spanBegin = (std::max)(runBegin, xMin);
+                    const int_type spanEnd = (std::min)(runEnd, xEnd);
+
+                    if (spanBegin < spanEnd)
+                        (void)std::forward<ConsumerFunctor>(consumer)(detail::PolygonRastrSpan{ y, spanBegin, spanEnd });
+                }
+            }
+        }
+    };
+} // namespace mglass::shapes
+
+#endif // ndef MAGNIFYING_GLASS_POLYGON_SHAPE_H
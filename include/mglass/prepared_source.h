@@ -0,0 +1,48 @@
+#ifndef MAGNIFYING_GLASS_PREPARED_SOURCE_H
+#define MAGNIFYING_GLASS_PREPARED_SOURCE_H
+
+#include "mglass/primitives.h"  // size_type
+#include "mglass/image.h"       // ARGB
+#include "mglass/image_span.h"  // ImageSpan
+#include <vector>               // std::vector
+
+
+namespace mglass
+{
+    // The PreparedSource class is a copy of an image surrounded by the replicated border
+    //  (see mglass::ImageSpan::getReplicatedBorder).
+    //
+    // Magnifiers read pixels of the border instead of clamping coordinates of the pixels near the edges of the image,
+    //  so the same source magnified many times (e.g. while a lens is dragged) should be prepared once
+    //  and then be passed to the magnifiers instead of the original image.
+    // The results of the magnifiers are the same as for the original image.
+    class PreparedSource final
+    {
+    public:
+        // The width of the border: enough for the widest interpolator (see mglass/interpolators.h)
+        //  and for a SIMD vector of pixels read at the last column of the image.
+        static constexpr size_type borderSize = 8;
+
+    public: // ctors/dtor
+        PreparedSource() = default;
+
+        // copies the pixels of the `image`
+        explicit PreparedSource(const ImageSpan& image);
+
+    public: // getters
+        [[nodiscard]] size_type getWidth() const noexcept { return width_; }
+        [[nodiscard]] size_type getHeight() const noexcept { return height_; }
+
+        // views the copy of the image (the view has the replicated border of borderSize pixels)
+        [[nodiscard]] ImageSpan getImage() const noexcept;
+
+        operator ImageSpan() const noexcept { return getImage(); } // NOLINT(google-explicit-constructor)
+
+    private:
+        std::vector<ARGB> pixels_;  // the rows of the image with the border
+        size_type width_ = 0;
+        size_type height_ = 0;
+    };
+} // namespace mglass
+
+#endif // ndef MAGNIFYING_GLASS_PREPARED_SOURCE_H
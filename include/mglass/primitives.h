@@ -4,6 +4,8 @@
 #include <cstdint>      // std::int32_t
 #include <cstddef>      // std::size_t
 #include <type_traits>  // std::is_arithmetic_v, std::is_same_v
+#include <algorithm>    // std::min, std::max
+#include <cmath>        // std::cos, std::sin
 
 namespace mglass
 {
@@ -142,6 +144,122 @@ namespace mglass
 
 
     using IntegralRectArea = RectArea<int_type, size_type>;
+
+
+    // The affine transform of the points p -> (xx * p.x + xy * p.y + dx; yx * p.x + yy * p.y + dy).
+    // The default one is the identity transform.
+    struct AffineTransform
+    {
+        float_type xx = 1;
+        float_type xy = 0;
+        float_type yx = 0;
+        float_type yy = 1;
+        float_type dx = 0;
+        float_type dy = 0;
+
+
+        // the rotation around (0; 0), positive angles are counterclockwise (the y-axis looks up)
+        [[nodiscard]] static AffineTransform rotation(const float_type radians) noexcept
+        {
+            const auto cos = static_cast<float_type>(std::cos(static_cast<double>(radians)));
+            const auto sin = static_cast<float_type>(std::sin(static_cast<double>(radians)));
+
+            return { cos, -sin, sin, cos, 0, 0 };
+        }
+
+        [[nodiscard]] static constexpr AffineTransform scaling(const float_type sx, const float_type sy) noexcept
+        {
+            return { sx, 0, 0, sy, 0, 0 };
+        }
+
+        [[nodiscard]] static constexpr AffineTransform translation(const float_type dx, const float_type dy) noexcept
+        {
+            return { 1, 0, 0, 1, dx, dy };
+        }
+
+        [[nodiscard]] constexpr Point<float_type> apply(const Point<float_type> p) const noexcept
+        {
+            return { xx * p.x + xy * p.y + dx, yx * p.x + yy * p.y + dy };
+        }
+
+        // returns the transform without the translation
+        [[nodiscard]] constexpr AffineTransform getLinearPart() const noexcept
+        {
+            return { xx, xy, yx, yy, 0, 0 };
+        }
+
+        [[nodiscard]] constexpr float_type getDeterminant() const noexcept
+        {
+            return xx * yy - xy * yx;
+        }
+
+        // If getDeterminant() == 0, the result's values are not finite.
+        [[nodiscard]] constexpr AffineTransform inversed() const noexcept
+        {
+            const float_type determinant = getDeterminant();
+
+            const float_type ixx = yy / determinant;
+            const float_type ixy = -xy / determinant;
+            const float_type iyx = -yx / determinant;
+            const float_type iyy = xx / determinant;
+
+            return { ixx, ixy, iyx, iyy, -(ixx * dx + ixy * dy), -(iyx * dx + iyy * dy) };
+        }
+    };
+
+    // returns the transform which applies `rhs` and then `lhs`
+    [[nodiscard]] constexpr AffineTransform operator*(const AffineTransform& lhs, const AffineTransform& rhs) noexcept
+    {
+        return {
+            lhs.xx * rhs.xx + lhs.xy * rhs.yx,
+            lhs.xx * rhs.xy + lhs.xy * rhs.yy,
+            lhs.yx * rhs.xx + lhs.yy * rhs.yx,
+            lhs.yx * rhs.xy + lhs.yy * rhs.yy,
+            lhs.xx * rhs.dx + lhs.xy * rhs.dy + lhs.dx,
+            lhs.yx * rhs.dx + lhs.yy * rhs.dy + lhs.dy
+        };
+    }
+
+    constexpr bool operator==(const AffineTransform& lhs, const AffineTransform& rhs) noexcept
+    {
+        return (lhs.xx == rhs.xx) && (lhs.xy == rhs.xy) && (lhs.yx == rhs.yx) && (lhs.yy == rhs.yy) &&
+               (lhs.dx == rhs.dx) && (lhs.dy == rhs.dy);
+    }
+
+    constexpr bool operator!=(const AffineTransform& lhs, const AffineTransform& rhs) noexcept
+    {
+        return (!(lhs == rhs));
+    }
+
+
+    // Returns the area which pixels belong to both `lhs` and `rhs`.
+    // If there are no such pixels, returned area has zero width and height.
+    [[nodiscard]] constexpr IntegralRectArea getIntersectionOf(const IntegralRectArea& lhs, const IntegralRectArea& rhs) noexcept
+    {
+        using wide_int = long long;
+
+        const auto left = (std::max)(static_cast<wide_int>(lhs.topLeft.x), static_cast<wide_int>(rhs.topLeft.x));
+        const auto top = (std::min)(static_cast<wide_int>(lhs.topLeft.y), static_cast<wide_int>(rhs.topLeft.y));
+
+        // exclusive bounds
+        const auto right = (std::min)(
+            static_cast<wide_int>(lhs.topLeft.x) + static_cast<wide_int>(lhs.width),
+            static_cast<wide_int>(rhs.topLeft.x) + static_cast<wide_int>(rhs.width)
+        );
+        const auto bottom = (std::max)(
+            static_cast<wide_int>(lhs.topLeft.y) - static_cast<wide_int>(lhs.height),
+            static_cast<wide_int>(rhs.topLeft.y) - static_cast<wide_int>(rhs.height)
+        );
+
+        if ((left >= right) || (top <= bottom))
+            return { { static_cast<int_type>(left), static_cast<int_type>(top) }, 0, 0 };
+
+        return {
+            { static_cast<int_type>(left), static_cast<int_type>(top) },
+            static_cast<size_type>(right - left),
+            static_cast<size_type>(top - bottom)
+        };
+    }
 } // namespace mglass
 
 #endif // ndef MAGNIFYING_GLASS_PRIMITIVES_H
@@ -0,0 +1,376 @@
+#ifndef MAGNIFYING_GLASS_RASTERIZED_SPANS_H
+#define MAGNIFYING_GLASS_RASTERIZED_SPANS_H
+
+#include "mglass/primitives.h"  // Point, IntegralRectArea, int_type, size_type, float_type
+#include "mglass/shape.h"       // Shape, BlockCoverage, RasterizationContextBase, RasterizationSpanBase, getShapeIntegralBounds
+#include <algorithm>            // std::max, std::min, std::stable_sort, std::all_of
+#include <cstddef>              // std::ptrdiff_t
+#include <cstdint>              // std::uint8_t
+#include <type_traits>          // std::enable_if_t, std::is_same_v
+#include <utility>              // std::forward
+#include <vector>               // std::vector
+
+
+// Storage of shapes rasterized once and rasterized again at other positions
+//  (see mglass::MagnifierPlan and mglass::ShapeMask).
+namespace mglass::detail
+{
+    // converts a value stored for a pixel of RasterizedSpans into the pixel's density
+    [[nodiscard]] inline float_type getDensityOf(const float_type density) noexcept
+    {
+        return density;
+    }
+
+    // the 8-bit coverage of a pixel is (density * 255)
+    [[nodiscard]] inline float_type getDensityOf(const std::uint8_t coverage) noexcept
+    {
+        return static_cast<float_type>(coverage) / 255;
+    }
+
+
+    class RasterizedPointContext final : public RasterizationContextBase<RasterizedPointContext>
+    {
+        // for accessing to getRasterizedPointImpl(), getPixelDensityImpl() from base
+        friend struct RasterizationContextBase<RasterizedPointContext>;
+
+    public:
+        RasterizedPointContext(Point<int_type> rasterizedPoint, float_type density) noexcept
+            : rasterizedPoint_(rasterizedPoint)
+            , density_(density)
+        {}
+
+    private: // RasterizationContextBase<RasterizedPointContext> implementation
+        Point<int_type> getRasterizedPointImpl() const noexcept { return rasterizedPoint_; }
+        float_type getPixelDensityImpl() const noexcept { return density_; }
+
+    private:
+        Point<int_type> rasterizedPoint_;
+        float_type density_;
+    };
+
+
+    // A span of RasterizedSpans, the Value of the pixel x is values[x - xBegin].
+    // If the values are not stored, densities of all the pixels are 1.
+    template<typename Value>
+    class RasterizedSpan final : public RasterizationSpanBase<RasterizedSpan<Value>>
+    {
+        // for accessing to get*Impl() from base
+        friend struct RasterizationSpanBase<RasterizedSpan<Value>>;
+
+    public:
+        RasterizedSpan(int_type y, int_type xBegin, int_type xEnd, const Value* values) noexcept
+            : y_(y)
+            , xBegin_(xBegin)
+            , xEnd_(xEnd)
+            , values_(values)
+        {}
+
+        // returns the 8-bit coverages of the pixels starting at getXBegin() (the magnifiers blend them directly)
+        template<typename V = Value, typename = std::enable_if_t<std::is_same_v<V, std::uint8_t>>>
+        [[nodiscard]] const std::uint8_t* getPixelCoverages() const noexcept
+        {
+            return values_;
+        }
+
+    private: // RasterizationSpanBase<RasterizedSpan> implementation
+        int_type getYImpl() const noexcept { return y_; }
+        int_type getXBeginImpl() const noexcept { return xBegin_; }
+        int_type getXEndImpl() const noexcept { return xEnd_; }
+
+        float_type getPixelDensityAtImpl(int_type x) const noexcept
+        {
+            return (values_ != nullptr) ? getDensityOf(values_[x - xBegin_]) : 1;
+        }
+
+    private:
+        int_type y_;
+        int_type xBegin_;
+        int_type xEnd_;
+        const Value* values_;   // of the pixel xBegin_
+    };
+
+
+    // The spans of a shape and the Values of their pixels (float_type densities or std::uint8_t coverages).
+    template<typename Value>
+    class RasterizedSpans final
+    {
+    public: // ctors/dtor
+        // no spans
+        RasterizedSpans() = default;
+
+        // Rasterizes the `shape` onto its integral bounds.
+        // If `storeValues` == true, the Value of each pixel is `valueOf`(density of the pixel).
+        template<typename ShapeImpl, typename RastrCtx, typename ValueOfDensity>
+        RasterizedSpans(const Shape<ShapeImpl, RastrCtx>& shape, bool storeValues, const ValueOfDensity& valueOf);
+
+    public: // getters
+        [[nodiscard]] bool hasValues() const noexcept { return !values_.empty(); }
+
+        // returns getShapeIntegralBounds of the rasterized shape moved by `offset`
+        [[nodiscard]] IntegralRectArea getIntegralBounds(const Point<int_type> offset = {0, 0}) const noexcept
+        {
+            return { { integralBounds_.topLeft.x + offset.x, integralBounds_.topLeft.y + offset.y },
+                     integralBounds_.width,
+                     integralBounds_.height };
+        }
+
+        // Calls `consumer`(RasterizedSpan<Value>) for the parts of the spans moved by `offset` inside the `rect`.
+        // The spans are passed in the order of the built-in shapes (see Shape::rasterizeSpansOnto).
+        template<typename ConsumerFunctor>
+        void forEachSpanInside(const IntegralRectArea& rect, Point<int_type> offset, ConsumerFunctor&& consumer) const;
+
+        // Classifies the `block` (see Shape::classifyBlock) by the spans moved by `offset`:
+        //  the block is Inside if the spans of each its row cover it without gaps and the densities of their pixels
+        //  inside the block are 1.
+        [[nodiscard]] BlockCoverage classifyBlock(const IntegralRectArea& block, Point<int_type> offset) const noexcept;
+
+    private:
+        struct StoredSpan final
+        {
+            int_type y;
+            int_type xBegin;
+            int_type xEnd;
+            size_type valuesOffset; // the Value of the pixel x is values_[valuesOffset + x - xBegin]
+        };
+
+    private:
+        IntegralRectArea integralBounds_{ {0, 0}, 0, 0 };
+
+        // ordered by decreasing y and then by increasing x
+        std::vector<StoredSpan> spans_;
+        // the spans of the row (integralBounds_.topLeft.y - i) are [rowsSpans_[i]; rowsSpans_[i + 1])
+        std::vector<size_type> rowsSpans_;
+        // empty if the values are not stored
+        std::vector<Value> values_;
+    };
+
+
+    // RasterizedSpans moved by an integral offset, it is a shape, so the magnifiers can rasterize it.
+    // The `spans` must outlive this.
+    template<typename Value>
+    class MovedRasterizedSpans final : public Shape<MovedRasterizedSpans<Value>, RasterizedPointContext>
+    {
+        friend struct Shape<MovedRasterizedSpans<Value>, RasterizedPointContext>;
+
+    public:
+        MovedRasterizedSpans(const RasterizedSpans<Value>& spans, Point<int_type> offset) noexcept
+            : spans_(spans)
+            , offset_(offset)
+        {}
+
+    private: // Shape<MovedRasterizedSpans> implementation
+        // getShapeIntegralBounds of these bounds is RasterizedSpans::getIntegralBounds(offset_)
+        [[nodiscard]] ShapeRectArea getBoundsImpl() const noexcept
+        {
+            const IntegralRectArea bounds = spans_.getIntegralBounds(offset_);
+
+            return {
+                { static_cast<float_type>(bounds.topLeft.x), static_cast<float_type>(bounds.topLeft.y) },
+                static_cast<float_type>((std::max)(bounds.width, size_type{1}) - 1),
+                static_cast<float_type>((std::max)(bounds.height, size_type{1}) - 1)
+            };
+        }
+
+        [[nodiscard]] BlockCoverage classifyBlockImpl(const IntegralRectArea& block) const noexcept
+        {
+            return spans_.classifyBlock(block, offset_);
+        }
+
+        template<typename ConsumerFunctor>
+        void rasterizeOntoImpl(IntegralRectArea rect, ConsumerFunctor&& consumer) const
+        {
+            spans_.forEachSpanInside(rect, offset_, [&consumer](const RasterizedSpan<Value>& span) {
+                for (int_type x = span.getXBegin(); x < span.getXEnd(); ++x)
+                {
+                    (void)std::forward<ConsumerFunctor>(consumer)(
+                        RasterizedPointContext{ { x, span.getY() }, span.getPixelDensityAt(x) }
+                    );
+                }
+            });
+        }
+
+        template<typename ConsumerFunctor>
+        void rasterizeSpansOntoImpl(IntegralRectArea rect, ConsumerFunctor&& consumer) const
+        {
+            spans_.forEachSpanInside(rect, offset_, std::forward<ConsumerFunctor>(consumer));
+        }
+
+    private:
+        const RasterizedSpans<Value>& spans_;
+        Point<int_type> offset_;
+    };
+
+
+    // ================================================================================================================
+    //  RasterizedSpans
+    // ================================================================================================================
+
+    template<typename Value>
+    template<typename ShapeImpl, typename RastrCtx, typename ValueOfDensity>
+    RasterizedSpans<Value>::RasterizedSpans(
+        const Shape<ShapeImpl, RastrCtx>& shape,
+        const bool storeValues,
+        const ValueOfDensity& valueOf)
+        : integralBounds_(getShapeIntegralBounds(shape))
+    {
+        // the densities of the current span
+        std::vector<float_type> densities;
+
+        shape.rasterizeSpansOnto(integralBounds_, [&](const auto& span) {
+            const int_type xBegin = span.getXBegin();
+            const int_type xEnd = span.getXEnd();
+
+            spans_.push_back({ span.getY(), xBegin, xEnd, values_.size() });
+
+            if (storeValues)
+            {
+                densities.resize(static_cast<size_type>(xEnd - xBegin));
+                span.getPixelDensitiesOf(xBegin, xEnd, densities.data());
+
+                for (const float_type density : densities)
+                    values_.push_back(valueOf(density));
+            }
+        });
+
+        // shapes are not required to emit the spans in order
+        std::stable_sort(spans_.begin(), spans_.end(), [](const StoredSpan& lhs, const StoredSpan& rhs) {
+            return (lhs.y > rhs.y) || ( (lhs.y == rhs.y) && (lhs.xBegin < rhs.xBegin) );
+        });
+
+        rowsSpans_.resize(integralBounds_.height + 1);
+
+        size_type spanIndex = 0;
+        for (size_type row = 0; row < integralBounds_.height; ++row)
+        {
+            const int_type y = integralBounds_.topLeft.y - static_cast<int_type>(row);
+
+            rowsSpans_[row] = spanIndex;
+            while ( (spanIndex < spans_.size()) && (spans_[spanIndex].y == y) )
+                ++spanIndex;
+        }
+        rowsSpans_[integralBounds_.height] = spanIndex;
+    }
+
+
+    template<typename Value>
+    template<typename ConsumerFunctor>
+    void RasterizedSpans<Value>::forEachSpanInside(
+        const IntegralRectArea& rect,
+        const Point<int_type> offset,
+        ConsumerFunctor&& consumer) const
+    {
+        if ( (rect.width < 1) || (rect.height < 1) || spans_.empty() )
+            return;
+
+        // `rect` in the coordinates of the rasterized shape
+        const int_type rectXBegin = rect.topLeft.x - offset.x;
+        const int_type rectXEnd = rectXBegin + static_cast<int_type>(rect.width);
+        const int_type rectYTop = rect.topLeft.y - offset.y;
+
+        const int_type boundsTop = integralBounds_.topLeft.y;
+        const auto rowsCount = static_cast<int_type>(integralBounds_.height);
+
+        // the row i is at y = boundsTop - i
+        const int_type rowBegin = (std::max)(boundsTop - rectYTop, int_type{0});
+        const int_type rowEnd = (std::min)(boundsTop - rectYTop + static_cast<int_type>(rect.height), rowsCount);
+
+        for (int_type row = rowBegin; row < rowEnd; ++row)
+        {
+            const auto rowIndex = static_cast<size_type>(row);
+
+            for (size_type i = rowsSpans_[rowIndex]; i < rowsSpans_[rowIndex + 1]; ++i)
+            {
+                const StoredSpan& span = spans_[i];
+
+                const int_type xBegin = (std::max)(span.xBegin, rectXBegin);
+                const int_type xEnd = (std::min)(span.xEnd, rectXEnd);
+
+                if (xBegin >= xEnd)
+                    continue;
+
+                const Value* const values = values_.empty()
+                    ? nullptr
+                    : values_.data() + span.valuesOffset + static_cast<size_type>(xBegin - span.xBegin);
+
+                (void)std::forward<ConsumerFunctor>(consumer)(
+                    RasterizedSpan<Value>{ span.y + offset.y, xBegin + offset.x, xEnd + offset.x, values }
+                );
+            }
+        }
+    }
+
+
+    template<typename Value>
+    BlockCoverage RasterizedSpans<Value>::classifyBlock(const IntegralRectArea& block, const Point<int_type> offset) const noexcept
+    {
+        if ( (block.width < 1) || (block.height < 1) || spans_.empty() )
+            return BlockCoverage::Outside;
+
+        // `block` in the coordinates of the rasterized shape
+        const int_type blockXBegin = block.topLeft.x - offset.x;
+        const int_type blockXEnd = blockXBegin + static_cast<int_type>(block.width);
+        const int_type blockYTop = block.topLeft.y - offset.y;
+
+        const int_type boundsTop = integralBounds_.topLeft.y;
+        const auto rowsCount = static_cast<int_type>(integralBounds_.height);
+
+        // the row i is at y = boundsTop - i
+        const int_type blockRowBegin = boundsTop - blockYTop;
+        const int_type blockRowEnd = blockRowBegin + static_cast<int_type>(block.height);
+        const int_type rowBegin = (std::max)(blockRowBegin, int_type{0});
+        const int_type rowEnd = (std::min)(blockRowEnd, rowsCount);
+
+        // the rows of the block outside of the bounds have no pixels
+        bool isSolid = (rowBegin == blockRowBegin) && (rowEnd == blockRowEnd);
+        bool isEmpty = true;
+
+        for (int_type row = rowBegin; row < rowEnd; ++row)
+        {
+            const auto rowIndex = static_cast<size_type>(row);
+
+            // the pixels [blockXBegin; solidEnd) of the row are covered by the solid pixels
+            int_type solidEnd = blockXBegin;
+
+            for (size_type i = rowsSpans_[rowIndex]; i < rowsSpans_[rowIndex + 1]; ++i)
+            {
+                const StoredSpan& span = spans_[i];
+
+                const int_type xBegin = (std::max)(span.xBegin, blockXBegin);
+                const int_type xEnd = (std::min)(span.xEnd, blockXEnd);
+
+                if (xBegin >= xEnd)
+                    continue;
+
+                isEmpty = false;
+
+                if (!isSolid || (xBegin != solidEnd))
+                    break;
+
+                if (!values_.empty())
+                {
+                    const auto valuesBegin = values_.begin() + static_cast<std::ptrdiff_t>(span.valuesOffset)
+                                                             + (xBegin - span.xBegin);
+                    const auto valuesEnd = valuesBegin + (xEnd - xBegin);
+
+                    if (!std::all_of(valuesBegin, valuesEnd, [](const Value value) { return (getDensityOf(value) == 1); }))
+                        break;
+                }
+
+                solidEnd = xEnd;
+            }
+
+            if (solidEnd != blockXEnd)
+                isSolid = false;
+
+            if (!isEmpty && !isSolid)
+                return BlockCoverage::Edge;
+        }
+
+        if (isEmpty)
+            return BlockCoverage::Outside;
+
+        return isSolid ? BlockCoverage::Inside : BlockCoverage::Edge;
+    }
+} // namespace mglass::detail
+
+#endif // ndef MAGNIFYING_GLASS_RASTERIZED_SPANS_H
@@ -2,6 +2,7 @@
 #define MAGNIFYING_GLASS_RECTANGLE_SHAPE_H
 
 #include "mglass/shape.h"
+#include "mglass/falloff_profile.h" // FalloffProfile
 #include <utility>              // std::forward
 #include <algorithm>            // std::min, std::max
 #include <cassert>              // assert
@@ -21,11 +22,13 @@ namespace mglass::shapes
                 Point<int_type> rasterizedPoint,
                 Point<float_type> rectCenter,
                 float_type rectWidth,
-                float_type rectHeight) noexcept
+                float_type rectHeight,
+                const FalloffProfile* falloff) noexcept
                 : rasterizedPoint_(rasterizedPoint)
                 , rectCenter_(rectCenter)
                 , rectWidth_(rectWidth)
                 , rectHeight_(rectHeight)
+                , falloff_(falloff)
             {}
 
         private: // RasterizationContextBase<RectangleRastrContext> implementation
@@ -45,7 +48,7 @@ namespace mglass::shapes
                 assert( ((relXLength >= 0_flt) && (relXLength <= 1_flt)) );
                 assert( ((relYLength >= 0_flt) && (relYLength <= 1_flt)) );
 
-                return std::pow(relXLength * relYLength, 1_flt / 5_flt);
+                return falloff_->getDensityAt(relXLength * relYLength);
             }
 
         private:
@@ -53,6 +56,57 @@ namespace mglass::shapes
             Point<float_type> rectCenter_;
             float_type rectWidth_;
             float_type rectHeight_;
+            const FalloffProfile* falloff_;
+        };
+
+
+        class RectangleRastrSpan final : public RasterizationSpanBase<RectangleRastrSpan>
+        {
+            // for accessing to get*Impl() from base
+            friend struct RasterizationSpanBase<RectangleRastrSpan>;
+
+        public:
+            RectangleRastrSpan(
+                int_type y,
+                int_type xBegin,
+                int_type xEnd,
+                Point<float_type> rectCenter,
+                float_type rectWidth,
+                float_type rectHeight,
+                const FalloffProfile* falloff) noexcept
+                : y_(y)
+                , xBegin_(xBegin)
+                , xEnd_(xEnd)
+                , rectCenter_(rectCenter)
+                , rectWidth_(rectWidth)
+                , rectHeight_(rectHeight)
+                , falloff_(falloff)
+            {}
+
+            // returns the rasterization context of the pixel (`x`, getY())
+            [[nodiscard]] RectangleRastrContext getContextAt(int_type x) const noexcept
+            {
+                return { { x, y_ }, rectCenter_, rectWidth_, rectHeight_, falloff_ };
+            }
+
+        private: // RasterizationSpanBase<RectangleRastrSpan> implementation
+            int_type getYImpl() const noexcept { return y_; }
+            int_type getXBeginImpl() const noexcept { return xBegin_; }
+            int_type getXEndImpl() const noexcept { return xEnd_; }
+
+            float_type getPixelDensityAtImpl(int_type x) const noexcept
+            {
+                return getContextAt(x).getPixelDensity();
+            }
+
+        private:
+            int_type y_;
+            int_type xBegin_;
+            int_type xEnd_;
+            Point<float_type> rectCenter_;
+            float_type rectWidth_;
+            float_type rectHeight_;
+            const FalloffProfile* falloff_;
         };
     } // namespace detail
 
@@ -61,24 +115,61 @@ namespace mglass::shapes
     {
         friend struct Shape<Rectangle, detail::RectangleRastrContext>;
 
+    public:
+        using RasterizationSpan = detail::RectangleRastrSpan;
+
     public: // ctors/dtor
+        // the `falloff` must outlive the rectangle (the built-in profiles live until the program exits)
         explicit Rectangle(
             Point<float_type> center = {0, 0},
             float_type width = 0,
-            float_type height = 0) noexcept;
+            float_type height = 0,
+            const FalloffProfile& falloff = FalloffProfile::fifthRoot()) noexcept;
+
+        // rejects the temporary profiles which would be destroyed before the rectangle is used
+        Rectangle(
+            Point<float_type> center,
+            float_type width,
+            float_type height,
+            const FalloffProfile&& falloff) = delete;
 
         ~Rectangle() noexcept = default;
 
+    public: // getters
+        [[nodiscard]] const FalloffProfile& getFalloffProfile() const noexcept { return *falloff_; }
+
+    public: // comparison
+        // the profiles are compared by their identifiers (see FalloffProfile::getId)
+        [[nodiscard]] bool operator==(const Rectangle& rhs) const noexcept
+        {
+            return (center_ == rhs.center_) && (width_ == rhs.width_) && (height_ == rhs.height_) &&
+                   (falloff_->getId() == rhs.falloff_->getId());
+        }
+
     protected:
         Point<float_type> center_;
         float_type width_;
         float_type height_;
+        const FalloffProfile* falloff_;
 
     private: // Shape<Rectangle> implementation
         [[nodiscard]] ShapeRectArea getBoundsImpl() const noexcept;
 
+        [[nodiscard]] BlockCoverage classifyBlockImpl(const IntegralRectArea& block) const noexcept;
+
         template<typename ConsumerFunctor>
         void rasterizeOntoImpl(IntegralRectArea rect, ConsumerFunctor&& consumer) const
+        {
+            rasterizeSpansOntoImpl(rect, [&consumer](const detail::RectangleRastrSpan& span) {
+                for (int_type x = span.getXBegin(); x < span.getXEnd(); ++x)
+                {
+                    (void)std::forward<ConsumerFunctor>(consumer)(span.getContextAt(x));
+                }
+            });
+        }
+
+        template<typename ConsumerFunctor>
+        void rasterizeSpansOntoImpl(IntegralRectArea rect, ConsumerFunctor&& consumer) const
         {
             using literals::operator""_flt;
 
@@ -137,12 +228,9 @@ namespace mglass::shapes
 
             for (int_type y = yStart; y > yEnd; --y)
             {
-                for (int_type x = xStart; x < xEnd; ++x)
-                {
-                    (void)std::forward<ConsumerFunctor>(consumer)(
-                        detail::RectangleRastrContext{ {x, y}, center_, width_, height_ }
-                    );
-                }
+                (void)std::forward<ConsumerFunctor>(consumer)(
+                    detail::RectangleRastrSpan{ y, xStart, xEnd, center_, width_, height_, falloff_ }
+                );
             }
         }
     };
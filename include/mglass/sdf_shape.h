@@ -0,0 +1,432 @@
+#ifndef MAGNIFYING_GLASS_SDF_SHAPE_H
+#define MAGNIFYING_GLASS_SDF_SHAPE_H
+
+#include "mglass/primitives.h"          // Point, IntegralRectArea, getIntersectionOf, int_type, size_type, float_type
+#include "mglass/shape.h"               // Shape, BlockCoverage, getShapeIntegralBounds
+#include "mglass/rasterized_spans.h"    // RasterizedPointContext, RasterizedSpan
+#include <algorithm>                    // std::min, std::max
+#include <array>                        // std::array
+#include <cmath>                        // std::abs, std::sqrt, std::pow
+#include <limits>                       // std::numeric_limits
+#include <memory>                       // std::shared_ptr, std::make_shared
+#include <utility>                      // std::forward, std::move
+#include <vector>                       // std::vector
+
+
+namespace mglass::shapes
+{
+    // The signed distance functions of some shapes for SdfShape.
+    // The distances are in pixels, negative inside the shape and positive outside of it;
+    //  the points are relative to the center of the shape.
+    // The functions are compared by their parameters, so the shapes with equal functions share the masks
+    //  of ShapeMaskCache.
+    namespace sdf
+    {
+        // The rectangle halfWidth * 2 x halfHeight * 2 with the corners rounded by `radius`
+        //  (radius <= (std::min)(halfWidth, halfHeight)).
+        struct RoundedRectangle
+        {
+            float_type halfWidth;
+            float_type halfHeight;
+            float_type radius;
+
+            [[nodiscard]] bool operator==(const RoundedRectangle& rhs) const noexcept
+            {
+                return (halfWidth == rhs.halfWidth) &&
+                       (halfHeight == rhs.halfHeight) &&
+                       (radius == rhs.radius);
+            }
+
+            [[nodiscard]] float_type operator()(const Point<float_type> p) const noexcept
+            {
+                // the distances to the rectangle whose corners are the centers of the rounding circles
+                const float_type qx = std::abs(p.x) - (halfWidth - radius);
+                const float_type qy = std::abs(p.y) - (halfHeight - radius);
+
+                const float_type outsideX = (std::max)(qx, float_type{0});
+                const float_type outsideY = (std::max)(qy, float_type{0});
+
+                const float_type outside = std::sqrt(outsideX * outsideX + outsideY * outsideY);
+                const float_type inside = (std::min)((std::max)(qx, qy), float_type{0});
+
+                return outside + inside - radius;
+            }
+        };
+
+        // The rectangle halfWidth * 2 x halfHeight * 2 whose shorter sides are semicircles.
+        struct Stadium
+        {
+            float_type halfWidth;
+            float_type halfHeight;
+
+            [[nodiscard]] bool operator==(const Stadium& rhs) const noexcept
+            {
+                return (halfWidth == rhs.halfWidth) &&
+                       (halfHeight == rhs.halfHeight);
+            }
+
+            [[nodiscard]] float_type operator()(const Point<float_type> p) const noexcept
+            {
+                return RoundedRectangle{ halfWidth, halfHeight, (std::min)(halfWidth, halfHeight) }(p);
+            }
+        };
+
+        // The disk of the radius `outerRadius` without the disk of the radius `innerRadius` (innerRadius <= outerRadius).
+        struct Ring
+        {
+            float_type outerRadius;
+            float_type innerRadius;
+
+            [[nodiscard]] bool operator==(const Ring& rhs) const noexcept
+            {
+                return (outerRadius == rhs.outerRadius) &&
+                       (innerRadius == rhs.innerRadius);
+            }
+
+            [[nodiscard]] float_type operator()(const Point<float_type> p) const noexcept
+            {
+                const float_type middleRadius = (outerRadius + innerRadius) / 2;
+                const float_type halfThickness = (outerRadius - innerRadius) / 2;
+
+                return std::abs(std::sqrt(p.x * p.x + p.y * p.y) - middleRadius) - halfThickness;
+            }
+        };
+
+        // The superellipse |x / halfWidth|^exponent + |y / halfHeight|^exponent <= 1 (exponent >= 2).
+        // The distance is a lower bound of the exact one (it's exact at the ends of the shorter axis),
+        //  so the edge is a bit softer along the longer axis.
+        struct Superellipse
+        {
+            float_type halfWidth;
+            float_type halfHeight;
+            float_type exponent;
+
+            [[nodiscard]] bool operator==(const Superellipse& rhs) const noexcept
+            {
+                return (halfWidth == rhs.halfWidth) &&
+                       (halfHeight == rhs.halfHeight) &&
+                       (exponent == rhs.exponent);
+            }
+
+            [[nodiscard]] float_type operator()(const Point<float_type> p) const noexcept
+            {
+                // the norm is (1 / min(halfWidth, halfHeight))-Lipschitz since exponent >= 2
+                const float_type norm = std::pow(
+                    std::pow(std::abs(p.x / halfWidth), exponent) + std::pow(std::abs(p.y / halfHeight), exponent),
+                    1 / exponent
+                );
+
+                return (norm - 1) * (std::min)(halfWidth, halfHeight);
+            }
+        };
+    } // namespace sdf
+
+
+    // The SdfShape class turns a signed distance function into a shape placed at the `center`.
+    // DistanceFunction must have the method `float_type operator()(Point<float_type> p) const noexcept`
+    //  which returns the signed distance (in pixels) from the point `p` (relative to the center) to the edge
+    //  of the shape: negative inside the shape and positive outside of it (see the sdf namespace).
+    // The function must be 1-Lipschitz (it's true for the exact distances), the blocks of the pixels are culled
+    //  by the distance at their centers.
+    //
+    // A pixel is rasterized if the distance d at its center is less than 0.5, its density is (0.5 - d)
+    //  clamped by 1 (i.e. the edge of the shape is antialiased by the approximate coverage of the pixel).
+    // The shape must be inside the rectangle width x height with the same center.
+    //
+    // The pixels are rasterized by the tiles tileSize x tileSize aligned to the multiples of tileSize.
+    // The quadtree of a tile is descended only at the edge of the shape (the blocks fully outside or inside it
+    //  are classified by a single distance), so the count of the evaluations of the function is proportional
+    //  to the perimeter of the shape. The tiles do not depend on the rasterized area, so the densities
+    //  of the pixels are the same for any area.
+    //
+    // ShapeMaskCache reuses the masks of the shapes whose distance functions are equal if DistanceFunction
+    //  has operator== (like the functions of the sdf namespace). Otherwise (e.g. for lambdas) only the shapes
+    //  sharing the function share the masks, so the shapes rebuilt for each frame must be constructed
+    //  from the same std::shared_ptr to the function.
+    template<typename DistanceFunction>
+    class SdfShape : public Shape<SdfShape<DistanceFunction>, mglass::detail::RasterizedPointContext>
+    {
+        friend struct Shape<SdfShape<DistanceFunction>, mglass::detail::RasterizedPointContext>;
+
+    public:
+        using RasterizationSpan = mglass::detail::RasterizedSpan<float_type>;
+
+        static constexpr int_type tileSize = 16;
+        // the pixels of the blocks of this size at the edge of the shape are evaluated one by one
+        static constexpr int_type leafSize = 2;
+
+    public: // ctors/dtor
+        explicit SdfShape(
+            Point<float_type> center = {0, 0},
+            float_type width = 0,
+            float_type height = 0,
+            DistanceFunction distance = {})
+            : SdfShape(center, width, height, std::make_shared<const DistanceFunction>(std::move(distance)))
+        {}
+
+        // `distance` must not be nullptr
+        SdfShape(
+            Point<float_type> center,
+            float_type width,
+            float_type height,
+            std::shared_ptr<const DistanceFunction> distance) noexcept
+            : center_(center)
+            , width_(width)
+            , height_(height)
+            , distance_(std::move(distance))
+        {}
+
+        ~SdfShape() noexcept = default;
+
+    public: // getters
+        [[nodiscard]] Point<float_type> getCenter() const noexcept { return center_; }
+
+        [[nodiscard]] const DistanceFunction& getOutline() const noexcept { return *distance_; }
+        // the distance function shared by the copies of the shape
+        [[nodiscard]] const std::shared_ptr<const DistanceFunction>& getSharedOutline() const noexcept { return distance_; }
+
+    protected:
+        Point<float_type> center_;
+        float_type width_;
+        float_type height_;
+        std::shared_ptr<const DistanceFunction> distance_;
+
+    private:
+        // the pixels [xBegin; xEnd) of a row, their densities are values[valuesOffset...] or 1 if solid
+        struct Interval final
+        {
+            int_type xBegin;
+            int_type xEnd;
+            size_type valuesOffset;
+        };
+
+        static constexpr size_type solid = std::numeric_limits<size_type>::max();
+
+        // the intervals of the rows of a band of tiles, the row i is at y = top - i
+        struct Band final
+        {
+            int_type top;
+            // the rasterized area
+            IntegralRectArea area;
+            std::array<std::vector<Interval>, tileSize> intervals;
+            std::array<std::vector<float_type>, tileSize> values;
+        };
+
+    private: // Shape<SdfShape> implementation
+        [[nodiscard]] ShapeRectArea getBoundsImpl() const noexcept
+        {
+            return { { center_.x - width_ / 2, center_.y + height_ / 2 }, width_, height_ };
+        }
+
+        [[nodiscard]] BlockCoverage classifyBlockImpl(const IntegralRectArea& block) const noexcept
+        {
+            // the margin covers the rounding errors of the distances of the pixels
+            constexpr float_type margin = float_type{1} / 16;
+
+            if ((block.width < 1) || (block.height < 1))
+                return BlockCoverage::Edge;
+
+            const BlockCoverage result = classify(
+                block.topLeft.x, block.topLeft.y, static_cast<int_type>(block.width), static_cast<int_type>(block.height), margin
+            );
+
+            // the pixels outside the bounds are not rasterized
+            if ( (result == BlockCoverage::Inside) &&
+                 (getIntersectionOf(block, getShapeIntegralBounds(*this)) != block) )
+            {
+                return BlockCoverage::Edge;
+            }
+
+            return result;
+        }
+
+        template<typename ConsumerFunctor>
+        void rasterizeOntoImpl(IntegralRectArea rect, ConsumerFunctor&& consumer) const
+        {
+            rasterizeSpansOntoImpl(rect, [&consumer](const RasterizationSpan& span) {
+                for (int_type x = span.getXBegin(); x < span.getXEnd(); ++x)
+                {
+                    (void)std::forward<ConsumerFunctor>(consumer)(
+                        mglass::detail::RasterizedPointContext{ { x, span.getY() }, span.getPixelDensityAt(x) }
+                    );
+                }
+            });
+        }
+
+        template<typename ConsumerFunctor>
+        void rasterizeSpansOntoImpl(IntegralRectArea rect, ConsumerFunctor&& consumer) const
+        {
+            Band band{};
+            band.area = getIntersectionOf(getShapeIntegralBounds(*this), rect);
+
+            if ((band.area.width < 1) || (band.area.height < 1))
+                return;
+
+            const IntegralRectArea& area = band.area;
+            const int_type areaXEnd = area.topLeft.x + static_cast<int_type>(area.width);
+            const int_type areaYEnd = area.topLeft.y - static_cast<int_type>(area.height);
+
+            const int_type firstTileX = floorToTile(area.topLeft.x);
+
+            for (band.top = floorToTile(area.topLeft.y) + tileSize - 1; band.top > areaYEnd; band.top -= tileSize)
+            {
+                for (auto& rowIntervals : band.intervals)
+                    rowIntervals.clear();
+                for (auto& rowValues : band.values)
+                    rowValues.clear();
+
+                // the blocks are visited in Z-order, so the intervals of each row are appended from left to right
+                for (int_type tileX = firstTileX; tileX < areaXEnd; tileX += tileSize)
+                    rasterizeBlock(band, tileX, band.top, tileSize);
+
+                const int_type rowBegin = (std::max)(band.top - area.topLeft.y, int_type{0});
+                const int_type rowEnd = (std::min)(band.top - areaYEnd, tileSize);
+
+                for (int_type row = rowBegin; row < rowEnd; ++row)
+                {
+                    const auto rowIndex = static_cast<size_type>(row);
+
+                    for (const Interval& interval : band.intervals[rowIndex])
+                    {
+                        const float_type* const values = (interval.valuesOffset == solid)
+                            ? nullptr
+                            : band.values[rowIndex].data() + interval.valuesOffset;
+
+                        (void)std::forward<ConsumerFunctor>(consumer)(
+                            RasterizationSpan{ band.top - row, interval.xBegin, interval.xEnd, values }
+                        );
+                    }
+                }
+            }
+        }
+
+    private:
+        // returns the multiple of tileSize which is the nearest one not greater than `coordinate`
+        [[nodiscard]] static int_type floorToTile(const int_type coordinate) noexcept
+        {
+            const int_type remainder = coordinate % tileSize;
+            return coordinate - ((remainder < 0) ? (remainder + tileSize) : remainder);
+        }
+
+        [[nodiscard]] static float_type getDensityOf(const float_type distance) noexcept
+        {
+            using namespace literals;
+
+            // (NaN stays NaN, so such pixels are not rasterized)
+            return (std::min)((std::max)(0.5_flt - distance, 0_flt), 1_flt);
+        }
+
+        // returns the distance at the point (`x`; `y`)
+        [[nodiscard]] float_type getDistanceAt(const float_type x, const float_type y) const noexcept
+        {
+            return (*distance_)({ x - center_.x, y - center_.y });
+        }
+
+        // Classifies the block `width` x `height` with the top left pixel (`left`; `top`)
+        //  by the distance at its center: the distances at the pixels' centers differ from it
+        //  by the distance between the centers at most.
+        [[nodiscard]] BlockCoverage classify(
+            const int_type left,
+            const int_type top,
+            const int_type width,
+            const int_type height,
+            const float_type margin) const noexcept
+        {
+            using namespace literals;
+
+            const float_type halfWidth = static_cast<float_type>(width - 1) / 2;
+            const float_type halfHeight = static_cast<float_type>(height - 1) / 2;
+            const float_type radius = std::sqrt(halfWidth * halfWidth + halfHeight * halfHeight);
+
+            // +0.5 is for moving to the pixel's center
+            const float_type distance = getDistanceAt(
+                (static_cast<float_type>(left) + 0.5_flt) + halfWidth,
+                (static_cast<float_type>(top) + 0.5_flt) - halfHeight
+            );
+
+            if (distance - radius >= 0.5_flt + margin)
+                return BlockCoverage::Outside;
+            if (distance + radius <= -0.5_flt - margin)
+                return BlockCoverage::Inside;
+
+            return BlockCoverage::Edge;
+        }
+
+        // appends the intervals of the pixels of the block `size` x `size` with the top left pixel (`left`; `top`)
+        void rasterizeBlock(Band& band, const int_type left, const int_type top, const int_type size) const
+        {
+            using namespace literals;
+
+            const IntegralRectArea& area = band.area;
+
+            // the part of the block inside the area
+            const int_type xBegin = (std::max)(left, area.topLeft.x);
+            const int_type xEnd = (std::min)(left + size, area.topLeft.x + static_cast<int_type>(area.width));
+            const int_type yBegin = (std::min)(top, area.topLeft.y);
+            const int_type yEnd = (std::max)(top - size, area.topLeft.y - static_cast<int_type>(area.height));
+
+            if ((xBegin >= xEnd) || (yBegin <= yEnd))
+                return;
+
+            const BlockCoverage coverage = classify(left, top, size, size, 0);
+
+            if (coverage == BlockCoverage::Outside)
+                return;
+
+            if (coverage == BlockCoverage::Inside)
+            {
+                for (int_type y = yBegin; y > yEnd; --y)
+                {
+                    std::vector<Interval>& intervals = band.intervals[static_cast<size_type>(band.top - y)];
+
+                    if (!intervals.empty() && (intervals.back().valuesOffset == solid) && (intervals.back().xEnd == xBegin))
+                        intervals.back().xEnd = xEnd;
+                    else
+                        intervals.push_back({ xBegin, xEnd, solid });
+                }
+
+                return;
+            }
+
+            if (size > leafSize)
+            {
+                const int_type half = size / 2;
+
+                rasterizeBlock(band, left, top, half);
+                rasterizeBlock(band, left + half, top, half);
+                rasterizeBlock(band, left, top - half, half);
+                rasterizeBlock(band, left + half, top - half, half);
+
+                return;
+            }
+
+            for (int_type y = yBegin; y > yEnd; --y)
+            {
+                const auto rowIndex = static_cast<size_type>(band.top - y);
+                std::vector<Interval>& intervals = band.intervals[rowIndex];
+                std::vector<float_type>& values = band.values[rowIndex];
+
+                for (int_type x = xBegin; x < xEnd; ++x)
+                {
+                    // +0.5 is for moving to the pixel's center
+                    const float_type density = getDensityOf(getDistanceAt(
+                        static_cast<float_type>(x) + 0.5_flt,
+                        static_cast<float_type>(y) + 0.5_flt
+                    ));
+
+                    if (!(density > 0))
+                        continue;
+
+                    if (!intervals.empty() && (intervals.back().valuesOffset != solid) && (intervals.back().xEnd == x))
+                        intervals.back().xEnd = x + 1;
+                    else
+                        intervals.push_back({ x, x + 1, values.size() });
+
+                    values.push_back(density);
+                }
+            }
+        }
+    };
+} // namespace mglass::shapes
+
+#endif // ndef MAGNIFYING_GLASS_SDF_SHAPE_H
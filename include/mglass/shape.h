@@ -3,8 +3,8 @@
 
 #include "mglass/primitives.h"  // Point, RectArea, IntegralRectArea, int_type, size_type, float_type
 #include <cmath>                // std::ceil, std::floor
-#include <type_traits>          // std::is_invocable_v
-#include <utility>              // std::forward
+#include <type_traits>          // std::is_invocable_v, std::void_t
+#include <utility>              // std::forward, std::declval
 
 
 namespace mglass
@@ -52,6 +52,83 @@ namespace mglass
     };
 
 
+    // The RasterizationSpanBase interface provides definitions for information
+    //  about a horizontal run of pixels [getXBegin(); getXEnd()) at the row getY()
+    //  onto which points of a shape were rasterized (it is used at Shape::rasterizeSpansOnto).
+    //
+    // CRTP is used for the same reasons as in RasterizationContextBase.
+    template<typename Derived>
+    struct RasterizationSpanBase
+    {
+        // Returns y-coordinate of the row which contains the span.
+        [[nodiscard]] int_type getY() const noexcept
+        {
+            return static_cast<const Derived*>(this)->getYImpl();
+        }
+
+        // Returns x-coordinate of the first pixel of the span.
+        [[nodiscard]] int_type getXBegin() const noexcept
+        {
+            return static_cast<const Derived*>(this)->getXBeginImpl();
+        }
+
+        // Returns x-coordinate of the pixel following the last pixel of the span.
+        // getXEnd() is always greater than getXBegin().
+        [[nodiscard]] int_type getXEnd() const noexcept
+        {
+            return static_cast<const Derived*>(this)->getXEndImpl();
+        }
+
+        // Returns density of the pixel (`x`, getY()) (see RasterizationContextBase::getPixelDensity).
+        // Behaviour is undefined if `x` is not inside the range [getXBegin(); getXEnd()).
+        [[nodiscard]] float_type getPixelDensityAt(int_type x) const noexcept
+        {
+            return static_cast<const Derived*>(this)->getPixelDensityAtImpl(x);
+        }
+
+        // Writes the densities of the pixels [`xBegin`; `xEnd`) of the row into `densities`
+        //  (`densities`[0] is the density of the pixel `xBegin`).
+        // The densities are the same as the ones returned by getPixelDensityAt,
+        //  but the spans can calculate them by batches (e.g. via SIMD).
+        // Behaviour is undefined if [`xBegin`; `xEnd`) is not inside the range [getXBegin(); getXEnd()).
+        void getPixelDensitiesOf(int_type xBegin, int_type xEnd, float_type* densities) const noexcept
+        {
+            static_cast<const Derived*>(this)->getPixelDensitiesOfImpl(xBegin, xEnd, densities);
+        }
+
+    protected: // crtp methods implementation
+        [[noreturn]] int_type getYImpl() const noexcept
+        {
+            static_assert(detail::dependent_false_v<Derived>, "is not implemented");
+        }
+
+        [[noreturn]] int_type getXBeginImpl() const noexcept
+        {
+            static_assert(detail::dependent_false_v<Derived>, "is not implemented");
+        }
+
+        [[noreturn]] int_type getXEndImpl() const noexcept
+        {
+            static_assert(detail::dependent_false_v<Derived>, "is not implemented");
+        }
+
+        [[noreturn]] float_type getPixelDensityAtImpl([[maybe_unused]] int_type x) const noexcept
+        {
+            static_assert(detail::dependent_false_v<Derived>, "is not implemented");
+        }
+
+        void getPixelDensitiesOfImpl(const int_type xBegin, const int_type xEnd, float_type* densities) const noexcept
+        {
+            for (int_type x = xBegin; x < xEnd; ++x, ++densities)
+                *densities = getPixelDensityAt(x);
+        }
+
+    protected:
+        // dtor will not be invoked by the library
+        ~RasterizationSpanBase() noexcept = default;
+    };
+
+
     namespace detail
     {
         template<typename T>
@@ -64,9 +141,56 @@ namespace mglass
         {
             return false;
         }
+
+
+        // One-pixel span built from a RasterizationContext.
+        // It is used by the default implementation of Shape::rasterizeSpansOnto.
+        template<typename RasterizationContextT>
+        class PointRasterizationSpan final : public RasterizationSpanBase<PointRasterizationSpan<RasterizationContextT>>
+        {
+            // for accessing to get*Impl() from base
+            friend struct RasterizationSpanBase<PointRasterizationSpan<RasterizationContextT>>;
+
+        public:
+            explicit PointRasterizationSpan(const RasterizationContextBase<RasterizationContextT>& rastrCtx) noexcept
+                : rastrCtx_(rastrCtx)
+                , point_(rastrCtx.getRasterizedPoint())
+            {}
+
+        private: // RasterizationSpanBase<PointRasterizationSpan> implementation
+            int_type getYImpl() const noexcept { return point_.y; }
+            int_type getXBeginImpl() const noexcept { return point_.x; }
+            int_type getXEndImpl() const noexcept { return point_.x + 1; }
+
+            float_type getPixelDensityAtImpl([[maybe_unused]] int_type x) const noexcept
+            {
+                return rastrCtx_.getPixelDensity();
+            }
+
+        private:
+            const RasterizationContextBase<RasterizationContextT>& rastrCtx_;
+            Point<int_type> point_;
+        };
+
+
+        // true if the values of the type T can be compared by operator==
+        template<typename T, typename = void>
+        constexpr bool isEqualityComparable = false;
+
+        template<typename T>
+        constexpr bool isEqualityComparable<T, std::void_t<decltype(bool(std::declval<const T&>() == std::declval<const T&>()))>> = true;
     } // namespace detail
 
 
+    // The coverage of a block of pixels by a shape (see Shape::classifyBlock).
+    enum class BlockCoverage
+    {
+        Outside,    // no pixel of the block is rasterized
+        Edge,       // the block can have both rasterized and not rasterized pixels or densities less than 1
+        Inside      // all the pixels of the block are rasterized and their densities are 1
+    };
+
+
     // The Shape interface provides definitions for objects that represent some form of magnifying glass
     //  (e.g. rectangle or ellipse magnifying glass).
     //
@@ -103,6 +227,30 @@ namespace mglass
             static_cast<const Derived*>(this)->rasterizeOntoImpl(rect, std::forward<ConsumerFunctor>(consumer));
         }
 
+        // rasterizes this shape onto the area described by `rect` like rasterizeOnto does,
+        //  but `consumer` will be invoked on each horizontal span of the rasterized points instead of each point.
+        //  It must be invocable by a const reference to an object derived from RasterizationSpanBase.
+        // Spans do not overlap each other. Built-in shapes emit rows from the top (the greatest y) to the bottom
+        //  and spans of the same row from the left to the right.
+        // Returned values of the `consumer` will be ignored.
+        //
+        // Shapes which do not implement rasterizeSpansOntoImpl get one-pixel spans built from rasterizeOnto.
+        template<typename ConsumerFunctor>
+        void rasterizeSpansOnto(const IntegralRectArea& rect, ConsumerFunctor&& consumer) const
+        {
+            static_cast<const Derived*>(this)->rasterizeSpansOntoImpl(rect, std::forward<ConsumerFunctor>(consumer));
+        }
+
+        // Classifies the pixels of the `block` (see BlockCoverage) without rasterizing them,
+        //  so the blocks inside the shape can be processed without the per-pixel work.
+        // The classification is conservative: Edge is a valid result for any block.
+        //
+        // Shapes which do not implement classifyBlockImpl classify all the blocks as Edge.
+        [[nodiscard]] BlockCoverage classifyBlock(const IntegralRectArea& block) const noexcept
+        {
+            return static_cast<const Derived*>(this)->classifyBlockImpl(block);
+        }
+
     protected: // ctors/dtor
         constexpr Shape() noexcept = default;
 
@@ -122,6 +270,24 @@ namespace mglass
         {
             static_assert(detail::dependent_false_v<Derived>, "is not implemented");
         }
+
+        template<typename ConsumerFunctor>
+        void rasterizeSpansOntoImpl(IntegralRectArea rect, ConsumerFunctor&& consumer) const
+        {
+            static_cast<const Derived*>(this)->rasterizeOntoImpl(
+                rect,
+                [&consumer](const RasterizationContext& rastrCtx) {
+                    (void)std::forward<ConsumerFunctor>(consumer)(
+                        detail::PointRasterizationSpan<RasterizationContext>{ rastrCtx }
+                    );
+                }
+            );
+        }
+
+        [[nodiscard]] BlockCoverage classifyBlockImpl([[maybe_unused]] const IntegralRectArea& block) const noexcept
+        {
+            return BlockCoverage::Edge;
+        }
     };
 
 
@@ -0,0 +1,299 @@
+#ifndef MAGNIFYING_GLASS_SHAPE_MASK_H
+#define MAGNIFYING_GLASS_SHAPE_MASK_H
+
+#include "mglass/primitives.h"          // Point, IntegralRectArea, AffineTransform, int_type, size_type, float_type
+#include "mglass/shape.h"               // Shape, BlockCoverage, detail::isEqualityComparable
+#include "mglass/rasterized_spans.h"    // detail::RasterizedSpans, detail::MovedRasterizedSpans, detail::RasterizedPointContext
+#include "mglass/falloff_profile.h"     // FalloffProfile
+#include <algorithm>                    // std::min, std::max
+#include <cmath>                        // std::lround
+#include <cstdint>                      // std::uint8_t, std::uint64_t
+#include <memory>                       // std::shared_ptr, std::make_shared
+#include <type_traits>                  // std::void_t, std::decay_t, std::remove_cv_t
+#include <typeindex>                    // std::type_index
+#include <typeinfo>                     // typeid
+#include <utility>                      // std::forward, std::move, std::declval
+#include <vector>                       // std::vector
+
+
+namespace mglass
+{
+    namespace detail
+    {
+        // Returns the identifier of the falloff profile of the `shape` (see FalloffProfile::getId)
+        //  or 0 if the shape has no getFalloffProfile().
+        template<typename ShapeImpl, typename = void>
+        struct FalloffProfileIdOf final
+        {
+            [[nodiscard]] static std::uint64_t get(const ShapeImpl&) noexcept { return 0; }
+        };
+
+        template<typename ShapeImpl>
+        struct FalloffProfileIdOf<ShapeImpl, std::void_t<decltype(std::declval<const ShapeImpl&>().getFalloffProfile())>> final
+        {
+            [[nodiscard]] static std::uint64_t get(const ShapeImpl& shape) noexcept
+            {
+                return shape.getFalloffProfile().getId();
+            }
+        };
+
+        // compares the values of two outlines of the same type
+        using OutlinesEqualFunction = bool (*)(const void* lhs, const void* rhs);
+
+        // Returns the shared outline of the `shape` or nullptr if the shape has no getSharedOutline()
+        //  (the shapes of the same type and size are the same up to translation only if their outlines are the same).
+        // The owning pointer keeps the outline alive while it's a part of a key of ShapeMaskCache,
+        //  so another outline can not be allocated at its address.
+        // getEqualityFunction() returns the function comparing the values of the outlines if they have operator==
+        //  or nullptr if the outlines are the same only if they are shared.
+        template<typename ShapeImpl, typename = void>
+        struct OutlineOf final
+        {
+            [[nodiscard]] static std::shared_ptr<const void> get(const ShapeImpl&) noexcept { return nullptr; }
+            [[nodiscard]] static OutlinesEqualFunction getEqualityFunction() noexcept { return nullptr; }
+        };
+
+        template<typename ShapeImpl>
+        struct OutlineOf<ShapeImpl, std::void_t<decltype(std::declval<const ShapeImpl&>().getSharedOutline())>> final
+        {
+            using Outline = std::remove_cv_t<
+                typename std::decay_t<decltype(std::declval<const ShapeImpl&>().getSharedOutline())>::element_type
+            >;
+
+            [[nodiscard]] static std::shared_ptr<const void> get(const ShapeImpl& shape) noexcept
+            {
+                return shape.getSharedOutline();
+            }
+
+            [[nodiscard]] static OutlinesEqualFunction getEqualityFunction() noexcept
+            {
+                if constexpr (isEqualityComparable<Outline>)
+                {
+                    return [](const void* lhs, const void* rhs) {
+                        return bool(*static_cast<const Outline*>(lhs) == *static_cast<const Outline*>(rhs));
+                    };
+                }
+                else
+                {
+                    return nullptr;
+                }
+            }
+        };
+
+        // Returns the transform of the unit shape into the `shape` (see shapes::TransformedEllipse)
+        //  or the identity transform if the shape has no getUnitShapeTransform().
+        template<typename ShapeImpl, typename = void>
+        struct UnitShapeTransformOf final
+        {
+            [[nodiscard]] static AffineTransform get(const ShapeImpl&) noexcept { return {}; }
+        };
+
+        template<typename ShapeImpl>
+        struct UnitShapeTransformOf<ShapeImpl, std::void_t<decltype(std::declval<const ShapeImpl&>().getUnitShapeTransform())>> final
+        {
+            [[nodiscard]] static AffineTransform get(const ShapeImpl& shape) noexcept
+            {
+                return shape.getUnitShapeTransform().getLinearPart();
+            }
+        };
+    } // namespace detail
+
+
+    // The ShapeMask class is a shape rasterized once: its spans and the 8-bit coverages of their pixels
+    //  (a coverage is the density of a pixel multiplied by 255).
+    // The magnifiers blend the coverages directly instead of calculating the densities of the pixels
+    //  (see getPixelDensity of the shapes), so the results of alpha-blending can differ by 1 from the ones of the shape.
+    class ShapeMask final
+    {
+    public: // ctors/dtor
+        // the mask of an empty shape
+        ShapeMask() = default;
+
+        template<typename ShapeImpl, typename RastrCtx>
+        explicit ShapeMask(const Shape<ShapeImpl, RastrCtx>& shape)
+            : spans_(shape, true, [](const float_type density) {
+                const float_type coverage = (std::min)((std::max)(density, float_type{0}), float_type{1}) * 255;
+                return static_cast<std::uint8_t>(std::lround(coverage));
+            })
+        {}
+
+    public: // getters
+        // returns getShapeIntegralBounds of the masked shape moved by `offset`
+        [[nodiscard]] IntegralRectArea getIntegralBounds(Point<int_type> offset = {0, 0}) const noexcept
+        {
+            return spans_.getIntegralBounds(offset);
+        }
+
+        // Returns the mask moved by `offset` as a shape which can be passed to the magnifiers.
+        // This must outlive the returned object.
+        [[nodiscard]] detail::MovedRasterizedSpans<std::uint8_t> movedBy(Point<int_type> offset) const noexcept
+        {
+            return { spans_, offset };
+        }
+
+    private:
+        detail::RasterizedSpans<std::uint8_t> spans_;
+    };
+
+
+    // The PlacedShapeMask class is a shape which is a ShapeMask moved by an integral offset.
+    // It shares the ownership of the mask, so it stays valid even if the mask is evicted from a ShapeMaskCache.
+    class PlacedShapeMask final : public Shape<PlacedShapeMask, detail::RasterizedPointContext>
+    {
+        friend struct Shape<PlacedShapeMask, detail::RasterizedPointContext>;
+
+    public:
+        PlacedShapeMask(std::shared_ptr<const ShapeMask> mask, Point<int_type> offset) noexcept
+            : mask_(std::move(mask))
+            , offset_(offset)
+        {}
+
+        [[nodiscard]] const ShapeMask& getMask() const noexcept { return *mask_; }
+        [[nodiscard]] Point<int_type> getOffset() const noexcept { return offset_; }
+
+    private: // Shape<PlacedShapeMask> implementation
+        [[nodiscard]] ShapeRectArea getBoundsImpl() const noexcept
+        {
+            return mask_->movedBy(offset_).getBounds();
+        }
+
+        [[nodiscard]] BlockCoverage classifyBlockImpl(const IntegralRectArea& block) const noexcept
+        {
+            return mask_->movedBy(offset_).classifyBlock(block);
+        }
+
+        template<typename ConsumerFunctor>
+        void rasterizeOntoImpl(IntegralRectArea rect, ConsumerFunctor&& consumer) const
+        {
+            mask_->movedBy(offset_).rasterizeOnto(rect, std::forward<ConsumerFunctor>(consumer));
+        }
+
+        template<typename ConsumerFunctor>
+        void rasterizeSpansOntoImpl(IntegralRectArea rect, ConsumerFunctor&& consumer) const
+        {
+            mask_->movedBy(offset_).rasterizeSpansOnto(rect, std::forward<ConsumerFunctor>(consumer));
+        }
+
+    private:
+        std::shared_ptr<const ShapeMask> mask_;
+        Point<int_type> offset_;
+    };
+
+
+    // The ShapeMaskCache class keeps the masks of the recently used shapes.
+    //
+    // A mask is reused for a shape of the same type, size, falloff profile (see FalloffProfile),
+    //  outline (see shapes::PolygonOutline; the outlines having operator== are compared by their values,
+    //  the other ones are the same only if they are shared) and unit shape transform (see shapes::TransformedEllipse)
+    //  whose center differs by an integral offset after rounding the centers to 1/subpixelSteps of a pixel
+    //  (so the mask can be shifted by up to 1/subpixelSteps of a pixel relative to the shape).
+    // Shapes of the same type, size, falloff profile, outline and unit shape transform must be the same
+    //  up to translation (it is true for all the built-in shapes).
+    //
+    // The cache is not thread-safe.
+    class ShapeMaskCache final
+    {
+    public:
+        static constexpr int_type subpixelSteps = 16;
+
+    public: // ctors/dtor
+        // at most `capacity` masks are kept (the least recently used ones are evicted)
+        explicit ShapeMaskCache(size_type capacity = 8) noexcept;
+
+    public: // modifiers
+        // Returns the mask of the `shape` at the position of the `shape`, rasterizes it on a cache miss.
+        template<typename ShapeImpl, typename RastrCtx>
+        [[nodiscard]] PlacedShapeMask getMaskOf(const Shape<ShapeImpl, RastrCtx>& shape);
+
+        void clear() noexcept;
+
+    public: // getters
+        // the number of the kept masks
+        [[nodiscard]] size_type getSize() const noexcept { return entries_.size(); }
+
+    private:
+        struct Key final
+        {
+            std::type_index shapeType;
+            float_type width;
+            float_type height;
+            // the identifier of the falloff profile (0 if the shape has no falloff profile),
+            //  the addresses of the profiles can be reused by other profiles while the masks are kept
+            std::uint64_t falloffId;
+            // nullptr if the shape has no outline (the entries keep the outlines alive)
+            std::shared_ptr<const void> outline;
+            // compares the outlines by their values, nullptr if only the shared outlines are the same
+            detail::OutlinesEqualFunction outlinesEqual;
+            // the identity transform if the shape has no unit shape transform
+            AffineTransform unitShapeTransform;
+            // the fractional parts of the center in 1/subpixelSteps of a pixel
+            int_type centerFractionX;
+            int_type centerFractionY;
+
+            [[nodiscard]] bool operator==(const Key& rhs) const noexcept;
+
+            // the keys must have the same shape type
+            [[nodiscard]] bool outlinesAreEqual(const Key& rhs) const noexcept;
+        };
+
+        struct Entry final
+        {
+            Key key;
+            // the integral part of the quantized center of the shape the mask was rasterized from
+            Point<int_type> center;
+            std::shared_ptr<const ShapeMask> mask;
+        };
+
+        // the quantized center of a shape split into the integral part and the fraction
+        struct QuantizedCenter final
+        {
+            Point<int_type> integral;
+            Point<int_type> fraction;
+        };
+
+    private:
+        [[nodiscard]] static QuantizedCenter quantizeCenterOf(const ShapeRectArea& bounds) noexcept;
+
+        // returns the entry with the `key` moved to the front or nullptr if there is no such entry
+        [[nodiscard]] const Entry* find(const Key& key) noexcept;
+
+        // inserts the `entry` at the front evicting the least recently used entry if needed
+        const Entry& insert(Entry&& entry);
+
+    private:
+        // the most recently used entries are at the front
+        std::vector<Entry> entries_;
+        size_type capacity_;
+    };
+
+
+    template<typename ShapeImpl, typename RastrCtx>
+    PlacedShapeMask ShapeMaskCache::getMaskOf(const Shape<ShapeImpl, RastrCtx>& shape)
+    {
+        const ShapeRectArea bounds = shape.getBounds();
+        const QuantizedCenter center = quantizeCenterOf(bounds);
+
+        const Key key{
+            typeid(ShapeImpl),
+            bounds.width,
+            bounds.height,
+            detail::FalloffProfileIdOf<ShapeImpl>::get(static_cast<const ShapeImpl&>(shape)),
+            detail::OutlineOf<ShapeImpl>::get(static_cast<const ShapeImpl&>(shape)),
+            detail::OutlineOf<ShapeImpl>::getEqualityFunction(),
+            detail::UnitShapeTransformOf<ShapeImpl>::get(static_cast<const ShapeImpl&>(shape)),
+            center.fraction.x,
+            center.fraction.y
+        };
+
+        const Entry* entry = find(key);
+        if (entry == nullptr)
+            entry = &insert({ key, center.integral, std::make_shared<const ShapeMask>(shape) });
+
+        return {
+            entry->mask,
+            { center.integral.x - entry->center.x, center.integral.y - entry->center.y }
+        };
+    }
+} // namespace mglass
+
+#endif // ndef MAGNIFYING_GLASS_SHAPE_MASK_H
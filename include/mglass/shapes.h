@@ -1,7 +1,15 @@
 #ifndef MAGNIFYING_GLASS_SHAPES_H
 #define MAGNIFYING_GLASS_SHAPES_H
 
-#include "mglass/ellipse_shape.h"   // mglass::shapes::Ellipse
-#include "mglass/rectangle_shape.h" // mglass::shapes::Rectangle
+#include "mglass/ellipse_shape.h"               // mglass::shapes::Ellipse
+#include "mglass/rectangle_shape.h"             // mglass::shapes::Rectangle
+#include "mglass/antialiased_ellipse_shape.h"   // mglass::shapes::AntialiasedEllipse
+#include "mglass/antialiased_rectangle_shape.h" // mglass::shapes::AntialiasedRectangle
+#include "mglass/polygon_shape.h"               // mglass::shapes::Polygon, mglass::shapes::PolygonOutline
+#include "mglass/mask_shape.h"                  // mglass::shapes::Mask, mglass::shapes::MaskOutline
+#include "mglass/transformed_shapes.h"          // mglass::shapes::TransformedEllipse, mglass::shapes::TransformedRectangle
+#include "mglass/sdf_shape.h"                   // mglass::shapes::SdfShape, mglass::shapes::sdf::*
+#include "mglass/csg_shapes.h"                  // mglass::shapes::Union, mglass::shapes::Intersection, mglass::shapes::Difference
+#include "mglass/fixed_ellipse_shape.h"         // mglass::shapes::FixedEllipse
 
 #endif // ndef MAGNIFYING_GLASS_SHAPES_H
@@ -0,0 +1,490 @@
+#ifndef MAGNIFYING_GLASS_TRANSFORMED_SHAPES_H
+#define MAGNIFYING_GLASS_TRANSFORMED_SHAPES_H
+
+#include "mglass/primitives.h"          // Point, AffineTransform, IntegralRectArea, int_type, float_type
+#include "mglass/shape.h"               // Shape, RasterizationSpanBase
+#include "mglass/falloff_profile.h"     // FalloffProfile
+#include "mglass/rasterized_spans.h"    // RasterizedPointContext
+#include <algorithm>                    // std::min, std::max
+#include <cmath>                        // std::abs, std::floor, std::ceil, std::sqrt
+#include <limits>                       // std::numeric_limits
+#include <utility>                      // std::forward
+
+
+// Ellipses and rectangles transformed by arbitrary affine transforms (e.g. rotated).
+// Such a shape is the unit shape (the unit disk or the square [-1; 1] x [-1; 1]) transformed by the linear
+//  transform getUnitShapeTransform() and placed at the center.
+namespace mglass::shapes
+{
+    namespace detail
+    {
+        // The coordinates of the centers of the pixels of a row in the coordinate system of the unit shape.
+        // They are linear in x, so the pixels are not transformed one by one.
+        struct UnitShapeRow final
+        {
+            // x-coordinate of the shape's center
+            float_type centerX;
+            // the unit shape coordinates of the point (centerX; the row's center)
+            float_type originX;
+            float_type originY;
+            // the changes of the unit shape coordinates per pixel
+            float_type stepX;
+            float_type stepY;
+
+            // returns the unit shape coordinates of the center of the pixel `x`
+            [[nodiscard]] Point<float_type> getAt(const int_type x) const noexcept
+            {
+                using namespace literals;
+
+                // +0.5 is for moving to the pixel's center
+                const float_type relX = (static_cast<float_type>(x) + 0.5_flt) - centerX;
+                return { originX + stepX * relX, originY + stepY * relX };
+            }
+        };
+
+
+        // The transform of the pixels' centers into the coordinate system of the unit shape.
+        class UnitShapeMapping final
+        {
+        public:
+            // `unitShapeTransform` transforms the unit shape into the shape placed at (0; 0)
+            UnitShapeMapping(Point<float_type> center, const AffineTransform& unitShapeTransform) noexcept
+                : center_(center)
+                , inversed_(unitShapeTransform.getLinearPart().inversed())
+            {}
+
+            // returns false if the shape is degenerate (e.g. some of its axes are 0)
+            [[nodiscard]] bool isValid() const noexcept
+            {
+                const float_type determinant = inversed_.getDeterminant();
+                return (determinant != 0) && (std::abs(determinant) < std::numeric_limits<float_type>::infinity());
+            }
+
+            [[nodiscard]] UnitShapeRow getRow(const int_type y) const noexcept
+            {
+                using namespace literals;
+
+                // +0.5 is for moving to the pixel's center
+                const float_type relY = (static_cast<float_type>(y) + 0.5_flt) - center_.y;
+                return { center_.x, inversed_.xy * relY, inversed_.yy * relY, inversed_.xx, inversed_.yx };
+            }
+
+        private:
+            Point<float_type> center_;
+            AffineTransform inversed_;
+        };
+
+
+        // 1 - (x^2 + y^2) of the point of the unit shape (it's >= 0 inside the unit disk)
+        [[nodiscard]] inline float_type getUnitDiskDistanceOf(const Point<float_type> p) noexcept
+        {
+            using namespace literals;
+
+            return 1_flt - (p.x * p.x + p.y * p.y);
+        }
+
+        // (1 - |x|) * (1 - |y|) of the point of the unit shape if it's inside the unit square, otherwise -1
+        [[nodiscard]] inline float_type getUnitSquareDistanceOf(const Point<float_type> p) noexcept
+        {
+            using namespace literals;
+
+            const float_type relX = 1_flt - std::abs(p.x);
+            const float_type relY = 1_flt - std::abs(p.y);
+
+            return ((relX >= 0_flt) && (relY >= 0_flt)) ? (relX * relY) : -1_flt;
+        }
+
+
+        // A span of the shapes transformed by an affine transform,
+        //  the density of a pixel is the falloff profile of DistanceOf(the unit shape coordinates of the pixel).
+        template<float_type (*DistanceOf)(Point<float_type>) noexcept>
+        class TransformedShapeRastrSpan final : public RasterizationSpanBase<TransformedShapeRastrSpan<DistanceOf>>
+        {
+            // for accessing to get*Impl() from base
+            friend struct RasterizationSpanBase<TransformedShapeRastrSpan<DistanceOf>>;
+
+        public:
+            TransformedShapeRastrSpan(
+                int_type y,
+                int_type xBegin,
+                int_type xEnd,
+                const UnitShapeRow& row,
+                const FalloffProfile* falloff) noexcept
+                : y_(y)
+                , xBegin_(xBegin)
+                , xEnd_(xEnd)
+                , row_(row)
+                , falloff_(falloff)
+            {}
+
+            // returns the rasterization context of the pixel (`x`, getY())
+            [[nodiscard]] mglass::detail::RasterizedPointContext getContextAt(int_type x) const noexcept
+            {
+                return { { x, y_ }, getPixelDensityAtImpl(x) };
+            }
+
+        private: // RasterizationSpanBase<TransformedShapeRastrSpan> implementation
+            int_type getYImpl() const noexcept { return y_; }
+            int_type getXBeginImpl() const noexcept { return xBegin_; }
+            int_type getXEndImpl() const noexcept { return xEnd_; }
+
+            float_type getPixelDensityAtImpl(int_type x) const noexcept
+            {
+                return falloff_->getDensityAt(DistanceOf(row_.getAt(x)));
+            }
+
+            void getPixelDensitiesOfImpl(int_type xBegin, int_type xEnd, float_type* densities) const noexcept
+            {
+                for (int_type x = xBegin; x < xEnd; ++x)
+                    densities[x - xBegin] = DistanceOf(row_.getAt(x));
+
+                falloff_->getDensitiesAt(densities, static_cast<size_type>(xEnd - xBegin));
+            }
+
+        private:
+            int_type y_;
+            int_type xBegin_;
+            int_type xEnd_;
+            UnitShapeRow row_;
+            const FalloffProfile* falloff_;
+        };
+
+
+        // Calls `consumer`(Span) for the runs of the pixels inside the shape, the rows are visited from the top.
+        // `getRunEstimateOf`(row, xMin, xMax, runLeft, runRight) returns false if the row has no pixels inside the shape,
+        //  otherwise it sets the estimated inclusive range of the run of the row inside the range [xMin; xMax]
+        //  which is corrected pixel by pixel by DistanceOf afterwards.
+        // The pixels inside the shape must form a single run in each row.
+        template<
+            float_type (*DistanceOf)(Point<float_type>) noexcept,
+            typename GetRunEstimateFunctor,
+            typename ConsumerFunctor>
+        void rasterizeTransformedShapeSpans(
+            const IntegralRectArea& thisIntegralBounds,
+            const IntegralRectArea& rect,
+            const UnitShapeMapping& mapping,
+            const FalloffProfile* falloff,
+            const GetRunEstimateFunctor& getRunEstimateOf,
+            ConsumerFunctor&& consumer)
+        {
+            if ((rect.width < 1) || (rect.height < 1))
+                return;
+            if ((thisIntegralBounds.width < 1) || (thisIntegralBounds.height < 1) || !mapping.isValid())
+                return;
+
+            const auto rectXMin = rect.topLeft.x;
+            const auto rectXMax = rect.topLeft.x + static_cast<int_type>(rect.width - 1);
+
+            // the inclusive range of the bounds
+            const auto xMin = thisIntegralBounds.topLeft.x;
+            const auto xMax = thisIntegralBounds.topLeft.x + static_cast<int_type>(thisIntegralBounds.width - 1);
+
+            // only the rows inside both the bounds and `rect` are visited
+            const auto yStart = (std::min)(thisIntegralBounds.topLeft.y, rect.topLeft.y);
+            const auto yEnd = (std::max)(
+                thisIntegralBounds.topLeft.y - static_cast<int_type>(thisIntegralBounds.height),
+                rect.topLeft.y - static_cast<int_type>(rect.height)
+            );
+
+            for (int_type y = yStart; y > yEnd; --y)
+            {
+                const UnitShapeRow row = mapping.getRow(y);
+
+                int_type runLeft = 0;
+                int_type runRight = 0;
+
+                if (!getRunEstimateOf(row, xMin, xMax, runLeft, runRight))
+                    continue;
+
+                const auto isInside = [&row](const int_type x) { return (DistanceOf(row.getAt(x)) >= 0); };
+
+                // the estimate is exact up to the rounding errors, so the ends are moved by a few pixels at most
+                while ((runRight < xMax) && isInside(runRight + 1))
+                    ++runRight;
+                while ((runRight >= runLeft) && !isInside(runRight))
+                    --runRight;
+
+                while ((runLeft > xMin) && isInside(runLeft - 1))
+                    --runLeft;
+                while ((runLeft <= runRight) && !isInside(runLeft))
+                    ++runLeft;
+
+                const int_type spanBegin = (std::max)(runLeft, rectXMin);
+                const int_type spanEnd = (std::min)(runRight, rectXMax) + 1;
+
+                if (spanBegin < spanEnd)
+                {
+                    (void)std::forward<ConsumerFunctor>(consumer)(
+                        TransformedShapeRastrSpan<DistanceOf>{ y, spanBegin, spanEnd, row, falloff }
+                    );
+                }
+            }
+        }
+    } // namespace detail
+
+
+    // The TransformedEllipse class is the ellipse with the axes xAxis, yAxis transformed by an affine transform
+    //  (e.g. rotated) and placed at the center.
+    // The density of a pixel is the falloff profile of (1 - r^2) where r is the distance from the center
+    //  to the pixel's center in the coordinate system of the unit disk (so it's the same as the one of Ellipse
+    //  for the identity transform).
+    //
+    // Each row is rasterized as a single run whose ends are solved from the quadratic equation of the row,
+    //  so the cost is proportional to the count of the rows and the rasterized pixels.
+    class TransformedEllipse : public Shape<TransformedEllipse, mglass::detail::RasterizedPointContext>
+    {
+        friend struct Shape<TransformedEllipse, mglass::detail::RasterizedPointContext>;
+
+    public:
+        using RasterizationSpan = detail::TransformedShapeRastrSpan<detail::getUnitDiskDistanceOf>;
+
+    public: // ctors/dtor
+        // The ellipse with the center (0; 0) and the axes `xAxis`, `yAxis` is transformed by the `transform`
+        //  and then is moved to the `center`.
+        // If the transformed ellipse is degenerate (e.g. some of the axes are 0), it rasterizes no pixels.
+        // The `falloff` must outlive the ellipse (the built-in profiles live until the program exits).
+        explicit TransformedEllipse(
+            Point<float_type> center = {0, 0},
+            float_type xAxis = 0,
+            float_type yAxis = 0,
+            const AffineTransform& transform = {},
+            const FalloffProfile& falloff = FalloffProfile::quartic()) noexcept;
+
+        // rejects the temporary profiles which would be destroyed before the ellipse is used
+        TransformedEllipse(
+            Point<float_type> center,
+            float_type xAxis,
+            float_type yAxis,
+            const AffineTransform& transform,
+            const FalloffProfile&& falloff) = delete;
+
+        ~TransformedEllipse() noexcept = default;
+
+    public: // getters
+        // the center of the transformed ellipse
+        [[nodiscard]] Point<float_type> getCenter() const noexcept { return center_; }
+
+        // the linear transform of the unit disk into the ellipse placed at (0; 0)
+        [[nodiscard]] const AffineTransform& getUnitShapeTransform() const noexcept { return unitShapeTransform_; }
+
+        [[nodiscard]] const FalloffProfile& getFalloffProfile() const noexcept { return *falloff_; }
+
+    public: // comparison
+        // the profiles are compared by their identifiers (see FalloffProfile::getId)
+        [[nodiscard]] bool operator==(const TransformedEllipse& rhs) const noexcept
+        {
+            return (center_ == rhs.center_) && (unitShapeTransform_ == rhs.unitShapeTransform_) &&
+                   (falloff_->getId() == rhs.falloff_->getId());
+        }
+
+    protected:
+        Point<float_type> center_;
+        AffineTransform unitShapeTransform_;
+        const FalloffProfile* falloff_;
+
+    private: // Shape<TransformedEllipse> implementation
+        [[nodiscard]] ShapeRectArea getBoundsImpl() const noexcept;
+
+        template<typename ConsumerFunctor>
+        void rasterizeOntoImpl(IntegralRectArea rect, ConsumerFunctor&& consumer) const
+        {
+            rasterizeSpansOntoImpl(rect, [&consumer](const RasterizationSpan& span) {
+                for (int_type x = span.getXBegin(); x < span.getXEnd(); ++x)
+                    (void)std::forward<ConsumerFunctor>(consumer)(span.getContextAt(x));
+            });
+        }
+
+        template<typename ConsumerFunctor>
+        void rasterizeSpansOntoImpl(IntegralRectArea rect, ConsumerFunctor&& consumer) const
+        {
+            using namespace literals;
+
+            const auto getRunEstimateOf = [](
+                const detail::UnitShapeRow& row,
+                const int_type xMin,
+                const int_type xMax,
+                int_type& runLeft,
+                int_type& runRight)
+            {
+                // the squared distance of the pixel relX is (A * relX^2 + 2 * B * relX + C)
+                const float_type a = row.stepX * row.stepX + row.stepY * row.stepY;
+                const float_type b = row.stepX * row.originX + row.stepY * row.originY;
+
+                // the pixel containing the point of the row nearest to the center is inside the ellipse
+                //  if any pixel of the row is (also handles NaN)
+                const float_type vertex = -b / a;
+                const auto anchor = static_cast<int_type>((std::min)(
+                    (std::max)(std::floor(row.centerX + vertex), static_cast<float_type>(xMin)),
+                    static_cast<float_type>(xMax)
+                ));
+
+                if (!(detail::getUnitDiskDistanceOf(row.getAt(anchor)) >= 0))
+                    return false;
+
+                const float_type vertexDistance = detail::getUnitDiskDistanceOf(
+                    { row.originX + row.stepX * vertex, row.originY + row.stepY * vertex }
+                );
+                const float_type halfRunLength = std::sqrt((std::max)(vertexDistance, 0_flt) / a);
+
+                const float_type leftEstimate = std::ceil(row.centerX + vertex - 0.5_flt - halfRunLength);
+                const float_type rightEstimate = std::floor(row.centerX + vertex - 0.5_flt + halfRunLength);
+
+                runLeft = static_cast<int_type>(
+                    (std::min)( (std::max)(leftEstimate, static_cast<float_type>(xMin)), static_cast<float_type>(anchor) )
+                );
+                runRight = static_cast<int_type>(
+                    (std::max)( (std::min)(rightEstimate, static_cast<float_type>(xMax)), static_cast<float_type>(anchor) )
+                );
+
+                return true;
+            };
+
+            detail::rasterizeTransformedShapeSpans<detail::getUnitDiskDistanceOf>(
+                getShapeIntegralBounds(*this),
+                rect,
+                detail::UnitShapeMapping{ center_, unitShapeTransform_ },
+                falloff_,
+                getRunEstimateOf,
+                std::forward<ConsumerFunctor>(consumer)
+            );
+        }
+    };
+
+
+    // The TransformedRectangle class is the rectangle of the size width x height transformed by an affine transform
+    //  (e.g. rotated) and placed at the center.
+    // The density of a pixel is the falloff profile of ((1 - |x|) * (1 - |y|)) where (x; y) is the pixel's center
+    //  in the coordinate system of the square [-1; 1] x [-1; 1].
+    //
+    // Each row is rasterized as a single run between the crossings of the row with the edges of the rectangle,
+    //  so the cost is proportional to the count of the rows and the rasterized pixels.
+    class TransformedRectangle : public Shape<TransformedRectangle, mglass::detail::RasterizedPointContext>
+    {
+        friend struct Shape<TransformedRectangle, mglass::detail::RasterizedPointContext>;
+
+    public:
+        using RasterizationSpan = detail::TransformedShapeRastrSpan<detail::getUnitSquareDistanceOf>;
+
+    public: // ctors/dtor
+        // The rectangle with the center (0; 0) and the size `width` x `height` is transformed by the `transform`
+        //  and then is moved to the `center`.
+        // If the transformed rectangle is degenerate (e.g. its width is 0), it rasterizes no pixels.
+        // The `falloff` must outlive the rectangle (the built-in profiles live until the program exits).
+        explicit TransformedRectangle(
+            Point<float_type> center = {0, 0},
+            float_type width = 0,
+            float_type height = 0,
+            const AffineTransform& transform = {},
+            const FalloffProfile& falloff = FalloffProfile::fifthRoot()) noexcept;
+
+        // rejects the temporary profiles which would be destroyed before the rectangle is used
+        TransformedRectangle(
+            Point<float_type> center,
+            float_type width,
+            float_type height,
+            const AffineTransform& transform,
+            const FalloffProfile&& falloff) = delete;
+
+        ~TransformedRectangle() noexcept = default;
+
+    public: // getters
+        // the center of the transformed rectangle
+        [[nodiscard]] Point<float_type> getCenter() const noexcept { return center_; }
+
+        // the linear transform of the square [-1; 1] x [-1; 1] into the rectangle placed at (0; 0)
+        [[nodiscard]] const AffineTransform& getUnitShapeTransform() const noexcept { return unitShapeTransform_; }
+
+        [[nodiscard]] const FalloffProfile& getFalloffProfile() const noexcept { return *falloff_; }
+
+    public: // comparison
+        // the profiles are compared by their identifiers (see FalloffProfile::getId)
+        [[nodiscard]] bool operator==(const TransformedRectangle& rhs) const noexcept
+        {
+            return (center_ == rhs.center_) && (unitShapeTransform_ == rhs.unitShapeTransform_) &&
+                   (falloff_->getId() == rhs.falloff_->getId());
+        }
+
+    protected:
+        Point<float_type> center_;
+        AffineTransform unitShapeTransform_;
+        const FalloffProfile* falloff_;
+
+    private: // Shape<TransformedRectangle> implementation
+        [[nodiscard]] ShapeRectArea getBoundsImpl() const noexcept;
+
+        template<typename ConsumerFunctor>
+        void rasterizeOntoImpl(IntegralRectArea rect, ConsumerFunctor&& consumer) const
+        {
+            rasterizeSpansOntoImpl(rect, [&consumer](const RasterizationSpan& span) {
+                for (int_type x = span.getXBegin(); x < span.getXEnd(); ++x)
+                    (void)std::forward<ConsumerFunctor>(consumer)(span.getContextAt(x));
+            });
+        }
+
+        template<typename ConsumerFunctor>
+        void rasterizeSpansOntoImpl(IntegralRectArea rect, ConsumerFunctor&& consumer) const
+        {
+            using namespace literals;
+
+            const auto getRunEstimateOf = [](
+                const detail::UnitShapeRow& row,
+                const int_type xMin,
+                const int_type xMax,
+                int_type& runLeft,
+                int_type& runRight)
+            {
+                // the range of relX of the row inside the square
+                float_type lower = -std::numeric_limits<float_type>::infinity();
+                float_type upper = std::numeric_limits<float_type>::infinity();
+
+                // each pair of the opposite edges bounds the range by the points where they cross the row
+                const auto clipBy = [&lower, &upper](const float_type origin, const float_type step) {
+                    if (step == 0)
+                    {
+                        // the row is parallel to the edges
+                        if (!(std::abs(origin) <= 1_flt))
+                            upper = -std::numeric_limits<float_type>::infinity();
+                        return;
+                    }
+
+                    const float_type first = (-1_flt - origin) / step;
+                    const float_type second = (1_flt - origin) / step;
+
+                    lower = (std::max)(lower, (std::min)(first, second));
+                    upper = (std::min)(upper, (std::max)(first, second));
+                };
+
+                clipBy(row.originX, row.stepX);
+                clipBy(row.originY, row.stepY);
+
+                // the inclusive range of the pixels whose centers are inside the range
+                const float_type leftEstimate = (std::max)(
+                    std::ceil(row.centerX + lower - 0.5_flt), static_cast<float_type>(xMin)
+                );
+                const float_type rightEstimate = (std::min)(
+                    std::floor(row.centerX + upper - 0.5_flt), static_cast<float_type>(xMax)
+                );
+
+                // (also handles NaN)
+                if (!(leftEstimate <= rightEstimate))
+                    return false;
+
+                runLeft = static_cast<int_type>(leftEstimate);
+                runRight = static_cast<int_type>(rightEstimate);
+
+                return true;
+            };
+
+            detail::rasterizeTransformedShapeSpans<detail::getUnitSquareDistanceOf>(
+                getShapeIntegralBounds(*this),
+                rect,
+                detail::UnitShapeMapping{ center_, unitShapeTransform_ },
+                falloff_,
+                getRunEstimateOf,
+                std::forward<ConsumerFunctor>(consumer)
+            );
+        }
+    };
+} // namespace mglass::shapes
+
+#endif // ndef MAGNIFYING_GLASS_TRANSFORMED_SHAPES_H
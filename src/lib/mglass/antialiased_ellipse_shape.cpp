@@ -0,0 +1,169 @@
+#include "mglass/antialiased_ellipse_shape.h"
+#include <cmath>        // std::sqrt, std::asin, std::abs, std::floor, std::ceil
+
+
+namespace mglass::shapes
+{
+    namespace detail
+    {
+        namespace
+        {
+            // the area under the unit circle Y = sqrt(1 - X^2) from 0 to `t` (`t` is inside the range [0; 1])
+            [[nodiscard]] double getAreaUnderUnitCircle(const double t) noexcept
+            {
+                return (t * std::sqrt(1 - t * t) + std::asin(t)) / 2;
+            }
+
+            // Returns the signed area of the intersection of the unit disk and the rectangle with the corners
+            //  (0; 0) and (`u`; `v`) (the area is negative if exactly one of `u` and `v` is negative).
+            [[nodiscard]] double getUnitDiskCornerArea(const double u, const double v) noexcept
+            {
+                const double sign = ((u < 0) != (v < 0)) ? -1 : 1;
+
+                const double x = (std::min)(std::abs(u), 1.0);
+                const double y = (std::min)(std::abs(v), 1.0);
+
+                if (x * x + y * y <= 1)
+                    return sign * x * y;
+
+                // the rectangle [0; xCross] x [0; y] is inside the disk,
+                //  the part of [xCross; x] inside the disk is under the circle
+                const double xCross = std::sqrt(1 - y * y);
+
+                return sign * (xCross * y + getAreaUnderUnitCircle(x) - getAreaUnderUnitCircle(xCross));
+            }
+        } // namespace
+
+
+        AntialiasedEllipseRow getAntialiasedEllipseRow(
+            const Point<float_type> center,
+            const float_type a,
+            const float_type b,
+            const int_type y) noexcept
+        {
+            AntialiasedEllipseRow row{ 0, 0, 0, 0 };
+
+            // the distances from the center to the bottom and the top edges of the row
+            const double bottomDistance = static_cast<double>(y) - static_cast<double>(center.y);
+            const double topDistance = bottomDistance + 1;
+
+            const double nearestDistance = ((bottomDistance <= 0) && (topDistance >= 0))
+                ? 0
+                : (std::min)(std::abs(bottomDistance), std::abs(topDistance));
+            const double farthestDistance = (std::max)(std::abs(bottomDistance), std::abs(topDistance));
+
+            // (also handles NaN)
+            if (!(nearestDistance < b))
+                return row;
+
+            // the half of the chord of the ellipse at the `distance` from the center
+            const auto getHalfChordAt = [a, b](const double distance) {
+                const double t = distance / b;
+                return a * std::sqrt(1 - t * t);
+            };
+
+            // the widest chord of the row bounds the pixels which intersect the ellipse
+            const double outerHalfChord = getHalfChordAt(nearestDistance);
+            row.begin = static_cast<int_type>(std::floor(center.x - outerHalfChord));
+            row.end = static_cast<int_type>(std::ceil(center.x + outerHalfChord));
+
+            // the narrowest one bounds the pixels inside the ellipse
+            row.interiorBegin = row.begin;
+            row.interiorEnd = row.begin;
+
+            if (farthestDistance < b)
+            {
+                const double innerHalfChord = getHalfChordAt(farthestDistance);
+                const auto interiorBegin = static_cast<int_type>(std::ceil(center.x - innerHalfChord));
+                const auto interiorEnd = static_cast<int_type>(std::floor(center.x + innerHalfChord));
+
+                if (interiorBegin < interiorEnd)
+                {
+                    row.interiorBegin = (std::max)(interiorBegin, row.begin);
+                    row.interiorEnd = (std::min)(interiorEnd, row.end);
+                }
+            }
+
+            return row;
+        }
+
+
+        float_type getEllipsePixelCoverage(
+            const Point<float_type> center,
+            const float_type a,
+            const float_type b,
+            const int_type x,
+            const int_type y) noexcept
+        {
+            // the pixel in the coordinate system where the ellipse is the unit disk
+            const double u0 = (static_cast<double>(x) - center.x) / a;
+            const double u1 = (static_cast<double>(x) + 1 - center.x) / a;
+            const double v0 = (static_cast<double>(y) - center.y) / b;
+            const double v1 = (static_cast<double>(y) + 1 - center.y) / b;
+
+            const double unitDiskArea = getUnitDiskCornerArea(u1, v1) - getUnitDiskCornerArea(u0, v1)
+                                      - getUnitDiskCornerArea(u1, v0) + getUnitDiskCornerArea(u0, v0);
+
+            // the areas are scaled by a * b back
+            const double area = unitDiskArea * static_cast<double>(a) * static_cast<double>(b);
+
+            return static_cast<float_type>((std::min)((std::max)(area, 0.0), 1.0));
+        }
+    } // namespace detail
+
+
+    AntialiasedEllipse::AntialiasedEllipse(Point<float_type> center, float_type xAxis, float_type yAxis) noexcept
+        : center_(center)
+        , xAxisLength_(xAxis)
+        , yAxisLength_(yAxis)
+    {}
+
+
+    ShapeRectArea AntialiasedEllipse::getBoundsImpl() const noexcept
+    {
+        const auto halfWidth = xAxisLength_ / 2;
+        const auto halfHeight = yAxisLength_ / 2;
+        const Point topLeft{ center_.x - halfWidth, center_.y + halfHeight };
+
+        return { topLeft, xAxisLength_, yAxisLength_ };
+    }
+
+
+    BlockCoverage AntialiasedEllipse::classifyBlockImpl(const IntegralRectArea& block) const noexcept
+    {
+        const float_type a = xAxisLength_ / 2;
+        const float_type b = yAxisLength_ / 2;
+
+        // (also handles NaN)
+        if ( (block.width < 1) || (block.height < 1) || !(a > 0) || !(b > 0) )
+            return BlockCoverage::Outside;
+
+        const int_type left = block.topLeft.x;
+        const int_type right = block.topLeft.x + static_cast<int_type>(block.width - 1);
+        const int_type top = block.topLeft.y;
+        const int_type bottom = block.topLeft.y - static_cast<int_type>(block.height - 1);
+
+        // the rows are calculated like the ones of rasterizeSpansOntoImpl
+
+        // the widest row of the block is the closest one to the center
+        const auto closestRow = (std::min)( (std::max)(static_cast<int_type>(std::floor(center_.y)), bottom), top );
+        const detail::AntialiasedEllipseRow widestRow = detail::getAntialiasedEllipseRow(center_, a, b, closestRow);
+
+        if ( (widestRow.begin >= widestRow.end) || (right < widestRow.begin) || (left >= widestRow.end) )
+            return BlockCoverage::Outside;
+
+        // the narrowest interior is at the top or the bottom row
+        const auto isInterior = [left, right](const detail::AntialiasedEllipseRow& row) {
+            return (row.interiorBegin <= left) && (right < row.interiorEnd);
+        };
+
+        if ( isInterior(detail::getAntialiasedEllipseRow(center_, a, b, top)) &&
+             isInterior(detail::getAntialiasedEllipseRow(center_, a, b, bottom)) )
+        {
+            return BlockCoverage::Inside;
+        }
+
+        return BlockCoverage::Edge;
+    }
+
+} // namespace mglass::shapes
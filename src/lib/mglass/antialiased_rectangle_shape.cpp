@@ -0,0 +1,73 @@
+#include "mglass/antialiased_rectangle_shape.h"
+#include <cmath>        // std::floor, std::ceil
+
+
+namespace mglass::shapes
+{
+    namespace detail
+    {
+        AntialiasedRectangleAxis AntialiasedRectangleAxis::calculateFor(const float_type first, const float_type last) noexcept
+        {
+            // (also handles NaN)
+            if (!(first < last))
+                return { 0, 0, 0, 0 };
+
+            AntialiasedRectangleAxis result{
+                static_cast<int_type>(std::floor(first)),
+                static_cast<int_type>(std::ceil(last)),
+                static_cast<int_type>(std::ceil(first)),
+                static_cast<int_type>(std::floor(last))
+            };
+
+            if (result.interiorBegin >= result.interiorEnd)
+                result.interiorEnd = result.interiorBegin;
+
+            return result;
+        }
+    } // namespace detail
+
+
+    AntialiasedRectangle::AntialiasedRectangle(Point<float_type> center, float_type width, float_type height) noexcept
+        : center_(center)
+        , width_(width)
+        , height_(height)
+    {}
+
+
+    ShapeRectArea AntialiasedRectangle::getBoundsImpl() const noexcept
+    {
+        return { { center_.x - width_ / 2, center_.y + height_ / 2 }, width_, height_ };
+    }
+
+
+    BlockCoverage AntialiasedRectangle::classifyBlockImpl(const IntegralRectArea& block) const noexcept
+    {
+        if ((block.width < 1) || (block.height < 1))
+            return BlockCoverage::Outside;
+
+        // the ranges are calculated like the ones of rasterizeSpansOntoImpl
+        const ShapeRectArea bounds = getBoundsImpl();
+        const auto columns = detail::AntialiasedRectangleAxis::calculateFor(bounds.topLeft.x, bounds.topLeft.x + bounds.width);
+        const auto rows = detail::AntialiasedRectangleAxis::calculateFor(bounds.topLeft.y - bounds.height, bounds.topLeft.y);
+
+        const int_type blockLeft = block.topLeft.x;
+        const int_type blockRight = block.topLeft.x + static_cast<int_type>(block.width - 1);
+        const int_type blockTop = block.topLeft.y;
+        const int_type blockBottom = block.topLeft.y - static_cast<int_type>(block.height - 1);
+
+        if ( (blockRight < columns.begin) || (blockLeft >= columns.end) ||
+             (blockTop < rows.begin) || (blockBottom >= rows.end) )
+        {
+            return BlockCoverage::Outside;
+        }
+
+        if ( (blockLeft >= columns.interiorBegin) && (blockRight < columns.interiorEnd) &&
+             (blockBottom >= rows.interiorBegin) && (blockTop < rows.interiorEnd) )
+        {
+            return BlockCoverage::Inside;
+        }
+
+        return BlockCoverage::Edge;
+    }
+
+} // namespace mglass::shapes
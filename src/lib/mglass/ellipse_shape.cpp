@@ -1,12 +1,86 @@
 #include "mglass/ellipse_shape.h"
+#include <utility>      // std::pair
+
+#if defined(__AVX2__) || defined(__SSE4_1__)
+    #include <immintrin.h>  // _mm*
+    #define MGLASS_ELLIPSE_SHAPE_SIMD
+#endif
 
 
 namespace mglass::shapes
 {
-    Ellipse::Ellipse(Point<float_type> center, float_type xAxis, float_type yAxis) noexcept
+    namespace detail
+    {
+        void getEllipseNormalizedDistances(
+            const float_type centerX,
+            const float_type a2Inversed,
+            const float_type y2divb2,
+            int_type x,
+            const int_type xEnd,
+            float_type* distances) noexcept
+        {
+            using namespace literals;
+
+#ifdef MGLASS_ELLIPSE_SHAPE_SIMD
+            // the same operations as the ones of EllipseRastrSpan::getPixelDensityAt
+    #if defined(__AVX2__)
+            constexpr int_type lanesCount = 8;
+
+            const __m256 one = _mm256_set1_ps(1);
+            const __m256 half = _mm256_set1_ps(0.5_flt);
+            const __m256 center = _mm256_set1_ps(centerX);
+            const __m256 scale = _mm256_set1_ps(a2Inversed);
+            const __m256 offset = _mm256_set1_ps(y2divb2);
+            const __m256i laneIndices = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+            for (; x + lanesCount <= xEnd; x += lanesCount, distances += lanesCount)
+            {
+                const __m256i xs = _mm256_add_epi32(_mm256_set1_epi32(x), laneIndices);
+                const __m256 relX = _mm256_sub_ps(_mm256_add_ps(_mm256_cvtepi32_ps(xs), half), center);
+                const __m256 result = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(relX, relX), scale), offset);
+
+                _mm256_storeu_ps(distances, _mm256_sub_ps(one, result));
+            }
+    #else // SSE4.1
+            constexpr int_type lanesCount = 4;
+
+            const __m128 one = _mm_set1_ps(1);
+            const __m128 half = _mm_set1_ps(0.5_flt);
+            const __m128 center = _mm_set1_ps(centerX);
+            const __m128 scale = _mm_set1_ps(a2Inversed);
+            const __m128 offset = _mm_set1_ps(y2divb2);
+            const __m128i laneIndices = _mm_setr_epi32(0, 1, 2, 3);
+
+            for (; x + lanesCount <= xEnd; x += lanesCount, distances += lanesCount)
+            {
+                const __m128i xs = _mm_add_epi32(_mm_set1_epi32(x), laneIndices);
+                const __m128 relX = _mm_sub_ps(_mm_add_ps(_mm_cvtepi32_ps(xs), half), center);
+                const __m128 result = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(relX, relX), scale), offset);
+
+                _mm_storeu_ps(distances, _mm_sub_ps(one, result));
+            }
+    #endif
+#endif // MGLASS_ELLIPSE_SHAPE_SIMD
+
+            for (; x < xEnd; ++x, ++distances)
+            {
+                // +0.5 is for moving to the pixel's center
+                const float_type relX = (static_cast<float_type>(x) + 0.5_flt) - centerX;
+                *distances = 1_flt - (relX * relX * a2Inversed + y2divb2);
+            }
+        }
+    } // namespace detail
+
+
+    Ellipse::Ellipse(
+        Point<float_type> center,
+        float_type xAxis,
+        float_type yAxis,
+        const FalloffProfile& falloff) noexcept
         : center_(center)
         , xAxisLength_(xAxis)
         , yAxisLength_(yAxis)
+        , falloff_(&falloff)
     {}
 
 
@@ -19,4 +93,57 @@ namespace mglass::shapes
         return { topLeft, xAxisLength_, yAxisLength_ };
     }
 
+    BlockCoverage Ellipse::classifyBlockImpl(const IntegralRectArea& block) const noexcept
+    {
+        using namespace literals;
+
+        // covers the rounding errors of the rasterization (which solves the equation in another form)
+        constexpr float_type margin = 1_flt / 1024;
+
+        if ((block.width < 1) || (block.height < 1))
+            return BlockCoverage::Outside;
+
+        // the same values as the ones of rasterizeSpansOntoImpl
+        const auto a2Inversed = 1_flt / ((xAxisLength_ * xAxisLength_) / 4);
+        const auto b2Inversed = 1_flt / ((yAxisLength_ * yAxisLength_) / 4);
+
+        // Returns the least and the greatest squares of the distances from the `center`
+        //  to the centers of the pixels [`first`; `last`].
+        // The squares are calculated like the ones of the pixels (see EllipseRastrSpan::getX2At)
+        //  and the rounding is monotonic, so the bounds hold for the calculated values of all the pixels.
+        const auto getSquaresRangeOf = [](const int_type first, const int_type last, const float_type center) {
+            // +0.5 is for moving to the pixel's center
+            const float_type firstDistance = (static_cast<float_type>(first) + 0.5_flt) - center;
+            const float_type lastDistance = (static_cast<float_type>(last) + 0.5_flt) - center;
+
+            const float_type firstSquare = firstDistance * firstDistance;
+            const float_type lastSquare = lastDistance * lastDistance;
+
+            // 0 if the center is between the pixels
+            const float_type least = ((firstDistance <= 0_flt) && (lastDistance >= 0_flt))
+                ? 0_flt
+                : (std::min)(firstSquare, lastSquare);
+
+            return std::pair{ least, (std::max)(firstSquare, lastSquare) };
+        };
+
+        const auto [x2Least, x2Greatest] = getSquaresRangeOf(
+            block.topLeft.x, block.topLeft.x + static_cast<int_type>(block.width - 1), center_.x);
+        const auto [y2Least, y2Greatest] = getSquaresRangeOf(
+            block.topLeft.y - static_cast<int_type>(block.height - 1), block.topLeft.y, center_.y);
+
+        // x^2 / a^2 + y^2 / b^2 (the comparisons are false for NaN of the degenerate ellipses)
+        const float_type leastResult = x2Least * a2Inversed + y2Least * b2Inversed;
+        const float_type greatestResult = x2Greatest * a2Inversed + y2Greatest * b2Inversed;
+
+        if (leastResult > 1_flt + margin)
+            return BlockCoverage::Outside;
+
+        // the density is calculated at u == 1 - result (see EllipseRastrSpan)
+        if ( (greatestResult <= 1_flt - margin) && (1_flt - greatestResult >= falloff_->getSolidDistance()) )
+            return BlockCoverage::Inside;
+
+        return BlockCoverage::Edge;
+    }
+
 } // namespace mglass::shapes
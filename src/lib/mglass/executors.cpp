@@ -0,0 +1,137 @@
+#include "mglass/executors.h"
+
+
+namespace mglass
+{
+    // ================================================================================================================
+    //  SequentialExecutor
+    // ================================================================================================================
+
+    void SequentialExecutor::parallelFor(size_type tasksCount, const std::function<void(size_type taskIndex)>& task)
+    {
+        for (size_type i = 0; i < tasksCount; ++i)
+            task(i);
+    }
+
+
+    // ================================================================================================================
+    //  ThreadPool
+    // ================================================================================================================
+
+    ThreadPool::ThreadPool(size_type workerThreadsCount) noexcept(false)
+    {
+        workers_.reserve(workerThreadsCount);
+
+        try
+        {
+            for (size_type i = 0; i < workerThreadsCount; ++i)
+                workers_.emplace_back([this] { workerLoop(); });
+        }
+        catch (...)
+        {
+            {
+                const std::lock_guard<std::mutex> lock{mutex_};
+                stopRequested_ = true;
+            }
+            jobStarted_.notify_all();
+
+            for (auto& worker : workers_)
+                worker.join();
+
+            throw;
+        }
+    }
+
+    ThreadPool::~ThreadPool() noexcept
+    {
+        {
+            const std::lock_guard<std::mutex> lock{mutex_};
+            stopRequested_ = true;
+        }
+        jobStarted_.notify_all();
+
+        for (auto& worker : workers_)
+            worker.join();
+    }
+
+
+    void ThreadPool::parallelFor(size_type tasksCount, const std::function<void(size_type taskIndex)>& task)
+    {
+        if (tasksCount < 1)
+            return;
+
+        if (workers_.empty() || (tasksCount == 1))
+        {
+            for (size_type i = 0; i < tasksCount; ++i)
+                task(i);
+            return;
+        }
+
+        const std::lock_guard<std::mutex> jobLock{jobMutex_};
+
+        {
+            const std::lock_guard<std::mutex> lock{mutex_};
+
+            task_ = &task;
+            tasksCount_ = tasksCount;
+            nextTask_.store(0, std::memory_order_relaxed);
+            busyWorkersCount_ = workers_.size();
+            ++jobGeneration_;
+        }
+        jobStarted_.notify_all();
+
+        runTasks(task, tasksCount);
+
+        // each worker takes part in each job, so `task` must outlive all of them
+        std::unique_lock<std::mutex> lock{mutex_};
+        jobFinished_.wait(lock, [this] { return busyWorkersCount_ == 0; });
+
+        task_ = nullptr;
+        tasksCount_ = 0;
+    }
+
+
+    size_type ThreadPool::getDefaultWorkerThreadsCount() noexcept
+    {
+        const unsigned hardwareConcurrency = std::thread::hardware_concurrency();
+        return (hardwareConcurrency > 1) ? (hardwareConcurrency - 1) : 0;
+    }
+
+
+    void ThreadPool::workerLoop() noexcept
+    {
+        size_type lastJobGeneration = 0;
+
+        std::unique_lock<std::mutex> lock{mutex_};
+
+        while (true)
+        {
+            jobStarted_.wait(lock, [&] { return stopRequested_ || (jobGeneration_ != lastJobGeneration); });
+
+            if (stopRequested_)
+                return;
+
+            lastJobGeneration = jobGeneration_;
+
+            const auto* const task = task_;
+            const size_type tasksCount = tasksCount_;
+
+            lock.unlock();
+            runTasks(*task, tasksCount);
+            lock.lock();
+
+            if (--busyWorkersCount_ == 0)
+                jobFinished_.notify_one();
+        }
+    }
+
+    void ThreadPool::runTasks(const std::function<void(size_type)>& task, const size_type tasksCount) noexcept
+    {
+        for (size_type i = nextTask_.fetch_add(1, std::memory_order_relaxed);
+             i < tasksCount;
+             i = nextTask_.fetch_add(1, std::memory_order_relaxed))
+        {
+            task(i);
+        }
+    }
+} // namespace mglass
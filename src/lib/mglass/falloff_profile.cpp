@@ -0,0 +1,148 @@
+#include "mglass/falloff_profile.h"
+#include <atomic>       // std::atomic
+#include <cmath>        // std::exp, std::pow
+
+#if defined(__AVX2__) || defined(__SSE4_1__)
+    #include <immintrin.h>  // _mm*
+    #define MGLASS_FALLOFF_PROFILE_SIMD
+#endif
+
+
+namespace mglass
+{
+    std::uint64_t FalloffProfile::makeId() noexcept
+    {
+        static std::atomic<std::uint64_t> lastId{0};
+        return ++lastId;
+    }
+
+
+    const FalloffProfile& FalloffProfile::linear()
+    {
+        static const FalloffProfile profile = fromFunction([](const double u) { return u; });
+        return profile;
+    }
+
+    const FalloffProfile& FalloffProfile::smoothstep()
+    {
+        static const FalloffProfile profile = fromFunction([](const double u) { return u * u * (3 - 2 * u); });
+        return profile;
+    }
+
+    const FalloffProfile& FalloffProfile::gaussian()
+    {
+        static const FalloffProfile profile = fromFunction([](const double u) {
+            constexpr double sigma = 0.4;
+            const auto bell = [](const double distance) { return std::exp(-(distance * distance) / (2 * sigma * sigma)); };
+
+            // the bell is 1 at the center (distance == 0), the value at the edge is subtracted
+            return (bell(1 - u) - bell(1)) / (1 - bell(1));
+        });
+        return profile;
+    }
+
+    const FalloffProfile& FalloffProfile::quartic()
+    {
+        static const FalloffProfile profile = fromFunction([](const double u) {
+            const double v = 1 - u;
+            return 1 - (v * v) * (v * v);
+        });
+        return profile;
+    }
+
+    const FalloffProfile& FalloffProfile::fifthRoot()
+    {
+        static const FalloffProfile profile = fromFunction([](const double u) { return std::pow(u, 1.0 / 5.0); });
+        return profile;
+    }
+
+
+    void FalloffProfile::getDensitiesAt(float_type* values, const size_type count) const noexcept
+    {
+        float_type* const end = values + count;
+
+#ifdef MGLASS_FALLOFF_PROFILE_SIMD
+        // the same operations as the ones of getDensityAt, the both branches are calculated for each lane
+    #if defined(__AVX2__)
+        constexpr size_type lanesCount = 8;
+
+        const __m256 one = _mm256_set1_ps(1);
+        const __m256 zero = _mm256_setzero_ps();
+        const __m256 minU = _mm256_set1_ps(minTabulatedU);
+        const __m256 zeroInterpolationScale = _mm256_set1_ps(1 / minTabulatedU);
+        const __m256 densityAtZero = _mm256_set1_ps(densityAtZero_);
+        const __m256 densityDeltaAtZero = _mm256_set1_ps(table_[0].density - densityAtZero_);
+        const __m256i minBits = _mm256_set1_epi32(static_cast<int>(minTabulatedUBits));
+        const __m256i mask = _mm256_set1_epi32(static_cast<int>(fractionMask));
+        const __m256 fractionScale = _mm256_set1_ps(1.0f / (1U << fractionBits));
+
+        for (; values + lanesCount <= end; values += lanesCount)
+        {
+            // (the order of the operands keeps NaN like std::min, std::max do)
+            const __m256 u = _mm256_min_ps(one, _mm256_loadu_ps(values));
+            const __m256 isTabulated = _mm256_cmp_ps(u, minU, _CMP_GE_OQ);
+
+            const __m256 zeroFraction = _mm256_mul_ps(_mm256_max_ps(zero, u), zeroInterpolationScale);
+            const __m256 lowDensity = _mm256_add_ps(densityAtZero, _mm256_mul_ps(densityDeltaAtZero, zeroFraction));
+
+            const __m256i position = _mm256_sub_epi32(_mm256_castps_si256(u), minBits);
+            // the lanes which are not tabulated look the first entry up to stay inside the table
+            const __m256i index = _mm256_and_si256(
+                _mm256_srli_epi32(position, fractionBits), _mm256_castps_si256(isTabulated));
+            const __m256 fraction = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_and_si256(position, mask)), fractionScale);
+
+            // the entries are pairs of floats: the density at 2 * index and the delta at 2 * index + 1
+            static_assert( (sizeof(Entry) == 2 * sizeof(float_type)) );
+            const __m256i densityIndex = _mm256_slli_epi32(index, 1);
+            const __m256 density = _mm256_i32gather_ps(&table_[0].density, densityIndex, sizeof(float_type));
+            const __m256 delta = _mm256_i32gather_ps(&table_[0].density, _mm256_add_epi32(densityIndex, _mm256_set1_epi32(1)), sizeof(float_type));
+            const __m256 tabulatedDensity = _mm256_add_ps(density, _mm256_mul_ps(delta, fraction));
+
+            _mm256_storeu_ps(values, _mm256_blendv_ps(lowDensity, tabulatedDensity, isTabulated));
+        }
+    #else // SSE4.1
+        constexpr size_type lanesCount = 4;
+
+        const __m128 one = _mm_set1_ps(1);
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 minU = _mm_set1_ps(minTabulatedU);
+        const __m128 zeroInterpolationScale = _mm_set1_ps(1 / minTabulatedU);
+        const __m128 densityAtZero = _mm_set1_ps(densityAtZero_);
+        const __m128 densityDeltaAtZero = _mm_set1_ps(table_[0].density - densityAtZero_);
+        const __m128i minBits = _mm_set1_epi32(static_cast<int>(minTabulatedUBits));
+        const __m128i mask = _mm_set1_epi32(static_cast<int>(fractionMask));
+        const __m128 fractionScale = _mm_set1_ps(1.0f / (1U << fractionBits));
+
+        for (; values + lanesCount <= end; values += lanesCount)
+        {
+            // (the order of the operands keeps NaN like std::min, std::max do)
+            const __m128 u = _mm_min_ps(one, _mm_loadu_ps(values));
+            const __m128 isTabulated = _mm_cmpge_ps(u, minU);
+
+            const __m128 zeroFraction = _mm_mul_ps(_mm_max_ps(zero, u), zeroInterpolationScale);
+            const __m128 lowDensity = _mm_add_ps(densityAtZero, _mm_mul_ps(densityDeltaAtZero, zeroFraction));
+
+            const __m128i position = _mm_sub_epi32(_mm_castps_si128(u), minBits);
+            // the lanes which are not tabulated look the first entry up to stay inside the table
+            const __m128i index = _mm_and_si128(_mm_srli_epi32(position, fractionBits), _mm_castps_si128(isTabulated));
+            const __m128 fraction = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(position, mask)), fractionScale);
+
+            // SSE4.1 has no gathers
+            const Entry& entry0 = table_[static_cast<size_type>(_mm_extract_epi32(index, 0))];
+            const Entry& entry1 = table_[static_cast<size_type>(_mm_extract_epi32(index, 1))];
+            const Entry& entry2 = table_[static_cast<size_type>(_mm_extract_epi32(index, 2))];
+            const Entry& entry3 = table_[static_cast<size_type>(_mm_extract_epi32(index, 3))];
+
+            const __m128 density = _mm_setr_ps(entry0.density, entry1.density, entry2.density, entry3.density);
+            const __m128 delta = _mm_setr_ps(entry0.delta, entry1.delta, entry2.delta, entry3.delta);
+            const __m128 tabulatedDensity = _mm_add_ps(density, _mm_mul_ps(delta, fraction));
+
+            _mm_storeu_ps(values, _mm_blendv_ps(lowDensity, tabulatedDensity, isTabulated));
+        }
+    #endif
+#endif // MGLASS_FALLOFF_PROFILE_SIMD
+
+        for (; values < end; ++values)
+            *values = getDensityAt(*values);
+    }
+} // namespace mglass
@@ -144,6 +144,11 @@ namespace mglass
             pixel = color;
     }
 
+    ARGB* Image::getRowData(size_type y) noexcept
+    {
+        return data_.data() + y * width_;
+    }
+
 
     bool Image::operator==(const Image& rhs) const noexcept
     {
@@ -172,6 +177,11 @@ namespace mglass
         return data_[y * width_ + x];
     }
 
+    const ARGB* Image::getRowData(size_type y) const noexcept
+    {
+        return data_.data() + y * width_;
+    }
+
 
     void Image::saveToPNGStream(std::ostream& stream) const
     {
@@ -0,0 +1,61 @@
+#include "mglass/lens_batch.h"
+#include <algorithm>    // std::min
+
+
+namespace mglass::detail
+{
+    LensGrid::LensGrid(const IntegralRectArea& area, const std::vector<IntegralRectArea>& lensesAreas)
+        : area_(area)
+        , columnsCount_((area.width + tileSize - 1) / tileSize)
+        , rowsCount_((area.height + tileSize - 1) / tileSize)
+        , tilesOffsets_(columnsCount_ * rowsCount_ + 1, 0)
+    {
+        // calls `func`(tileIndex) for each tile overlapped by the `lensArea`
+        const auto forEachTileOf = [this](const IntegralRectArea& lensArea, const auto& func) {
+            const IntegralRectArea clipped = getIntersectionOf(lensArea, area_);
+            if ( (clipped.width < 1) || (clipped.height < 1) )
+                return;
+
+            const auto left = static_cast<size_type>(clipped.topLeft.x - area_.topLeft.x);
+            const auto top = static_cast<size_type>(area_.topLeft.y - clipped.topLeft.y);
+
+            for (size_type row = top / tileSize; row <= (top + clipped.height - 1) / tileSize; ++row)
+            {
+                for (size_type column = left / tileSize; column <= (left + clipped.width - 1) / tileSize; ++column)
+                    func(row * columnsCount_ + column);
+            }
+        };
+
+        // the lists are counted first, so the lenses are placed without reallocations
+        for (const IntegralRectArea& lensArea : lensesAreas)
+            forEachTileOf(lensArea, [this](const size_type tileIndex) { ++tilesOffsets_[tileIndex + 1]; });
+
+        for (size_type i = 1; i < tilesOffsets_.size(); ++i)
+            tilesOffsets_[i] += tilesOffsets_[i - 1];
+
+        lenses_.resize(tilesOffsets_.back());
+
+        // the next free place of each list, the lenses are placed in increasing order of their indices
+        std::vector<size_type> tilesEnds(tilesOffsets_.begin(), tilesOffsets_.end() - 1);
+
+        for (size_type lensIndex = 0; lensIndex < lensesAreas.size(); ++lensIndex)
+        {
+            forEachTileOf(lensesAreas[lensIndex], [this, &tilesEnds, lensIndex](const size_type tileIndex) {
+                lenses_[tilesEnds[tileIndex]++] = lensIndex;
+            });
+        }
+    }
+
+
+    IntegralRectArea LensGrid::getTileArea(const size_type tileIndex) const noexcept
+    {
+        const size_type left = tileIndex % columnsCount_ * tileSize;
+        const size_type top = tileIndex / columnsCount_ * tileSize;
+
+        return {
+            { area_.topLeft.x + static_cast<int_type>(left), area_.topLeft.y - static_cast<int_type>(top) },
+            (std::min)(tileSize, area_.width - left),
+            (std::min)(tileSize, area_.height - top)
+        };
+    }
+} // namespace mglass::detail
@@ -0,0 +1,53 @@
+#include "mglass/magnifier_plan.h"
+
+
+namespace mglass
+{
+    void MagnifierPlan::nearestNeighbor(
+        Executor& executor,
+        const Point<int_type> shapeOffset,
+        const ImageSpan& imageSrc,
+        const Point<int_type> imageTopLeft,
+        Image& imageDst) const
+    {
+        magnifiers::nearestNeighbor(
+            executor, detail::MovedRasterizedSpans<float_type>{spans_, shapeOffset}, scaleFactor_,
+            imageSrc, imageTopLeft, imageDst, alphaBlendingIsEnabled_);
+    }
+
+    void MagnifierPlan::nearestNeighbor(
+        const Point<int_type> shapeOffset,
+        const ImageSpan& imageSrc,
+        const Point<int_type> imageTopLeft,
+        Image& imageDst) const
+    {
+        SequentialExecutor executor;
+        nearestNeighbor(executor, shapeOffset, imageSrc, imageTopLeft, imageDst);
+    }
+
+    void MagnifierPlan::nearestNeighbor(
+        Executor& executor,
+        const Point<int_type> shapeOffset,
+        const ImageSpan& imageSrc,
+        const Point<int_type> imageTopLeft,
+        const MutableImageSpan& imageDst,
+        const Point<int_type> dstOffset,
+        const bool fillWithTransparent) const
+    {
+        magnifiers::nearestNeighbor(
+            executor, detail::MovedRasterizedSpans<float_type>{spans_, shapeOffset}, scaleFactor_,
+            imageSrc, imageTopLeft, imageDst, dstOffset, alphaBlendingIsEnabled_, fillWithTransparent);
+    }
+
+    void MagnifierPlan::nearestNeighbor(
+        const Point<int_type> shapeOffset,
+        const ImageSpan& imageSrc,
+        const Point<int_type> imageTopLeft,
+        const MutableImageSpan& imageDst,
+        const Point<int_type> dstOffset,
+        const bool fillWithTransparent) const
+    {
+        SequentialExecutor executor;
+        nearestNeighbor(executor, shapeOffset, imageSrc, imageTopLeft, imageDst, dstOffset, fillWithTransparent);
+    }
+} // namespace mglass
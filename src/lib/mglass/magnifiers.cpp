@@ -1,5 +1,12 @@
 #include "mglass/magnifiers.h"
 #include <algorithm>            // std::min, std::max
+#include <cmath>                // std::abs, std::floor, std::ceil, std::round
+#include <cstring>              // std::memcpy
+
+#if defined(__AVX2__) || defined(__SSE4_1__)
+    #include <immintrin.h>      // _mm*
+    #define MGLASS_MAGNIFIERS_SIMD
+#endif
 
 
 namespace mglass::magnifiers::detail
@@ -20,8 +27,8 @@ namespace mglass::magnifiers::detail
         const Point<float_type> start,
         Point<float_type> end) noexcept
     {
-        end.x = start.x + (end.x - start.x) * scaleFactor;
-        end.y = start.y + (end.y - start.y) * scaleFactor;
+        end.x = scaleCoordinateBy(scaleFactor, start.x, end.x);
+        end.y = scaleCoordinateBy(scaleFactor, start.y, end.y);
 
         return end;
     }
@@ -31,6 +38,33 @@ namespace mglass::magnifiers::detail
     //  InterpolationInfo
     // ================================================================================================================
 
+    namespace
+    {
+        // lengths of the parts of the fake pixel (see InterpolationInfo::calculateFor) along one axis
+        struct AxisParts final
+        {
+            float_type before;  // before the start of the pixel containing the point
+            float_type inside;  // inside the pixel containing the point
+            float_type after;   // after the end of the pixel containing the point
+        };
+
+        // `pixelStart` must be equal to std::floor(`point`)
+        [[nodiscard]] AxisParts calculateAxisParts(const float_type point, const float_type pixelStart) noexcept
+        {
+            const float_type pixelEnd = pixelStart + 1;
+
+            // let's make "pixel" around the `point`
+            const float_type fakePixelStart = point - 0.5f;
+            const float_type fakePixelEnd = point + 0.5f;
+
+            return {
+                (std::max)(pixelStart - fakePixelStart, 0.f),
+                1 - std::abs(fakePixelEnd - pixelEnd),
+                (std::max)(fakePixelEnd - pixelEnd, 0.f)
+            };
+        }
+    } // namespace
+
     // `pixelBottomLeft` must be equal to { std::floor(`point`.x), std::floor(`point`.y) }
     InterpolationInfo InterpolationInfo::calculateFor(
         const Point<float_type> point,
@@ -78,20 +112,16 @@ namespace mglass::magnifiers::detail
         //  BTW we got a normalized convolution matrix.
         //
 
-        const Point<float_type> pixelTopRight { pixelBottomLeft.x + 1, pixelBottomLeft.y + 1 };
+        const AxisParts xParts = calculateAxisParts(point.x, pixelBottomLeft.x);
+        const AxisParts yParts = calculateAxisParts(point.y, pixelBottomLeft.y);
 
-        // let's make "pixel" around the `point`
-        const Point<float_type> fakePixelBottomLeft { point.x - 0.5f, point.y - 0.5f };
-        const Point<float_type> fakePixelTopRight { point.x + 0.5f, point.y + 0.5f };
+        const float_type beforeLeftLength = xParts.before;
+        const float_type insideXLength = xParts.inside;
+        const float_type afterRightLength = xParts.after;
 
-        const float_type beforeLeftLength = (std::max)(pixelBottomLeft.x - fakePixelBottomLeft.x, 0.f);
-        const float_type beforeBottomLength = (std::max)(pixelBottomLeft.y - fakePixelBottomLeft.y, 0.f);
-
-        const float_type afterRightLength = (std::max)(fakePixelTopRight.x - pixelTopRight.x, 0.f);
-        const float_type afterTopLength = (std::max)(fakePixelTopRight.y - pixelTopRight.y, 0.f);
-
-        const float_type insideXLength = 1 - std::abs(fakePixelTopRight.x - pixelTopRight.x);
-        const float_type insideYLength = 1 - std::abs(fakePixelTopRight.y - pixelTopRight.y);
+        const float_type beforeBottomLength = yParts.before;
+        const float_type insideYLength = yParts.inside;
+        const float_type afterTopLength = yParts.after;
 
         InterpolationInfo result; // NOLINT (initialization is below)
 
@@ -108,7 +138,7 @@ namespace mglass::magnifiers::detail
         return result;
     }
 
-    ARGB InterpolationInfo::applyTo(const Point<size_type> pixelPos, const Image& imageSrc) const
+    ARGB InterpolationInfo::applyTo(const Point<size_type> pixelPos, const ImageSpan& imageSrc) const
     {
         // 4th is the center
         ARGB srcPixels[9];
@@ -149,4 +179,548 @@ namespace mglass::magnifiers::detail
         };
     }
 
+
+    // ================================================================================================================
+    //  SIMD helpers
+    // ================================================================================================================
+
+#ifdef MGLASS_MAGNIFIERS_SIMD
+    namespace
+    {
+        // Thin wrappers of the SIMD intrinsics, so the kernels below are written once for both AVX2 and SSE4.1.
+        // Every floating point operation is the exact analogue of the scalar one used by the magnifiers.
+        namespace simd
+        {
+    #if defined(__AVX2__)
+            constexpr int_type lanesCount = 8;
+
+            using floats = __m256;
+            using ints = __m256i;
+
+            inline floats set(const float_type value) noexcept { return _mm256_set1_ps(value); }
+            inline ints set(const std::int32_t value) noexcept { return _mm256_set1_epi32(value); }
+            inline ints laneIndices() noexcept { return _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7); }
+
+            inline floats add(const floats lhs, const floats rhs) noexcept { return _mm256_add_ps(lhs, rhs); }
+            inline floats sub(const floats lhs, const floats rhs) noexcept { return _mm256_sub_ps(lhs, rhs); }
+            inline floats mul(const floats lhs, const floats rhs) noexcept { return _mm256_mul_ps(lhs, rhs); }
+            inline floats floor(const floats value) noexcept { return _mm256_floor_ps(value); }
+
+            inline ints add(const ints lhs, const ints rhs) noexcept { return _mm256_add_epi32(lhs, rhs); }
+            inline ints sub(const ints lhs, const ints rhs) noexcept { return _mm256_sub_epi32(lhs, rhs); }
+            inline ints max(const ints lhs, const ints rhs) noexcept { return _mm256_max_epi32(lhs, rhs); }
+            inline ints min(const ints lhs, const ints rhs) noexcept { return _mm256_min_epi32(lhs, rhs); }
+            inline ints bitAnd(const ints lhs, const ints rhs) noexcept { return _mm256_and_si256(lhs, rhs); }
+            inline ints bitOr(const ints lhs, const ints rhs) noexcept { return _mm256_or_si256(lhs, rhs); }
+            template<int Bits> ints shiftLeft(const ints value) noexcept { return _mm256_slli_epi32(value, Bits); }
+            template<int Bits> ints shiftRight(const ints value) noexcept { return _mm256_srli_epi32(value, Bits); }
+            template<int Bits> ints shiftRightArithmetic(const ints value) noexcept { return _mm256_srai_epi32(value, Bits); }
+
+            // operations on the pairs of 16-bit integers stored in 32-bit lanes
+            inline ints mulLow16(const ints lhs, const ints rhs) noexcept { return _mm256_mullo_epi16(lhs, rhs); }
+            // lhs.low * rhs.low + lhs.high * rhs.high for each 32-bit lane
+            inline ints multiplyAdd16(const ints lhs, const ints rhs) noexcept { return _mm256_madd_epi16(lhs, rhs); }
+            // takes the low halves of the lanes from `lhs` and the high ones from `rhs`
+            inline ints blendHigh16(const ints lhs, const ints rhs) noexcept { return _mm256_blend_epi16(lhs, rhs, 0xAA); }
+
+            inline floats toFloats(const ints value) noexcept { return _mm256_cvtepi32_ps(value); }
+            inline ints truncToInts(const floats value) noexcept { return _mm256_cvttps_epi32(value); }
+
+            // loads `row`[`columns`[i]] for each lane
+            inline ints gather(const ARGB* const row, const ints columns) noexcept
+            {
+                return _mm256_i32gather_epi32(reinterpret_cast<const int*>(row), columns, sizeof(ARGB));
+            }
+
+            inline ints load(const ARGB* const src) noexcept
+            {
+                return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+            }
+
+            inline ints load(const std::int32_t* const src) noexcept
+            {
+                return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+            }
+
+            inline ints load(const std::int16_t* const src) noexcept
+            {
+                return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+            }
+
+            inline void store(void* const dst, const ints pixels) noexcept
+            {
+                _mm256_storeu_si256(static_cast<__m256i*>(dst), pixels);
+            }
+
+            inline std::int32_t firstLaneOf(const ints value) noexcept { return _mm256_cvtsi256_si32(value); }
+            inline std::int32_t lastLaneOf(const ints value) noexcept { return _mm256_extract_epi32(value, 7); }
+
+            // returns { `value`[`indices`[0]], `value`[`indices`[1]], ... }, indices must be inside [0; lanesCount)
+            inline ints permute(const ints value, const ints indices) noexcept
+            {
+                return _mm256_permutevar8x32_epi32(value, indices);
+            }
+
+            // shuffles bytes inside each 32-bit lane: byte i of a lane is taken from the byte (`mask` >> 8i) & 0xFF of it
+            inline ints shuffleBytesOfLanes(const ints value, const std::int32_t mask) noexcept
+            {
+                // _mm256_shuffle_epi8 indexes bytes of 128-bit halves
+                const ints bytesIndices = _mm256_add_epi32(
+                    _mm256_set1_epi32(mask),
+                    _mm256_setr_epi32(0, 0x04040404, 0x08080808, 0x0C0C0C0C, 0, 0x04040404, 0x08080808, 0x0C0C0C0C)
+                );
+                return _mm256_shuffle_epi8(value, bytesIndices);
+            }
+    #else // SSE4.1
+            constexpr int_type lanesCount = 4;
+
+            using floats = __m128;
+            using ints = __m128i;
+
+            inline floats set(const float_type value) noexcept { return _mm_set1_ps(value); }
+            inline ints set(const std::int32_t value) noexcept { return _mm_set1_epi32(value); }
+            inline ints laneIndices() noexcept { return _mm_setr_epi32(0, 1, 2, 3); }
+
+            inline floats add(const floats lhs, const floats rhs) noexcept { return _mm_add_ps(lhs, rhs); }
+            inline floats sub(const floats lhs, const floats rhs) noexcept { return _mm_sub_ps(lhs, rhs); }
+            inline floats mul(const floats lhs, const floats rhs) noexcept { return _mm_mul_ps(lhs, rhs); }
+            inline floats floor(const floats value) noexcept { return _mm_floor_ps(value); }
+
+            inline ints add(const ints lhs, const ints rhs) noexcept { return _mm_add_epi32(lhs, rhs); }
+            inline ints sub(const ints lhs, const ints rhs) noexcept { return _mm_sub_epi32(lhs, rhs); }
+            inline ints max(const ints lhs, const ints rhs) noexcept { return _mm_max_epi32(lhs, rhs); }
+            inline ints min(const ints lhs, const ints rhs) noexcept { return _mm_min_epi32(lhs, rhs); }
+            inline ints bitAnd(const ints lhs, const ints rhs) noexcept { return _mm_and_si128(lhs, rhs); }
+            inline ints bitOr(const ints lhs, const ints rhs) noexcept { return _mm_or_si128(lhs, rhs); }
+            template<int Bits> ints shiftLeft(const ints value) noexcept { return _mm_slli_epi32(value, Bits); }
+            template<int Bits> ints shiftRight(const ints value) noexcept { return _mm_srli_epi32(value, Bits); }
+            template<int Bits> ints shiftRightArithmetic(const ints value) noexcept { return _mm_srai_epi32(value, Bits); }
+
+            // operations on the pairs of 16-bit integers stored in 32-bit lanes
+            inline ints mulLow16(const ints lhs, const ints rhs) noexcept { return _mm_mullo_epi16(lhs, rhs); }
+            // lhs.low * rhs.low + lhs.high * rhs.high for each 32-bit lane
+            inline ints multiplyAdd16(const ints lhs, const ints rhs) noexcept { return _mm_madd_epi16(lhs, rhs); }
+            // takes the low halves of the lanes from `lhs` and the high ones from `rhs`
+            inline ints blendHigh16(const ints lhs, const ints rhs) noexcept { return _mm_blend_epi16(lhs, rhs, 0xAA); }
+
+            inline floats toFloats(const ints value) noexcept { return _mm_cvtepi32_ps(value); }
+            inline ints truncToInts(const floats value) noexcept { return _mm_cvttps_epi32(value); }
+
+            // loads `row`[`columns`[i]] for each lane
+            inline ints gather(const ARGB* const row, const ints columns) noexcept
+            {
+                const auto* const pixels = reinterpret_cast<const int*>(row);
+
+                return _mm_setr_epi32(
+                    pixels[_mm_extract_epi32(columns, 0)],
+                    pixels[_mm_extract_epi32(columns, 1)],
+                    pixels[_mm_extract_epi32(columns, 2)],
+                    pixels[_mm_extract_epi32(columns, 3)]
+                );
+            }
+
+            inline ints load(const ARGB* const src) noexcept
+            {
+                return _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+            }
+
+            inline ints load(const std::int32_t* const src) noexcept
+            {
+                return _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+            }
+
+            inline ints load(const std::int16_t* const src) noexcept
+            {
+                return _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+            }
+
+            inline void store(void* const dst, const ints pixels) noexcept
+            {
+                _mm_storeu_si128(static_cast<__m128i*>(dst), pixels);
+            }
+
+            inline std::int32_t firstLaneOf(const ints value) noexcept { return _mm_cvtsi128_si32(value); }
+            inline std::int32_t lastLaneOf(const ints value) noexcept { return _mm_extract_epi32(value, 3); }
+
+            // returns { `value`[`indices`[0]], `value`[`indices`[1]], ... }, indices must be inside [0; lanesCount)
+            inline ints permute(const ints value, const ints indices) noexcept
+            {
+                // index i of a lane becomes bytes { 4i, 4i + 1, 4i + 2, 4i + 3 } of the lane
+                const ints bytesIndices = _mm_add_epi32(_mm_mullo_epi32(indices, _mm_set1_epi32(0x04040404)), _mm_set1_epi32(0x03020100));
+                return _mm_shuffle_epi8(value, bytesIndices);
+            }
+
+            // shuffles bytes inside each 32-bit lane: byte i of a lane is taken from the byte (`mask` >> 8i) & 0xFF of it
+            inline ints shuffleBytesOfLanes(const ints value, const std::int32_t mask) noexcept
+            {
+                const ints bytesIndices = _mm_add_epi32(_mm_set1_epi32(mask), _mm_setr_epi32(0, 0x04040404, 0x08080808, 0x0C0C0C0C));
+                return _mm_shuffle_epi8(value, bytesIndices);
+            }
+    #endif
+
+            // converts pixels loaded from mglass::ARGB to the layout of the Format
+            template<PixelFormat Format>
+            ints toFormat(const ints pixels) noexcept
+            {
+                using Layout = mglass::detail::PixelLayout<Format>;
+
+                if constexpr (Format == PixelFormat::ARGB)
+                {
+                    return pixels;
+                }
+                else
+                {
+                    // offsets of the channels of mglass::ARGB: a = 0, r = 1, g = 2, b = 3
+                    constexpr std::int32_t mask = (0 << (8 * Layout::a)) | (1 << (8 * Layout::r))
+                                                | (2 << (8 * Layout::g)) | (3 << (8 * Layout::b));
+
+                    return shuffleBytesOfLanes(pixels, mask);
+                }
+            }
+        } // namespace simd
+
+
+        // columns of the `imageSrc` onto which the pixels [x; x + lanesCount) of a row are mapped
+        //  (the same as the scalar calculations of the magnifiers)
+        simd::ints srcColumnsOf(const RowMapping& mapping, const int_type x) noexcept
+        {
+            using namespace simd;
+
+            const floats xs = toFloats(add(set(static_cast<std::int32_t>(x)), laneIndices()));
+
+            const floats scaleCenterX = set(mapping.scaleCenterX);
+            const floats srcPointX = add(scaleCenterX, mul(sub(xs, scaleCenterX), set(mapping.scaleFactor)));
+
+            return sub(truncToInts(floor(srcPointX)), set(static_cast<std::int32_t>(mapping.imageSrcLeft)));
+        }
+    } // namespace
+#endif // MGLASS_MAGNIFIERS_SIMD
+
+
+    // ================================================================================================================
+    //  interpolateRow
+    // ================================================================================================================
+
+    namespace
+    {
+        // Each row of the taps is filtered along x first, the sums of the channels are rounded to
+        //  interpolationRowSumBits fractional bits to fit the 16-bit operands of the filtering along y.
+        // The magnitudes of the sums are below 1.5 * 255 * (1 << interpolationRowSumBits) for all the interpolators.
+        constexpr int interpolationRowSumBits = interpolationWeightBits - 8;
+        constexpr int interpolationRowShift = interpolationWeightBits - interpolationRowSumBits;
+        constexpr int interpolationSumShift = interpolationWeightBits + interpolationRowSumBits;
+
+        static_assert( (static_cast<std::int32_t>(0xFF * 3 / 2) << interpolationRowSumBits) <= 0x7FFF );
+
+        // a, r, g, b
+        constexpr unsigned channelsCount = 4;
+
+
+#ifdef MGLASS_MAGNIFIERS_SIMD
+        // interpolates `simd::lanesCount` pixels starting at the `column` of the `columns` table
+        template<int TapsCount>
+        void interpolatePixels(
+            const AxisInterpolationTable& columns,
+            const size_type column,
+            const std::int32_t (&rowsWeightsPairs)[TapsCount / 2],
+            const ARGB* const (&srcRows)[TapsCount],
+            ARGB* const result) noexcept
+        {
+            using namespace simd;
+
+            static_assert(sizeof(ARGB) == sizeof(std::int32_t), "mglass::ARGB is expected to have no padding");
+
+            constexpr int pairsCount = TapsCount / 2;
+
+            ints srcColumns[TapsCount];
+            for (int tap = 0; tap < TapsCount; ++tap)
+                srcColumns[tap] = load(columns.getPixelsOfTap(tap) + column);
+
+            ints columnsWeights[pairsCount];
+            for (int pair = 0; pair < pairsCount; ++pair)
+                columnsWeights[pair] = load(columns.getWeightsOfPair(pair) + column * 2);
+
+            const ints channelsMask = set(std::int32_t{0x00FF00FF});
+            const ints highHalvesMask = set(static_cast<std::int32_t>(0xFFFF0000));
+            const ints rowRounding = set(std::int32_t{1} << (interpolationRowShift - 1));
+
+            ints sums[channelsCount];
+            for (auto& sum : sums)
+                sum = set(std::int32_t{1} << (interpolationSumShift - 1));
+
+            for (int rowsPair = 0; rowsPair < pairsCount; ++rowsPair)
+            {
+                ints rowsSums[2][channelsCount];
+
+                for (int i = 0; i < 2; ++i)
+                {
+                    const ARGB* const srcRow = srcRows[rowsPair * 2 + i];
+
+                    ints (&rowSums)[channelsCount] = rowsSums[i];
+                    for (auto& sum : rowSums)
+                        sum = rowRounding;
+
+                    for (int pair = 0; pair < pairsCount; ++pair)
+                    {
+                        const ints pixels0 = gather(srcRow, srcColumns[pair * 2]);
+                        const ints pixels1 = gather(srcRow, srcColumns[pair * 2 + 1]);
+
+                        // { a, g } and { r, b } of each pixel
+                        const ints ag0 = bitAnd(pixels0, channelsMask);
+                        const ints ag1 = bitAnd(pixels1, channelsMask);
+                        const ints rb0 = bitAnd(shiftRight<8>(pixels0), channelsMask);
+                        const ints rb1 = bitAnd(shiftRight<8>(pixels1), channelsMask);
+
+                        // { channel of the tap 2j, channel of the tap 2j + 1 } pairs
+                        const ints channelsPairs[channelsCount] = {
+                            blendHigh16(ag0, shiftLeft<16>(ag1)),
+                            blendHigh16(rb0, shiftLeft<16>(rb1)),
+                            blendHigh16(shiftRight<16>(ag0), bitAnd(ag1, highHalvesMask)),
+                            blendHigh16(shiftRight<16>(rb0), bitAnd(rb1, highHalvesMask))
+                        };
+
+                        for (unsigned channel = 0; channel < channelsCount; ++channel)
+                            rowSums[channel] = add(rowSums[channel], multiplyAdd16(channelsPairs[channel], columnsWeights[pair]));
+                    }
+
+                    for (auto& sum : rowSums)
+                        sum = shiftRightArithmetic<interpolationRowShift>(sum);
+                }
+
+                const ints rowsWeights = set(rowsWeightsPairs[rowsPair]);
+
+                for (unsigned channel = 0; channel < channelsCount; ++channel)
+                {
+                    const ints rowsSumsPair = blendHigh16(rowsSums[0][channel], shiftLeft<16>(rowsSums[1][channel]));
+                    sums[channel] = add(sums[channel], multiplyAdd16(rowsSumsPair, rowsWeights));
+                }
+            }
+
+            const ints zero = set(std::int32_t{0});
+            const ints channelMax = set(std::int32_t{0xFF});
+
+            ints channels[channelsCount];
+            for (unsigned channel = 0; channel < channelsCount; ++channel)
+                channels[channel] = min(max(shiftRightArithmetic<interpolationSumShift>(sums[channel]), zero), channelMax);
+
+            // channels are ordered as a, r, g, b
+            store(result, bitOr(
+                bitOr(channels[0], shiftLeft<8>(channels[1])),
+                bitOr(shiftLeft<16>(channels[2]), shiftLeft<24>(channels[3]))
+            ));
+        }
+#endif // MGLASS_MAGNIFIERS_SIMD
+    } // namespace
+
+
+    template<int TapsCount>
+    void interpolateRow(
+        const ImageSpan& imageSrc,
+        const InterpolationTables& tables,
+        const int_type y,
+        const int_type xBegin,
+        const int_type xEnd,
+        ARGB* result) noexcept
+    {
+        const AxisInterpolationTable& columns = tables.columns;
+        const AxisInterpolationTable& rows = tables.rows;
+
+        assert( (columns.tapsCount == TapsCount) && (rows.tapsCount == TapsCount) );
+
+        const auto row = static_cast<size_type>(y - rows.begin);
+
+        std::int32_t rowsWeights[TapsCount];    // NOLINT (initialization is below)
+        const ARGB* srcRows[TapsCount];         // NOLINT (initialization is below)
+
+        for (int tap = 0; tap < TapsCount; ++tap)
+        {
+            rowsWeights[tap] = rows.getWeightsOfPair(tap / 2)[row * 2 + static_cast<size_type>(tap % 2)];
+            srcRows[tap] = imageSrc.getBorderedRowData(rows.getPixelsOfTap(tap)[row]);
+        }
+
+        auto column = static_cast<size_type>(xBegin - columns.begin);
+        const auto columnsEnd = static_cast<size_type>(xEnd - columns.begin);
+
+#ifdef MGLASS_MAGNIFIERS_SIMD
+        constexpr int pairsCount = TapsCount / 2;
+
+        std::int32_t rowsWeightsPairs[pairsCount]; // NOLINT (initialization is below)
+
+        for (int pair = 0; pair < pairsCount; ++pair)
+        {
+            const auto low = static_cast<std::uint16_t>(rowsWeights[pair * 2]);
+            const auto high = static_cast<std::uint16_t>(rowsWeights[pair * 2 + 1]);
+
+            rowsWeightsPairs[pair] = static_cast<std::int32_t>(low | (static_cast<std::uint32_t>(high) << 16));
+        }
+
+        for (; column + simd::lanesCount <= columnsEnd; column += simd::lanesCount, result += simd::lanesCount)
+            interpolatePixels<TapsCount>(columns, column, rowsWeightsPairs, srcRows, result);
+#endif
+
+        // the same calculations as the ones of the SIMD implementation
+        for (; column < columnsEnd; ++column, ++result)
+        {
+            std::int32_t sums[channelsCount];
+            for (auto& sum : sums)
+                sum = std::int32_t{1} << (interpolationSumShift - 1);
+
+            for (int rowTap = 0; rowTap < TapsCount; ++rowTap)
+            {
+                std::int32_t rowSums[channelsCount];
+                for (auto& sum : rowSums)
+                    sum = std::int32_t{1} << (interpolationRowShift - 1);
+
+                for (int tap = 0; tap < TapsCount; ++tap)
+                {
+                    const std::int32_t weight = columns.getWeightsOfPair(tap / 2)[column * 2 + static_cast<size_type>(tap % 2)];
+                    const ARGB pixel = srcRows[rowTap][columns.getPixelsOfTap(tap)[column]];
+
+                    rowSums[0] += weight * pixel.a;
+                    rowSums[1] += weight * pixel.r;
+                    rowSums[2] += weight * pixel.g;
+                    rowSums[3] += weight * pixel.b;
+                }
+
+                // right shifts of negative values are arithmetic on all the supported compilers
+                for (unsigned channel = 0; channel < channelsCount; ++channel)
+                    sums[channel] += rowsWeights[rowTap] * (rowSums[channel] >> interpolationRowShift);
+            }
+
+            std::uint8_t channels[channelsCount];
+            for (unsigned channel = 0; channel < channelsCount; ++channel)
+                channels[channel] = static_cast<std::uint8_t>( (std::min)((std::max)(sums[channel] >> interpolationSumShift, 0), 0xFF) );
+
+            *result = { channels[0], channels[1], channels[2], channels[3] };
+        }
+    }
+
+    template void interpolateRow<2>(const ImageSpan&, const InterpolationTables&, int_type, int_type, int_type, ARGB*) noexcept;
+    template void interpolateRow<4>(const ImageSpan&, const InterpolationTables&, int_type, int_type, int_type, ARGB*) noexcept;
+    template void interpolateRow<6>(const ImageSpan&, const InterpolationTables&, int_type, int_type, int_type, ARGB*) noexcept;
+
+
+    // ================================================================================================================
+    //  copyNearestRow
+    // ================================================================================================================
+
+#ifndef MGLASS_MAGNIFIERS_SIMD
+    // The minimal magnification for which copyNearestRow fills runs of pixels instead of copying pixels one by one.
+    // The vectorized copying is faster than filling runs at all practical magnifications, so runs are used only
+    //  by the scalar build.
+    constexpr float_type minScaleOfRuns = 8;
+
+    namespace
+    {
+        // writes `count` copies of the `color` in the DstFormat into `dst`
+        template<PixelFormat DstFormat>
+        void fillPixels(std::uint8_t* const dst, const int_type count, const ARGB color) noexcept
+        {
+            std::uint8_t pixel[MutableImageSpan::bytesPerPixel];
+            mglass::detail::storePixel<DstFormat>(pixel, color);
+
+            for (int_type i = 0; i < count; ++i)
+                std::memcpy(dst + i * MutableImageSpan::bytesPerPixel, pixel, sizeof(pixel));
+        }
+
+        // copyNearestRow for the case when runs of adjacent pixels of the row are mapped onto the same pixel
+        template<PixelFormat DstFormat>
+        void fillNearestRuns(const RowMapping& mapping, const int_type xBegin, const int_type xEnd, std::uint8_t* const dst) noexcept
+        {
+            const ARGB* const srcRowData = mapping.imageSrc.getRowData(mapping.srcRow);
+
+            const auto columnOf = [&mapping](const int_type x) noexcept {
+                const float_type srcPointX = scaleCoordinateBy(mapping.scaleFactor, mapping.scaleCenterX, static_cast<float_type>(x));
+                return static_cast<int_type>(std::floor(srcPointX)) - mapping.imageSrcLeft;
+            };
+
+            // used only for estimations of the runs' lengths, the exact mapping is checked by columnOf
+            const double scaleCenterX = mapping.scaleCenterX;
+            const double inversedScaleFactor = 1. / static_cast<double>(mapping.scaleFactor);
+
+            int_type runBegin = xBegin;
+            int_type column = columnOf(runBegin);
+
+            while (runBegin < xEnd)
+            {
+                // estimate the first pixel mapped onto the next column
+                const double nextColumnStart = static_cast<double>(column) + mapping.imageSrcLeft + 1;
+                const double runEndEstimation = std::ceil(scaleCenterX + (nextColumnStart - scaleCenterX) * inversedScaleFactor);
+
+                auto runEnd = static_cast<int_type>(
+                    (std::min)( (std::max)(runEndEstimation, static_cast<double>(runBegin + 1)), static_cast<double>(xEnd) )
+                );
+
+                // columns do not decrease while x grows, so the estimation is fixed by moving it
+                while ((runEnd - 1 > runBegin) && (columnOf(runEnd - 1) != column))
+                    --runEnd;
+
+                int_type nextColumn = column;
+                while ((runEnd < xEnd) && ((nextColumn = columnOf(runEnd)) == column))
+                    ++runEnd;
+
+                fillPixels<DstFormat>(
+                    dst + static_cast<size_type>(runBegin - xBegin) * MutableImageSpan::bytesPerPixel,
+                    runEnd - runBegin,
+                    srcRowData[column]
+                );
+
+                runBegin = runEnd;
+                column = nextColumn;
+            }
+        }
+    } // namespace
+#endif // ndef MGLASS_MAGNIFIERS_SIMD
+
+
+    template<PixelFormat DstFormat>
+    void copyNearestRow(const RowMapping& mapping, const int_type xBegin, const int_type xEnd, std::uint8_t* dst) noexcept
+    {
+#ifndef MGLASS_MAGNIFIERS_SIMD
+        // magnifying more than minScaleOfRuns times makes runs long enough to fill them one by one
+        if (mapping.scaleFactor * minScaleOfRuns <= 1)
+            return fillNearestRuns<DstFormat>(mapping, xBegin, xEnd, dst);
+#endif
+
+        const ARGB* const srcRowData = mapping.imageSrc.getRowData(mapping.srcRow);
+
+        int_type x = xBegin;
+
+#ifdef MGLASS_MAGNIFIERS_SIMD
+        {
+            using namespace simd;
+
+            // the number of the pixels of a row which can be loaded (the replicated border after the last column included)
+            const auto loadableWidth = static_cast<std::int32_t>(mapping.imageSrc.getWidth() + mapping.imageSrc.getReplicatedBorder());
+
+            for (; x + lanesCount <= xEnd; x += lanesCount, dst += lanesCount * MutableImageSpan::bytesPerPixel)
+            {
+                const ints columns = srcColumnsOf(mapping, x);
+                const std::int32_t firstColumn = firstLaneOf(columns);
+
+                // columns do not decrease, so while magnifying all the required pixels are usually
+                //  inside the vector loaded at the first column and can be taken from it by a shuffle
+                const ints pixels = ( (lastLaneOf(columns) - firstColumn < lanesCount) && (firstColumn + lanesCount <= loadableWidth) )
+                    ? permute(load(srcRowData + firstColumn), sub(columns, set(firstColumn)))
+                    : gather(srcRowData, columns);
+
+                store(dst, toFormat<DstFormat>(pixels));
+            }
+        }
+#endif
+
+        for (; x < xEnd; ++x, dst += MutableImageSpan::bytesPerPixel)
+        {
+            const float_type srcPointX = scaleCoordinateBy(mapping.scaleFactor, mapping.scaleCenterX, static_cast<float_type>(x));
+            const float_type pixelStartX = std::floor(srcPointX);
+
+            const auto srcColumn = static_cast<size_type>(static_cast<int_type>(pixelStartX) - mapping.imageSrcLeft);
+
+            mglass::detail::storePixel<DstFormat>(dst, srcRowData[srcColumn]);
+        }
+    }
+
+    template void copyNearestRow<PixelFormat::ARGB>(const RowMapping&, int_type, int_type, std::uint8_t*) noexcept;
+    template void copyNearestRow<PixelFormat::BGRA>(const RowMapping&, int_type, int_type, std::uint8_t*) noexcept;
+    template void copyNearestRow<PixelFormat::RGBA>(const RowMapping&, int_type, int_type, std::uint8_t*) noexcept;
 } // namespace mglass::magnifiers::detail
@@ -0,0 +1,151 @@
+#include "mglass/mask_shape.h"
+#include <memory>   // std::make_shared
+#include <utility>  // std::move
+
+
+namespace mglass::shapes
+{
+    // ================================================================================================================
+    //  MaskOutline
+    // ================================================================================================================
+
+    MaskOutline::MaskOutline(const ImageSpan& image)
+    {
+        const size_type width = image.getWidth();
+        const size_type height = image.getHeight();
+
+        std::vector<std::uint8_t> coverages(width * height);
+
+        for (size_type row = 0; row < height; ++row)
+        {
+            const ARGB* const rowData = image.getRowData(row);
+
+            for (size_type col = 0; col < width; ++col)
+                coverages[row * width + col] = rowData[col].a;
+        }
+
+        assignRuns(coverages, width, height);
+    }
+
+
+    MaskOutline MaskOutline::fromBits(
+        const size_type width,
+        const size_type height,
+        const std::uint8_t* const packedBits)
+    {
+        const size_type rowBytes = (width + 7) / 8;
+
+        std::vector<std::uint8_t> coverages(width * height);
+
+        for (size_type row = 0; row < height; ++row)
+        {
+            const std::uint8_t* const rowBits = packedBits + row * rowBytes;
+
+            for (size_type col = 0; col < width; ++col)
+            {
+                const bool isSet = ((rowBits[col / 8] >> (7 - col % 8)) & 1) != 0;
+                coverages[row * width + col] = isSet ? 255 : 0;
+            }
+        }
+
+        MaskOutline result;
+        result.assignRuns(coverages, width, height);
+
+        return result;
+    }
+
+
+    void MaskOutline::assignRuns(const std::vector<std::uint8_t>& coverages, const size_type width, const size_type height)
+    {
+        // the covered rows and columns
+        size_type rowBegin = height;
+        size_type rowEnd = 0;
+        size_type colBegin = width;
+        size_type colEnd = 0;
+
+        for (size_type row = 0; row < height; ++row)
+        {
+            for (size_type col = 0; col < width; ++col)
+            {
+                if (coverages[row * width + col] == 0)
+                    continue;
+
+                rowBegin = (std::min)(rowBegin, row);
+                rowEnd = (std::max)(rowEnd, row + 1);
+                colBegin = (std::min)(colBegin, col);
+                colEnd = (std::max)(colEnd, col + 1);
+            }
+        }
+
+        runs_.clear();
+        coverages_.clear();
+        rowsRuns_.assign(1, 0);
+
+        if (rowBegin >= rowEnd)
+        {
+            bounds_ = { {0, 0}, 0, 0 };
+            return;
+        }
+
+        bounds_ = { { static_cast<int_type>(colBegin), -static_cast<int_type>(rowBegin) },
+                    colEnd - colBegin,
+                    rowEnd - rowBegin };
+
+        for (size_type row = rowBegin; row < rowEnd; ++row)
+        {
+            const std::uint8_t* const rowCoverages = coverages.data() + row * width;
+
+            for (size_type col = colBegin; col < colEnd;)
+            {
+                if (rowCoverages[col] == 0)
+                {
+                    ++col;
+                    continue;
+                }
+
+                const size_type runBegin = col;
+                for (; (col < colEnd) && (rowCoverages[col] != 0); ++col)
+                    coverages_.push_back(rowCoverages[col]);
+
+                runs_.push_back({
+                    static_cast<int_type>(runBegin),
+                    static_cast<int_type>(col),
+                    coverages_.size() - (col - runBegin)
+                });
+            }
+
+            rowsRuns_.push_back(runs_.size());
+        }
+    }
+
+
+    // ================================================================================================================
+    //  Mask
+    // ================================================================================================================
+
+    Mask::Mask()
+        : Mask({0, 0}, std::make_shared<const MaskOutline>())
+    {}
+
+    Mask::Mask(const ImageSpan& image, const Point<int_type> topLeft)
+        : Mask(topLeft, std::make_shared<const MaskOutline>(image))
+    {}
+
+    Mask::Mask(const Point<int_type> topLeft, std::shared_ptr<const MaskOutline> outline) noexcept
+        : topLeft_(topLeft)
+        , outline_(std::move(outline))
+    {}
+
+
+    ShapeRectArea Mask::getBoundsImpl() const noexcept
+    {
+        const IntegralRectArea& outlineBounds = outline_->getBounds();
+
+        return {
+            { static_cast<float_type>(topLeft_.x + outlineBounds.topLeft.x),
+              static_cast<float_type>(topLeft_.y + outlineBounds.topLeft.y) },
+            static_cast<float_type>((std::max)(outlineBounds.width, size_type{1}) - 1),
+            static_cast<float_type>((std::max)(outlineBounds.height, size_type{1}) - 1)
+        };
+    }
+} // namespace mglass::shapes
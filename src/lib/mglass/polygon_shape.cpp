@@ -0,0 +1,107 @@
+#include "mglass/polygon_shape.h"
+#include <algorithm>    // std::sort, std::min, std::max
+#include <cmath>        // std::cos, std::sin
+#include <memory>       // std::make_shared
+#include <utility>      // std::move
+
+
+namespace mglass::shapes
+{
+    // ================================================================================================================
+    //  PolygonOutline
+    // ================================================================================================================
+
+    PolygonOutline::PolygonOutline(std::vector<Point<float_type>> vertices)
+        : vertices_(std::move(vertices))
+        , edges_()
+        , bounds_{ {0, 0}, 0, 0 }
+    {
+        // there is no area inside less than 3 vertices
+        if (vertices_.size() < 3)
+            return;
+
+        float_type left = vertices_.front().x;
+        float_type right = left;
+        float_type bottom = vertices_.front().y;
+        float_type top = bottom;
+
+        for (size_type i = 0; i < vertices_.size(); ++i)
+        {
+            const Point<float_type> begin = vertices_[i];
+            const Point<float_type> end = vertices_[(i + 1) % vertices_.size()];
+
+            left = (std::min)(left, begin.x);
+            right = (std::max)(right, begin.x);
+            bottom = (std::min)(bottom, begin.y);
+            top = (std::max)(top, begin.y);
+
+            // horizontal edges do not cross the scanlines
+            if (begin.y == end.y)
+                continue;
+
+            const Point<float_type> lower = (begin.y < end.y) ? begin : end;
+            const Point<float_type> upper = (begin.y < end.y) ? end : begin;
+
+            edges_.push_back({ lower.y, upper.y, lower.x, (upper.x - lower.x) / (upper.y - lower.y) });
+        }
+
+        std::sort(edges_.begin(), edges_.end(), [](const Edge& lhs, const Edge& rhs) {
+            return (lhs.yTop > rhs.yTop);
+        });
+
+        bounds_ = { { left, top }, right - left, top - bottom };
+    }
+
+
+    // ================================================================================================================
+    //  Polygon
+    // ================================================================================================================
+
+    Polygon::Polygon(Point<float_type> center, std::vector<Point<float_type>> vertices)
+        : center_(center)
+        , outline_(std::make_shared<const PolygonOutline>(std::move(vertices)))
+    {}
+
+    Polygon::Polygon(Point<float_type> center, std::shared_ptr<const PolygonOutline> outline) noexcept
+        : center_(center)
+        , outline_(std::move(outline))
+    {}
+
+    Polygon Polygon::regular(
+        const Point<float_type> center,
+        const size_type verticesCount,
+        const float_type width,
+        const float_type height)
+    {
+        constexpr double pi = 3.14159265358979323846;
+
+        std::vector<Point<float_type>> vertices;
+        vertices.reserve(verticesCount);
+
+        for (size_type i = 0; i < verticesCount; ++i)
+        {
+            // counterclockwise from the top
+            const double angle = pi / 2 + 2 * pi * static_cast<double>(i) / static_cast<double>(verticesCount);
+
+            vertices.push_back({
+                static_cast<float_type>(width / 2 * std::cos(angle)),
+                static_cast<float_type>(height / 2 * std::sin(angle))
+            });
+        }
+
+        return Polygon{ center, std::move(vertices) };
+    }
+
+
+    ShapeRectArea Polygon::getBoundsImpl() const noexcept
+    {
+        const ShapeRectArea& outlineBounds = outline_->getBounds();
+
+        return {
+            { center_.x + outlineBounds.topLeft.x, center_.y + outlineBounds.topLeft.y },
+            outlineBounds.width,
+            outlineBounds.height
+        };
+    }
+
+} // namespace mglass::shapes
@@ -0,0 +1,48 @@
+#include "mglass/prepared_source.h"
+#include <algorithm>    // std::min, std::fill_n, std::copy_n
+
+
+namespace mglass
+{
+    PreparedSource::PreparedSource(const ImageSpan& image)
+        : width_(image.getWidth())
+        , height_(image.getHeight())
+    {
+        if ( (width_ < 1) || (height_ < 1) )
+            return;
+
+        const size_type rowStride = width_ + 2 * borderSize;
+
+        pixels_.resize(rowStride * (height_ + 2 * borderSize));
+
+        // the rows of the border replicate the first and the last rows of the image
+        for (size_type row = 0; row < height_ + 2 * borderSize; ++row)
+        {
+            const size_type y = (row < borderSize) ? 0 : (std::min)(row - borderSize, height_ - 1);
+
+            const ARGB* const src = image.getRowData(y);
+            ARGB* const dst = pixels_.data() + row * rowStride;
+
+            std::fill_n(dst, borderSize, src[0]);
+            std::copy_n(src, width_, dst + borderSize);
+            std::fill_n(dst + borderSize + width_, borderSize, src[width_ - 1]);
+        }
+    }
+
+
+    ImageSpan PreparedSource::getImage() const noexcept
+    {
+        if (pixels_.empty())
+            return {};
+
+        const size_type rowStride = width_ + 2 * borderSize;
+
+        return {
+            pixels_.data() + borderSize * rowStride + borderSize,
+            width_,
+            height_,
+            rowStride,
+            borderSize
+        };
+    }
+} // namespace mglass
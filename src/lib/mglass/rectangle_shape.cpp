@@ -1,12 +1,19 @@
 #include "mglass/rectangle_shape.h"
+#include <algorithm>    // std::max
+#include <cmath>        // std::abs
 
 
 namespace mglass::shapes
 {
-    Rectangle::Rectangle(Point<float_type> center, float_type width, float_type height) noexcept
+    Rectangle::Rectangle(
+        Point<float_type> center,
+        float_type width,
+        float_type height,
+        const FalloffProfile& falloff) noexcept
         : center_(center)
         , width_(width)
         , height_(height)
+        , falloff_(&falloff)
     {}
 
 
@@ -15,4 +22,54 @@ namespace mglass::shapes
         return { { center_.x - width_ / 2, center_.y + height_ / 2 }, width_, height_ };
     }
 
+    BlockCoverage Rectangle::classifyBlockImpl(const IntegralRectArea& block) const noexcept
+    {
+        using namespace literals;
+
+        if ((block.width < 1) || (block.height < 1))
+            return BlockCoverage::Outside;
+
+        const ShapeRectArea bounds = getBoundsImpl();
+
+        const int_type blockLeft = block.topLeft.x;
+        const int_type blockRight = block.topLeft.x + static_cast<int_type>(block.width - 1);
+        const int_type blockTop = block.topLeft.y;
+        const int_type blockBottom = block.topLeft.y - static_cast<int_type>(block.height - 1);
+
+        const auto getCenterOf = [](const int_type coordinate) { return static_cast<float_type>(coordinate) + 0.5_flt; };
+
+        // the centers of the rasterized pixels are inside [left; right) x (bottom; top] (see rasterizeSpansOntoImpl)
+        const float_type left = bounds.topLeft.x;
+        const float_type right = bounds.topLeft.x + bounds.width;
+        const float_type top = bounds.topLeft.y;
+        const float_type bottom = bounds.topLeft.y - bounds.height;
+
+        if ( (getCenterOf(blockRight) < left) || (getCenterOf(blockLeft) >= right) ||
+             (getCenterOf(blockBottom) > top) || (getCenterOf(blockTop) <= bottom) )
+        {
+            return BlockCoverage::Outside;
+        }
+
+        if ( (getCenterOf(blockLeft) < left) || (getCenterOf(blockRight) >= right) ||
+             (getCenterOf(blockTop) > top) || (getCenterOf(blockBottom) <= bottom) )
+        {
+            return BlockCoverage::Edge;
+        }
+
+        // the least u is at a corner of the block, it is calculated like the ones of the pixels
+        //  (see RectangleRastrContext) and the rounding is monotonic
+        const auto getRelativeLengthOf = [](const int_type first, const int_type last, const float_type center, const float_type length) {
+            const float_type distance = (std::max)(
+                std::abs(static_cast<float_type>(first) - center),
+                std::abs(static_cast<float_type>(last) - center)
+            );
+            return 1_flt - 2_flt * distance / length;
+        };
+
+        const float_type u = getRelativeLengthOf(blockLeft, blockRight, center_.x, width_) *
+                             getRelativeLengthOf(blockBottom, blockTop, center_.y, height_);
+
+        return (u >= falloff_->getSolidDistance()) ? BlockCoverage::Inside : BlockCoverage::Edge;
+    }
+
 } // namespace mglass::shapes
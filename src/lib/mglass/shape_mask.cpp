@@ -0,0 +1,99 @@
+#include "mglass/shape_mask.h"
+#include <algorithm>    // std::rotate
+#include <cmath>        // std::llround
+
+
+namespace mglass
+{
+    namespace
+    {
+        // splits the `coordinate` rounded to 1/`steps` into the integral part and the fraction (in 1/`steps`)
+        void quantizeCoordinate(
+            const float_type coordinate,
+            const int_type steps,
+            int_type& integral,
+            int_type& fraction) noexcept
+        {
+            const auto quantized = static_cast<int_type>(std::llround(static_cast<double>(coordinate) * steps));
+
+            fraction = quantized % steps;
+            if (fraction < 0)
+                fraction += steps;
+
+            integral = (quantized - fraction) / steps;
+        }
+    } // namespace
+
+
+    ShapeMaskCache::ShapeMaskCache(const size_type capacity) noexcept
+        : capacity_((capacity < 1) ? 1 : capacity)
+    {}
+
+
+    void ShapeMaskCache::clear() noexcept
+    {
+        entries_.clear();
+    }
+
+
+    bool ShapeMaskCache::Key::operator==(const Key& rhs) const noexcept
+    {
+        return (shapeType == rhs.shapeType) &&
+               (width == rhs.width) &&
+               (height == rhs.height) &&
+               (falloffId == rhs.falloffId) &&
+               outlinesAreEqual(rhs) &&
+               (unitShapeTransform == rhs.unitShapeTransform) &&
+               (centerFractionX == rhs.centerFractionX) &&
+               (centerFractionY == rhs.centerFractionY);
+    }
+
+
+    bool ShapeMaskCache::Key::outlinesAreEqual(const Key& rhs) const noexcept
+    {
+        if (outline == rhs.outline)
+            return true;
+
+        // the types of the shapes are the same, so the outlines have the same type
+        return (outlinesEqual != nullptr) && (outline != nullptr) && (rhs.outline != nullptr) &&
+               outlinesEqual(outline.get(), rhs.outline.get());
+    }
+
+
+    ShapeMaskCache::QuantizedCenter ShapeMaskCache::quantizeCenterOf(const ShapeRectArea& bounds) noexcept
+    {
+        QuantizedCenter result{};
+
+        quantizeCoordinate(bounds.topLeft.x + bounds.width / 2, subpixelSteps, result.integral.x, result.fraction.x);
+        quantizeCoordinate(bounds.topLeft.y - bounds.height / 2, subpixelSteps, result.integral.y, result.fraction.y);
+
+        return result;
+    }
+
+
+    const ShapeMaskCache::Entry* ShapeMaskCache::find(const Key& key) noexcept
+    {
+        for (auto it = entries_.begin(); it != entries_.end(); ++it)
+        {
+            if (it->key == key)
+            {
+                // moves the found entry to the front keeping the order of the others
+                std::rotate(entries_.begin(), it, it + 1);
+                return &entries_.front();
+            }
+        }
+
+        return nullptr;
+    }
+
+
+    const ShapeMaskCache::Entry& ShapeMaskCache::insert(Entry&& entry)
+    {
+        if (entries_.size() >= capacity_)
+            entries_.pop_back();
+
+        entries_.insert(entries_.begin(), std::move(entry));
+
+        return entries_.front();
+    }
+} // namespace mglass
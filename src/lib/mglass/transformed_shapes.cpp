@@ -0,0 +1,88 @@
+#include "mglass/transformed_shapes.h"
+
+
+namespace mglass::shapes
+{
+    namespace
+    {
+        // returns the transform of the unit shape into the shape of the size `width` x `height`
+        //  transformed by the `transform` (without the translation)
+        AffineTransform getUnitShapeTransformOf(
+            const float_type width,
+            const float_type height,
+            const AffineTransform& transform) noexcept
+        {
+            return transform.getLinearPart() * AffineTransform::scaling(width / 2, height / 2);
+        }
+
+        // returns the center of the shape placed at the `center` and transformed by the `transform`
+        Point<float_type> getTransformedCenterOf(const Point<float_type> center, const AffineTransform& transform) noexcept
+        {
+            return { center.x + transform.dx, center.y + transform.dy };
+        }
+    } // namespace
+
+
+    // ================================================================================================================
+    //  TransformedEllipse
+    // ================================================================================================================
+
+    TransformedEllipse::TransformedEllipse(
+        const Point<float_type> center,
+        const float_type xAxis,
+        const float_type yAxis,
+        const AffineTransform& transform,
+        const FalloffProfile& falloff) noexcept
+        : center_(getTransformedCenterOf(center, transform))
+        , unitShapeTransform_(getUnitShapeTransformOf(xAxis, yAxis, transform))
+        , falloff_(&falloff)
+    {}
+
+
+    ShapeRectArea TransformedEllipse::getBoundsImpl() const noexcept
+    {
+        const AffineTransform& t = unitShapeTransform_;
+
+        // the extreme points of the transformed unit circle (cos(a) * (xx; yx) + sin(a) * (xy; yy))
+        const float_type halfWidth = std::sqrt(t.xx * t.xx + t.xy * t.xy);
+        const float_type halfHeight = std::sqrt(t.yx * t.yx + t.yy * t.yy);
+
+        return {
+            { center_.x - halfWidth, center_.y + halfHeight },
+            halfWidth * 2,
+            halfHeight * 2
+        };
+    }
+
+
+    // ================================================================================================================
+    //  TransformedRectangle
+    // ================================================================================================================
+
+    TransformedRectangle::TransformedRectangle(
+        const Point<float_type> center,
+        const float_type width,
+        const float_type height,
+        const AffineTransform& transform,
+        const FalloffProfile& falloff) noexcept
+        : center_(getTransformedCenterOf(center, transform))
+        , unitShapeTransform_(getUnitShapeTransformOf(width, height, transform))
+        , falloff_(&falloff)
+    {}
+
+
+    ShapeRectArea TransformedRectangle::getBoundsImpl() const noexcept
+    {
+        const AffineTransform& t = unitShapeTransform_;
+
+        // the extreme points of the transformed square are its corners (+-(xx; yx) +- (xy; yy))
+        const float_type halfWidth = std::abs(t.xx) + std::abs(t.xy);
+        const float_type halfHeight = std::abs(t.yx) + std::abs(t.yy);
+
+        return {
+            { center_.x - halfWidth, center_.y + halfHeight },
+            halfWidth * 2,
+            halfHeight * 2
+        };
+    }
+} // namespace mglass::shapes
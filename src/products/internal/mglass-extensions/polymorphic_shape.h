@@ -9,6 +9,9 @@
 namespace mglass
 {
     class Image;
+    class ImageSpan;
+    class MutableImageSpan;
+    class MagnifierPlan;
 }
 
 
@@ -36,19 +39,43 @@ namespace mglassext
         virtual mglass::float_type getWidth() const noexcept = 0;
         virtual mglass::float_type getHeight() const noexcept = 0;
 
+        // the area of the pixels which can be rasterized by the shape (see mglass::getShapeIntegralBounds)
+        virtual mglass::IntegralRectArea getIntegralBounds() const noexcept = 0;
+
+        // returns the plan for magnifying the shape at many positions (see mglass::MagnifierPlan)
+        virtual mglass::MagnifierPlan makeMagnifierPlan(mglass::float_type scaleFactor, bool enableAlphaBlending) const = 0;
+
         virtual void applyNearestNeighbor(
             mglass::float_type scaleFactor,
-            const mglass::Image& imageSrc,
+            const mglass::ImageSpan& imageSrc,
             mglass::Point<mglass::int_type> imageTopLeft,
             mglass::Image& imageDst,
             bool enableAlphaBlending) const = 0;
 
         virtual void applyNearestNeighborAntiAliased(
             mglass::float_type scaleFactor,
-            const mglass::Image& imageSrc,
+            const mglass::ImageSpan& imageSrc,
             mglass::Point<mglass::int_type> imageTopLeft,
             mglass::Image& imageDst,
             bool enableAlphaBlending) const = 0;
+
+        virtual void applyNearestNeighbor(
+            mglass::float_type scaleFactor,
+            const mglass::ImageSpan& imageSrc,
+            mglass::Point<mglass::int_type> imageTopLeft,
+            const mglass::MutableImageSpan& imageDst,
+            mglass::Point<mglass::int_type> dstOffset,
+            bool enableAlphaBlending,
+            bool fillWithTransparent) const = 0;
+
+        virtual void applyNearestNeighborAntiAliased(
+            mglass::float_type scaleFactor,
+            const mglass::ImageSpan& imageSrc,
+            mglass::Point<mglass::int_type> imageTopLeft,
+            const mglass::MutableImageSpan& imageDst,
+            mglass::Point<mglass::int_type> dstOffset,
+            bool enableAlphaBlending,
+            bool fillWithTransparent) const = 0;
     };
 } // mglassext
 
@@ -1,6 +1,9 @@
 #include "polymorphic_shapes.h"
-#include "mglass/magnifiers.h"  // mglass::magnifiers::*
-#include <stdexcept>            // std::invalid_argument
+#include "mglass/magnifiers.h"      // mglass::magnifiers::*
+#include "mglass/magnifier_plan.h"  // mglass::MagnifierPlan
+#include <memory>                   // std::make_shared
+#include <stdexcept>                // std::invalid_argument
+#include <utility>                  // std::move
 
 
 namespace mglassext
@@ -53,9 +56,19 @@ namespace mglassext
         return height_;
     }
 
+    mglass::IntegralRectArea PolymorphicRectangle::getIntegralBounds() const noexcept
+    {
+        return mglass::getShapeIntegralBounds(*this);
+    }
+
+    mglass::MagnifierPlan PolymorphicRectangle::makeMagnifierPlan(mglass::float_type scaleFactor, bool enableAlphaBlending) const
+    {
+        return mglass::MagnifierPlan{*this, scaleFactor, enableAlphaBlending};
+    }
+
     void PolymorphicRectangle::applyNearestNeighbor(
         mglass::float_type scaleFactor,
-        const mglass::Image& imageSrc,
+        const mglass::ImageSpan& imageSrc,
         mglass::Point<mglass::int_type> imageTopLeft,
         mglass::Image& imageDst,
         bool enableAlphaBlending) const
@@ -65,7 +78,7 @@ namespace mglassext
 
     void PolymorphicRectangle::applyNearestNeighborAntiAliased(
         mglass::float_type scaleFactor,
-        const mglass::Image& imageSrc,
+        const mglass::ImageSpan& imageSrc,
         mglass::Point<mglass::int_type> imageTopLeft,
         mglass::Image& imageDst,
         bool enableAlphaBlending) const
@@ -73,6 +86,32 @@ namespace mglassext
         mglass::magnifiers::nearestNeighborInterpolated(*this, scaleFactor, imageSrc, imageTopLeft, imageDst, enableAlphaBlending);
     }
 
+    void PolymorphicRectangle::applyNearestNeighbor(
+        mglass::float_type scaleFactor,
+        const mglass::ImageSpan& imageSrc,
+        mglass::Point<mglass::int_type> imageTopLeft,
+        const mglass::MutableImageSpan& imageDst,
+        mglass::Point<mglass::int_type> dstOffset,
+        bool enableAlphaBlending,
+        bool fillWithTransparent) const
+    {
+        mglass::magnifiers::nearestNeighbor(
+            *this, scaleFactor, imageSrc, imageTopLeft, imageDst, dstOffset, enableAlphaBlending, fillWithTransparent);
+    }
+
+    void PolymorphicRectangle::applyNearestNeighborAntiAliased(
+        mglass::float_type scaleFactor,
+        const mglass::ImageSpan& imageSrc,
+        mglass::Point<mglass::int_type> imageTopLeft,
+        const mglass::MutableImageSpan& imageDst,
+        mglass::Point<mglass::int_type> dstOffset,
+        bool enableAlphaBlending,
+        bool fillWithTransparent) const
+    {
+        mglass::magnifiers::nearestNeighborInterpolated(
+            *this, scaleFactor, imageSrc, imageTopLeft, imageDst, dstOffset, enableAlphaBlending, fillWithTransparent);
+    }
+
 
     // ================================================================================================================
     //  PolymorphicEllipse
@@ -122,9 +161,19 @@ namespace mglassext
         return yAxisLength_;
     }
 
+    mglass::IntegralRectArea PolymorphicEllipse::getIntegralBounds() const noexcept
+    {
+        return mglass::getShapeIntegralBounds(*this);
+    }
+
+    mglass::MagnifierPlan PolymorphicEllipse::makeMagnifierPlan(mglass::float_type scaleFactor, bool enableAlphaBlending) const
+    {
+        return mglass::MagnifierPlan{*this, scaleFactor, enableAlphaBlending};
+    }
+
     void PolymorphicEllipse::applyNearestNeighbor(
         mglass::float_type scaleFactor,
-        const mglass::Image& imageSrc,
+        const mglass::ImageSpan& imageSrc,
         mglass::Point<mglass::int_type> imageTopLeft,
         mglass::Image& imageDst,
         bool enableAlphaBlending) const
@@ -134,11 +183,154 @@ namespace mglassext
 
     void PolymorphicEllipse::applyNearestNeighborAntiAliased(
         mglass::float_type scaleFactor,
-        const mglass::Image& imageSrc,
+        const mglass::ImageSpan& imageSrc,
         mglass::Point<mglass::int_type> imageTopLeft,
         mglass::Image& imageDst,
         bool enableAlphaBlending) const
     {
         mglass::magnifiers::nearestNeighborInterpolated(*this, scaleFactor, imageSrc, imageTopLeft, imageDst, enableAlphaBlending);
     }
+
+    void PolymorphicEllipse::applyNearestNeighbor(
+        mglass::float_type scaleFactor,
+        const mglass::ImageSpan& imageSrc,
+        mglass::Point<mglass::int_type> imageTopLeft,
+        const mglass::MutableImageSpan& imageDst,
+        mglass::Point<mglass::int_type> dstOffset,
+        bool enableAlphaBlending,
+        bool fillWithTransparent) const
+    {
+        mglass::magnifiers::nearestNeighbor(
+            *this, scaleFactor, imageSrc, imageTopLeft, imageDst, dstOffset, enableAlphaBlending, fillWithTransparent);
+    }
+
+    void PolymorphicEllipse::applyNearestNeighborAntiAliased(
+        mglass::float_type scaleFactor,
+        const mglass::ImageSpan& imageSrc,
+        mglass::Point<mglass::int_type> imageTopLeft,
+        const mglass::MutableImageSpan& imageDst,
+        mglass::Point<mglass::int_type> dstOffset,
+        bool enableAlphaBlending,
+        bool fillWithTransparent) const
+    {
+        mglass::magnifiers::nearestNeighborInterpolated(
+            *this, scaleFactor, imageSrc, imageTopLeft, imageDst, dstOffset, enableAlphaBlending, fillWithTransparent);
+    }
+
+
+    // ================================================================================================================
+    //  PolymorphicPolygon
+    // ================================================================================================================
+
+    PolymorphicPolygon::PolymorphicPolygon(std::vector<mglass::Point<mglass::float_type>> vertices)
+        : mglass::shapes::Polygon({}, std::move(vertices))
+        , prototype_(outline_)
+    {}
+
+    void PolymorphicPolygon::moveCenterTo(mglass::float_type newCenterX, mglass::float_type newCenterY) noexcept
+    {
+        center_.x = newCenterX;
+        center_.y = newCenterY;
+    }
+
+    void PolymorphicPolygon::setSize(mglass::float_type newWidth, mglass::float_type newHeight) noexcept(false)
+    {
+        if (newWidth < 0)
+            throw std::invalid_argument("PolymorphicPolygon::setSize: `newWidth` < 0");
+        if (newHeight < 0)
+            throw std::invalid_argument("PolymorphicPolygon::setSize: `newHeight` < 0");
+
+        if (newWidth == 0) newHeight = 0;
+        if (newHeight == 0) newWidth = 0;
+
+        // the prototype is scaled relative to the center (a prototype of zero size can not be scaled)
+        const mglass::ShapeRectArea& prototypeBounds = prototype_->getBounds();
+        const mglass::float_type scaleX = (prototypeBounds.width > 0) ? (newWidth / prototypeBounds.width) : 0;
+        const mglass::float_type scaleY = (prototypeBounds.height > 0) ? (newHeight / prototypeBounds.height) : 0;
+
+        std::vector<mglass::Point<mglass::float_type>> vertices = prototype_->getVertices();
+        for (auto& vertex : vertices)
+        {
+            vertex.x *= scaleX;
+            vertex.y *= scaleY;
+        }
+
+        outline_ = std::make_shared<const mglass::shapes::PolygonOutline>(std::move(vertices));
+    }
+
+    std::string_view PolymorphicPolygon::getIdentifier() const noexcept
+    {
+        return "polygon";
+    }
+
+    mglass::Point<mglass::float_type> PolymorphicPolygon::getCenter() const noexcept
+    {
+        return center_;
+    }
+
+    mglass::float_type PolymorphicPolygon::getWidth() const noexcept
+    {
+        return outline_->getBounds().width;
+    }
+
+    mglass::float_type PolymorphicPolygon::getHeight() const noexcept
+    {
+        return outline_->getBounds().height;
+    }
+
+    mglass::IntegralRectArea PolymorphicPolygon::getIntegralBounds() const noexcept
+    {
+        return mglass::getShapeIntegralBounds(*this);
+    }
+
+    mglass::MagnifierPlan PolymorphicPolygon::makeMagnifierPlan(mglass::float_type scaleFactor, bool enableAlphaBlending) const
+    {
+        return mglass::MagnifierPlan{*this, scaleFactor, enableAlphaBlending};
+    }
+
+    void PolymorphicPolygon::applyNearestNeighbor(
+        mglass::float_type scaleFactor,
+        const mglass::ImageSpan& imageSrc,
+        mglass::Point<mglass::int_type> imageTopLeft,
+        mglass::Image& imageDst,
+        bool enableAlphaBlending) const
+    {
+        mglass::magnifiers::nearestNeighbor(*this, scaleFactor, imageSrc, imageTopLeft, imageDst, enableAlphaBlending);
+    }
+
+    void PolymorphicPolygon::applyNearestNeighborAntiAliased(
+        mglass::float_type scaleFactor,
+        const mglass::ImageSpan& imageSrc,
+        mglass::Point<mglass::int_type> imageTopLeft,
+        mglass::Image& imageDst,
+        bool enableAlphaBlending) const
+    {
+        mglass::magnifiers::nearestNeighborInterpolated(*this, scaleFactor, imageSrc, imageTopLeft, imageDst, enableAlphaBlending);
+    }
+
+    void PolymorphicPolygon::applyNearestNeighbor(
+        mglass::float_type scaleFactor,
+        const mglass::ImageSpan& imageSrc,
+        mglass::Point<mglass::int_type> imageTopLeft,
+        const mglass::MutableImageSpan& imageDst,
+        mglass::Point<mglass::int_type> dstOffset,
+        bool enableAlphaBlending,
+        bool fillWithTransparent) const
+    {
+        mglass::magnifiers::nearestNeighbor(
+            *this, scaleFactor, imageSrc, imageTopLeft, imageDst, dstOffset, enableAlphaBlending, fillWithTransparent);
+    }
+
+    void PolymorphicPolygon::applyNearestNeighborAntiAliased(
+        mglass::float_type scaleFactor,
+        const mglass::ImageSpan& imageSrc,
+        mglass::Point<mglass::int_type> imageTopLeft,
+        const mglass::MutableImageSpan& imageDst,
+        mglass::Point<mglass::int_type> dstOffset,
+        bool enableAlphaBlending,
+        bool fillWithTransparent) const
+    {
+        mglass::magnifiers::nearestNeighborInterpolated(
+            *this, scaleFactor, imageSrc, imageTopLeft, imageDst, dstOffset, enableAlphaBlending, fillWithTransparent);
+    }
 } // namespace mglassext
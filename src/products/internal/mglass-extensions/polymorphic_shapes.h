@@ -3,6 +3,8 @@
 
 #include "polymorphic_shape.h"
 #include "mglass/shapes.h"      // mglass::shapes::*
+#include <memory>               // std::shared_ptr
+#include <vector>               // std::vector
 
 
 namespace mglassext
@@ -23,20 +25,41 @@ namespace mglassext
         mglass::Point<mglass::float_type> getCenter() const noexcept override;
         mglass::float_type getWidth() const noexcept override;
         mglass::float_type getHeight() const noexcept override;
+        mglass::IntegralRectArea getIntegralBounds() const noexcept override;
+
+        mglass::MagnifierPlan makeMagnifierPlan(mglass::float_type scaleFactor, bool enableAlphaBlending) const override;
 
         void applyNearestNeighbor(
             mglass::float_type scaleFactor,
-            const mglass::Image& imageSrc,
+            const mglass::ImageSpan& imageSrc,
             mglass::Point<mglass::int_type> imageTopLeft,
             mglass::Image& imageDst,
             bool enableAlphaBlending) const override;
 
         void applyNearestNeighborAntiAliased(
             mglass::float_type scaleFactor,
-            const mglass::Image& imageSrc,
+            const mglass::ImageSpan& imageSrc,
             mglass::Point<mglass::int_type> imageTopLeft,
             mglass::Image& imageDst,
             bool enableAlphaBlending) const override;
+
+        void applyNearestNeighbor(
+            mglass::float_type scaleFactor,
+            const mglass::ImageSpan& imageSrc,
+            mglass::Point<mglass::int_type> imageTopLeft,
+            const mglass::MutableImageSpan& imageDst,
+            mglass::Point<mglass::int_type> dstOffset,
+            bool enableAlphaBlending,
+            bool fillWithTransparent) const override;
+
+        void applyNearestNeighborAntiAliased(
+            mglass::float_type scaleFactor,
+            const mglass::ImageSpan& imageSrc,
+            mglass::Point<mglass::int_type> imageTopLeft,
+            const mglass::MutableImageSpan& imageDst,
+            mglass::Point<mglass::int_type> dstOffset,
+            bool enableAlphaBlending,
+            bool fillWithTransparent) const override;
     };
 
 
@@ -56,20 +79,100 @@ namespace mglassext
         mglass::Point<mglass::float_type> getCenter() const noexcept override;
         mglass::float_type getWidth() const noexcept override;
         mglass::float_type getHeight() const noexcept override;
+        mglass::IntegralRectArea getIntegralBounds() const noexcept override;
+
+        mglass::MagnifierPlan makeMagnifierPlan(mglass::float_type scaleFactor, bool enableAlphaBlending) const override;
+
+        void applyNearestNeighbor(
+            mglass::float_type scaleFactor,
+            const mglass::ImageSpan& imageSrc,
+            mglass::Point<mglass::int_type> imageTopLeft,
+            mglass::Image& imageDst,
+            bool enableAlphaBlending) const override;
+
+        void applyNearestNeighborAntiAliased(
+            mglass::float_type scaleFactor,
+            const mglass::ImageSpan& imageSrc,
+            mglass::Point<mglass::int_type> imageTopLeft,
+            mglass::Image& imageDst,
+            bool enableAlphaBlending) const override;
+
+        void applyNearestNeighbor(
+            mglass::float_type scaleFactor,
+            const mglass::ImageSpan& imageSrc,
+            mglass::Point<mglass::int_type> imageTopLeft,
+            const mglass::MutableImageSpan& imageDst,
+            mglass::Point<mglass::int_type> dstOffset,
+            bool enableAlphaBlending,
+            bool fillWithTransparent) const override;
+
+        void applyNearestNeighborAntiAliased(
+            mglass::float_type scaleFactor,
+            const mglass::ImageSpan& imageSrc,
+            mglass::Point<mglass::int_type> imageTopLeft,
+            const mglass::MutableImageSpan& imageDst,
+            mglass::Point<mglass::int_type> dstOffset,
+            bool enableAlphaBlending,
+            bool fillWithTransparent) const override;
+    };
+
+
+    class PolymorphicPolygon final : public PolymorphicShape, public mglass::shapes::Polygon
+    {
+    public: // ctors/dtor
+        // the `vertices` (relative to the center) are the prototype which is scaled by setSize
+        explicit PolymorphicPolygon(std::vector<mglass::Point<mglass::float_type>> vertices = {});
+
+    public: // modifiers
+        void moveCenterTo(mglass::float_type newCenterX, mglass::float_type newCenterY) noexcept override;
+
+        void setSize(mglass::float_type newWidth, mglass::float_type newHeight) noexcept(false) override;
+
+    public: // getters
+        std::string_view getIdentifier() const noexcept override;
+
+        mglass::Point<mglass::float_type> getCenter() const noexcept override;
+        mglass::float_type getWidth() const noexcept override;
+        mglass::float_type getHeight() const noexcept override;
+        mglass::IntegralRectArea getIntegralBounds() const noexcept override;
+
+        mglass::MagnifierPlan makeMagnifierPlan(mglass::float_type scaleFactor, bool enableAlphaBlending) const override;
 
         void applyNearestNeighbor(
             mglass::float_type scaleFactor,
-            const mglass::Image& imageSrc,
+            const mglass::ImageSpan& imageSrc,
             mglass::Point<mglass::int_type> imageTopLeft,
             mglass::Image& imageDst,
             bool enableAlphaBlending) const override;
 
         void applyNearestNeighborAntiAliased(
             mglass::float_type scaleFactor,
-            const mglass::Image& imageSrc,
+            const mglass::ImageSpan& imageSrc,
             mglass::Point<mglass::int_type> imageTopLeft,
             mglass::Image& imageDst,
             bool enableAlphaBlending) const override;
+
+        void applyNearestNeighbor(
+            mglass::float_type scaleFactor,
+            const mglass::ImageSpan& imageSrc,
+            mglass::Point<mglass::int_type> imageTopLeft,
+            const mglass::MutableImageSpan& imageDst,
+            mglass::Point<mglass::int_type> dstOffset,
+            bool enableAlphaBlending,
+            bool fillWithTransparent) const override;
+
+        void applyNearestNeighborAntiAliased(
+            mglass::float_type scaleFactor,
+            const mglass::ImageSpan& imageSrc,
+            mglass::Point<mglass::int_type> imageTopLeft,
+            const mglass::MutableImageSpan& imageDst,
+            mglass::Point<mglass::int_type> dstOffset,
+            bool enableAlphaBlending,
+            bool fillWithTransparent) const override;
+
+    private:
+        // the outline scaled by setSize
+        std::shared_ptr<const mglass::shapes::PolygonOutline> prototype_;
     };
 } // namespace mglassext
 
@@ -144,6 +144,9 @@ CmdArgs CmdArgs::parse(const int argc, char **argv) noexcept(false)
                 shape = std::make_unique<mglassext::PolymorphicEllipse>();
             else if (shapeIdentifier == "rectangle")
                 shape = std::make_unique<mglassext::PolymorphicRectangle>();
+            else if (shapeIdentifier == "polygon")
+                shape = std::make_unique<mglassext::PolymorphicPolygon>(
+                    mglass::shapes::Polygon::regular({0, 0}, 6, 1, 1).getOutline().getVertices());
             else
                 throw std::runtime_error("unknown value of the `--shape` parameter \""s
                                          .append(shapeIdentifier)
@@ -325,7 +328,8 @@ std::ostream& CmdArgs::writeHelp(std::ostream& stream)
            "\n"
            "  --output=<path-to-file>  = Required. Specify a file to which the magnified image will be written.\n"
            "  --shape=<identifier>     = Required. Specify a shape of the magnifying glass. Supported \n"
-           "                             identifiers are: `ellipse`, `rectangle`.\n"
+           "                             identifiers are: `ellipse`, `rectangle`, `polygon`\n"
+           "                             (`polygon` is a regular hexagon).\n"
            "  --dx=<value>             = Required. Specify the floating-point width of the magnifying glass.\n"
            "                             Value must be inside the range [0; +inf).\n"
            "  --dy=<value>             = Required. Specify the floating-point height of the magnifying glass.\n"
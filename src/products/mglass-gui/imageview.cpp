@@ -3,6 +3,8 @@
 #include <QLabel>
 #include <QPixmap>
 #include <QMouseEvent>
+#include <QRect>
+#include <QSize>
 #include <utility>              // std::move
 #include <cmath>                // std::isnan
 #include <stdexcept>            // std::invalid_argument
@@ -53,6 +55,7 @@ void ImageView::setShape(std::unique_ptr<mglassext::PolymorphicShape> newShape)
         throw std::invalid_argument("`newShape` does not own an object");
 
     mglassShape_ = std::move(newShape);
+    magnifierPlan_.reset();
 
     updateMagnifierCursor();
 }
@@ -67,6 +70,7 @@ void ImageView::setScaleFactor(mglass::float_type newScaleFactor) noexcept(false
         throw std::invalid_argument("ImageView::setScaleFactor(float newScaleFactor): newScaleFactor is not inside the range (0; +inf)");
 
     scaleFactor_ = newScaleFactor;
+    magnifierPlan_.reset();
 
     updateMagnifierCursor();
 }
@@ -75,6 +79,7 @@ void ImageView::setScaleFactor(mglass::float_type newScaleFactor) noexcept(false
 void ImageView::enableAlphaBlending()
 {
     alphaBlendingIsEnabled_ = true;
+    magnifierPlan_.reset();
 
     updateMagnifierCursor();
 }
@@ -82,6 +87,7 @@ void ImageView::enableAlphaBlending()
 void ImageView::disableAlphaBlending()
 {
     alphaBlendingIsEnabled_ = false;
+    magnifierPlan_.reset();
 
     updateMagnifierCursor();
 }
@@ -165,21 +171,55 @@ void ImageView::updateMagnifierCursor(int posX, int posY)
     if (!visibleRegion().contains(QPoint(posX, posY)))
         return (void)disableMagnifier();
 
-    const auto xFloat = static_cast<mglass::float_type>(posX);
-    const auto yFloat = static_cast<mglass::float_type>(posY);
+    // the shape is rasterized once, then its plan is just moved to the cursor
+    if (!magnifierPlan_.has_value())
+    {
+        mglassShape_->moveCenterTo(0, 0);
+        magnifierPlan_ = mglassShape_->makeMagnifierPlan(scaleFactor_, alphaBlendingIsEnabled_);
+    }
+
+    const mglass::Point<mglass::int_type> shapeOffset{ posX, -posY };
+
+    mglassShape_->moveCenterTo(static_cast<mglass::float_type>(posX), static_cast<mglass::float_type>(-posY));
+
+    const QRect wholeImgRect{
+        imageLabel_->pos().x() + imageBorders_,
+        imageLabel_->pos().y() + imageBorders_,
+        static_cast<int>(mglassWholeImg_->getWidth()),
+        static_cast<int>(mglassWholeImg_->getHeight())
+    };
 
-    mglassShape_->moveCenterTo(xFloat, -yFloat);
+    // only the visible part of the image is magnified (without copying it)
+    const QRect visibleImgRect = visibleRegion().boundingRect().intersected(wholeImgRect);
 
-    const mglass::Point<mglass::int_type> mglassImgPos{ imageLabel_->pos().x() + imageBorders_, -imageLabel_->pos().y() - imageBorders_ };
+    const auto visibleImg = mglass::ImageSpan{ *mglassWholeImg_ }.getSubSpan(
+        static_cast<mglass::size_type>(visibleImgRect.x() - wholeImgRect.x()),
+        static_cast<mglass::size_type>(visibleImgRect.y() - wholeImgRect.y()),
+        static_cast<mglass::size_type>(visibleImgRect.width()),
+        static_cast<mglass::size_type>(visibleImgRect.height())
+    );
 
-    // TODO: crop mglassWholeImg_ to visibleRegion(). It can be implemented via smth like mglass::ImageView
+    const mglass::Point<mglass::int_type> mglassImgPos{ visibleImgRect.x(), -visibleImgRect.y() };
+
+    // the magnified image is written directly into the pixels of the cursor's buffer
+    const mglass::IntegralRectArea shapeBounds = magnifierPlan_->getIntegralBounds(shapeOffset);
+    const QSize cursorImgSize{ static_cast<int>(shapeBounds.width), static_cast<int>(shapeBounds.height) };
+
+    if (cursorImgBuf_.size() != cursorImgSize)
+        cursorImgBuf_ = QImage(cursorImgSize, QImage::Format_ARGB32);
+
+    const mglass::MutableImageSpan cursorImg{
+        cursorImgBuf_.bits(),
+        static_cast<mglass::size_type>(cursorImgBuf_.width()),
+        static_cast<mglass::size_type>(cursorImgBuf_.height()),
+        static_cast<mglass::size_type>(cursorImgBuf_.bytesPerLine()),
+        qtArgb32PixelFormat_
+    };
 
     if (antiAliasingIsEnabled_)
-        mglassShape_->applyNearestNeighborAntiAliased(scaleFactor_, *mglassWholeImg_, mglassImgPos, mglassMagnifiedImg_, alphaBlendingIsEnabled_);
+        magnifierPlan_->nearestNeighborInterpolated(shapeOffset, visibleImg, mglassImgPos, cursorImg, {0, 0}, true);
     else
-        mglassShape_->applyNearestNeighbor(scaleFactor_, *mglassWholeImg_, mglassImgPos, mglassMagnifiedImg_, alphaBlendingIsEnabled_);
-
-    convertMglassImgToQtImg(mglassMagnifiedImg_, cursorImgBuf_);
+        magnifierPlan_->nearestNeighbor(shapeOffset, visibleImg, mglassImgPos, cursorImg, {0, 0}, true);
 
     setCursor(QPixmap::fromImage(cursorImgBuf_));
 }
@@ -3,9 +3,11 @@
 
 #include "mglass-extensions/polymorphic_shape.h"    // mglassext::PolymorphicShape
 #include "mglass/mglass.h"                          // mglass::*
+#include "mglass/magnifier_plan.h"                  // mglass::MagnifierPlan
 #include <QWidget>
 #include <QCursor>
 #include <QImage>
+#include <QtGlobal>                                 // Q_BYTE_ORDER
 #include <memory>                                   // std::unique_ptr
 #include <optional>                                 // std::optional
 
@@ -66,6 +68,10 @@ private:
     static constexpr int imageAreaMargins_ = 50;
     static constexpr int imageBorders_ = 5;
 
+    // QImage::Format_ARGB32 stores pixels as 32-bit words 0xAARRGGBB
+    static constexpr mglass::PixelFormat qtArgb32PixelFormat_ =
+        (Q_BYTE_ORDER == Q_LITTLE_ENDIAN) ? mglass::PixelFormat::BGRA : mglass::PixelFormat::ARGB;
+
 private:
     std::unique_ptr<mglassext::PolymorphicShape> mglassShape_;
     mglass::float_type scaleFactor_;
@@ -76,7 +82,9 @@ private:
     QLabel* imageLabel_;
     QCursor defaultCursor_;
     std::optional<mglass::Image> mglassWholeImg_;
-    mglass::Image mglassMagnifiedImg_;
+    // the shape centered at (0; 0) rasterized for the current scale factor and alpha-blending mode
+    //  (reset when any of them is changed)
+    std::optional<mglass::MagnifierPlan> magnifierPlan_;
     QImage cursorImgBuf_;
 };
 
@@ -0,0 +1,357 @@
+#include "mglass/shapes.h"          // mglass::shapes::AntialiasedEllipse, mglass::shapes::AntialiasedRectangle
+#include "gtest/gtest.h"
+#include <cstddef>                  // std::size_t
+#include <unordered_map>            // std::unordered_map
+#include <unordered_set>            // std::unordered_set
+#include <algorithm>                // std::min
+#include <cmath>                    // std::abs
+
+
+namespace
+{
+    struct PointHash
+    {
+        template<typename T>
+        std::size_t operator()(const mglass::Point<T> p) const noexcept
+        {
+            return (std::hash<T>{}(p.x) ^ std::hash<T>{}(p.y));
+        }
+    };
+
+    using IntPoint = mglass::Point<mglass::int_type>;
+    using IntPointSet = std::unordered_set<IntPoint, PointHash>;
+    using DensityMap = std::unordered_map<IntPoint, mglass::float_type, PointHash>;
+
+    constexpr double pi = 3.14159265358979323846;
+
+    template<typename ShapeImpl>
+    DensityMap getDensitiesOf(const ShapeImpl& shape, const mglass::IntegralRectArea area)
+    {
+        DensityMap result;
+
+        shape.rasterizeOnto(area, [&result](const typename ShapeImpl::RasterizationContext& rstCtx) {
+            EXPECT_TRUE(result.emplace(rstCtx.getRasterizedPoint(), rstCtx.getPixelDensity()).second);
+        });
+
+        return result;
+    }
+
+    template<typename ShapeImpl>
+    mglass::IntegralRectArea getAreaAround(const ShapeImpl& shape, const mglass::int_type margin)
+    {
+        const mglass::IntegralRectArea bounds = mglass::getShapeIntegralBounds(shape);
+
+        return {
+            { bounds.topLeft.x - margin, bounds.topLeft.y + margin },
+            bounds.width + 2 * static_cast<mglass::size_type>(margin),
+            bounds.height + 2 * static_cast<mglass::size_type>(margin)
+        };
+    }
+
+    // the area of the intersection of the pixel and the shape calculated by supersampling
+    template<typename InsideFunction>
+    double getSupersampledCoverage(const IntPoint pixel, const InsideFunction& isInside)
+    {
+        constexpr int samplesPerAxis = 64;
+
+        int insideCount = 0;
+        for (int i = 0; i < samplesPerAxis; ++i)
+        {
+            for (int j = 0; j < samplesPerAxis; ++j)
+            {
+                const double x = pixel.x + (i + 0.5) / samplesPerAxis;
+                const double y = pixel.y + (j + 0.5) / samplesPerAxis;
+
+                insideCount += isInside(x, y) ? 1 : 0;
+            }
+        }
+
+        return static_cast<double>(insideCount) / (samplesPerAxis * samplesPerAxis);
+    }
+
+    template<typename ShapeImpl>
+    void checkSpansMatchPoints(const ShapeImpl& shape, const mglass::IntegralRectArea area)
+    {
+        const DensityMap expectedDensities = getDensitiesOf(shape, area);
+
+        IntPointSet actualPoints;
+        mglass::int_type prevY = area.topLeft.y + 1;
+
+        shape.rasterizeSpansOnto(area, [&](const typename ShapeImpl::RasterizationSpan& span) {
+            ASSERT_LT(span.getXBegin(), span.getXEnd());
+            ASSERT_LT(span.getY(), prevY) << "The shape should emit a single span per row from the top to the bottom.";
+            prevY = span.getY();
+
+            for (auto x = span.getXBegin(); x < span.getXEnd(); ++x)
+            {
+                const IntPoint point{x, span.getY()};
+                ASSERT_TRUE(actualPoints.emplace(point).second);
+
+                const auto it = expectedDensities.find(point);
+                ASSERT_NE(it, expectedDensities.end());
+                ASSERT_EQ(span.getPixelDensityAt(x), it->second);
+            }
+        });
+
+        ASSERT_EQ(actualPoints.size(), expectedDensities.size());
+    }
+
+    template<typename ShapeImpl>
+    void checkBlocksMatchRasterization(const ShapeImpl& shape)
+    {
+        const mglass::IntegralRectArea area = getAreaAround(shape, 20);
+        const DensityMap densities = getDensitiesOf(shape, area);
+
+        for (const mglass::size_type blockSize : { 1, 5, 16 })
+        {
+            for (mglass::size_type row = 0; row < area.height; row += blockSize)
+            {
+                for (mglass::size_type column = 0; column < area.width; column += blockSize)
+                {
+                    const mglass::IntegralRectArea block{
+                        { area.topLeft.x + static_cast<mglass::int_type>(column), area.topLeft.y - static_cast<mglass::int_type>(row) },
+                        (std::min)(blockSize, area.width - column),
+                        (std::min)(blockSize, area.height - row)
+                    };
+
+                    const mglass::BlockCoverage coverage = shape.classifyBlock(block);
+
+                    for (mglass::size_type y = 0; y < block.height; ++y)
+                    {
+                        for (mglass::size_type x = 0; x < block.width; ++x)
+                        {
+                            const IntPoint point{
+                                block.topLeft.x + static_cast<mglass::int_type>(x),
+                                block.topLeft.y - static_cast<mglass::int_type>(y)
+                            };
+                            const auto it = densities.find(point);
+
+                            if (coverage == mglass::BlockCoverage::Outside)
+                            {
+                                ASSERT_EQ(it, densities.end()) << "An Outside block should have no rasterized pixels.";
+                            }
+                            else if (coverage == mglass::BlockCoverage::Inside)
+                            {
+                                ASSERT_NE(it, densities.end()) << "All the pixels of an Inside block should be rasterized.";
+                                ASSERT_EQ(it->second, 1) << "All the pixels of an Inside block should have the density 1.";
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+} // namespace
+
+
+// ====================================================================================================================
+// AntialiasedEllipse
+// ====================================================================================================================
+
+TEST(MGLASS_ANTIALIASED_ELLIPSE_SHAPE, RASTERIZE_EMPTY)
+{
+    const mglass::shapes::AntialiasedEllipse e{ {0.5f, 0.5f}, 0, 10 };
+
+    bool gotCalled = false;
+    e.rasterizeOnto({ {-50, 50}, 100, 100 }, [&gotCalled](const mglass::shapes::AntialiasedEllipse::RasterizationContext&) {
+        gotCalled = true;
+    });
+
+    ASSERT_FALSE(gotCalled) << "Empty ellipse should rasterize no points.";
+}
+
+TEST(MGLASS_ANTIALIASED_ELLIPSE_SHAPE, COVERAGES_SUM_TO_AREA)
+{
+    const mglass::shapes::AntialiasedEllipse ellipses[] {
+        mglass::shapes::AntialiasedEllipse{ {0, 0}, 10, 5 },
+        mglass::shapes::AntialiasedEllipse{ {0.3f, -7.8f}, 37.4f, 91.1f },
+        mglass::shapes::AntialiasedEllipse{ {-12.5f, 3.5f}, 1.5f, 120 },
+        mglass::shapes::AntialiasedEllipse{ {100.25f, 100.75f}, 250, 100 },
+        mglass::shapes::AntialiasedEllipse{ {0.5f, 0.5f}, 0.7f, 0.3f },
+    };
+
+    for (const auto& e : ellipses)
+    {
+        const mglass::ShapeRectArea bounds = e.getBounds();
+        const double expectedArea = pi * bounds.width * bounds.height / 4;
+
+        double actualArea = 0;
+        for (const auto& [point, density] : getDensitiesOf(e, getAreaAround(e, 2)))
+        {
+            ASSERT_GE(density, 0);
+            ASSERT_LE(density, 1);
+            actualArea += density;
+        }
+
+        EXPECT_NEAR(actualArea, expectedArea, expectedArea * 1e-4);
+    }
+}
+
+TEST(MGLASS_ANTIALIASED_ELLIPSE_SHAPE, COVERAGES_MATCH_SUPERSAMPLING)
+{
+    const mglass::Point<mglass::float_type> center{ 3.3f, -2.6f };
+    const double a = 17.2;
+    const double b = 9.4;
+
+    const mglass::shapes::AntialiasedEllipse e{ center, static_cast<mglass::float_type>(2 * a), static_cast<mglass::float_type>(2 * b) };
+
+    const auto isInside = [&](const double x, const double y) {
+        const double dx = (x - center.x) / a;
+        const double dy = (y - center.y) / b;
+        return (dx * dx + dy * dy) <= 1;
+    };
+
+    const DensityMap densities = getDensitiesOf(e, getAreaAround(e, 2));
+    ASSERT_FALSE(densities.empty());
+
+    for (const auto& [point, density] : densities)
+        ASSERT_NEAR(density, getSupersampledCoverage(point, isInside), 0.02) << point.x << ", " << point.y;
+}
+
+TEST(MGLASS_ANTIALIASED_ELLIPSE_SHAPE, INTERIOR_PIXELS_ARE_SOLID)
+{
+    const mglass::shapes::AntialiasedEllipse e{ {0.3f, -7.8f}, 37.4f, 91.1f };
+    const mglass::IntegralRectArea area = getAreaAround(e, 2);
+
+    std::size_t interiorPixelsCount = 0;
+
+    e.rasterizeSpansOnto(area, [&interiorPixelsCount](const mglass::shapes::AntialiasedEllipse::RasterizationSpan& span) {
+        ASSERT_LE(span.getInteriorBegin(), span.getInteriorEnd());
+
+        for (auto x = span.getInteriorBegin(); x < span.getInteriorEnd(); ++x)
+        {
+            // the interior pixels are not calculated, but the exact area should agree with them
+            const mglass::float_type exactCoverage = mglass::shapes::detail::getEllipsePixelCoverage(
+                { 0.3f, -7.8f }, 37.4f / 2, 91.1f / 2, x, span.getY());
+
+            ASSERT_EQ(span.getPixelDensityAt(x), 1);
+            ASSERT_NEAR(exactCoverage, 1, 1e-5);
+            ++interiorPixelsCount;
+        }
+    });
+
+    EXPECT_GT(interiorPixelsCount, 0U);
+}
+
+TEST(MGLASS_ANTIALIASED_ELLIPSE_SHAPE, RASTERIZE_SPANS_MATCH_POINTS)
+{
+    const mglass::shapes::AntialiasedEllipse ellipses[] {
+        mglass::shapes::AntialiasedEllipse{ {0, 0}, 10, 5 },
+        mglass::shapes::AntialiasedEllipse{ {0.3f, -7.8f}, 37.4f, 91.1f },
+        mglass::shapes::AntialiasedEllipse{ {-12.5f, 3.5f}, 1.5f, 120 },
+        mglass::shapes::AntialiasedEllipse{ {100, 100}, 250, 100 },
+    };
+
+    const mglass::IntegralRectArea rasterizeOntoAreas[] {
+        { {-50, 50}, 100, 100 },
+        { {0, 98}, 100, 100 },
+        { {-13, 60}, 7, 200 },
+        { {-200, 200}, 400, 400 },
+    };
+
+    for (const auto& e : ellipses)
+    {
+        for (const auto& area : rasterizeOntoAreas)
+            checkSpansMatchPoints(e, area);
+    }
+}
+
+TEST(MGLASS_ANTIALIASED_ELLIPSE_SHAPE, CLASSIFY_BLOCKS_MATCH_RASTERIZATION)
+{
+    const mglass::shapes::AntialiasedEllipse ellipses[] {
+        mglass::shapes::AntialiasedEllipse{ {0, 0}, 10, 5 },
+        mglass::shapes::AntialiasedEllipse{ {0.3f, -7.8f}, 37.4f, 91.1f },
+        mglass::shapes::AntialiasedEllipse{ {-12.5f, 3.5f}, 1.5f, 120 },
+        mglass::shapes::AntialiasedEllipse{ {100, 100}, 250, 100 },
+        mglass::shapes::AntialiasedEllipse{ {0, 0}, 0, 100 },
+    };
+
+    for (const auto& e : ellipses)
+        checkBlocksMatchRasterization(e);
+}
+
+
+// ====================================================================================================================
+// AntialiasedRectangle
+// ====================================================================================================================
+
+TEST(MGLASS_ANTIALIASED_RECTANGLE_SHAPE, RASTERIZE_EMPTY)
+{
+    const mglass::shapes::AntialiasedRectangle r{ {0.5f, 0.5f}, 10, 0 };
+
+    bool gotCalled = false;
+    r.rasterizeOnto({ {-50, 50}, 100, 100 }, [&gotCalled](const mglass::shapes::AntialiasedRectangle::RasterizationContext&) {
+        gotCalled = true;
+    });
+
+    ASSERT_FALSE(gotCalled) << "Empty rectangle should rasterize no points.";
+}
+
+TEST(MGLASS_ANTIALIASED_RECTANGLE_SHAPE, COVERAGES_MATCH_SUPERSAMPLING)
+{
+    const mglass::shapes::AntialiasedRectangle rectangles[] {
+        mglass::shapes::AntialiasedRectangle{ {0, 0}, 10, 5 },
+        mglass::shapes::AntialiasedRectangle{ {0.3f, -7.8f}, 37.4f, 21.1f },
+        mglass::shapes::AntialiasedRectangle{ {-12.5f, 3.5f}, 0.5f, 12 },
+        mglass::shapes::AntialiasedRectangle{ {0.5f, 0.5f}, 0.25f, 0.75f },
+    };
+
+    for (const auto& r : rectangles)
+    {
+        const mglass::ShapeRectArea bounds = r.getBounds();
+        const double left = bounds.topLeft.x;
+        const double right = left + bounds.width;
+        const double top = bounds.topLeft.y;
+        const double bottom = top - bounds.height;
+
+        const auto isInside = [=](const double x, const double y) {
+            return (x >= left) && (x <= right) && (y >= bottom) && (y <= top);
+        };
+
+        double actualArea = 0;
+        for (const auto& [point, density] : getDensitiesOf(r, getAreaAround(r, 2)))
+        {
+            ASSERT_NEAR(density, getSupersampledCoverage(point, isInside), 1.0 / 64) << point.x << ", " << point.y;
+            actualArea += density;
+        }
+
+        EXPECT_NEAR(actualArea, static_cast<double>(bounds.width) * bounds.height, 1e-3);
+    }
+}
+
+TEST(MGLASS_ANTIALIASED_RECTANGLE_SHAPE, RASTERIZE_SPANS_MATCH_POINTS)
+{
+    const mglass::shapes::AntialiasedRectangle rectangles[] {
+        mglass::shapes::AntialiasedRectangle{ {0, 0}, 10, 5 },
+        mglass::shapes::AntialiasedRectangle{ {0.3f, -7.8f}, 37.4f, 91.1f },
+        mglass::shapes::AntialiasedRectangle{ {-12.5f, 3.5f}, 1.5f, 120 },
+        mglass::shapes::AntialiasedRectangle{ {100, 100}, 250, 100 },
+    };
+
+    const mglass::IntegralRectArea rasterizeOntoAreas[] {
+        { {-50, 50}, 100, 100 },
+        { {0, 98}, 100, 100 },
+        { {-13, 60}, 7, 200 },
+        { {-200, 200}, 400, 400 },
+    };
+
+    for (const auto& r : rectangles)
+    {
+        for (const auto& area : rasterizeOntoAreas)
+            checkSpansMatchPoints(r, area);
+    }
+}
+
+TEST(MGLASS_ANTIALIASED_RECTANGLE_SHAPE, CLASSIFY_BLOCKS_MATCH_RASTERIZATION)
+{
+    const mglass::shapes::AntialiasedRectangle rectangles[] {
+        mglass::shapes::AntialiasedRectangle{ {0, 0}, 10, 5 },
+        mglass::shapes::AntialiasedRectangle{ {0.3f, -7.8f}, 37.4f, 91.1f },
+        mglass::shapes::AntialiasedRectangle{ {-12.5f, 3.5f}, 1.5f, 120 },
+        mglass::shapes::AntialiasedRectangle{ {100, 100}, 250, 100 },
+        mglass::shapes::AntialiasedRectangle{ {0, 0}, 0, 100 },
+    };
+
+    for (const auto& r : rectangles)
+        checkBlocksMatchRasterization(r);
+}
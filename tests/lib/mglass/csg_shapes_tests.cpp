@@ -0,0 +1,343 @@
+#include "mglass/shapes.h"          // mglass::shapes::Union, mglass::shapes::Intersection, mglass::shapes::Difference
+#include "mglass/shape_mask.h"      // mglass::ShapeMaskCache
+#include "gtest/gtest.h"
+#include "shape_test_utils.h"        // shape_test_utils::*
+#include <algorithm>                // std::min, std::max
+#include <type_traits>              // std::decay_t
+#include <utility>                  // std::pair
+#include <vector>                   // std::vector
+
+
+namespace
+{
+    using shape_test_utils::IntPoint;
+    using shape_test_utils::IntPointDensities;
+    using shape_test_utils::rasterizePointsOf;
+
+    using EllipsesUnion = mglass::shapes::Union<mglass::shapes::Ellipse, mglass::shapes::Ellipse>;
+    using EllipseRectangleIntersection = mglass::shapes::Intersection<mglass::shapes::Ellipse, mglass::shapes::Rectangle>;
+    using EllipsesDifference = mglass::shapes::Difference<mglass::shapes::Ellipse, mglass::shapes::Ellipse>;
+
+    // the density is 1 farther than 0.2 from the edge, so the hole cut by such a shape has the transparent pixels
+    const mglass::FalloffProfile& getSteepFalloff()
+    {
+        static const auto profile = mglass::FalloffProfile::fromFunction([](const double u) { return (std::min)(1.0, u / 0.2); });
+        return profile;
+    }
+
+    // Checks the pixels rasterized by the `shape` against the pixels of its operands combined one by one.
+    template<mglass::shapes::BooleanOperation Operation, typename First, typename Second>
+    void checkRasterizedPixels(
+        const mglass::shapes::BooleanShape<Operation, First, Second>& shape,
+        const mglass::IntegralRectArea& area)
+    {
+        const IntPointDensities firstPoints = rasterizePointsOf(shape.getFirst(), area);
+        const IntPointDensities secondPoints = rasterizePointsOf(shape.getSecond(), area);
+
+        IntPointDensities expected;
+
+        for (const auto& [point, density] : firstPoints)
+        {
+            const auto it = secondPoints.find(point);
+
+            if (Operation == mglass::shapes::BooleanOperation::Union)
+                expected.emplace(point, (it == secondPoints.end()) ? density : (std::max)(density, it->second));
+            else if (Operation == mglass::shapes::BooleanOperation::Intersection)
+            {
+                if (it != secondPoints.end())
+                    expected.emplace(point, (std::min)(density, it->second));
+            }
+            else if (it == secondPoints.end())
+                expected.emplace(point, density);
+            else if (it->second < 1)
+                expected.emplace(point, (std::min)(density, 1 - it->second));
+        }
+
+        if (Operation == mglass::shapes::BooleanOperation::Union)
+        {
+            for (const auto& [point, density] : secondPoints)
+                expected.emplace(point, density);
+        }
+
+        ASSERT_EQ(rasterizePointsOf(shape, area), expected);
+    }
+} // namespace
+
+
+// ====================================================================================================================
+// getBounds
+// ====================================================================================================================
+
+TEST(MGLASS_CSG_SHAPES, BOUNDS)
+{
+    const mglass::shapes::Ellipse left{ {-10, 0}, 40, 20 };
+    const mglass::shapes::Ellipse right{ {15, 5}, 30, 40 };
+
+    EXPECT_EQ(EllipsesUnion(left, right).getBounds(), (mglass::ShapeRectArea{ {-30, 25}, 60, 40 }));
+    EXPECT_EQ(
+        (mglass::shapes::Intersection<mglass::shapes::Ellipse, mglass::shapes::Ellipse>(left, right).getBounds()),
+        (mglass::ShapeRectArea{ {0, 10}, 10, 20 })
+    );
+    EXPECT_EQ(EllipsesDifference(left, right).getBounds(), left.getBounds());
+
+    // the disjoint operands
+    const mglass::shapes::Ellipse far{ {100, 100}, 10, 10 };
+    const mglass::ShapeRectArea disjoint =
+        mglass::shapes::Intersection<mglass::shapes::Ellipse, mglass::shapes::Ellipse>(left, far).getBounds();
+
+    EXPECT_EQ(disjoint.width, 0);
+    EXPECT_EQ(disjoint.height, 0);
+}
+
+
+// ====================================================================================================================
+// rasterizeOnto, rasterizeSpansOnto
+// ====================================================================================================================
+
+TEST(MGLASS_CSG_SHAPES, RASTERIZE_MATCHES_OPERANDS)
+{
+    const mglass::IntegralRectArea areas[] {
+        { {-100, 100}, 200, 200 },
+        { {-13, 20}, 7, 200 },
+        { {-5, 5}, 10, 10 },
+    };
+
+    const mglass::shapes::Ellipse first{ {-10.3f, 2.6f}, 91.4f, 50.7f };
+    const mglass::shapes::Ellipse second{ {12.8f, -7.1f}, 60.2f, 88.4f };
+    const mglass::shapes::Rectangle rectangle{ {5.5f, 10.5f}, 73, 31 };
+
+    for (const auto& area : areas)
+    {
+        checkRasterizedPixels(EllipsesUnion(first, second), area);
+        checkRasterizedPixels(EllipseRectangleIntersection(first, rectangle), area);
+        checkRasterizedPixels(EllipsesDifference(first, second), area);
+        checkRasterizedPixels(EllipsesDifference(second, first), area);
+    }
+
+    // the disjoint operands
+    const mglass::shapes::Ellipse far{ {60, 60}, 20, 20 };
+    const mglass::IntegralRectArea area{ {-100, 100}, 200, 200 };
+
+    checkRasterizedPixels(EllipsesUnion(first, far), area);
+    checkRasterizedPixels(EllipsesDifference(first, far), area);
+    EXPECT_TRUE(rasterizePointsOf(
+        mglass::shapes::Intersection<mglass::shapes::Ellipse, mglass::shapes::Ellipse>(first, far), area
+    ).empty());
+}
+
+TEST(MGLASS_CSG_SHAPES, RING_HAS_HOLE)
+{
+    const EllipsesDifference ring{
+        mglass::shapes::Ellipse{ {0, 0}, 100, 100 },
+        mglass::shapes::Ellipse{ {0, 0}, 60, 60, getSteepFalloff() }
+    };
+
+    const IntPointDensities points = rasterizePointsOf(ring, mglass::getShapeIntegralBounds(ring));
+
+    EXPECT_EQ(points.count({0, 0}), 0U);
+    EXPECT_EQ(points.count({-10, 10}), 0U);
+    EXPECT_EQ(points.count({39, 0}), 1U);
+    EXPECT_EQ(points.count({0, -45}), 1U);
+}
+
+TEST(MGLASS_CSG_SHAPES, RING_INNER_EDGE_IS_FEATHERED)
+{
+    const mglass::shapes::Ellipse outer{ {0, 0}, 100, 100 };
+    const mglass::shapes::Ellipse inner{ {0, 0}, 60, 60 };
+    const EllipsesDifference ring{ outer, inner };
+
+    const IntPointDensities points = rasterizePointsOf(ring, mglass::getShapeIntegralBounds(ring));
+    const IntPointDensities innerPoints = rasterizePointsOf(inner, mglass::getShapeIntegralBounds(inner));
+
+    // the densities fade towards the hole like the ones of the outer edge fade towards the outside
+    mglass::float_type prevDensity = 0;
+    mglass::int_type featheredCount = 0;
+
+    for (mglass::int_type x = 1; x < 30; ++x)
+    {
+        const auto it = points.find({x, 0});
+        const auto innerIt = innerPoints.find({x, 0});
+
+        ASSERT_TRUE(innerIt != innerPoints.end()) << x;
+        if (innerIt->second >= 1)
+        {
+            ASSERT_TRUE(it == points.end()) << x;
+            continue;
+        }
+
+        ASSERT_TRUE(it != points.end()) << x;
+        EXPECT_FLOAT_EQ(it->second, 1 - innerIt->second) << x;
+        EXPECT_GE(it->second, prevDensity) << x;
+
+        featheredCount += ((it->second > 0.1f) && (it->second < 0.9f)) ? 1 : 0;
+        prevDensity = it->second;
+    }
+
+    EXPECT_GT(featheredCount, 1);
+    EXPECT_GT(prevDensity, 0.8f);
+}
+
+TEST(MGLASS_CSG_SHAPES, RASTERIZE_SPANS_MATCH_POINTS)
+{
+    const mglass::IntegralRectArea rasterizeOntoAreas[] {
+        { {-50, 50}, 100, 100 },
+        { {0, 98}, 100, 100 },
+        { {-13, 20}, 7, 200 },
+        { {-5, 5}, 10, 10 },
+    };
+
+    // the nested operands make the rows of the union consist of the adjacent pieces and the ones of the difference
+    //  consist of several spans
+    const mglass::shapes::Ellipse outer{ {0.3f, -0.8f}, 90, 70 };
+    const mglass::shapes::Ellipse inner{ {10.7f, 4.2f}, 30, 20, getSteepFalloff() };
+
+    const EllipsesUnion unionShape{ outer, inner };
+    const EllipsesDifference difference{ outer, inner };
+
+    const auto checkSpans = [&rasterizeOntoAreas](const auto& shape) {
+        using ShapeT = std::decay_t<decltype(shape)>;
+
+        for (const auto& area : rasterizeOntoAreas)
+        {
+            std::vector<std::pair<IntPoint, mglass::float_type>> expectedPoints;
+            shape.rasterizeOnto(area, [&expectedPoints](const typename ShapeT::RasterizationContext& rstCtx) {
+                expectedPoints.emplace_back(rstCtx.getRasterizedPoint(), rstCtx.getPixelDensity());
+            });
+
+            std::vector<std::pair<IntPoint, mglass::float_type>> actualPoints;
+            IntPoint prevEnd{ area.topLeft.x - 1, area.topLeft.y + 1 };
+
+            shape.rasterizeSpansOnto(area, [&](const typename ShapeT::RasterizationSpan& span) {
+                ASSERT_LT(span.getXBegin(), span.getXEnd());
+                ASSERT_TRUE( (span.getY() < prevEnd.y) || ((span.getY() == prevEnd.y) && (span.getXBegin() > prevEnd.x)) )
+                    << "The shape should emit the disjoint spans from the top to the bottom and from the left to the right.";
+                prevEnd = { span.getXEnd(), span.getY() };
+
+                for (auto x = span.getXBegin(); x < span.getXEnd(); ++x)
+                    actualPoints.emplace_back(IntPoint{x, span.getY()}, span.getPixelDensityAt(x));
+            });
+
+            ASSERT_EQ(actualPoints, expectedPoints);
+        }
+    };
+
+    checkSpans(unionShape);
+    checkSpans(difference);
+}
+
+TEST(MGLASS_CSG_SHAPES, CLASSIFY_BLOCK_MATCHES_RASTERIZATION)
+{
+    const mglass::shapes::Rectangle outer{ {0, 0}, 120, 90 };
+    const mglass::shapes::Rectangle inner{ {10, 5}, 40, 30 };
+
+    const mglass::shapes::Difference<mglass::shapes::Rectangle, mglass::shapes::Rectangle> shape{ outer, inner };
+
+    const IntPointDensities points = rasterizePointsOf(shape, mglass::getShapeIntegralBounds(shape));
+
+    for (mglass::int_type top = 60; top > -60; top -= 8)
+    {
+        for (mglass::int_type left = -70; left < 70; left += 8)
+        {
+            const mglass::IntegralRectArea block{ {left, top}, 8, 8 };
+            const mglass::BlockCoverage coverage = shape.classifyBlock(block);
+
+            for (mglass::int_type y = top; y > top - 8; --y)
+            {
+                for (mglass::int_type x = left; x < left + 8; ++x)
+                {
+                    const auto it = points.find({x, y});
+
+                    if (coverage == mglass::BlockCoverage::Outside)
+                    {
+                        ASSERT_TRUE(it == points.end());
+                    }
+                    if (coverage == mglass::BlockCoverage::Inside)
+                    {
+                        ASSERT_TRUE( (it != points.end()) && (it->second == 1) );
+                    }
+                }
+            }
+        }
+    }
+
+    // the operands are outside this block, so it is outside any result
+    const mglass::IntegralRectArea farBlock{ {200, 200}, 8, 8 };
+
+    EXPECT_EQ(shape.classifyBlock(farBlock), mglass::BlockCoverage::Outside);
+    EXPECT_EQ(EllipsesUnion(mglass::shapes::Ellipse{}, mglass::shapes::Ellipse{}).classifyBlock(farBlock),
+              mglass::BlockCoverage::Outside);
+}
+
+
+// ====================================================================================================================
+// ShapeMaskCache
+// ====================================================================================================================
+
+TEST(MGLASS_CSG_SHAPES, MASK_CACHE_DISTINGUISHES_OPERANDS)
+{
+    mglass::ShapeMaskCache cache;
+
+    // the same bounds, but different holes
+    const EllipsesDifference first{ mglass::shapes::Ellipse{ {0, 0}, 80, 80 }, mglass::shapes::Ellipse{ {-10, 0}, 30, 30 } };
+    const EllipsesDifference second{ mglass::shapes::Ellipse{ {0, 0}, 80, 80 }, mglass::shapes::Ellipse{ {10, 0}, 30, 30 } };
+
+    const auto firstMask = cache.getMaskOf(first);
+    const auto secondMask = cache.getMaskOf(second);
+
+    EXPECT_EQ(cache.getSize(), 2U);
+    EXPECT_NE(&firstMask.getMask(), &secondMask.getMask());
+
+    // the copy shares the operands, so it shares the mask
+    const EllipsesDifference copy = first;
+
+    EXPECT_EQ(&cache.getMaskOf(copy).getMask(), &firstMask.getMask());
+    EXPECT_EQ(cache.getSize(), 2U);
+}
+
+TEST(MGLASS_CSG_SHAPES, MASK_CACHE_COMPARES_OPERANDS_BY_VALUE)
+{
+    using PolygonsUnion = mglass::shapes::Union<mglass::shapes::Polygon, mglass::shapes::Polygon>;
+    using NestedDifference = mglass::shapes::Difference<EllipsesUnion, mglass::shapes::Rectangle>;
+
+    static_assert( mglass::detail::isEqualityComparable<EllipsesDifference::Operands> );
+    static_assert( mglass::detail::isEqualityComparable<NestedDifference::Operands> );
+    static_assert( !mglass::detail::isEqualityComparable<PolygonsUnion::Operands> );
+
+    mglass::ShapeMaskCache cache;
+
+    const auto makeRing = [](const mglass::float_type innerAxis) {
+        return EllipsesDifference{ mglass::shapes::Ellipse{ {0, 0}, 80, 80 }, mglass::shapes::Ellipse{ {0, 0}, innerAxis, innerAxis } };
+    };
+
+    // the ring rebuilt each frame shares the mask
+    const auto ringMask = cache.getMaskOf(makeRing(30));
+    EXPECT_EQ(&cache.getMaskOf(makeRing(30)).getMask(), &ringMask.getMask());
+    EXPECT_EQ(cache.getSize(), 1U);
+
+    EXPECT_NE(&cache.getMaskOf(makeRing(40)).getMask(), &ringMask.getMask());
+    EXPECT_EQ(cache.getSize(), 2U);
+
+    const auto makeNested = []() {
+        return NestedDifference{
+            EllipsesUnion{ mglass::shapes::Ellipse{ {-10, 0}, 40, 40 }, mglass::shapes::Ellipse{ {10, 0}, 40, 40 } },
+            mglass::shapes::Rectangle{ {0, 0}, 10, 10 }
+        };
+    };
+
+    const auto nestedMask = cache.getMaskOf(makeNested());
+    EXPECT_EQ(&cache.getMaskOf(makeNested()).getMask(), &nestedMask.getMask());
+    EXPECT_EQ(cache.getSize(), 3U);
+
+    // the operands without operator== are the same only if they are shared
+    const auto makePolygons = []() {
+        return PolygonsUnion{
+            mglass::shapes::Polygon::regular({0, 0}, 6, 40, 40), mglass::shapes::Polygon::regular({10, 0}, 5, 40, 40)
+        };
+    };
+
+    const PolygonsUnion polygons = makePolygons();
+    const auto polygonsMask = cache.getMaskOf(polygons);
+
+    EXPECT_EQ(&cache.getMaskOf(PolygonsUnion{ polygons }).getMask(), &polygonsMask.getMask());
+    EXPECT_NE(&cache.getMaskOf(makePolygons()).getMask(), &polygonsMask.getMask());
+}
@@ -2,7 +2,10 @@
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"    // testing::*
 #include <cstddef>          // std::size_t
+#include <unordered_map>    // std::unordered_map
 #include <unordered_set>    // std::unordered_set
+#include <algorithm>        // std::min
+#include <vector>           // std::vector
 
 
 namespace
@@ -388,3 +391,251 @@ TEST(MGLASS_ELLIPSE_SHAPE, RASTERIZE_10_5_ONTO_100_100_NO_INTERSECTIONS)
 
     ASSERT_TRUE(actualPoints.empty());
 }
+
+TEST(MGLASS_ELLIPSE_SHAPE, RASTERIZE_MATCHES_PIXEL_CENTERS_TEST)
+{
+    struct EllipseParams
+    {
+        mglass::Point<mglass::float_type> center;
+        mglass::float_type xAxis;
+        mglass::float_type yAxis;
+    };
+
+    static constexpr EllipseParams ellipses[] {
+        { {0, 0}, 10, 5 },
+        { {0.5f, -0.5f}, 11, 11 },
+        { {0.3f, -7.8f}, 37.4f, 91.1f },
+        { {-12.5f, 3.5f}, 1.5f, 120 },
+        { {7.25f, 1.75f}, 190, 0.75f },
+        { {100, 100}, 250, 100 },
+    };
+
+    const mglass::IntegralRectArea rasterizeOntoAreas[] {
+        { {-50, 50}, 100, 100 },
+        { {0, 98}, 100, 100 },
+        { {-13, 60}, 7, 200 },
+        { {-200, 200}, 400, 400 },
+    };
+
+    for (const auto& params : ellipses)
+    {
+        const mglass::shapes::Ellipse e{ params.center, params.xAxis, params.yAxis };
+
+        // a pixel is inside the ellipse if its center satisfies the ellipse equation
+        const auto a2 = (params.xAxis * params.xAxis) / 4;
+        const auto b2Inversed = 1.f / ((params.yAxis * params.yAxis) / 4);
+
+        for (const auto& area : rasterizeOntoAreas)
+        {
+            IntPointSet expectedPoints;
+
+            const auto areaBottomRight = area.getBottomRight();
+            for (auto y = area.topLeft.y; y >= areaBottomRight.y; --y)
+            {
+                const float yRel = (static_cast<float>(y) + 0.5f) - params.center.y;
+                const float rightPart = a2 - a2 * (yRel * yRel * b2Inversed);
+
+                for (auto x = area.topLeft.x; x <= areaBottomRight.x; ++x)
+                {
+                    const float xRel = (static_cast<float>(x) + 0.5f) - params.center.x;
+                    if (xRel * xRel <= rightPart)
+                        expectedPoints.emplace(IntPoint{x, y});
+                }
+            }
+
+            IntPointSet actualPoints;
+            e.rasterizeOnto(area, [&actualPoints](const mglass::shapes::Ellipse::RasterizationContext& rstCtx) {
+                actualPoints.emplace(rstCtx.getRasterizedPoint());
+            });
+
+            ASSERT_EQ(actualPoints, expectedPoints);
+        }
+    }
+}
+
+
+// ====================================================================================================================
+// rasterizeSpansOnto
+// ====================================================================================================================
+
+TEST(MGLASS_ELLIPSE_SHAPE, RASTERIZE_SPANS_EMPTY)
+{
+    const mglass::shapes::Ellipse e{ {0, 0}, 0, 0};
+
+    const mglass::IntegralRectArea rasterizeOntoArea{
+        {0, 0},
+        100,
+        100
+    };
+
+    bool gotCalled = false;
+    e.rasterizeSpansOnto(rasterizeOntoArea, [&gotCalled](const mglass::shapes::Ellipse::RasterizationSpan&) {
+        gotCalled = true;
+    });
+
+    ASSERT_FALSE(gotCalled) << "Empty ellipse should rasterize no spans.";
+}
+
+TEST(MGLASS_ELLIPSE_SHAPE, RASTERIZE_SPANS_MATCH_POINTS)
+{
+    const mglass::shapes::Ellipse ellipses[] {
+        mglass::shapes::Ellipse{ {0, 0}, 10, 5 },
+        mglass::shapes::Ellipse{ {0, 0}, 10, 6 },
+        mglass::shapes::Ellipse{ {0.3f, -7.8f}, 37.4f, 91.1f },
+        mglass::shapes::Ellipse{ {-12.5f, 3.5f}, 1.5f, 120 },
+        mglass::shapes::Ellipse{ {100, 100}, 250, 100 },
+    };
+
+    const mglass::IntegralRectArea rasterizeOntoAreas[] {
+        { {-50, 50}, 100, 100 },
+        { {0, 98}, 100, 100 },
+        { {-13, 60}, 7, 200 },
+        { {-200, 200}, 400, 400 },
+    };
+
+    for (const auto& e : ellipses)
+    {
+        for (const auto& area : rasterizeOntoAreas)
+        {
+            IntPointSet expectedPoints;
+            e.rasterizeOnto(area, [&expectedPoints](const mglass::shapes::Ellipse::RasterizationContext& rstCtx) {
+                expectedPoints.emplace(rstCtx.getRasterizedPoint());
+            });
+
+            IntPointSet actualPoints;
+            mglass::int_type prevY = area.topLeft.y + 1;
+
+            e.rasterizeSpansOnto(area, [&](const mglass::shapes::Ellipse::RasterizationSpan& span) {
+                ASSERT_LT(span.getXBegin(), span.getXEnd());
+                ASSERT_LT(span.getY(), prevY) << "The ellipse should emit a single span per row from the top to the bottom.";
+                prevY = span.getY();
+
+                for (auto x = span.getXBegin(); x < span.getXEnd(); ++x)
+                {
+                    ASSERT_TRUE(actualPoints.emplace(IntPoint{x, span.getY()}).second);
+                    ASSERT_GE(span.getPixelDensityAt(x), 0);
+                    ASSERT_LE(span.getPixelDensityAt(x), 1);
+                }
+            });
+
+            ASSERT_EQ(actualPoints, expectedPoints);
+        }
+    }
+}
+
+
+TEST(MGLASS_ELLIPSE_SHAPE, SPAN_DENSITIES_BATCH_EQUALS_SCALAR)
+{
+    const auto feathered = mglass::FalloffProfile::fromFunction([](const double u) { return (std::min)(1.0, u / 0.2); });
+
+    const mglass::shapes::Ellipse ellipses[] {
+        mglass::shapes::Ellipse{ {0, 0}, 10, 5 },
+        mglass::shapes::Ellipse{ {0.3f, -7.8f}, 37.4f, 91.1f },
+        mglass::shapes::Ellipse{ {-12.5f, 3.5f}, 1.5f, 120, mglass::FalloffProfile::linear() },
+        mglass::shapes::Ellipse{ {100.7f, 100.2f}, 251, 99, feathered },
+    };
+
+    for (const auto& e : ellipses)
+    {
+        std::size_t spansCount = 0;
+
+        e.rasterizeSpansOnto(mglass::getShapeIntegralBounds(e), [&spansCount](const mglass::shapes::Ellipse::RasterizationSpan& span) {
+            ++spansCount;
+
+            // the subranges exercise all the tails of the SIMD loops
+            for (mglass::int_type skip = 0; (skip < 9) && (span.getXBegin() + skip < span.getXEnd()); ++skip)
+            {
+                const mglass::int_type xBegin = span.getXBegin() + skip;
+
+                std::vector<mglass::float_type> densities(static_cast<std::size_t>(span.getXEnd() - xBegin));
+                span.getPixelDensitiesOf(xBegin, span.getXEnd(), densities.data());
+
+                for (auto x = xBegin; x < span.getXEnd(); ++x)
+                    ASSERT_EQ(densities[static_cast<std::size_t>(x - xBegin)], span.getPixelDensityAt(x)) << x << ", " << span.getY();
+            }
+        });
+
+        EXPECT_GT(spansCount, 0U);
+    }
+}
+
+
+// ====================================================================================================================
+// classifyBlock()
+// ====================================================================================================================
+
+TEST(MGLASS_ELLIPSE_SHAPE, CLASSIFY_BLOCKS_MATCH_RASTERIZATION)
+{
+    // the density is 1 farther than 0.2 from the edge
+    const auto feathered = mglass::FalloffProfile::fromFunction([](const double u) { return (std::min)(1.0, u / 0.2); });
+
+    const mglass::shapes::Ellipse shapes[] {
+        mglass::shapes::Ellipse{ {0, 0}, 10, 5, feathered },
+        mglass::shapes::Ellipse{ {0.3f, -7.8f}, 37.4f, 91.1f, feathered },
+        mglass::shapes::Ellipse{ {-12.5f, 3.5f}, 1.5f, 120, feathered },
+        mglass::shapes::Ellipse{ {100, 100}, 250, 100, feathered },
+        mglass::shapes::Ellipse{ {100.5f, 100.5f}, 250, 100 },
+        mglass::shapes::Ellipse{ {0, 0}, 0, 100, feathered },
+    };
+
+    for (const auto& shape : shapes)
+    {
+        const mglass::IntegralRectArea bounds = mglass::getShapeIntegralBounds(shape);
+        const mglass::IntegralRectArea area{
+            { bounds.topLeft.x - 20, bounds.topLeft.y + 20 },
+            bounds.width + 40,
+            bounds.height + 40
+        };
+
+        std::unordered_map<IntPoint, mglass::float_type, PointHash> densities;
+        shape.rasterizeOnto(area, [&densities](const mglass::shapes::Ellipse::RasterizationContext& rstCtx) {
+            densities.emplace(rstCtx.getRasterizedPoint(), rstCtx.getPixelDensity());
+        });
+
+        for (const mglass::size_type blockSize : { 1, 5, 16 })
+        {
+            for (mglass::size_type row = 0; row < area.height; row += blockSize)
+            {
+                for (mglass::size_type column = 0; column < area.width; column += blockSize)
+                {
+                    const mglass::IntegralRectArea block{
+                        { area.topLeft.x + static_cast<mglass::int_type>(column), area.topLeft.y - static_cast<mglass::int_type>(row) },
+                        (std::min)(blockSize, area.width - column),
+                        (std::min)(blockSize, area.height - row)
+                    };
+
+                    const mglass::BlockCoverage coverage = shape.classifyBlock(block);
+
+                    for (mglass::size_type y = 0; y < block.height; ++y)
+                    {
+                        for (mglass::size_type x = 0; x < block.width; ++x)
+                        {
+                            const IntPoint point{
+                                block.topLeft.x + static_cast<mglass::int_type>(x),
+                                block.topLeft.y - static_cast<mglass::int_type>(y)
+                            };
+                            const auto it = densities.find(point);
+
+                            if (coverage == mglass::BlockCoverage::Outside)
+                            {
+                                ASSERT_EQ(it, densities.end()) << "An Outside block should have no rasterized pixels.";
+                            }
+                            else if (coverage == mglass::BlockCoverage::Inside)
+                            {
+                                ASSERT_NE(it, densities.end()) << "All the pixels of an Inside block should be rasterized.";
+                                ASSERT_EQ(it->second, 1) << "All the pixels of an Inside block should have the density 1.";
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // the blocks deep inside the shapes are classified as Inside, the ones far from them as Outside
+    EXPECT_EQ(shapes[3].classifyBlock({ {90, 110}, 16, 16 }), mglass::BlockCoverage::Inside);
+    EXPECT_EQ(shapes[3].classifyBlock({ {-100, 300}, 16, 16 }), mglass::BlockCoverage::Outside);
+
+    // the density of the default profile is less than 1 almost everywhere
+    EXPECT_EQ(shapes[4].classifyBlock({ {90, 110}, 16, 16 }), mglass::BlockCoverage::Edge);
+}
@@ -0,0 +1,77 @@
+#include "mglass/executors.h"
+#include "gtest/gtest.h"
+#include <atomic>           // std::atomic
+#include <vector>           // std::vector
+
+
+namespace
+{
+    // checks that `executor` calls the task exactly once for each index
+    void checkAllTasksAreRunOnce(mglass::Executor& executor, const mglass::size_type tasksCount)
+    {
+        std::vector<std::atomic<int>> callsCount(tasksCount);
+        for (auto& count : callsCount)
+            count = 0;
+
+        executor.parallelFor(tasksCount, [&callsCount](const mglass::size_type i) {
+            ++callsCount[i];
+        });
+
+        for (mglass::size_type i = 0; i < tasksCount; ++i)
+            ASSERT_EQ(callsCount[i].load(), 1) << "task #" << i;
+    }
+} // namespace
+
+
+// ====================================================================================================================
+// SequentialExecutor
+// ====================================================================================================================
+
+TEST(MGLASS_SEQUENTIAL_EXECUTOR, RUNS_TASKS_IN_ORDER)
+{
+    mglass::SequentialExecutor executor;
+
+    EXPECT_EQ(executor.getConcurrency(), 1);
+
+    std::vector<mglass::size_type> calls;
+    executor.parallelFor(5, [&calls](const mglass::size_type i) { calls.push_back(i); });
+
+    EXPECT_EQ(calls, (std::vector<mglass::size_type>{ 0, 1, 2, 3, 4 }));
+}
+
+
+// ====================================================================================================================
+// ThreadPool
+// ====================================================================================================================
+
+TEST(MGLASS_THREAD_POOL, NO_WORKERS)
+{
+    mglass::ThreadPool pool{0};
+
+    EXPECT_EQ(pool.getConcurrency(), 1);
+    checkAllTasksAreRunOnce(pool, 0);
+    checkAllTasksAreRunOnce(pool, 1);
+    checkAllTasksAreRunOnce(pool, 100);
+}
+
+TEST(MGLASS_THREAD_POOL, RUNS_EACH_TASK_ONCE)
+{
+    mglass::ThreadPool pool{7};
+
+    EXPECT_EQ(pool.getConcurrency(), 8);
+
+    for (const mglass::size_type tasksCount : { 0, 1, 2, 7, 8, 9, 1000 })
+        checkAllTasksAreRunOnce(pool, tasksCount);
+}
+
+TEST(MGLASS_THREAD_POOL, MANY_SUBSEQUENT_JOBS)
+{
+    mglass::ThreadPool pool{3};
+
+    std::atomic<mglass::size_type> sum{0};
+
+    for (int job = 0; job < 1000; ++job)
+        pool.parallelFor(10, [&sum](const mglass::size_type i) { sum += i; });
+
+    EXPECT_EQ(sum.load(), 1000 * 45);
+}
@@ -0,0 +1,184 @@
+#include "mglass/falloff_profile.h" // mglass::FalloffProfile
+#include "mglass/shapes.h"          // mglass::shapes::*
+#include "mglass/shape_mask.h"      // mglass::ShapeMaskCache
+#include "gtest/gtest.h"
+#include <cmath>                    // std::pow, std::exp, std::abs, std::isnan
+#include <cstddef>                  // std::size_t, std::ptrdiff_t
+#include <cstdint>                  // std::uint64_t
+#include <limits>                   // std::numeric_limits
+#include <optional>                 // std::optional
+#include <type_traits>              // std::is_constructible_v
+#include <vector>                   // std::vector
+
+
+namespace
+{
+    template<typename DensityFunction>
+    void checkProfileEqualsFunction(const mglass::FalloffProfile& profile, const DensityFunction& densityOf)
+    {
+        // the edge, the steep part near the edge and the uniform grid
+        for (const double u : { 0.0, 1e-9, 1e-7, 3e-5, 0.001, 0.0123 })
+            ASSERT_NEAR(profile.getDensityAt(static_cast<mglass::float_type>(u)), densityOf(u), 1e-3) << "u = " << u;
+
+        for (int i = 0; i <= 1000; ++i)
+        {
+            const double u = i / 1000.0;
+            ASSERT_NEAR(profile.getDensityAt(static_cast<mglass::float_type>(u)), densityOf(u), 1e-4) << "u = " << u;
+        }
+    }
+} // namespace
+
+
+TEST(MGLASS_FALLOFF_PROFILE, BUILT_IN_PROFILES)
+{
+    checkProfileEqualsFunction(mglass::FalloffProfile::linear(), [](const double u) { return u; });
+    checkProfileEqualsFunction(mglass::FalloffProfile::smoothstep(), [](const double u) { return u * u * (3 - 2 * u); });
+    checkProfileEqualsFunction(mglass::FalloffProfile::quartic(), [](const double u) { return 1 - std::pow(1 - u, 4); });
+    checkProfileEqualsFunction(mglass::FalloffProfile::fifthRoot(), [](const double u) { return std::pow(u, 0.2); });
+
+    const mglass::FalloffProfile& gaussian = mglass::FalloffProfile::gaussian();
+    EXPECT_NEAR(gaussian.getDensityAt(0), 0, 1e-6);
+    EXPECT_NEAR(gaussian.getDensityAt(1), 1, 1e-6);
+    EXPECT_NEAR(gaussian.getDensityAt(0.6f), (std::exp(-0.5) - std::exp(-3.125)) / (1 - std::exp(-3.125)), 1e-4);
+}
+
+TEST(MGLASS_FALLOFF_PROFILE, CLAMPING)
+{
+    const auto profile = mglass::FalloffProfile::fromFunction([](const double u) { return 2 * u - 0.5; });
+
+    EXPECT_EQ(profile.getDensityAt(-1), 0);
+    EXPECT_EQ(profile.getDensityAt(0), 0);
+    EXPECT_EQ(profile.getDensityAt(1), 1);
+    EXPECT_EQ(profile.getDensityAt(5), 1);
+    EXPECT_NEAR(profile.getDensityAt(0.5f), 0.5f, 1e-6);
+
+    // the values of the function are clamped
+    EXPECT_EQ(profile.getDensityAt(0.1f), 0);
+    EXPECT_EQ(profile.getDensityAt(0.9f), 1);
+}
+
+TEST(MGLASS_FALLOFF_PROFILE, BATCH_EQUALS_SCALAR)
+{
+    // the values outside [0; 1], the ones below the tabulated range and the ones between the entries
+    std::vector<mglass::float_type> us{
+        -1, -0.0f, 0, 1e-12f, 1e-10f, 2.3e-10f, 1e-7f, 3e-5f, 0.25f, 0.999999f, 1, 1.5f,
+        std::numeric_limits<mglass::float_type>::quiet_NaN(),
+        std::numeric_limits<mglass::float_type>::infinity()
+    };
+    for (int i = 0; i <= 1000; ++i)
+        us.push_back(static_cast<mglass::float_type>(i) / 997);
+
+    const auto feathered = mglass::FalloffProfile::fromFunction([](const double u) { return 0.25 + u; });
+
+    for (const mglass::FalloffProfile* profile : { &mglass::FalloffProfile::quartic(), &mglass::FalloffProfile::fifthRoot(), &feathered })
+    {
+        // all the lengths exercise the tails of the SIMD loops
+        for (std::size_t offset = 0; offset < 9; ++offset)
+        {
+            std::vector<mglass::float_type> densities(us.begin() + static_cast<std::ptrdiff_t>(offset), us.end());
+            profile->getDensitiesAt(densities.data(), densities.size());
+
+            for (std::size_t i = 0; i < densities.size(); ++i)
+            {
+                const mglass::float_type expected = profile->getDensityAt(us[offset + i]);
+
+                if (std::isnan(expected))
+                    ASSERT_TRUE(std::isnan(densities[i])) << "u = " << us[offset + i];
+                else
+                    ASSERT_EQ(densities[i], expected) << "u = " << us[offset + i];
+            }
+        }
+    }
+}
+
+TEST(MGLASS_FALLOFF_PROFILE, SHAPES)
+{
+    const mglass::shapes::Ellipse defaultEllipse{ {0.5f, -0.5f}, 250, 100 };
+    const mglass::shapes::Ellipse linearEllipse{ {0.5f, -0.5f}, 250, 100, mglass::FalloffProfile::linear() };
+
+    EXPECT_EQ(&defaultEllipse.getFalloffProfile(), &mglass::FalloffProfile::quartic());
+    EXPECT_EQ(&linearEllipse.getFalloffProfile(), &mglass::FalloffProfile::linear());
+
+    linearEllipse.rasterizeSpansOnto(mglass::getShapeIntegralBounds(linearEllipse), [](const auto& span) {
+        for (mglass::int_type x = span.getXBegin(); x < span.getXEnd(); ++x)
+        {
+            const mglass::float_type r2 = span.getX2At(x) * span.getA2Inversed() + span.getY2DivB2();
+            ASSERT_NEAR(span.getPixelDensityAt(x), 1 - r2, 1e-4);
+        }
+    });
+
+    const mglass::shapes::Rectangle defaultRectangle{ {0, 0}, 250, 100 };
+    const mglass::shapes::Rectangle smoothRectangle{ {0, 0}, 250, 100, mglass::FalloffProfile::smoothstep() };
+
+    EXPECT_EQ(&defaultRectangle.getFalloffProfile(), &mglass::FalloffProfile::fifthRoot());
+
+    smoothRectangle.rasterizeOnto(mglass::getShapeIntegralBounds(smoothRectangle), [](const auto& context) {
+        const auto point = context.getRasterizedPoint();
+        const double u = (1 - 2 * std::abs(point.x) / 250.0) * (1 - 2 * std::abs(point.y) / 100.0);
+
+        ASSERT_NEAR(context.getPixelDensity(), u * u * (3 - 2 * u), 1e-4);
+    });
+}
+
+TEST(MGLASS_FALLOFF_PROFILE, SHAPES_REJECT_TEMPORARY_PROFILES)
+{
+    using Center = mglass::Point<mglass::float_type>;
+    using mglass::float_type;
+
+    // the shapes keep the address of the profile, so a temporary one would dangle
+    static_assert( !std::is_constructible_v<mglass::shapes::Ellipse, Center, float_type, float_type, mglass::FalloffProfile> );
+    static_assert( !std::is_constructible_v<mglass::shapes::Rectangle, Center, float_type, float_type, mglass::FalloffProfile> );
+
+    static_assert( std::is_constructible_v<mglass::shapes::Ellipse, Center, float_type, float_type, const mglass::FalloffProfile&> );
+    static_assert( std::is_constructible_v<mglass::shapes::Rectangle, Center, float_type, float_type, const mglass::FalloffProfile&> );
+
+    using Transform = mglass::AffineTransform;
+
+    static_assert( !std::is_constructible_v<mglass::shapes::TransformedEllipse,
+                                            Center, float_type, float_type, Transform, mglass::FalloffProfile> );
+    static_assert( !std::is_constructible_v<mglass::shapes::TransformedRectangle,
+                                            Center, float_type, float_type, Transform, mglass::FalloffProfile> );
+
+    static_assert( std::is_constructible_v<mglass::shapes::TransformedEllipse,
+                                           Center, float_type, float_type, Transform, const mglass::FalloffProfile&> );
+    static_assert( std::is_constructible_v<mglass::shapes::TransformedRectangle,
+                                           Center, float_type, float_type, Transform, const mglass::FalloffProfile&> );
+
+    SUCCEED();
+}
+
+TEST(MGLASS_FALLOFF_PROFILE, MASK_CACHE_DISTINGUISHES_PROFILES)
+{
+    mglass::ShapeMaskCache cache;
+
+    const auto quarticMask = cache.getMaskOf(mglass::shapes::Ellipse{ {0, 0}, 250, 100 });
+    const auto gaussianMask = cache.getMaskOf(mglass::shapes::Ellipse{ {0, 0}, 250, 100, mglass::FalloffProfile::gaussian() });
+
+    EXPECT_NE(&quarticMask.getMask(), &gaussianMask.getMask());
+    EXPECT_EQ(cache.getSize(), 2);
+}
+
+TEST(MGLASS_FALLOFF_PROFILE, MASK_CACHE_DISTINGUISHES_PROFILES_AT_SAME_ADDRESS)
+{
+    mglass::ShapeMaskCache cache;
+
+    // the both profiles are placed at the same address
+    std::optional<mglass::FalloffProfile> profile;
+
+    profile.emplace(mglass::FalloffProfile::fromFunction([](const double u) { return u; }));
+    const auto linearMask = cache.getMaskOf(mglass::shapes::Ellipse{ {0, 0}, 250, 100, *profile });
+    const std::uint64_t linearId = profile->getId();
+
+    profile.reset();
+    profile.emplace(mglass::FalloffProfile::fromFunction([](const double u) { return std::pow(u, 0.1); }));
+    EXPECT_NE(profile->getId(), linearId);
+
+    const auto steepMask = cache.getMaskOf(mglass::shapes::Ellipse{ {0, 0}, 250, 100, *profile });
+    EXPECT_NE(&steepMask.getMask(), &linearMask.getMask());
+    EXPECT_EQ(cache.getSize(), 2);
+
+    // the copies of a profile share its masks
+    const mglass::FalloffProfile copy = *profile;
+    EXPECT_EQ(copy.getId(), profile->getId());
+    EXPECT_EQ(&cache.getMaskOf(mglass::shapes::Ellipse{ {0, 0}, 250, 100, copy }).getMask(), &steepMask.getMask());
+}
@@ -0,0 +1,198 @@
+#include "mglass/shapes.h"          // mglass::shapes::FixedEllipse, mglass::shapes::Ellipse
+#include "mglass/shape_mask.h"      // mglass::ShapeMaskCache
+#include "gtest/gtest.h"
+#include "shape_test_utils.h"        // shape_test_utils::*
+#include <cstddef>                  // std::size_t
+#include <utility>                  // std::pair
+#include <vector>                   // std::vector
+
+
+namespace
+{
+    using shape_test_utils::IntPoint;
+    using shape_test_utils::IntPointDensities;
+    using shape_test_utils::rasterizePointsOf;
+
+    // Checks the pixels of the `fixedEllipse` against the ones of the equal Ellipse.
+    template<mglass::size_type Width, mglass::size_type Height>
+    void checkEqualsEllipse(const mglass::shapes::FixedEllipse<Width, Height>& fixedEllipse)
+    {
+        const mglass::shapes::Ellipse ellipse{ fixedEllipse.getCenter(), Width, Height };
+
+        const mglass::IntegralRectArea bounds = mglass::getShapeIntegralBounds(fixedEllipse);
+        ASSERT_EQ(bounds, (mglass::IntegralRectArea{ fixedEllipse.getTopLeft(), Width, Height }));
+
+        const mglass::IntegralRectArea area{ { bounds.topLeft.x - 2, bounds.topLeft.y + 2 }, Width + 4, Height + 4 };
+
+        const IntPointDensities expected = rasterizePointsOf(ellipse, area);
+        const IntPointDensities actual = rasterizePointsOf(fixedEllipse, area);
+
+        ASSERT_EQ(actual.size(), expected.size());
+
+        for (const auto& [point, density] : expected)
+        {
+            const auto it = actual.find(point);
+            ASSERT_TRUE(it != actual.end()) << point.x << ", " << point.y;
+
+            // the coverages are rounded to 1/255
+            ASSERT_NEAR(it->second, density, 0.5f / 255 + 1e-3f) << point.x << ", " << point.y;
+        }
+    }
+} // namespace
+
+
+// ====================================================================================================================
+// detail::fixedEllipseRows, detail::getFixedEllipseCoverages
+// ====================================================================================================================
+
+TEST(MGLASS_FIXED_ELLIPSE_SHAPE, ROWS_ARE_CALCULATED_AT_COMPILE_TIME)
+{
+    constexpr const auto& rows = mglass::shapes::detail::fixedEllipseRows<8, 6>.rows;
+
+    // the top row: (2 * column - 7)^2 * 36 + 25 * 64 <= 64 * 36 for the columns 2..5
+    static_assert( (rows[0].xBegin == 2) && (rows[0].xEnd == 6) );
+    // the middle rows cover the box
+    static_assert( (rows[2].xBegin == 0) && (rows[2].xEnd == 8) );
+    static_assert( (rows[3].xBegin == rows[2].xBegin) && (rows[3].xEnd == rows[2].xEnd) );
+
+    constexpr const auto& lensRows = mglass::shapes::detail::fixedEllipseRows<256, 256>.rows;
+
+    static_assert( (lensRows[128].xBegin == 0) && (lensRows[128].xEnd == 256) );
+    static_assert( (lensRows[0].xBegin == lensRows[255].xBegin) && (lensRows[0].xEnd == lensRows[255].xEnd) );
+
+    // the single pixel is at the center
+    static_assert( (mglass::shapes::detail::fixedEllipseRows<1, 1>.rows[0].xEnd == 1) );
+
+    SUCCEED();
+}
+
+TEST(MGLASS_FIXED_ELLIPSE_SHAPE, COVERAGES)
+{
+    const auto& coverages = mglass::shapes::detail::getFixedEllipseCoverages<8, 6>();
+
+    // the pixel at the edge of the ellipse is included with zero coverage
+    EXPECT_LT(coverages.coverages[2 * 8 + 0], coverages.coverages[2 * 8 + 3]);
+
+    // the coverages are calculated once
+    EXPECT_EQ((&mglass::shapes::detail::getFixedEllipseCoverages<8, 6>()), &coverages);
+
+    const auto& lensCoverages = mglass::shapes::detail::getFixedEllipseCoverages<256, 256>();
+
+    EXPECT_LT(lensCoverages.rows[128].solidBegin, 128);
+    EXPECT_GT(lensCoverages.rows[128].solidEnd, 128);
+    EXPECT_EQ(lensCoverages.coverages[128 * 256 + 128], 255);
+}
+
+
+// ====================================================================================================================
+// rasterizeOnto, rasterizeSpansOnto
+// ====================================================================================================================
+
+TEST(MGLASS_FIXED_ELLIPSE_SHAPE, RASTERIZE_EQUALS_ELLIPSE)
+{
+    checkEqualsEllipse(mglass::shapes::FixedEllipse<256, 256>{ {100, -30} });
+    checkEqualsEllipse(mglass::shapes::FixedEllipse<31, 17>{ {-7, 12} });
+    checkEqualsEllipse(mglass::shapes::FixedEllipse<64, 40>{ {0, 0} });
+    checkEqualsEllipse(mglass::shapes::FixedEllipse<1, 1>{ {5, 5} });
+}
+
+TEST(MGLASS_FIXED_ELLIPSE_SHAPE, RASTERIZE_SPANS_MATCH_POINTS)
+{
+    using Shape = mglass::shapes::FixedEllipse<90, 70>;
+
+    const mglass::IntegralRectArea rasterizeOntoAreas[] {
+        { {-50, 50}, 100, 100 },
+        { {0, 98}, 100, 100 },
+        { {-13, 20}, 7, 200 },
+        { {-5, 5}, 10, 10 },
+    };
+
+    const Shape shape{ {-45, 35} };
+
+    for (const auto& area : rasterizeOntoAreas)
+    {
+        std::vector<std::pair<IntPoint, mglass::float_type>> expectedPoints;
+        shape.rasterizeOnto(area, [&expectedPoints](const Shape::RasterizationContext& rstCtx) {
+            expectedPoints.emplace_back(rstCtx.getRasterizedPoint(), rstCtx.getPixelDensity());
+        });
+
+        std::vector<std::pair<IntPoint, mglass::float_type>> actualPoints;
+        IntPoint prevEnd{ area.topLeft.x - 1, area.topLeft.y + 1 };
+
+        shape.rasterizeSpansOnto(area, [&](const Shape::RasterizationSpan& span) {
+            ASSERT_LT(span.getXBegin(), span.getXEnd());
+            ASSERT_TRUE( (span.getY() < prevEnd.y) || ((span.getY() == prevEnd.y) && (span.getXBegin() >= prevEnd.x)) )
+                << "The shape should emit the spans from the top to the bottom and from the left to the right.";
+            prevEnd = { span.getXEnd(), span.getY() };
+
+            for (auto x = span.getXBegin(); x < span.getXEnd(); ++x)
+                actualPoints.emplace_back(IntPoint{x, span.getY()}, span.getPixelDensityAt(x));
+        });
+
+        ASSERT_EQ(actualPoints, expectedPoints);
+    }
+}
+
+TEST(MGLASS_FIXED_ELLIPSE_SHAPE, CLASSIFY_BLOCK_MATCHES_RASTERIZATION)
+{
+    const mglass::shapes::FixedEllipse<120, 90> shape{ {-60, 45} };
+
+    const IntPointDensities points = rasterizePointsOf(shape, mglass::getShapeIntegralBounds(shape));
+
+    std::size_t insideCount = 0;
+    std::size_t outsideCount = 0;
+
+    for (mglass::int_type top = 60; top > -60; top -= 8)
+    {
+        for (mglass::int_type left = -70; left < 70; left += 8)
+        {
+            const mglass::IntegralRectArea block{ {left, top}, 8, 8 };
+            const mglass::BlockCoverage coverage = shape.classifyBlock(block);
+
+            insideCount += (coverage == mglass::BlockCoverage::Inside) ? 1 : 0;
+            outsideCount += (coverage == mglass::BlockCoverage::Outside) ? 1 : 0;
+
+            for (mglass::int_type y = top; y > top - 8; --y)
+            {
+                for (mglass::int_type x = left; x < left + 8; ++x)
+                {
+                    const auto it = points.find({x, y});
+
+                    if (coverage == mglass::BlockCoverage::Outside)
+                    {
+                        ASSERT_TRUE(it == points.end());
+                    }
+                    if (coverage == mglass::BlockCoverage::Inside)
+                    {
+                        ASSERT_TRUE( (it != points.end()) && (it->second == 1) );
+                    }
+                }
+            }
+        }
+    }
+
+    EXPECT_GT(insideCount, 0U);
+    EXPECT_GT(outsideCount, 0U);
+}
+
+
+// ====================================================================================================================
+// ShapeMaskCache
+// ====================================================================================================================
+
+TEST(MGLASS_FIXED_ELLIPSE_SHAPE, MASK_CACHE_DISTINGUISHES_SIZES)
+{
+    mglass::ShapeMaskCache cache;
+
+    const mglass::shapes::FixedEllipse<64, 64> circle{ {0, 0} };
+    const mglass::shapes::Ellipse ellipse{ circle.getCenter(), 64, 64 };
+
+    const auto circleMask = cache.getMaskOf(circle);
+    EXPECT_NE(&cache.getMaskOf(ellipse).getMask(), &circleMask.getMask());
+    EXPECT_NE(&cache.getMaskOf(mglass::shapes::FixedEllipse<64, 32>{}).getMask(), &circleMask.getMask());
+    EXPECT_EQ(cache.getSize(), 3U);
+
+    // the moved shape shares the mask
+    EXPECT_EQ(&cache.getMaskOf(mglass::shapes::FixedEllipse<64, 64>{ {-30, 45} }).getMask(), &circleMask.getMask());
+    EXPECT_EQ(cache.getSize(), 3U);
+}
@@ -0,0 +1,212 @@
+#include "mglass/mglass.h"
+#include "gtest/gtest.h"
+#include "image_test_utils.h" // image_test_utils::makeGradientImage
+#include <cstdint>          // std::uint8_t
+#include <vector>           // std::vector
+
+
+namespace
+{
+    using image_test_utils::makeGradientImage;
+} // namespace
+
+
+// ====================================================================================================================
+// ctors
+// ====================================================================================================================
+
+TEST(MGLASS_IMAGE_SPAN, CTOR_DEFAULT)
+{
+    constexpr mglass::ImageSpan span;
+
+    EXPECT_EQ(span.getWidth(), 0);
+    EXPECT_EQ(span.getHeight(), 0);
+}
+
+TEST(MGLASS_IMAGE_SPAN, CTOR_FROM_EMPTY_IMAGE)
+{
+    const mglass::Image img;
+    const mglass::ImageSpan span{img};
+
+    EXPECT_EQ(span.getWidth(), 0);
+    EXPECT_EQ(span.getHeight(), 0);
+}
+
+TEST(MGLASS_IMAGE_SPAN, CTOR_0_100)
+{
+    const std::vector<mglass::ARGB> buffer(100);
+    const mglass::ImageSpan span{buffer.data(), 0, 100, 1};
+
+    EXPECT_EQ(span.getWidth(), 0);
+    EXPECT_EQ(span.getHeight(), 0);
+}
+
+TEST(MGLASS_IMAGE_SPAN, CTOR_FROM_IMAGE)
+{
+    const auto img = makeGradientImage(37, 19);
+    const mglass::ImageSpan span{img};
+
+    ASSERT_EQ(span.getWidth(), img.getWidth());
+    ASSERT_EQ(span.getHeight(), img.getHeight());
+    ASSERT_EQ(span.getRowStride(), img.getWidth());
+
+    for (mglass::size_type y = 0; y < img.getHeight(); ++y)
+        for (mglass::size_type x = 0; x < img.getWidth(); ++x)
+            ASSERT_EQ(span.getPixelAt(x, y), img.getPixelAt(x, y));
+}
+
+TEST(MGLASS_IMAGE_SPAN, CTOR_FOREIGN_BUFFER_WITH_STRIDE)
+{
+    constexpr mglass::size_type width = 5;
+    constexpr mglass::size_type height = 3;
+    constexpr mglass::size_type stride = 8;
+
+    std::vector<mglass::ARGB> buffer(stride * height, mglass::ARGB::black());
+    for (mglass::size_type y = 0; y < height; ++y)
+        for (mglass::size_type x = 0; x < width; ++x)
+            buffer[y * stride + x] = { 1, static_cast<std::uint8_t>(x), static_cast<std::uint8_t>(y), 2 };
+
+    const mglass::ImageSpan span{buffer.data(), width, height, stride};
+
+    ASSERT_EQ(span.getWidth(), width);
+    ASSERT_EQ(span.getHeight(), height);
+    ASSERT_EQ(span.getRowStride(), stride);
+
+    for (mglass::size_type y = 0; y < height; ++y)
+    {
+        ASSERT_EQ(span.getRowData(y), buffer.data() + y * stride);
+
+        for (mglass::size_type x = 0; x < width; ++x)
+        {
+            const mglass::ARGB expected{ 1, static_cast<std::uint8_t>(x), static_cast<std::uint8_t>(y), 2 };
+            ASSERT_EQ(span.getPixelAt(x, y), expected);
+        }
+    }
+}
+
+
+// ====================================================================================================================
+// getSubSpan
+// ====================================================================================================================
+
+TEST(MGLASS_IMAGE_SPAN, SUBSPAN_INSIDE)
+{
+    const auto img = makeGradientImage(40, 30);
+    const auto sub = mglass::ImageSpan{img}.getSubSpan(3, 4, 10, 20);
+
+    ASSERT_EQ(sub.getWidth(), 10);
+    ASSERT_EQ(sub.getHeight(), 20);
+    ASSERT_EQ(sub.getRowStride(), 40);
+
+    for (mglass::size_type y = 0; y < sub.getHeight(); ++y)
+        for (mglass::size_type x = 0; x < sub.getWidth(); ++x)
+            ASSERT_EQ(sub.getPixelAt(x, y), img.getPixelAt(x + 3, y + 4));
+}
+
+TEST(MGLASS_IMAGE_SPAN, SUBSPAN_CLIPPED)
+{
+    const auto img = makeGradientImage(40, 30);
+    const auto sub = mglass::ImageSpan{img}.getSubSpan(35, 25, 10, 20);
+
+    ASSERT_EQ(sub.getWidth(), 5);
+    ASSERT_EQ(sub.getHeight(), 5);
+    ASSERT_EQ(sub.getPixelAt(4, 4), img.getPixelAt(39, 29));
+}
+
+TEST(MGLASS_IMAGE_SPAN, SUBSPAN_OUTSIDE)
+{
+    const auto img = makeGradientImage(40, 30);
+
+    const auto sub1 = mglass::ImageSpan{img}.getSubSpan(40, 0, 10, 20);
+    EXPECT_EQ(sub1.getWidth(), 0);
+    EXPECT_EQ(sub1.getHeight(), 0);
+
+    const auto sub2 = mglass::ImageSpan{img}.getSubSpan(0, 30, 10, 20);
+    EXPECT_EQ(sub2.getWidth(), 0);
+    EXPECT_EQ(sub2.getHeight(), 0);
+}
+
+
+// ====================================================================================================================
+// MutableImageSpan
+// ====================================================================================================================
+
+TEST(MGLASS_MUTABLE_IMAGE_SPAN, CTOR_FROM_IMAGE)
+{
+    auto img = makeGradientImage(37, 19);
+    const mglass::MutableImageSpan span{img};
+
+    ASSERT_EQ(span.getWidth(), img.getWidth());
+    ASSERT_EQ(span.getHeight(), img.getHeight());
+    ASSERT_EQ(span.getRowStrideBytes(), img.getWidth() * 4);
+    ASSERT_EQ(span.getFormat(), mglass::PixelFormat::ARGB);
+
+    for (mglass::size_type y = 0; y < img.getHeight(); ++y)
+        for (mglass::size_type x = 0; x < img.getWidth(); ++x)
+            ASSERT_EQ(span.getPixelAt(x, y), img.getPixelAt(x, y));
+
+    span.setPixelAt(3, 4, mglass::ARGB::black());
+    ASSERT_EQ(img.getPixelAt(3, 4), mglass::ARGB::black());
+}
+
+TEST(MGLASS_MUTABLE_IMAGE_SPAN, PIXEL_FORMATS_LAYOUT)
+{
+    const mglass::ARGB color{ 0x11, 0x22, 0x33, 0x44 };
+
+    struct FormatLayout { mglass::PixelFormat format; std::uint8_t bytes[4]; };
+    const FormatLayout layouts[] = {
+        { mglass::PixelFormat::ARGB, { 0x11, 0x22, 0x33, 0x44 } },
+        { mglass::PixelFormat::BGRA, { 0x44, 0x33, 0x22, 0x11 } },
+        { mglass::PixelFormat::RGBA, { 0x22, 0x33, 0x44, 0x11 } }
+    };
+
+    for (const auto& layout : layouts)
+    {
+        std::uint8_t buffer[4] = {};
+        const mglass::MutableImageSpan span{buffer, 1, 1, 4, layout.format};
+
+        span.setPixelAt(0, 0, color);
+
+        for (int i = 0; i < 4; ++i)
+            ASSERT_EQ(buffer[i], layout.bytes[i]);
+
+        ASSERT_EQ(span.getPixelAt(0, 0), color);
+    }
+}
+
+TEST(MGLASS_MUTABLE_IMAGE_SPAN, STRIDE_AND_FILL_OF_SUBSPAN)
+{
+    constexpr mglass::size_type width = 6;
+    constexpr mglass::size_type height = 5;
+    constexpr mglass::size_type strideBytes = 32;
+
+    std::vector<std::uint8_t> buffer(strideBytes * height, 0xAB);
+    const mglass::MutableImageSpan span{buffer.data(), width, height, strideBytes, mglass::PixelFormat::BGRA};
+
+    const auto sub = span.getSubSpan(4, 3, 10, 10);
+    ASSERT_EQ(sub.getWidth(), 2);
+    ASSERT_EQ(sub.getHeight(), 2);
+    ASSERT_EQ(sub.getRowStrideBytes(), strideBytes);
+    ASSERT_EQ(sub.getFormat(), mglass::PixelFormat::BGRA);
+
+    sub.fill(mglass::ARGB::black());
+
+    for (mglass::size_type y = 0; y < height; ++y)
+    {
+        for (mglass::size_type x = 0; x < width; ++x)
+        {
+            if ((x >= 4) && (y >= 3))
+                ASSERT_EQ(span.getPixelAt(x, y), mglass::ARGB::black());
+            else
+                ASSERT_EQ(span.getPixelAt(x, y), (mglass::ARGB{ 0xAB, 0xAB, 0xAB, 0xAB }));
+        }
+
+        // the padding at the end of rows is not touched
+        for (mglass::size_type i = width * 4; i < strideBytes; ++i)
+            ASSERT_EQ(buffer[y * strideBytes + i], 0xAB);
+    }
+
+    const auto outside = span.getSubSpan(6, 0, 1, 1);
+    EXPECT_EQ(outside.getWidth(), 0);
+    EXPECT_EQ(outside.getHeight(), 0);
+}
@@ -0,0 +1,25 @@
+#ifndef MAGNIFYING_GLASS_TESTS_IMAGE_TEST_UTILS_H
+#define MAGNIFYING_GLASS_TESTS_IMAGE_TEST_UTILS_H
+
+#include "mglass/image.h"       // mglass::Image
+#include "mglass/primitives.h"  // mglass::size_type
+#include <cstdint>              // std::uint8_t
+
+
+// The helpers shared by the tests of the images.
+namespace image_test_utils
+{
+    // the image whose pixel (x; y) is { 255, x, y, 7 } (the coordinates are truncated to 8 bits)
+    inline mglass::Image makeGradientImage(mglass::size_type width, mglass::size_type height)
+    {
+        mglass::Image result{width, height};
+
+        for (mglass::size_type y = 0; y < height; ++y)
+            for (mglass::size_type x = 0; x < width; ++x)
+                result.setPixelAt(x, y, { 255, static_cast<std::uint8_t>(x), static_cast<std::uint8_t>(y), 7 });
+
+        return result;
+    }
+} // namespace image_test_utils
+
+#endif // ndef MAGNIFYING_GLASS_TESTS_IMAGE_TEST_UTILS_H
@@ -0,0 +1,196 @@
+#include "mglass/mglass.h"          // mglass::*
+#include "mglass/lens_batch.h"      // mglass::Lens, mglass::magnifiers::magnifyLenses
+#include "mglass/magnifiers.h"      // mglass::magnifiers::*
+#include "mglass/shapes.h"          // mglass::shapes::*
+#include "gtest/gtest.h"
+#include <cstdint>                  // std::uint8_t
+#include <vector>                   // std::vector
+
+
+namespace
+{
+    using EllipseLens = mglass::Lens<mglass::shapes::Ellipse>;
+
+    // the small lenses scattered over Lenna.png (some of them overlap each other or the edges of the image)
+    std::vector<EllipseLens> makeHeatMapLenses(const mglass::size_type count)
+    {
+        const mglass::LensFilter filters[] = {
+            mglass::LensFilter::Nearest,
+            mglass::LensFilter::Bilinear,
+            mglass::LensFilter::Bicubic,
+            mglass::LensFilter::Lanczos3
+        };
+
+        std::vector<EllipseLens> result;
+
+        for (mglass::size_type i = 0; i < count; ++i)
+        {
+            const auto x = static_cast<mglass::float_type>((i * 97) % 540) - 14.5f;
+            const auto y = -static_cast<mglass::float_type>((i * 61 + i / 7 * 13) % 530) + 9.0f;
+            const auto size = static_cast<mglass::float_type>(12 + (i * 29) % 41);
+
+            result.push_back({
+                mglass::shapes::Ellipse{ {x, y}, size, size * 0.75f },
+                1.5f + static_cast<mglass::float_type>(i % 5) * 0.5f,
+                filters[i % 4],
+                (i % 3) != 0
+            });
+        }
+
+        return result;
+    }
+
+    // magnifies the `lenses` one by one like magnifyLenses does
+    void magnifyOneByOne(
+        const std::vector<EllipseLens>& lenses,
+        const mglass::ImageSpan& imageSrc,
+        const mglass::Point<mglass::int_type> imageTopLeft,
+        const mglass::MutableImageSpan& imageDst,
+        const mglass::Point<mglass::int_type> dstTopLeft)
+    {
+        for (const EllipseLens& lens : lenses)
+        {
+            const mglass::IntegralRectArea bounds = mglass::getShapeIntegralBounds(lens.shape);
+            const mglass::Point<mglass::int_type> dstOffset{ bounds.topLeft.x - dstTopLeft.x, dstTopLeft.y - bounds.topLeft.y };
+
+            switch (lens.filter)
+            {
+                case mglass::LensFilter::Nearest:
+                    mglass::magnifiers::nearestNeighbor(
+                        lens.shape, lens.scaleFactor, imageSrc, imageTopLeft, imageDst, dstOffset, lens.enableAlphaBlending, false);
+                    break;
+                case mglass::LensFilter::Bilinear:
+                    mglass::magnifiers::nearestNeighborInterpolated<mglass::interpolators::Bilinear>(
+                        lens.shape, lens.scaleFactor, imageSrc, imageTopLeft, imageDst, dstOffset, lens.enableAlphaBlending, false);
+                    break;
+                case mglass::LensFilter::Bicubic:
+                    mglass::magnifiers::nearestNeighborInterpolated<mglass::interpolators::Bicubic>(
+                        lens.shape, lens.scaleFactor, imageSrc, imageTopLeft, imageDst, dstOffset, lens.enableAlphaBlending, false);
+                    break;
+                case mglass::LensFilter::Lanczos3:
+                    mglass::magnifiers::nearestNeighborInterpolated<mglass::interpolators::Lanczos3>(
+                        lens.shape, lens.scaleFactor, imageSrc, imageTopLeft, imageDst, dstOffset, lens.enableAlphaBlending, false);
+                    break;
+            }
+        }
+    }
+} // namespace
+
+
+// ====================================================================================================================
+// detail::LensGrid
+// ====================================================================================================================
+
+TEST(MGLASS_LENS_BATCH, GRID_LISTS_OVERLAPPING_LENSES)
+{
+    const mglass::IntegralRectArea area{ {-10, 100}, 150, 130 };
+
+    const std::vector<mglass::IntegralRectArea> lensesAreas{
+        { {-10, 100}, 20, 20 },     // inside the first tile
+        { {-50, 200}, 400, 400 },   // covers the area
+        { {30, 50}, 0, 0 },         // empty
+        { {50, 40}, 14, 1 },        // touches the tiles of two columns
+        { {100, -20}, 100, 100 },   // partially outside of the area
+        { {500, 500}, 10, 10 },     // outside of the area
+    };
+
+    const mglass::detail::LensGrid grid{area, lensesAreas};
+
+    ASSERT_EQ(grid.getTilesCount(), 9U);
+
+    mglass::size_type tilesPixelsCount = 0;
+
+    for (mglass::size_type tileIndex = 0; tileIndex < grid.getTilesCount(); ++tileIndex)
+    {
+        const mglass::IntegralRectArea tile = grid.getTileArea(tileIndex);
+
+        ASSERT_EQ(mglass::getIntersectionOf(tile, area), tile);
+        tilesPixelsCount += tile.width * tile.height;
+
+        std::vector<mglass::size_type> expected;
+        for (mglass::size_type i = 0; i < lensesAreas.size(); ++i)
+        {
+            if (mglass::getIntersectionOf(lensesAreas[i], tile).width > 0)
+                expected.push_back(i);
+        }
+
+        std::vector<mglass::size_type> actual;
+        grid.forEachLensOf(tileIndex, [&actual](const mglass::size_type lensIndex) { actual.push_back(lensIndex); });
+
+        ASSERT_EQ(actual, expected) << tileIndex;
+    }
+
+    EXPECT_EQ(tilesPixelsCount, area.width * area.height);
+
+    // the empty area has no tiles
+    EXPECT_EQ(mglass::detail::LensGrid({ {0, 0}, 0, 0 }, lensesAreas).getTilesCount(), 0U);
+}
+
+
+// ====================================================================================================================
+// magnifyLenses
+// ====================================================================================================================
+
+TEST(MGLASS_LENS_BATCH, NO_LENSES_KEEP_DESTINATION)
+{
+    // please make sure you are running this tests at "magnifying-glass/tests" working directory
+
+    const auto lenna = mglass::Image::fromPNGFile("resources/Lenna.png");
+
+    mglass::Image actualImg = lenna;
+    mglass::magnifiers::magnifyLenses(std::vector<EllipseLens>{}, lenna, {0, 0}, actualImg, {0, 0});
+
+    EXPECT_EQ(actualImg, lenna);
+}
+
+TEST(MGLASS_LENS_BATCH, EQUALS_LENSES_MAGNIFIED_ONE_BY_ONE)
+{
+    // please make sure you are running this tests at "magnifying-glass/tests" working directory
+
+    const auto lenna = mglass::Image::fromPNGFile("resources/Lenna.png");
+    const mglass::Point<mglass::int_type> imgTopLeft{ 0, 0 };
+
+    const std::vector<EllipseLens> lenses = makeHeatMapLenses(240);
+
+    mglass::ThreadPool threadPool{3};
+
+    // the lenses over a copy of the source
+    {
+        mglass::Image expectedImg = lenna;
+        magnifyOneByOne(lenses, lenna, imgTopLeft, expectedImg, imgTopLeft);
+
+        mglass::Image actualImg = lenna;
+        mglass::magnifiers::magnifyLenses(lenses, lenna, imgTopLeft, actualImg, imgTopLeft);
+        ASSERT_EQ(actualImg, expectedImg);
+
+        actualImg = lenna;
+        mglass::magnifiers::magnifyLenses(threadPool, lenses, lenna, imgTopLeft, actualImg, imgTopLeft);
+        ASSERT_EQ(actualImg, expectedImg);
+    }
+
+    // a BGRA framebuffer with padded rows viewing a part of the source
+    {
+        constexpr mglass::size_type dstWidth = 300;
+        constexpr mglass::size_type dstHeight = 200;
+        constexpr mglass::size_type dstStrideBytes = dstWidth * 4 + 24;
+        const mglass::Point<mglass::int_type> dstTopLeft{ 150, -270 };
+        const mglass::ARGB background{ 255, 1, 2, 3 };
+
+        std::vector<std::uint8_t> expectedBuffer(dstStrideBytes * dstHeight);
+        const mglass::MutableImageSpan expected{expectedBuffer.data(), dstWidth, dstHeight, dstStrideBytes, mglass::PixelFormat::BGRA};
+        expected.fill(background);
+
+        std::vector<std::uint8_t> actualBuffer(dstStrideBytes * dstHeight);
+        const mglass::MutableImageSpan actual{actualBuffer.data(), dstWidth, dstHeight, dstStrideBytes, mglass::PixelFormat::BGRA};
+        actual.fill(background);
+
+        magnifyOneByOne(lenses, lenna, imgTopLeft, expected, dstTopLeft);
+        mglass::magnifiers::magnifyLenses(threadPool, lenses, lenna, imgTopLeft, actual, dstTopLeft);
+
+        for (mglass::size_type y = 0; y < dstHeight; ++y)
+        {
+            for (mglass::size_type x = 0; x < dstWidth; ++x)
+                ASSERT_EQ(actual.getPixelAt(x, y), expected.getPixelAt(x, y)) << x << ", " << y;
+        }
+    }
+}
@@ -0,0 +1,315 @@
+#include "mglass/mglass.h"          // mglass::*
+#include "mglass/magnifier_plan.h"  // mglass::MagnifierPlan
+#include "mglass/magnifiers.h"      // mglass::magnifiers::*
+#include "mglass/shapes.h"          // mglass::shapes::*
+#include "gtest/gtest.h"
+#include <cstdint>                  // std::uint8_t
+#include <vector>                   // std::vector
+
+
+namespace
+{
+    // offsets of the shapes (some of them move the shapes partially outside of the image)
+    const mglass::Point<mglass::int_type> shapeOffsets[] = {
+        { 0, 0 }, { 1, -1 }, { 37, -211 }, { -150, 90 }, { 480, -500 }, { 256, -256 }
+    };
+
+
+    // `makeShape`(center) returns the shape with the `center`
+    template<typename ShapeMaker>
+    void checkPlanEqualsMovedShape(
+        const mglass::Image& imageSrc,
+        const ShapeMaker& makeShape,
+        const mglass::Point<mglass::float_type> center,
+        const mglass::float_type scaleFactor,
+        const bool alphaBlending)
+    {
+        const mglass::MagnifierPlan plan{makeShape(center), scaleFactor, alphaBlending};
+
+        for (const auto offset : shapeOffsets)
+        {
+            const auto movedShape = makeShape({
+                center.x + static_cast<mglass::float_type>(offset.x),
+                center.y + static_cast<mglass::float_type>(offset.y)
+            });
+
+            mglass::Image expectedOutputImg;
+            mglass::Image actualOutputImg;
+
+            ASSERT_EQ(plan.getIntegralBounds(offset), mglass::getShapeIntegralBounds(movedShape));
+
+            mglass::magnifiers::nearestNeighbor(movedShape, scaleFactor, imageSrc, {0, 0}, expectedOutputImg, alphaBlending);
+            plan.nearestNeighbor(offset, imageSrc, {0, 0}, actualOutputImg);
+            ASSERT_EQ(actualOutputImg, expectedOutputImg);
+
+            mglass::magnifiers::nearestNeighborInterpolated(movedShape, scaleFactor, imageSrc, {0, 0}, expectedOutputImg, alphaBlending);
+            plan.nearestNeighborInterpolated(offset, imageSrc, {0, 0}, actualOutputImg);
+            ASSERT_EQ(actualOutputImg, expectedOutputImg);
+
+            mglass::magnifiers::nearestNeighborInterpolated<mglass::interpolators::Bicubic>(
+                movedShape, scaleFactor, imageSrc, {0, 0}, expectedOutputImg, alphaBlending);
+            plan.nearestNeighborInterpolated<mglass::interpolators::Bicubic>(offset, imageSrc, {0, 0}, actualOutputImg);
+            ASSERT_EQ(actualOutputImg, expectedOutputImg);
+        }
+    }
+
+
+    // The ring of the radius 60 with the alpha fading to the right placed at `topLeft`.
+    mglass::shapes::Mask makeRingMask(const mglass::Point<mglass::int_type> topLeft)
+    {
+        mglass::Image ring{ 160, 140 };
+
+        for (mglass::size_type row = 0; row < ring.getHeight(); ++row)
+        {
+            for (mglass::size_type col = 0; col < ring.getWidth(); ++col)
+            {
+                const auto dx = static_cast<mglass::int_type>(col) - 80;
+                const auto dy = static_cast<mglass::int_type>(row) - 70;
+                const mglass::int_type distanceSquare = dx * dx + dy * dy;
+
+                if ((distanceSquare >= 900) && (distanceSquare <= 3600))
+                    ring.getRowData(row)[col] = { static_cast<std::uint8_t>(255 - col), 10, 20, 30 };
+            }
+        }
+
+        return mglass::shapes::Mask{ ring, topLeft };
+    }
+
+    // Returns a shape of the ShapeT type placed over Lenna.png.
+    template<typename ShapeT>
+    ShapeT makeShapeOverLenna();
+
+    template<>
+    mglass::shapes::AntialiasedEllipse makeShapeOverLenna()
+    {
+        return mglass::shapes::AntialiasedEllipse{ {310.5f, -160}, 389, 330 };
+    }
+
+    template<>
+    mglass::shapes::AntialiasedRectangle makeShapeOverLenna()
+    {
+        return mglass::shapes::AntialiasedRectangle{ {250.3f, -300.6f}, 301.2f, 257.7f };
+    }
+
+    template<>
+    mglass::shapes::Polygon makeShapeOverLenna()
+    {
+        return mglass::shapes::Polygon::regular({310.5f, -160}, 6, 389, 330);
+    }
+
+    template<>
+    mglass::shapes::Mask makeShapeOverLenna()
+    {
+        return makeRingMask({250, -120});
+    }
+
+    template<>
+    mglass::shapes::TransformedEllipse makeShapeOverLenna()
+    {
+        return mglass::shapes::TransformedEllipse{ {310.5f, -160}, 389, 230, mglass::AffineTransform::rotation(0.5f) };
+    }
+
+    template<>
+    mglass::shapes::TransformedRectangle makeShapeOverLenna()
+    {
+        return mglass::shapes::TransformedRectangle{ {250.5f, -260}, 300, 150, mglass::AffineTransform::rotation(0.5f) };
+    }
+
+    using StadiumShape = mglass::shapes::SdfShape<mglass::shapes::sdf::Stadium>;
+
+    template<>
+    StadiumShape makeShapeOverLenna()
+    {
+        return StadiumShape{ {310.5f, -160}, 389, 150, { 194.5f, 75 } };
+    }
+
+    using EllipsesDifference = mglass::shapes::Difference<mglass::shapes::Ellipse, mglass::shapes::Ellipse>;
+
+    template<>
+    EllipsesDifference makeShapeOverLenna()
+    {
+        return { mglass::shapes::Ellipse{ {310.5f, -160}, 389, 300 }, mglass::shapes::Ellipse{ {300, -150}, 150, 100 } };
+    }
+
+    template<>
+    mglass::shapes::FixedEllipse<256, 256> makeShapeOverLenna()
+    {
+        return mglass::shapes::FixedEllipse<256, 256>{ {180, -100} };
+    }
+} // namespace
+
+
+TEST(MGLASS_MAGNIFIER_PLAN, CTOR_DEFAULT)
+{
+    const mglass::MagnifierPlan plan;
+
+    EXPECT_EQ(plan.getScaleFactor(), 1);
+    EXPECT_FALSE(plan.isAlphaBlendingEnabled());
+
+    const auto img = mglass::Image{ 10, 10, mglass::ARGB::black() };
+
+    mglass::Image outputImg;
+    plan.nearestNeighbor({5, -5}, img, {0, 0}, outputImg);
+
+    // nothing is magnified
+    for (mglass::size_type y = 0; y < outputImg.getHeight(); ++y)
+        for (mglass::size_type x = 0; x < outputImg.getWidth(); ++x)
+            ASSERT_EQ(outputImg.getPixelAt(x, y), mglass::ARGB::transparent());
+}
+
+TEST(MGLASS_MAGNIFIER_PLAN, ELLIPSE_EQUALS_MOVED_SHAPE)
+{
+    // please make sure you are running this tests at "magnifying-glass/tests" working directory
+
+    const auto lenna = mglass::Image::fromPNGFile("resources/Lenna.png");
+
+    struct EllipseParams
+    {
+        mglass::Point<mglass::float_type> center;
+        mglass::float_type xAxis;
+        mglass::float_type yAxis;
+    };
+
+    const EllipseParams ellipses[] = {
+        { {0, 0}, 250, 100 },
+        { {0.5f, -0.5f}, 189, 300 },
+        { {0, 0}, 31, 31 }
+    };
+
+    for (const auto& params : ellipses)
+    {
+        const auto makeShape = [&params](const mglass::Point<mglass::float_type> center) {
+            return mglass::shapes::Ellipse{ center, params.xAxis, params.yAxis };
+        };
+
+        for (const mglass::float_type scaleFactor : { 0.7f, 2.5f, 13.7f })
+        {
+            checkPlanEqualsMovedShape(lenna, makeShape, params.center, scaleFactor, false);
+            checkPlanEqualsMovedShape(lenna, makeShape, params.center, scaleFactor, true);
+        }
+    }
+}
+
+TEST(MGLASS_MAGNIFIER_PLAN, RECTANGLE_EQUALS_MOVED_SHAPE)
+{
+    // please make sure you are running this tests at "magnifying-glass/tests" working directory
+
+    const auto lenna = mglass::Image::fromPNGFile("resources/Lenna.png");
+
+    const auto makeShape = [](const mglass::Point<mglass::float_type> center) {
+        return mglass::shapes::Rectangle{ center, 189, 130 };
+    };
+
+    for (const mglass::float_type scaleFactor : { 0.7f, 2.5f, 13.7f })
+    {
+        checkPlanEqualsMovedShape(lenna, makeShape, {0, 0}, scaleFactor, false);
+        checkPlanEqualsMovedShape(lenna, makeShape, {0, 0}, scaleFactor, true);
+    }
+}
+
+TEST(MGLASS_MAGNIFIER_PLAN, MUTABLE_SPAN_DESTINATION_EQUALS_MOVED_SHAPE)
+{
+    // please make sure you are running this tests at "magnifying-glass/tests" working directory
+
+    const auto lenna = mglass::Image::fromPNGFile("resources/Lenna.png");
+
+    const mglass::shapes::Ellipse shape{ {0, 0}, 250, 100 };
+    const mglass::MagnifierPlan plan{shape, 2.5f, true};
+
+    constexpr mglass::size_type width = 200;
+    constexpr mglass::size_type height = 90;
+    constexpr mglass::size_type strideBytes = width * 4 + 12;
+
+    for (const mglass::Point<mglass::int_type> dstOffset : { mglass::Point<mglass::int_type>{0, 0}, {-30, 7}, {15, -20} })
+    {
+        std::vector<std::uint8_t> expectedBuffer(strideBytes * height, 0x5A);
+        std::vector<std::uint8_t> actualBuffer(strideBytes * height, 0x5A);
+
+        const mglass::MutableImageSpan expectedImg{expectedBuffer.data(), width, height, strideBytes, mglass::PixelFormat::BGRA};
+        const mglass::MutableImageSpan actualImg{actualBuffer.data(), width, height, strideBytes, mglass::PixelFormat::BGRA};
+
+        for (const bool fillWithTransparent : { false, true })
+        {
+            const mglass::shapes::Ellipse movedShape{ {256, -256}, 250, 100 };
+
+            mglass::magnifiers::nearestNeighbor(
+                movedShape, 2.5f, lenna, {0, 0}, expectedImg, dstOffset, true, fillWithTransparent);
+            plan.nearestNeighbor({256, -256}, lenna, {0, 0}, actualImg, dstOffset, fillWithTransparent);
+            ASSERT_EQ(actualBuffer, expectedBuffer);
+
+            mglass::magnifiers::nearestNeighborInterpolated(
+                movedShape, 2.5f, lenna, {0, 0}, expectedImg, dstOffset, true, fillWithTransparent);
+            plan.nearestNeighborInterpolated({256, -256}, lenna, {0, 0}, actualImg, dstOffset, fillWithTransparent);
+            ASSERT_EQ(actualBuffer, expectedBuffer);
+        }
+    }
+}
+
+TEST(MGLASS_MAGNIFIER_PLAN, EXECUTORS_DO_NOT_AFFECT_RESULT)
+{
+    // please make sure you are running this tests at "magnifying-glass/tests" working directory
+
+    const auto lenna = mglass::Image::fromPNGFile("resources/Lenna.png");
+
+    const mglass::MagnifierPlan plan{mglass::shapes::Ellipse{ {0, 0}, 301, 457 }, 3.3f, true};
+
+    mglass::ThreadPool pool{3};
+
+    mglass::Image expectedOutputImg;
+    mglass::Image actualOutputImg;
+
+    plan.nearestNeighbor({200, -300}, lenna, {0, 0}, expectedOutputImg);
+    plan.nearestNeighbor(pool, {200, -300}, lenna, {0, 0}, actualOutputImg);
+    ASSERT_EQ(actualOutputImg, expectedOutputImg);
+
+    plan.nearestNeighborInterpolated({200, -300}, lenna, {0, 0}, expectedOutputImg);
+    plan.nearestNeighborInterpolated(pool, {200, -300}, lenna, {0, 0}, actualOutputImg);
+    ASSERT_EQ(actualOutputImg, expectedOutputImg);
+}
+
+
+// ====================================================================================================================
+// the shapes replayed by MagnifierPlan
+// ====================================================================================================================
+
+template<typename ShapeT>
+class MGLASS_MAGNIFIER_PLAN_SHAPES : public ::testing::Test
+{};
+
+using PlanShapes = ::testing::Types<
+    mglass::shapes::AntialiasedEllipse,
+    mglass::shapes::AntialiasedRectangle,
+    mglass::shapes::Polygon,
+    mglass::shapes::Mask,
+    mglass::shapes::TransformedEllipse,
+    mglass::shapes::TransformedRectangle,
+    StadiumShape,
+    EllipsesDifference,
+    mglass::shapes::FixedEllipse<256, 256>
+>;
+
+TYPED_TEST_SUITE(MGLASS_MAGNIFIER_PLAN_SHAPES, PlanShapes);
+
+TYPED_TEST(MGLASS_MAGNIFIER_PLAN_SHAPES, EQUALS_SHAPE)
+{
+    // please make sure you are running this tests at "magnifying-glass/tests" working directory
+
+    const auto lenna = mglass::Image::fromPNGFile("resources/Lenna.png");
+    const auto shape = makeShapeOverLenna<TypeParam>();
+
+    for (const bool alphaBlending : { false, true })
+    {
+        const mglass::MagnifierPlan plan{shape, 2.5f, alphaBlending};
+
+        mglass::Image expectedOutputImg;
+        mglass::Image actualOutputImg;
+
+        mglass::magnifiers::nearestNeighbor(shape, 2.5f, lenna, {0, 0}, expectedOutputImg, alphaBlending);
+        plan.nearestNeighbor({0, 0}, lenna, {0, 0}, actualOutputImg);
+        ASSERT_EQ(actualOutputImg, expectedOutputImg);
+
+        mglass::magnifiers::nearestNeighborInterpolated(shape, 2.5f, lenna, {0, 0}, expectedOutputImg, alphaBlending);
+        plan.nearestNeighborInterpolated({0, 0}, lenna, {0, 0}, actualOutputImg);
+        ASSERT_EQ(actualOutputImg, expectedOutputImg);
+    }
+}
@@ -1,7 +1,13 @@
 #include "mglass/mglass.h"      // mglass::*
 #include "mglass/magnifiers.h"  // mglass::magnifiers::*
 #include "mglass/shapes.h"      // mglass::shapes::*
+#include "mglass/magnifier_plan.h" // mglass::MagnifierPlan
 #include "gtest/gtest.h"
+#include <cstdint>              // std::uint8_t
+#include <vector>               // std::vector
+#include <functional>           // std::function
+#include <cmath>                // std::floor, std::abs
+#include <algorithm>            // std::max, std::min
 
 
 // ====================================================================================================================
@@ -117,3 +123,527 @@ TEST(MGLASS_NEAREST_NEIGHBOR, RECTANGLE_SCALE_4_SIZE_189_300_AT_499_M275)
     ASSERT_EQ(actualOutputImg, expectedOutputImg);
 }
 
+
+
+// ====================================================================================================================
+// mglass::ImageSpan sources
+// ====================================================================================================================
+
+TEST(MGLASS_NEAREST_NEIGHBOR, SUBSPAN_SOURCE_EQUALS_CROPPED_COPY)
+{
+    // please make sure you are running this tests at "magnifying-glass/tests" working directory
+
+    const auto lenna = mglass::Image::fromPNGFile("resources/Lenna.png");
+
+    // crop (100; 50) - (399; 249)
+    constexpr mglass::size_type cropX = 100;
+    constexpr mglass::size_type cropY = 50;
+    constexpr mglass::size_type cropWidth = 300;
+    constexpr mglass::size_type cropHeight = 200;
+
+    mglass::Image croppedCopy{cropWidth, cropHeight};
+    for (mglass::size_type y = 0; y < cropHeight; ++y)
+        for (mglass::size_type x = 0; x < cropWidth; ++x)
+            croppedCopy.setPixelAt(x, y, lenna.getPixelAt(x + cropX, y + cropY));
+
+    const auto croppedView = mglass::ImageSpan{lenna}.getSubSpan(cropX, cropY, cropWidth, cropHeight);
+
+    const mglass::Point<mglass::int_type> cropTopLeft{ 100, -50 };
+
+    const mglass::shapes::Ellipse shape{ {310, -160}, 189, 130 };
+
+    for (const bool alphaBlending : { false, true })
+    {
+        mglass::Image expectedOutputImg;
+        mglass::Image actualOutputImg;
+
+        mglass::magnifiers::nearestNeighbor(shape, 2.5, croppedCopy, cropTopLeft, expectedOutputImg, alphaBlending);
+        mglass::magnifiers::nearestNeighbor(shape, 2.5, croppedView, cropTopLeft, actualOutputImg, alphaBlending);
+        ASSERT_EQ(actualOutputImg, expectedOutputImg);
+
+        mglass::magnifiers::nearestNeighborInterpolated(shape, 2.5, croppedCopy, cropTopLeft, expectedOutputImg, alphaBlending);
+        mglass::magnifiers::nearestNeighborInterpolated(shape, 2.5, croppedView, cropTopLeft, actualOutputImg, alphaBlending);
+        ASSERT_EQ(actualOutputImg, expectedOutputImg);
+    }
+}
+
+
+// ====================================================================================================================
+// mglass::MutableImageSpan destinations
+// ====================================================================================================================
+
+TEST(MGLASS_NEAREST_NEIGHBOR, MUTABLE_SPAN_DESTINATION_EQUALS_IMAGE_DESTINATION)
+{
+    // please make sure you are running this tests at "magnifying-glass/tests" working directory
+
+    const auto lenna = mglass::Image::fromPNGFile("resources/Lenna.png");
+    const mglass::Point<mglass::int_type> imgTopLeft{ 0, 0 };
+
+    const mglass::shapes::Ellipse shape{ {310, -160}, 189, 130 };
+
+    // a BGRA framebuffer with padded rows, the magnified image is written at (dstOffset.x; dstOffset.y) of it
+    constexpr mglass::size_type dstWidth = 160;
+    constexpr mglass::size_type dstHeight = 120;
+    constexpr mglass::size_type dstStrideBytes = dstWidth * 4 + 24;
+    const mglass::ARGB background{ 255, 1, 2, 3 };
+
+    const mglass::Point<mglass::int_type> dstOffsets[] = { {0, 0}, {-20, -10}, {-100, 40}, {50, 70}, {500, 0} };
+
+    for (const bool alphaBlending : { false, true })
+    {
+        for (const bool interpolation : { false, true })
+        {
+            mglass::Image expectedImg;
+            if (interpolation)
+                mglass::magnifiers::nearestNeighborInterpolated(shape, 2.5, lenna, imgTopLeft, expectedImg, alphaBlending);
+            else
+                mglass::magnifiers::nearestNeighbor(shape, 2.5, lenna, imgTopLeft, expectedImg, alphaBlending);
+
+            for (const auto dstOffset : dstOffsets)
+            {
+                for (const bool fillWithTransparent : { false, true })
+                {
+                    std::vector<std::uint8_t> buffer(dstStrideBytes * dstHeight);
+                    const mglass::MutableImageSpan dst{buffer.data(), dstWidth, dstHeight, dstStrideBytes, mglass::PixelFormat::BGRA};
+                    dst.fill(background);
+
+                    if (interpolation)
+                        mglass::magnifiers::nearestNeighborInterpolated(
+                            shape, 2.5, lenna, imgTopLeft, dst, dstOffset, alphaBlending, fillWithTransparent);
+                    else
+                        mglass::magnifiers::nearestNeighbor(
+                            shape, 2.5, lenna, imgTopLeft, dst, dstOffset, alphaBlending, fillWithTransparent);
+
+                    for (mglass::size_type y = 0; y < dstHeight; ++y)
+                    {
+                        for (mglass::size_type x = 0; x < dstWidth; ++x)
+                        {
+                            const auto srcX = static_cast<mglass::int_type>(x) - dstOffset.x;
+                            const auto srcY = static_cast<mglass::int_type>(y) - dstOffset.y;
+
+                            const bool isUnderShape =
+                                (srcX >= 0) && (srcX < static_cast<mglass::int_type>(expectedImg.getWidth())) &&
+                                (srcY >= 0) && (srcY < static_cast<mglass::int_type>(expectedImg.getHeight()));
+
+                            mglass::ARGB expected = background;
+                            if (isUnderShape)
+                            {
+                                const auto expectedPixel = expectedImg.getPixelAt(
+                                    static_cast<mglass::size_type>(srcX),
+                                    static_cast<mglass::size_type>(srcY));
+
+                                // magnifiers write ARGB::transparent() exactly where they don't magnify anything
+                                if (fillWithTransparent || (expectedPixel != mglass::ARGB::transparent()))
+                                    expected = expectedPixel;
+                            }
+
+                            ASSERT_EQ(dst.getPixelAt(x, y), expected);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+
+// ====================================================================================================================
+// mglass::Executor
+// ====================================================================================================================
+
+namespace
+{
+    // runs the tasks at the calling thread but in the reversed order
+    //  and pretends to be concurrent for the magnifiers to split images into many bands
+    class ReversedExecutor final : public mglass::Executor
+    {
+    public:
+        void parallelFor(mglass::size_type tasksCount, const std::function<void(mglass::size_type)>& task) override
+        {
+            ++jobsCount;
+
+            for (mglass::size_type i = tasksCount; i > 0; --i)
+                task(i - 1);
+        }
+
+        [[nodiscard]] mglass::size_type getConcurrency() const noexcept override { return 8; }
+
+        int jobsCount = 0;
+    };
+} // namespace
+
+TEST(MGLASS_NEAREST_NEIGHBOR, EXECUTORS_DO_NOT_AFFECT_RESULT)
+{
+    // please make sure you are running this tests at "magnifying-glass/tests" working directory
+
+    const auto lenna = mglass::Image::fromPNGFile("resources/Lenna.png");
+    const mglass::Point<mglass::int_type> imgTopLeft{ 0, 0 };
+
+    const mglass::shapes::Ellipse ellipse{ {310, -160}, 389, 330 };
+    const mglass::shapes::Rectangle rectangle{ {250, -300}, 301, 257 };
+
+    mglass::ThreadPool threadPool{3};
+    ReversedExecutor reversedExecutor;
+
+    for (const bool alphaBlending : { false, true })
+    {
+        mglass::Image expectedImg;
+        mglass::Image actualImg;
+
+        mglass::magnifiers::nearestNeighbor(ellipse, 2.5, lenna, imgTopLeft, expectedImg, alphaBlending);
+        mglass::magnifiers::nearestNeighbor(threadPool, ellipse, 2.5, lenna, imgTopLeft, actualImg, alphaBlending);
+        ASSERT_EQ(actualImg, expectedImg);
+        mglass::magnifiers::nearestNeighbor(reversedExecutor, ellipse, 2.5, lenna, imgTopLeft, actualImg, alphaBlending);
+        ASSERT_EQ(actualImg, expectedImg);
+
+        mglass::magnifiers::nearestNeighborInterpolated(rectangle, 3, lenna, imgTopLeft, expectedImg, alphaBlending);
+        mglass::magnifiers::nearestNeighborInterpolated(threadPool, rectangle, 3, lenna, imgTopLeft, actualImg, alphaBlending);
+        ASSERT_EQ(actualImg, expectedImg);
+        mglass::magnifiers::nearestNeighborInterpolated(reversedExecutor, rectangle, 3, lenna, imgTopLeft, actualImg, alphaBlending);
+        ASSERT_EQ(actualImg, expectedImg);
+
+        // clipped by the destination
+        constexpr mglass::size_type dstWidth = 200;
+        constexpr mglass::size_type dstHeight = 300;
+        const mglass::Point<mglass::int_type> dstOffset{ -50, -20 };
+
+        mglass::Image expectedDst{dstWidth, dstHeight, mglass::ARGB::black()};
+        mglass::Image actualDst{dstWidth, dstHeight, mglass::ARGB::black()};
+
+        mglass::magnifiers::nearestNeighborInterpolated(
+            ellipse, 2.5, lenna, imgTopLeft, expectedDst, dstOffset, alphaBlending);
+        mglass::magnifiers::nearestNeighborInterpolated(
+            threadPool, ellipse, 2.5, lenna, imgTopLeft, actualDst, dstOffset, alphaBlending);
+        ASSERT_EQ(actualDst, expectedDst);
+    }
+
+    EXPECT_GT(reversedExecutor.jobsCount, 0);
+}
+
+TEST(MGLASS_NEAREST_NEIGHBOR, SOLID_BLOCKS_EQUAL_BLENDED_PIXELS)
+{
+    // please make sure you are running this tests at "magnifying-glass/tests" working directory
+
+    const auto lenna = mglass::Image::fromPNGFile("resources/Lenna.png");
+    const mglass::Point<mglass::int_type> imgTopLeft{ 0, 0 };
+
+    // the density is 1 farther than 0.1 from the edge, so most of the blocks are solid
+    const auto feathered = mglass::FalloffProfile::fromFunction([](const double u) { return (std::min)(1.0, u / 0.1); });
+
+    const mglass::shapes::Ellipse ellipse{ {310.5f, -160}, 389, 330, feathered };
+    const mglass::shapes::Rectangle rectangle{ {250, -300.5f}, 301, 257, feathered };
+
+    // the plan does not classify blocks, so all its pixels are blended
+    const mglass::MagnifierPlan ellipsePlan{ellipse, 2.5f, true};
+    const mglass::MagnifierPlan rectanglePlan{rectangle, 2.5f, true};
+
+    mglass::Image expectedImg;
+    mglass::Image actualImg;
+
+    mglass::magnifiers::nearestNeighbor(ellipse, 2.5f, lenna, imgTopLeft, actualImg, true);
+    ellipsePlan.nearestNeighbor({0, 0}, lenna, imgTopLeft, expectedImg);
+    ASSERT_EQ(actualImg, expectedImg);
+
+    mglass::magnifiers::nearestNeighborInterpolated(ellipse, 2.5f, lenna, imgTopLeft, actualImg, true);
+    ellipsePlan.nearestNeighborInterpolated({0, 0}, lenna, imgTopLeft, expectedImg);
+    ASSERT_EQ(actualImg, expectedImg);
+
+    mglass::magnifiers::nearestNeighbor(rectangle, 2.5f, lenna, imgTopLeft, actualImg, true);
+    rectanglePlan.nearestNeighbor({0, 0}, lenna, imgTopLeft, expectedImg);
+    ASSERT_EQ(actualImg, expectedImg);
+
+    mglass::magnifiers::nearestNeighborInterpolated(rectangle, 2.5f, lenna, imgTopLeft, actualImg, true);
+    rectanglePlan.nearestNeighborInterpolated({0, 0}, lenna, imgTopLeft, expectedImg);
+    ASSERT_EQ(actualImg, expectedImg);
+}
+
+
+// ====================================================================================================================
+// detail::interpolateRow
+// ====================================================================================================================
+
+TEST(MGLASS_NEAREST_NEIGHBOR, INTERPOLATE_ROW_APPROXIMATES_INTERPOLATION_INFO)
+{
+    // please make sure you are running this tests at "magnifying-glass/tests" working directory
+
+    using mglass::magnifiers::detail::AxisInterpolationTable;
+
+    const auto lenna = mglass::Image::fromPNGFile("resources/Lenna.png");
+    const mglass::ImageSpan imageSrc{lenna};
+
+    // the image is placed far from the origin in some cases to check the precision of the coordinates
+    const mglass::int_type imageSrcLefts[] = { 0, -3, 1000, -70001 };
+    const mglass::float_type scaleFactors[] = { 1 / 2.5f, 1 / 3.f, 1 / 8.f, 1 / 1.01f };
+
+    constexpr int maxChannelError = 1;
+
+    std::vector<mglass::ARGB> actual;
+
+    for (const auto imageSrcLeft : imageSrcLefts)
+    {
+        for (const auto scaleFactor : scaleFactors)
+        {
+            // the top-left corner of the image is (imageSrcLeft; imageSrcTop)
+            const mglass::int_type imageSrcTop = -imageSrcLeft;
+            const mglass::float_type scaleCenterX = static_cast<mglass::float_type>(imageSrcLeft) + 250.3f;
+            const mglass::float_type scaleCenterY = static_cast<mglass::float_type>(imageSrcTop) - 200.6f;
+
+            const auto columnOf = [&](const mglass::int_type x) {
+                const auto srcPointX = mglass::magnifiers::detail::scaleCoordinateBy(
+                    scaleFactor, scaleCenterX, static_cast<mglass::float_type>(x));
+                return static_cast<mglass::int_type>(std::floor(srcPointX)) - imageSrcLeft;
+            };
+            const auto rowOf = [&](const mglass::int_type y) {
+                const auto srcPointY = mglass::magnifiers::detail::scaleCoordinateBy(
+                    scaleFactor, scaleCenterY, static_cast<mglass::float_type>(y));
+                return imageSrcTop - static_cast<mglass::int_type>(std::floor(srcPointY));
+            };
+
+            // the points mapped inside the image
+            auto xBegin = static_cast<mglass::int_type>(scaleCenterX);
+            auto xEnd = xBegin;
+            while (columnOf(xBegin - 1) >= 0)
+                --xBegin;
+            while (columnOf(xEnd) < static_cast<mglass::int_type>(lenna.getWidth()))
+                ++xEnd;
+
+            auto yBegin = static_cast<mglass::int_type>(scaleCenterY);
+            auto yEnd = yBegin;
+            while (rowOf(yBegin - 1) < static_cast<mglass::int_type>(lenna.getHeight()))
+                --yBegin;
+            while (rowOf(yEnd) >= 0)
+                ++yEnd;
+
+            const mglass::magnifiers::detail::InterpolationTables tables{
+                AxisInterpolationTable::calculateFor<mglass::interpolators::Bilinear>(scaleFactor, scaleCenterX, imageSrcLeft, lenna.getWidth(), 0, false, xBegin, xEnd),
+                AxisInterpolationTable::calculateFor<mglass::interpolators::Bilinear>(scaleFactor, scaleCenterY, imageSrcTop, lenna.getHeight(), 0, true, yBegin, yEnd)
+            };
+
+            // the bottom and the top rows, their neighbors and a row inside
+            for (const mglass::int_type y : { yBegin, yBegin + 1, (yBegin + yEnd) / 2, yEnd - 2, yEnd - 1 })
+            {
+                const auto srcPointY = mglass::magnifiers::detail::scaleCoordinateBy(
+                    scaleFactor, scaleCenterY, static_cast<mglass::float_type>(y));
+                const auto srcRow = static_cast<mglass::size_type>(rowOf(y));
+
+                // unaligned beginnings and tails of various lengths
+                for (const mglass::int_type shift : { 0, 1, 3, 5, 7 })
+                {
+                    const auto begin = xBegin + shift;
+                    const auto end = xEnd - shift * 2;
+
+                    actual.resize(static_cast<mglass::size_type>(end - begin));
+                    mglass::magnifiers::detail::interpolateRow<2>(imageSrc, tables, y, begin, end, actual.data());
+
+                    for (mglass::int_type x = begin; x < end; ++x)
+                    {
+                        const auto srcPointX = mglass::magnifiers::detail::scaleCoordinateBy(
+                            scaleFactor, scaleCenterX, static_cast<mglass::float_type>(x));
+                        const auto pixelStartX = std::floor(srcPointX);
+                        const auto srcColumn = static_cast<mglass::size_type>(static_cast<mglass::int_type>(pixelStartX) - imageSrcLeft);
+
+                        const auto expected = mglass::magnifiers::detail::InterpolationInfo::calculateFor(
+                            { srcPointX, srcPointY }, { pixelStartX, std::floor(srcPointY) }
+                        ).applyTo({ srcColumn, srcRow }, imageSrc);
+
+                        const auto& color = actual[static_cast<mglass::size_type>(x - begin)];
+
+                        // the fixed-point interpolation differs only by the quantization errors
+                        ASSERT_EQ(color.a, expected.a) << "x = " << x << ", y = " << y;
+                        ASSERT_LE(std::abs(color.r - expected.r), maxChannelError) << "x = " << x << ", y = " << y;
+                        ASSERT_LE(std::abs(color.g - expected.g), maxChannelError) << "x = " << x << ", y = " << y;
+                        ASSERT_LE(std::abs(color.b - expected.b), maxChannelError) << "x = " << x << ", y = " << y;
+                    }
+                }
+            }
+        }
+    }
+}
+
+
+// ====================================================================================================================
+// mglass::interpolators
+// ====================================================================================================================
+
+template<typename Interpolator>
+static void checkInterpolationWeights()
+{
+    const auto& weights = mglass::magnifiers::detail::getInterpolationWeights<Interpolator>();
+    constexpr std::int32_t one = std::int32_t{1} << mglass::magnifiers::detail::interpolationWeightBits;
+
+    for (const auto& phaseWeights : weights)
+    {
+        std::int32_t sum = 0;
+        for (const auto weight : phaseWeights)
+            sum += weight;
+
+        ASSERT_EQ(sum, one);
+    }
+
+    // the point at the center of a pixel takes the color of the pixel
+    for (mglass::size_type tap = 0; tap < weights[0].size(); ++tap)
+        ASSERT_EQ(weights[0][tap], (tap == weights[0].size() / 2 - 1) ? one : 0) << "tap = " << tap;
+}
+
+TEST(MGLASS_INTERPOLATORS, WEIGHTS_ARE_NORMALIZED)
+{
+    checkInterpolationWeights<mglass::interpolators::Bilinear>();
+    checkInterpolationWeights<mglass::interpolators::Bicubic>();
+    checkInterpolationWeights<mglass::interpolators::Lanczos3>();
+}
+
+template<typename Interpolator>
+static void checkUniformColorIsPreserved()
+{
+    const mglass::ARGB color{ 200, 10, 100, 250 };
+    const mglass::Image imageSrc{ 50, 40, color };
+
+    const mglass::shapes::Rectangle shape{ {25, -20}, 40, 30 };
+
+    for (const float scaleFactor : { 1.f, 2.5f, 9.f })
+    {
+        // the pixels of the shape are `color`, the other ones are transparent
+        mglass::Image expectedImg;
+        mglass::magnifiers::nearestNeighbor(shape, scaleFactor, imageSrc, {0, 0}, expectedImg);
+
+        mglass::Image actualImg;
+        mglass::magnifiers::nearestNeighborInterpolated<Interpolator>(shape, scaleFactor, imageSrc, {0, 0}, actualImg);
+
+        ASSERT_EQ(actualImg, expectedImg) << "scale = " << scaleFactor;
+    }
+}
+
+TEST(MGLASS_INTERPOLATORS, UNIFORM_COLOR_IS_PRESERVED)
+{
+    checkUniformColorIsPreserved<mglass::interpolators::Bilinear>();
+    checkUniformColorIsPreserved<mglass::interpolators::Bicubic>();
+    checkUniformColorIsPreserved<mglass::interpolators::Lanczos3>();
+}
+
+TEST(MGLASS_INTERPOLATORS, LINEAR_GRADIENT_IS_PRESERVED)
+{
+    // all the interpolators reproduce linear functions (Lanczos3 does it approximately)
+
+    mglass::Image imageSrc{ 200, 200 };
+    for (mglass::size_type y = 0; y < imageSrc.getHeight(); ++y)
+    {
+        for (mglass::size_type x = 0; x < imageSrc.getWidth(); ++x)
+        {
+            imageSrc.setPixelAt(x, y, {
+                255,
+                static_cast<std::uint8_t>(x),
+                static_cast<std::uint8_t>(y),
+                static_cast<std::uint8_t>((x + y) / 2)
+            });
+        }
+    }
+
+    // the magnified area is far from the edges of the image
+    const mglass::shapes::Ellipse shape{ {100, -100}, 150, 120 };
+    constexpr float scaleFactor = 3.3f;
+
+    mglass::Image bilinearImg;
+    mglass::Image bicubicImg;
+    mglass::Image lanczosImg;
+    mglass::magnifiers::nearestNeighborInterpolated<mglass::interpolators::Bilinear>(shape, scaleFactor, imageSrc, {0, 0}, bilinearImg);
+    mglass::magnifiers::nearestNeighborInterpolated<mglass::interpolators::Bicubic>(shape, scaleFactor, imageSrc, {0, 0}, bicubicImg);
+    mglass::magnifiers::nearestNeighborInterpolated<mglass::interpolators::Lanczos3>(shape, scaleFactor, imageSrc, {0, 0}, lanczosImg);
+
+    const auto maxDifferenceOf = [](const mglass::ARGB lhs, const mglass::ARGB rhs) {
+        return (std::max)({ std::abs(lhs.a - rhs.a), std::abs(lhs.r - rhs.r), std::abs(lhs.g - rhs.g), std::abs(lhs.b - rhs.b) });
+    };
+
+    for (mglass::size_type y = 0; y < bilinearImg.getHeight(); ++y)
+    {
+        for (mglass::size_type x = 0; x < bilinearImg.getWidth(); ++x)
+        {
+            const auto expected = bilinearImg.getPixelAt(x, y);
+
+            ASSERT_LE(maxDifferenceOf(bicubicImg.getPixelAt(x, y), expected), 1) << "x = " << x << ", y = " << y;
+            ASSERT_LE(maxDifferenceOf(lanczosImg.getPixelAt(x, y), expected), 1) << "x = " << x << ", y = " << y;
+        }
+    }
+}
+
+
+// ====================================================================================================================
+// detail::copyNearestRow
+// ====================================================================================================================
+
+TEST(MGLASS_NEAREST_NEIGHBOR, COPY_NEAREST_ROW_EQUALS_SCALAR)
+{
+    // please make sure you are running this tests at "magnifying-glass/tests" working directory
+
+    const auto lenna = mglass::Image::fromPNGFile("resources/Lenna.png");
+    const mglass::ImageSpan imageSrc{lenna};
+
+    // scale factors > 1 shrink the image (the pixels of a vector are far from each other)
+    const mglass::float_type scaleFactors[] = { 1 / 2.5f, 1 / 8.f, 1 / 13.7f, 1 / 32.f, 1 / 1.01f, 1.f, 1.7f, 3.f };
+
+    std::vector<std::uint8_t> actual;
+
+    for (const mglass::int_type imageSrcLeft : { 0, -3, 1000 })
+    {
+        for (const auto scaleFactor : scaleFactors)
+        {
+            constexpr mglass::size_type srcRow = 123;
+
+            const mglass::float_type scaleCenterX = static_cast<mglass::float_type>(imageSrcLeft) + 250.3f;
+            const mglass::magnifiers::detail::RowMapping mapping{
+                imageSrc,
+                imageSrcLeft,
+                srcRow,
+                scaleFactor,
+                scaleCenterX
+            };
+
+            const auto columnOf = [&](const mglass::int_type x) {
+                const auto srcPointX = mglass::magnifiers::detail::scaleCoordinateBy(
+                    scaleFactor, scaleCenterX, static_cast<mglass::float_type>(x));
+                return static_cast<mglass::int_type>(std::floor(srcPointX)) - imageSrcLeft;
+            };
+
+            // the points mapped inside the image
+            auto xBegin = static_cast<mglass::int_type>(scaleCenterX);
+            auto xEnd = xBegin;
+            while (columnOf(xBegin - 1) >= 0)
+                --xBegin;
+            while (columnOf(xEnd) < static_cast<mglass::int_type>(lenna.getWidth()))
+                ++xEnd;
+
+            for (const auto format : { mglass::PixelFormat::ARGB, mglass::PixelFormat::BGRA, mglass::PixelFormat::RGBA })
+            {
+                // unaligned beginnings and tails of various lengths
+                for (const mglass::int_type shift : { 0, 1, 3, 5, 7 })
+                {
+                    const auto begin = xBegin + shift;
+                    const auto end = xEnd - shift * 2;
+                    const auto width = static_cast<mglass::size_type>(end - begin);
+
+                    actual.assign(width * 4, 0);
+
+                    switch (format)
+                    {
+                        case mglass::PixelFormat::ARGB:
+                            mglass::magnifiers::detail::copyNearestRow<mglass::PixelFormat::ARGB>(mapping, begin, end, actual.data());
+                            break;
+                        case mglass::PixelFormat::BGRA:
+                            mglass::magnifiers::detail::copyNearestRow<mglass::PixelFormat::BGRA>(mapping, begin, end, actual.data());
+                            break;
+                        case mglass::PixelFormat::RGBA:
+                            mglass::magnifiers::detail::copyNearestRow<mglass::PixelFormat::RGBA>(mapping, begin, end, actual.data());
+                            break;
+                    }
+
+                    const mglass::MutableImageSpan actualSpan{actual.data(), width, 1, width * 4, format};
+
+                    for (mglass::int_type x = begin; x < end; ++x)
+                    {
+                        const auto expected = lenna.getPixelAt(static_cast<mglass::size_type>(columnOf(x)), srcRow);
+                        ASSERT_EQ(actualSpan.getPixelAt(static_cast<mglass::size_type>(x - begin), 0), expected) << "x = " << x;
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,195 @@
+#include "mglass/shapes.h"          // mglass::shapes::Mask
+#include "mglass/shape_mask.h"      // mglass::ShapeMaskCache
+#include "gtest/gtest.h"
+#include "shape_test_utils.h"        // shape_test_utils::*
+#include <cstdint>                  // std::uint8_t
+#include <memory>                   // std::make_shared
+
+
+namespace
+{
+    using shape_test_utils::IntPoint;
+    using shape_test_utils::IntPointDensities;
+    using shape_test_utils::rasterizePointsOf;
+
+    // the ring of the radius 20 inside the 64x48 image with the alpha fading to the right
+    mglass::Image makeRingImage()
+    {
+        mglass::Image result{ 64, 48 };
+
+        for (mglass::size_type row = 0; row < result.getHeight(); ++row)
+        {
+            for (mglass::size_type col = 0; col < result.getWidth(); ++col)
+            {
+                const auto dx = static_cast<mglass::int_type>(col) - 30;
+                const auto dy = static_cast<mglass::int_type>(row) - 22;
+                const mglass::int_type distanceSquare = dx * dx + dy * dy;
+
+                if ((distanceSquare >= 100) && (distanceSquare <= 400))
+                    result.getRowData(row)[col] = { static_cast<std::uint8_t>(255 - col * 3), 10, 20, 30 };
+            }
+        }
+
+        return result;
+    }
+
+    // the pixels with non-zero alpha of the `image` placed at `topLeft` and their densities
+    IntPointDensities getCoveredPixelsOf(const mglass::Image& image, const IntPoint topLeft)
+    {
+        IntPointDensities result;
+
+        for (mglass::size_type row = 0; row < image.getHeight(); ++row)
+        {
+            for (mglass::size_type col = 0; col < image.getWidth(); ++col)
+            {
+                const std::uint8_t alpha = image.getPixelAt(col, row).a;
+
+                if (alpha != 0)
+                {
+                    const IntPoint point{
+                        topLeft.x + static_cast<mglass::int_type>(col),
+                        topLeft.y - static_cast<mglass::int_type>(row)
+                    };
+                    result.emplace(point, static_cast<mglass::float_type>(alpha) / 255);
+                }
+            }
+        }
+
+        return result;
+    }
+} // namespace
+
+
+// ====================================================================================================================
+// ctors + getBounds()
+// ====================================================================================================================
+
+TEST(MGLASS_MASK_SHAPE, CTOR_DEFAULT)
+{
+    const mglass::shapes::Mask m;
+
+    EXPECT_EQ(m.getOutline().getBounds().width, 0U);
+    EXPECT_EQ(m.getOutline().getBounds().height, 0U);
+
+    bool gotCalled = false;
+    m.rasterizeSpansOnto({ {-50, 50}, 100, 100 }, [&gotCalled](const mglass::shapes::Mask::RasterizationSpan&) {
+        gotCalled = true;
+    });
+
+    EXPECT_FALSE(gotCalled) << "Empty mask should rasterize no spans.";
+}
+
+TEST(MGLASS_MASK_SHAPE, BOUNDS_ARE_TRIMMED_TO_COVERED_PIXELS)
+{
+    const mglass::Image ring = makeRingImage();
+    const mglass::shapes::Mask m{ ring, {-7, 13} };
+
+    // the covered columns are [10; 51), the covered rows are [2; 43)
+    const mglass::IntegralRectArea expectBounds{ {-7 + 10, 13 - 2}, 41, 41 };
+
+    EXPECT_TRUE( (mglass::getShapeIntegralBounds(m) == expectBounds) );
+}
+
+TEST(MGLASS_MASK_SHAPE, FROM_BITS)
+{
+    // 10x3: the rows are 2 bytes each
+    const std::uint8_t bits[] {
+        0b1100'0000, 0b0100'0000,
+        0b0000'0000, 0b0000'0000,
+        0b0011'1100, 0b1000'0000,
+    };
+
+    const auto outline = std::make_shared<const mglass::shapes::MaskOutline>(
+        mglass::shapes::MaskOutline::fromBits(10, 3, bits));
+    const mglass::shapes::Mask m{ {100, 200}, outline };
+
+    const IntPointDensities actual = rasterizePointsOf(m, { {0, 300}, 300, 300 });
+
+    const IntPointDensities expected{
+        { {100, 200}, 1 }, { {101, 200}, 1 }, { {109, 200}, 1 },
+        { {102, 198}, 1 }, { {103, 198}, 1 }, { {104, 198}, 1 }, { {105, 198}, 1 }, { {108, 198}, 1 },
+    };
+
+    EXPECT_EQ(actual, expected);
+}
+
+
+// ====================================================================================================================
+// rasterizeOnto, rasterizeSpansOnto
+// ====================================================================================================================
+
+TEST(MGLASS_MASK_SHAPE, RASTERIZE_MATCHES_ALPHA)
+{
+    const mglass::Image ring = makeRingImage();
+
+    for (const IntPoint topLeft : { IntPoint{0, 0}, IntPoint{-7, 13}, IntPoint{25, -40} })
+    {
+        const mglass::shapes::Mask m{ ring, topLeft };
+
+        ASSERT_EQ(rasterizePointsOf(m, { {-100, 100}, 200, 200 }), getCoveredPixelsOf(ring, topLeft));
+    }
+}
+
+TEST(MGLASS_MASK_SHAPE, RASTERIZE_SPANS_MATCH_POINTS)
+{
+    const mglass::IntegralRectArea rasterizeOntoAreas[] {
+        { {-50, 50}, 100, 100 },
+        { {20, -5}, 100, 100 },
+        { {13, 20}, 7, 200 },
+        { {25, -15}, 10, 10 },
+    };
+
+    const mglass::Image ring = makeRingImage();
+    const mglass::shapes::Mask m{ ring, {-3, 8} };
+
+    for (const auto& area : rasterizeOntoAreas)
+    {
+        IntPointDensities expectedPoints;
+        m.rasterizeOnto(area, [&expectedPoints](const mglass::shapes::Mask::RasterizationContext& rstCtx) {
+            expectedPoints.emplace(rstCtx.getRasterizedPoint(), rstCtx.getPixelDensity());
+        });
+
+        IntPointDensities actualPoints;
+        IntPoint prevEnd{ area.topLeft.x - 1, area.topLeft.y + 1 };
+
+        m.rasterizeSpansOnto(area, [&](const mglass::shapes::Mask::RasterizationSpan& span) {
+            ASSERT_LT(span.getXBegin(), span.getXEnd());
+            ASSERT_TRUE( (span.getY() < prevEnd.y) || ((span.getY() == prevEnd.y) && (span.getXBegin() >= prevEnd.x)) )
+                << "The mask should emit the spans from the top to the bottom and from the left to the right.";
+            prevEnd = { span.getXEnd(), span.getY() };
+
+            for (auto x = span.getXBegin(); x < span.getXEnd(); ++x)
+            {
+                ASSERT_EQ(span.getPixelCoverages()[x - span.getXBegin()] / 255.0f, span.getPixelDensityAt(x));
+                ASSERT_TRUE(actualPoints.emplace(IntPoint{x, span.getY()}, span.getPixelDensityAt(x)).second);
+            }
+        });
+
+        ASSERT_EQ(actualPoints, expectedPoints);
+    }
+}
+
+
+// ====================================================================================================================
+// ShapeMaskCache
+// ====================================================================================================================
+
+TEST(MGLASS_MASK_SHAPE, MASK_CACHE_DISTINGUISHES_OUTLINES)
+{
+    mglass::ShapeMaskCache cache;
+
+    const mglass::Image ring = makeRingImage();
+    const auto ringOutline = std::make_shared<const mglass::shapes::MaskOutline>(ring);
+
+    const mglass::shapes::Mask m{ {0, 0}, ringOutline };
+    const mglass::shapes::Mask moved{ {-40, 17}, ringOutline };
+    const mglass::shapes::Mask copied{ ring, {0, 0} };
+
+    const auto mask = cache.getMaskOf(m);
+
+    EXPECT_EQ(&cache.getMaskOf(moved).getMask(), &mask.getMask());
+    EXPECT_EQ(cache.getSize(), 1U);
+
+    (void)cache.getMaskOf(copied);
+    EXPECT_EQ(cache.getSize(), 2U);
+}
@@ -0,0 +1,280 @@
+#include "mglass/shapes.h"          // mglass::shapes::Polygon
+#include "mglass/shape_mask.h"      // mglass::ShapeMaskCache
+#include "gtest/gtest.h"
+#include <cstddef>                  // std::size_t
+#include <memory>                   // std::make_shared
+#include <unordered_set>            // std::unordered_set
+#include <vector>                   // std::vector
+#include <algorithm>                // std::min, std::max
+#include <cmath>                    // std::sqrt
+
+
+namespace
+{
+    struct PointHash
+    {
+        template<typename T>
+        std::size_t operator()(const mglass::Point<T> p) const noexcept
+        {
+            return (std::hash<T>{}(p.x) ^ std::hash<T>{}(p.y));
+        }
+    };
+
+    using IntPoint = mglass::Point<mglass::int_type>;
+    using IntPointSet = std::unordered_set<IntPoint, PointHash>;
+    using Vertices = std::vector<mglass::Point<mglass::float_type>>;
+
+    // the even-odd rule: the count of the edges crossed by the ray from the point to the right is odd
+    bool isInsidePolygon(const mglass::Point<mglass::float_type> center, const Vertices& vertices, const double x, const double y)
+    {
+        bool inside = false;
+
+        for (std::size_t i = 0; i < vertices.size(); ++i)
+        {
+            const double x0 = center.x + vertices[i].x;
+            const double y0 = center.y + vertices[i].y;
+            const double x1 = center.x + vertices[(i + 1) % vertices.size()].x;
+            const double y1 = center.y + vertices[(i + 1) % vertices.size()].y;
+
+            if ( ((y0 <= y) && (y < y1)) || ((y1 <= y) && (y < y0)) )
+            {
+                if (x < x0 + (y - y0) * (x1 - x0) / (y1 - y0))
+                    inside = !inside;
+            }
+        }
+
+        return inside;
+    }
+
+    // the distance from the point to the nearest edge of the polygon
+    double getDistanceToEdges(const mglass::Point<mglass::float_type> center, const Vertices& vertices, const double x, const double y)
+    {
+        double result = 1e9;
+
+        for (std::size_t i = 0; i < vertices.size(); ++i)
+        {
+            const double x0 = center.x + vertices[i].x;
+            const double y0 = center.y + vertices[i].y;
+            const double dx = center.x + vertices[(i + 1) % vertices.size()].x - x0;
+            const double dy = center.y + vertices[(i + 1) % vertices.size()].y - y0;
+
+            const double lengthSquare = dx * dx + dy * dy;
+            const double t = (lengthSquare > 0) ? (std::min)(1.0, (std::max)(0.0, ((x - x0) * dx + (y - y0) * dy) / lengthSquare)) : 0.0;
+
+            const double distanceX = x - (x0 + t * dx);
+            const double distanceY = y - (y0 + t * dy);
+            result = (std::min)(result, std::sqrt(distanceX * distanceX + distanceY * distanceY));
+        }
+
+        return result;
+    }
+
+    const Vertices triangle{ {-20.3f, -10.1f}, {25.7f, -12.4f}, {3.1f, 30.9f} };
+    // concave
+    const Vertices arrow{ {-30.2f, 10.3f}, {0.4f, 10.3f}, {0.4f, 25.1f}, {30.7f, 0.2f}, {0.4f, -25.3f}, {0.4f, -10.2f}, {-30.2f, -10.2f} };
+    // self-intersecting (the pentagon inside it is a hole by the even-odd rule)
+    const Vertices pentagram{ {0.1f, 40.3f}, {23.6f, -32.4f}, {-38.1f, 12.6f}, {38.2f, 12.4f}, {-23.4f, -32.2f} };
+} // namespace
+
+
+// ====================================================================================================================
+// ctors + getBounds()
+// ====================================================================================================================
+
+TEST(MGLASS_POLYGON_SHAPE, CTOR_DEFAULT)
+{
+    const mglass::shapes::Polygon p;
+
+    constexpr mglass::ShapeRectArea expectBounds{
+        {0, 0},
+        0,
+        0
+    };
+
+    EXPECT_TRUE( (p.getBounds() == expectBounds) );
+    EXPECT_TRUE(p.getOutline().getEdges().empty());
+}
+
+TEST(MGLASS_POLYGON_SHAPE, CTOR_TRIANGLE_AT_05_m05)
+{
+    const mglass::shapes::Polygon p{ {0.5f, -0.5f}, { {-10, -5}, {20, -5}, {0, 15} } };
+
+    constexpr mglass::ShapeRectArea expectBounds{
+        {-9.5f, 14.5f},
+        30,
+        20
+    };
+
+    EXPECT_TRUE( (p.getBounds() == expectBounds) );
+    // the horizontal edge is skipped, the topmost edges are the first ones
+    ASSERT_EQ(p.getOutline().getEdges().size(), 2U);
+    EXPECT_EQ(p.getOutline().getEdges()[0].yTop, 15);
+    EXPECT_EQ(p.getOutline().getEdges()[1].yTop, 15);
+}
+
+TEST(MGLASS_POLYGON_SHAPE, REGULAR)
+{
+    const auto hexagon = mglass::shapes::Polygon::regular({10, 20}, 6, 100, 60);
+
+    ASSERT_EQ(hexagon.getOutline().getVertices().size(), 6U);
+    EXPECT_EQ(hexagon.getCenter().x, 10);
+    EXPECT_EQ(hexagon.getCenter().y, 20);
+
+    // the first vertex is at the top, the ones at the sides are at +-cos(30) of the half of the width
+    const mglass::ShapeRectArea bounds = hexagon.getBounds();
+    EXPECT_NEAR(bounds.topLeft.y, 50, 1e-4);
+    EXPECT_NEAR(bounds.height, 60, 1e-4);
+    EXPECT_NEAR(bounds.width, 100 * std::sqrt(3.0) / 2, 1e-4);
+}
+
+
+// ====================================================================================================================
+// rasterizeOnto, rasterizeSpansOnto
+// ====================================================================================================================
+
+TEST(MGLASS_POLYGON_SHAPE, RASTERIZE_EMPTY)
+{
+    const mglass::shapes::Polygon polygons[] {
+        mglass::shapes::Polygon{},
+        mglass::shapes::Polygon{ {0, 0}, { {-10, -10}, {10, 10} } },
+        mglass::shapes::Polygon{ {0, 0}, { {-10, 0}, {10, 0}, {20, 0} } },
+    };
+
+    for (const auto& p : polygons)
+    {
+        bool gotCalled = false;
+        p.rasterizeOnto({ {-50, 50}, 100, 100 }, [&gotCalled](const mglass::shapes::Polygon::RasterizationContext&) {
+            gotCalled = true;
+        });
+
+        ASSERT_FALSE(gotCalled) << "Empty polygon should rasterize no points.";
+    }
+}
+
+TEST(MGLASS_POLYGON_SHAPE, RASTERIZE_MATCHES_PIXEL_CENTERS_TEST)
+{
+    const mglass::Point<mglass::float_type> centers[] { {0, 0}, {0.5f, -0.5f}, {-17.3f, 4.9f} };
+
+    for (const Vertices* vertices : { &triangle, &arrow, &pentagram })
+    {
+        for (const auto center : centers)
+        {
+            const mglass::shapes::Polygon p{ center, *vertices };
+
+            const mglass::IntegralRectArea bounds = mglass::getShapeIntegralBounds(p);
+            const mglass::IntegralRectArea area{
+                { bounds.topLeft.x - 2, bounds.topLeft.y + 2 },
+                bounds.width + 4,
+                bounds.height + 4
+            };
+
+            IntPointSet points;
+            p.rasterizeOnto(area, [&](const mglass::shapes::Polygon::RasterizationContext& rstCtx) {
+                ASSERT_TRUE(points.emplace(rstCtx.getRasterizedPoint()).second);
+                ASSERT_EQ(rstCtx.getPixelDensity(), 1);
+            });
+
+            std::size_t insideCount = 0;
+
+            for (mglass::size_type row = 0; row < area.height; ++row)
+            {
+                for (mglass::size_type column = 0; column < area.width; ++column)
+                {
+                    const IntPoint point{
+                        area.topLeft.x + static_cast<mglass::int_type>(column),
+                        area.topLeft.y - static_cast<mglass::int_type>(row)
+                    };
+                    const double x = point.x + 0.5;
+                    const double y = point.y + 0.5;
+
+                    // the centers of the pixels on the edges can go either way because of the rounding
+                    if (getDistanceToEdges(center, *vertices, x, y) < 1e-3)
+                        continue;
+
+                    const bool inside = isInsidePolygon(center, *vertices, x, y);
+                    insideCount += inside ? 1 : 0;
+
+                    ASSERT_EQ(points.count(point) > 0, inside) << point.x << ", " << point.y;
+                }
+            }
+
+            EXPECT_GT(insideCount, 0U);
+        }
+    }
+}
+
+TEST(MGLASS_POLYGON_SHAPE, RASTERIZE_SPANS_MATCH_POINTS)
+{
+    const mglass::IntegralRectArea rasterizeOntoAreas[] {
+        { {-50, 50}, 100, 100 },
+        { {0, 98}, 100, 100 },
+        { {-13, 20}, 7, 200 },
+        { {-5, 5}, 10, 10 },
+    };
+
+    for (const Vertices* vertices : { &triangle, &arrow, &pentagram })
+    {
+        const mglass::shapes::Polygon p{ {0.3f, -0.8f}, *vertices };
+
+        for (const auto& area : rasterizeOntoAreas)
+        {
+            IntPointSet expectedPoints;
+            p.rasterizeOnto(area, [&expectedPoints](const mglass::shapes::Polygon::RasterizationContext& rstCtx) {
+                expectedPoints.emplace(rstCtx.getRasterizedPoint());
+            });
+
+            IntPointSet actualPoints;
+            IntPoint prevEnd{ area.topLeft.x - 1, area.topLeft.y + 1 };
+
+            p.rasterizeSpansOnto(area, [&](const mglass::shapes::Polygon::RasterizationSpan& span) {
+                ASSERT_LT(span.getXBegin(), span.getXEnd());
+                ASSERT_TRUE( (span.getY() < prevEnd.y) || ((span.getY() == prevEnd.y) && (span.getXBegin() >= prevEnd.x)) )
+                    << "The polygon should emit the spans from the top to the bottom and from the left to the right.";
+                prevEnd = { span.getXEnd(), span.getY() };
+
+                for (auto x = span.getXBegin(); x < span.getXEnd(); ++x)
+                {
+                    ASSERT_TRUE(actualPoints.emplace(IntPoint{x, span.getY()}).second);
+                    ASSERT_EQ(span.getPixelDensityAt(x), 1);
+                }
+            });
+
+            ASSERT_EQ(actualPoints, expectedPoints);
+        }
+    }
+}
+
+
+// ====================================================================================================================
+// ShapeMaskCache
+// ====================================================================================================================
+
+TEST(MGLASS_POLYGON_SHAPE, MASK_CACHE_DISTINGUISHES_OUTLINES)
+{
+    mglass::ShapeMaskCache cache;
+
+    const auto diamondOutline = std::make_shared<const mglass::shapes::PolygonOutline>(
+        Vertices{ {0, -10}, {10, 0}, {0, 10}, {-10, 0} });
+
+    // the same bounds, but different outlines
+    const mglass::shapes::Polygon diamond{ {10, 10}, diamondOutline };
+    const mglass::shapes::Polygon hourglass{ {10, 10}, { {-10, -10}, {10, -10}, {-10, 10}, {10, 10} } };
+
+    const auto diamondMask = cache.getMaskOf(diamond);
+    const auto hourglassMask = cache.getMaskOf(hourglass);
+
+    EXPECT_EQ(cache.getSize(), 2U);
+    EXPECT_NE(&diamondMask.getMask(), &hourglassMask.getMask());
+
+    // the translated polygon shares the outline, so it shares the mask
+    const mglass::shapes::Polygon movedDiamond{ {-30, 45}, diamondOutline };
+
+    EXPECT_EQ(&cache.getMaskOf(movedDiamond).getMask(), &diamondMask.getMask());
+    EXPECT_EQ(cache.getSize(), 2U);
+
+    // the copy of the outline is another outline
+    const mglass::shapes::Polygon copiedDiamond{ {-30, 45}, diamondOutline->getVertices() };
+
+    (void)cache.getMaskOf(copiedDiamond);
+    EXPECT_EQ(cache.getSize(), 3U);
+}
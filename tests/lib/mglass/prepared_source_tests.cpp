@@ -0,0 +1,129 @@
+#include "mglass/mglass.h"      // mglass::*
+#include "mglass/magnifiers.h"  // mglass::magnifiers::*
+#include "mglass/shapes.h"      // mglass::shapes::*
+#include "gtest/gtest.h"
+#include "image_test_utils.h"   // image_test_utils::makeGradientImage
+#include <cstddef>              // std::ptrdiff_t
+#include <algorithm>            // std::clamp
+
+
+namespace
+{
+    using image_test_utils::makeGradientImage;
+
+
+    template<typename Interpolator>
+    void checkPreparedSourceEqualsOriginal(
+        const mglass::Image& imageSrc,
+        const mglass::PreparedSource& preparedSrc,
+        const mglass::shapes::Ellipse& shape,
+        const float scaleFactor,
+        const bool alphaBlending)
+    {
+        mglass::Image expectedOutputImg;
+        mglass::Image actualOutputImg;
+
+        mglass::magnifiers::nearestNeighborInterpolated<Interpolator>(
+            shape, scaleFactor, imageSrc, {0, 0}, expectedOutputImg, alphaBlending);
+        mglass::magnifiers::nearestNeighborInterpolated<Interpolator>(
+            shape, scaleFactor, preparedSrc, {0, 0}, actualOutputImg, alphaBlending);
+
+        ASSERT_EQ(actualOutputImg, expectedOutputImg);
+    }
+} // namespace
+
+
+TEST(MGLASS_PREPARED_SOURCE, CTOR_DEFAULT)
+{
+    const mglass::PreparedSource src;
+
+    EXPECT_EQ(src.getWidth(), 0);
+    EXPECT_EQ(src.getHeight(), 0);
+    EXPECT_EQ(src.getImage().getWidth(), 0);
+    EXPECT_EQ(src.getImage().getHeight(), 0);
+}
+
+TEST(MGLASS_PREPARED_SOURCE, CTOR_FROM_EMPTY_IMAGE)
+{
+    const mglass::PreparedSource src{mglass::Image{}};
+
+    EXPECT_EQ(src.getWidth(), 0);
+    EXPECT_EQ(src.getHeight(), 0);
+    EXPECT_EQ(src.getImage().getWidth(), 0);
+    EXPECT_EQ(src.getImage().getHeight(), 0);
+}
+
+TEST(MGLASS_PREPARED_SOURCE, BORDER_REPLICATES_NEAREST_PIXELS)
+{
+    const auto img = makeGradientImage(13, 7);
+
+    const mglass::PreparedSource src{img};
+    const mglass::ImageSpan span = src.getImage();
+
+    ASSERT_EQ(span.getWidth(), img.getWidth());
+    ASSERT_EQ(span.getHeight(), img.getHeight());
+    ASSERT_EQ(span.getReplicatedBorder(), mglass::PreparedSource::borderSize);
+
+    const auto border = static_cast<std::ptrdiff_t>(span.getReplicatedBorder());
+    const auto width = static_cast<std::ptrdiff_t>(img.getWidth());
+    const auto height = static_cast<std::ptrdiff_t>(img.getHeight());
+
+    for (std::ptrdiff_t y = -border; y < height + border; ++y)
+    {
+        for (std::ptrdiff_t x = -border; x < width + border; ++x)
+        {
+            const auto expected = img.getPixelAt(
+                static_cast<mglass::size_type>(std::clamp<std::ptrdiff_t>(x, 0, width - 1)),
+                static_cast<mglass::size_type>(std::clamp<std::ptrdiff_t>(y, 0, height - 1))
+            );
+
+            ASSERT_EQ(span.getBorderedRowData(y)[x], expected) << "x = " << x << ", y = " << y;
+        }
+    }
+}
+
+TEST(MGLASS_PREPARED_SOURCE, SUBSPAN_HAS_NO_BORDER)
+{
+    const mglass::PreparedSource src{makeGradientImage(40, 30)};
+
+    EXPECT_EQ(src.getImage().getSubSpan(3, 4, 10, 20).getReplicatedBorder(), 0);
+}
+
+TEST(MGLASS_PREPARED_SOURCE, MAGNIFIERS_RESULTS_EQUAL_ORIGINAL)
+{
+    // please make sure you are running this tests at "magnifying-glass/tests" working directory
+
+    const auto lenna = mglass::Image::fromPNGFile("resources/Lenna.png");
+    const mglass::PreparedSource preparedLenna{lenna};
+
+    const auto width = static_cast<mglass::float_type>(lenna.getWidth());
+    const auto height = static_cast<mglass::float_type>(lenna.getHeight());
+
+    // the shapes cross the edges of the image, so the border is read
+    const mglass::shapes::Ellipse shapes[] = {
+        mglass::shapes::Ellipse{ {width / 2, -height / 2}, 250, 100 },
+        mglass::shapes::Ellipse{ {0, 0}, 189, 300 },
+        mglass::shapes::Ellipse{ {width - 3, -height + 5}, 301, 157 },
+        mglass::shapes::Ellipse{ {width / 2, -height / 2}, width + 50, height + 70 }
+    };
+
+    for (const auto& shape : shapes)
+    {
+        for (const float scaleFactor : { 0.7f, 1.f, 2.5f, 13.7f })
+        {
+            for (const bool alphaBlending : { false, true })
+            {
+                mglass::Image expectedOutputImg;
+                mglass::Image actualOutputImg;
+
+                mglass::magnifiers::nearestNeighbor(shape, scaleFactor, lenna, {0, 0}, expectedOutputImg, alphaBlending);
+                mglass::magnifiers::nearestNeighbor(shape, scaleFactor, preparedLenna, {0, 0}, actualOutputImg, alphaBlending);
+                ASSERT_EQ(actualOutputImg, expectedOutputImg);
+
+                checkPreparedSourceEqualsOriginal<mglass::interpolators::Bilinear>(lenna, preparedLenna, shape, scaleFactor, alphaBlending);
+                checkPreparedSourceEqualsOriginal<mglass::interpolators::Bicubic>(lenna, preparedLenna, shape, scaleFactor, alphaBlending);
+                checkPreparedSourceEqualsOriginal<mglass::interpolators::Lanczos3>(lenna, preparedLenna, shape, scaleFactor, alphaBlending);
+            }
+        }
+    }
+}
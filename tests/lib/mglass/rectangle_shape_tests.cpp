@@ -2,7 +2,9 @@
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"    // testing::*
 #include <cstddef>          // std::size_t
+#include <unordered_map>    // std::unordered_map
 #include <unordered_set>    // std::unordered_set
+#include <algorithm>        // std::min
 
 
 namespace
@@ -322,3 +324,149 @@ TEST(MGLASS_RECTANGLE_SHAPE, RASTERIZE_10_5_ONTO_100_100_NO_INTERSECTIONS)
 
     ASSERT_TRUE(actualPoints.empty());
 }
+
+
+// ====================================================================================================================
+// rasterizeSpansOnto
+// ====================================================================================================================
+
+TEST(MGLASS_RECTANGLE_SHAPE, RASTERIZE_SPANS_EMPTY)
+{
+    const mglass::shapes::Rectangle r{ {0, 0}, 0, 0};
+
+    const mglass::IntegralRectArea rasterizeOntoArea{
+        {0, 0},
+        100,
+        100
+    };
+
+    bool gotCalled = false;
+    r.rasterizeSpansOnto(rasterizeOntoArea, [&gotCalled](const mglass::shapes::Rectangle::RasterizationSpan&) {
+        gotCalled = true;
+    });
+
+    ASSERT_FALSE(gotCalled) << "Empty rectangle should rasterize no spans.";
+}
+
+TEST(MGLASS_RECTANGLE_SHAPE, RASTERIZE_SPANS_MATCH_POINTS)
+{
+    const mglass::shapes::Rectangle rectangles[] {
+        mglass::shapes::Rectangle{ {0, 0}, 10, 5 },
+        mglass::shapes::Rectangle{ {0.3f, -7.8f}, 37.4f, 91.1f },
+        mglass::shapes::Rectangle{ {-12.5f, 3.5f}, 1.5f, 120 },
+        mglass::shapes::Rectangle{ {100, 100}, 250, 100 },
+    };
+
+    const mglass::IntegralRectArea rasterizeOntoAreas[] {
+        { {-50, 50}, 100, 100 },
+        { {0, 98}, 100, 100 },
+        { {-13, 60}, 7, 200 },
+        { {-200, 200}, 400, 400 },
+    };
+
+    for (const auto& r : rectangles)
+    {
+        for (const auto& area : rasterizeOntoAreas)
+        {
+            IntPointSet expectedPoints;
+            r.rasterizeOnto(area, [&expectedPoints](const mglass::shapes::Rectangle::RasterizationContext& rstCtx) {
+                expectedPoints.emplace(rstCtx.getRasterizedPoint());
+            });
+
+            IntPointSet actualPoints;
+            mglass::int_type prevY = area.topLeft.y + 1;
+
+            r.rasterizeSpansOnto(area, [&](const mglass::shapes::Rectangle::RasterizationSpan& span) {
+                ASSERT_LT(span.getXBegin(), span.getXEnd());
+                ASSERT_LT(span.getY(), prevY) << "The rectangle should emit a single span per row from the top to the bottom.";
+                prevY = span.getY();
+
+                for (auto x = span.getXBegin(); x < span.getXEnd(); ++x)
+                    ASSERT_TRUE(actualPoints.emplace(IntPoint{x, span.getY()}).second);
+            });
+
+            ASSERT_EQ(actualPoints, expectedPoints);
+        }
+    }
+}
+
+
+// ====================================================================================================================
+// classifyBlock()
+// ====================================================================================================================
+
+TEST(MGLASS_RECTANGLE_SHAPE, CLASSIFY_BLOCKS_MATCH_RASTERIZATION)
+{
+    // the density is 1 farther than 0.2 from the edge
+    const auto feathered = mglass::FalloffProfile::fromFunction([](const double u) { return (std::min)(1.0, u / 0.2); });
+
+    const mglass::shapes::Rectangle shapes[] {
+        mglass::shapes::Rectangle{ {0, 0}, 10, 5, feathered },
+        mglass::shapes::Rectangle{ {0.3f, -7.8f}, 37.4f, 91.1f, feathered },
+        mglass::shapes::Rectangle{ {-12.5f, 3.5f}, 1.5f, 120, feathered },
+        mglass::shapes::Rectangle{ {100, 100}, 250, 100, feathered },
+        mglass::shapes::Rectangle{ {100.5f, 100.5f}, 250, 100 },
+        mglass::shapes::Rectangle{ {0, 0}, 0, 100, feathered },
+    };
+
+    for (const auto& shape : shapes)
+    {
+        const mglass::IntegralRectArea bounds = mglass::getShapeIntegralBounds(shape);
+        const mglass::IntegralRectArea area{
+            { bounds.topLeft.x - 20, bounds.topLeft.y + 20 },
+            bounds.width + 40,
+            bounds.height + 40
+        };
+
+        std::unordered_map<IntPoint, mglass::float_type, PointHash> densities;
+        shape.rasterizeOnto(area, [&densities](const mglass::shapes::Rectangle::RasterizationContext& rstCtx) {
+            densities.emplace(rstCtx.getRasterizedPoint(), rstCtx.getPixelDensity());
+        });
+
+        for (const mglass::size_type blockSize : { 1, 5, 16 })
+        {
+            for (mglass::size_type row = 0; row < area.height; row += blockSize)
+            {
+                for (mglass::size_type column = 0; column < area.width; column += blockSize)
+                {
+                    const mglass::IntegralRectArea block{
+                        { area.topLeft.x + static_cast<mglass::int_type>(column), area.topLeft.y - static_cast<mglass::int_type>(row) },
+                        (std::min)(blockSize, area.width - column),
+                        (std::min)(blockSize, area.height - row)
+                    };
+
+                    const mglass::BlockCoverage coverage = shape.classifyBlock(block);
+
+                    for (mglass::size_type y = 0; y < block.height; ++y)
+                    {
+                        for (mglass::size_type x = 0; x < block.width; ++x)
+                        {
+                            const IntPoint point{
+                                block.topLeft.x + static_cast<mglass::int_type>(x),
+                                block.topLeft.y - static_cast<mglass::int_type>(y)
+                            };
+                            const auto it = densities.find(point);
+
+                            if (coverage == mglass::BlockCoverage::Outside)
+                            {
+                                ASSERT_EQ(it, densities.end()) << "An Outside block should have no rasterized pixels.";
+                            }
+                            else if (coverage == mglass::BlockCoverage::Inside)
+                            {
+                                ASSERT_NE(it, densities.end()) << "All the pixels of an Inside block should be rasterized.";
+                                ASSERT_EQ(it->second, 1) << "All the pixels of an Inside block should have the density 1.";
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // the blocks deep inside the shapes are classified as Inside, the ones far from them as Outside
+    EXPECT_EQ(shapes[3].classifyBlock({ {90, 110}, 16, 16 }), mglass::BlockCoverage::Inside);
+    EXPECT_EQ(shapes[3].classifyBlock({ {-100, 300}, 16, 16 }), mglass::BlockCoverage::Outside);
+
+    // the density of the default profile is less than 1 almost everywhere
+    EXPECT_EQ(shapes[4].classifyBlock({ {90, 110}, 16, 16 }), mglass::BlockCoverage::Edge);
+}
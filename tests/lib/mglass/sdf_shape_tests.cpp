@@ -0,0 +1,299 @@
+#include "mglass/shapes.h"          // mglass::shapes::SdfShape, mglass::shapes::sdf::*
+#include "mglass/shape_mask.h"      // mglass::ShapeMaskCache
+#include "gtest/gtest.h"
+#include "shape_test_utils.h"        // shape_test_utils::*
+#include <algorithm>                // std::min, std::max
+#include <cmath>                    // std::sqrt
+#include <cstddef>                  // std::size_t
+#include <memory>                   // std::make_shared
+#include <utility>                  // std::pair
+#include <vector>                   // std::vector
+
+
+namespace
+{
+    using shape_test_utils::IntPoint;
+    using shape_test_utils::IntPointDensities;
+    using shape_test_utils::rasterizePointsOf;
+
+    using RoundedRectangleShape = mglass::shapes::SdfShape<mglass::shapes::sdf::RoundedRectangle>;
+    using StadiumShape = mglass::shapes::SdfShape<mglass::shapes::sdf::Stadium>;
+    using RingShape = mglass::shapes::SdfShape<mglass::shapes::sdf::Ring>;
+    using SuperellipseShape = mglass::shapes::SdfShape<mglass::shapes::sdf::Superellipse>;
+
+    // Checks the pixels rasterized by the `shape` against the densities of the pixels evaluated one by one.
+    template<typename DistanceFunction>
+    void checkRasterizedPixels(const mglass::shapes::SdfShape<DistanceFunction>& shape)
+    {
+        const mglass::IntegralRectArea bounds = mglass::getShapeIntegralBounds(shape);
+        const mglass::IntegralRectArea area{
+            { bounds.topLeft.x - 2, bounds.topLeft.y + 2 },
+            bounds.width + 4,
+            bounds.height + 4
+        };
+
+        const IntPointDensities points = rasterizePointsOf(shape, area);
+
+        std::size_t insideCount = 0;
+
+        for (mglass::size_type row = 0; row < area.height; ++row)
+        {
+            for (mglass::size_type column = 0; column < area.width; ++column)
+            {
+                const IntPoint point{
+                    area.topLeft.x + static_cast<mglass::int_type>(column),
+                    area.topLeft.y - static_cast<mglass::int_type>(row)
+                };
+
+                const mglass::float_type distance = shape.getOutline()({
+                    (static_cast<mglass::float_type>(point.x) + 0.5f) - shape.getCenter().x,
+                    (static_cast<mglass::float_type>(point.y) + 0.5f) - shape.getCenter().y
+                });
+                const mglass::float_type expectedDensity = (std::min)((std::max)(0.5f - distance, 0.0f), 1.0f);
+
+                const auto it = points.find(point);
+
+                if (it == points.end())
+                {
+                    ASSERT_LT(expectedDensity, 1e-3f) << point.x << ", " << point.y;
+                    continue;
+                }
+
+                ++insideCount;
+                ASSERT_NEAR(it->second, expectedDensity, 1e-5f) << point.x << ", " << point.y;
+            }
+        }
+
+        EXPECT_GT(insideCount, 0U);
+    }
+} // namespace
+
+
+// ====================================================================================================================
+// distance functions
+// ====================================================================================================================
+
+TEST(MGLASS_SDF_SHAPE, DISTANCE_FUNCTIONS)
+{
+    const mglass::shapes::sdf::RoundedRectangle roundedRectangle{ 20, 10, 4 };
+
+    EXPECT_FLOAT_EQ(roundedRectangle({0, 0}), -10);
+    EXPECT_FLOAT_EQ(roundedRectangle({25, 0}), 5);
+    EXPECT_FLOAT_EQ(roundedRectangle({0, -13}), 3);
+    // outside the rounded corner: 5 from the center of the rounding circle (16; 6)
+    EXPECT_FLOAT_EQ(roundedRectangle({19, 10}), 1);
+
+    const mglass::shapes::sdf::Stadium stadium{ 30, 10 };
+
+    EXPECT_FLOAT_EQ(stadium({0, 12}), 2);
+    // 4 from the center of the left semicircle (-20; 0)
+    EXPECT_FLOAT_EQ(stadium({-20, 4}), 4 - 10);
+    EXPECT_FLOAT_EQ(stadium({-33, 0}), 3);
+
+    const mglass::shapes::sdf::Ring ring{ 20, 12 };
+
+    EXPECT_FLOAT_EQ(ring({0, 0}), 12);
+    EXPECT_FLOAT_EQ(ring({16, 0}), -4);
+    EXPECT_FLOAT_EQ(ring({0, -23}), 3);
+
+    const mglass::shapes::sdf::Superellipse superellipse{ 20, 10, 4 };
+
+    EXPECT_FLOAT_EQ(superellipse({0, 0}), -10);
+    EXPECT_NEAR(superellipse({0, 10}), 0, 1e-5);
+    EXPECT_NEAR(superellipse({20, 0}), 0, 1e-5);
+}
+
+
+// ====================================================================================================================
+// rasterizeOnto, rasterizeSpansOnto
+// ====================================================================================================================
+
+TEST(MGLASS_SDF_SHAPE, RASTERIZE_EMPTY)
+{
+    const RoundedRectangleShape empty;
+
+    EXPECT_TRUE(rasterizePointsOf(empty, { {-50, 50}, 100, 100 }).empty());
+}
+
+TEST(MGLASS_SDF_SHAPE, RASTERIZE_MATCHES_DISTANCES)
+{
+    checkRasterizedPixels(RoundedRectangleShape{ {0, 0}, 80, 40, { 40, 20, 8 } });
+    checkRasterizedPixels(RoundedRectangleShape{ {-17.3f, 4.9f}, 45.4f, 91.2f, { 22.7f, 45.6f, 11.1f } });
+    checkRasterizedPixels(StadiumShape{ {0.5f, -0.5f}, 100, 36, { 50, 18 } });
+    checkRasterizedPixels(RingShape{ {3.1f, -7.7f}, 70, 70, { 35, 25 } });
+    checkRasterizedPixels(SuperellipseShape{ {10.25f, 30.75f}, 64, 44, { 32, 22, 4 } });
+}
+
+TEST(MGLASS_SDF_SHAPE, RING_HAS_HOLE)
+{
+    const RingShape ring{ {0, 0}, 100, 100, { 50, 30 } };
+
+    const IntPointDensities points = rasterizePointsOf(ring, mglass::getShapeIntegralBounds(ring));
+
+    EXPECT_EQ(points.count({0, 0}), 0U);
+    EXPECT_EQ(points.count({-21, 20}), 0U);
+    ASSERT_EQ(points.count({39, 0}), 1U);
+    EXPECT_EQ(points.at({39, 0}), 1);
+}
+
+TEST(MGLASS_SDF_SHAPE, RASTERIZE_DOES_NOT_DEPEND_ON_AREA)
+{
+    const StadiumShape stadium{ {0.3f, -0.8f}, 150, 60, { 75, 30 } };
+
+    const IntPointDensities allPoints = rasterizePointsOf(stadium, mglass::getShapeIntegralBounds(stadium));
+
+    const mglass::IntegralRectArea areas[] {
+        { {-50, 50}, 100, 100 },
+        { {-13, 20}, 7, 200 },
+        { {-75, -3}, 33, 19 },
+    };
+
+    for (const auto& area : areas)
+    {
+        IntPointDensities expected;
+        for (const auto& [point, density] : allPoints)
+        {
+            if (mglass::getIntersectionOf(area, { point, 1, 1 }).width > 0)
+                expected.emplace(point, density);
+        }
+
+        ASSERT_EQ(rasterizePointsOf(stadium, area), expected);
+    }
+}
+
+TEST(MGLASS_SDF_SHAPE, RASTERIZE_SPANS_MATCH_POINTS)
+{
+    const mglass::IntegralRectArea rasterizeOntoAreas[] {
+        { {-50, 50}, 100, 100 },
+        { {0, 98}, 100, 100 },
+        { {-13, 20}, 7, 200 },
+        { {-5, 5}, 10, 10 },
+    };
+
+    const RoundedRectangleShape shape{ {0.3f, -0.8f}, 90, 70, { 45, 35, 15 } };
+
+    for (const auto& area : rasterizeOntoAreas)
+    {
+        std::vector<std::pair<IntPoint, mglass::float_type>> expectedPoints;
+        shape.rasterizeOnto(area, [&expectedPoints](const RoundedRectangleShape::RasterizationContext& rstCtx) {
+            expectedPoints.emplace_back(rstCtx.getRasterizedPoint(), rstCtx.getPixelDensity());
+        });
+
+        std::vector<std::pair<IntPoint, mglass::float_type>> actualPoints;
+        IntPoint prevEnd{ area.topLeft.x - 1, area.topLeft.y + 1 };
+
+        shape.rasterizeSpansOnto(area, [&](const RoundedRectangleShape::RasterizationSpan& span) {
+            ASSERT_LT(span.getXBegin(), span.getXEnd());
+            ASSERT_TRUE( (span.getY() < prevEnd.y) || ((span.getY() == prevEnd.y) && (span.getXBegin() >= prevEnd.x)) )
+                << "The shape should emit the spans from the top to the bottom and from the left to the right.";
+            prevEnd = { span.getXEnd(), span.getY() };
+
+            for (auto x = span.getXBegin(); x < span.getXEnd(); ++x)
+                actualPoints.emplace_back(IntPoint{x, span.getY()}, span.getPixelDensityAt(x));
+        });
+
+        ASSERT_EQ(actualPoints, expectedPoints);
+    }
+}
+
+TEST(MGLASS_SDF_SHAPE, CLASSIFY_BLOCK_MATCHES_RASTERIZATION)
+{
+    const SuperellipseShape shape{ {0.3f, -0.8f}, 120, 90, { 60, 45, 3 } };
+
+    const IntPointDensities points = rasterizePointsOf(shape, mglass::getShapeIntegralBounds(shape));
+
+    std::size_t insideCount = 0;
+    std::size_t outsideCount = 0;
+
+    for (mglass::int_type top = 60; top > -60; top -= 8)
+    {
+        for (mglass::int_type left = -70; left < 70; left += 8)
+        {
+            const mglass::IntegralRectArea block{ {left, top}, 8, 8 };
+            const mglass::BlockCoverage coverage = shape.classifyBlock(block);
+
+            insideCount += (coverage == mglass::BlockCoverage::Inside) ? 1 : 0;
+            outsideCount += (coverage == mglass::BlockCoverage::Outside) ? 1 : 0;
+
+            for (mglass::int_type y = top; y > top - 8; --y)
+            {
+                for (mglass::int_type x = left; x < left + 8; ++x)
+                {
+                    const auto it = points.find({x, y});
+
+                    if (coverage == mglass::BlockCoverage::Outside)
+                    {
+                        ASSERT_TRUE(it == points.end());
+                    }
+                    if (coverage == mglass::BlockCoverage::Inside)
+                    {
+                        ASSERT_TRUE( (it != points.end()) && (it->second == 1) );
+                    }
+                }
+            }
+        }
+    }
+
+    EXPECT_GT(insideCount, 0U);
+    EXPECT_GT(outsideCount, 0U);
+}
+
+
+// ====================================================================================================================
+// ShapeMaskCache
+// ====================================================================================================================
+
+TEST(MGLASS_SDF_SHAPE, MASK_CACHE_DISTINGUISHES_DISTANCE_FUNCTIONS)
+{
+    mglass::ShapeMaskCache cache;
+
+    const auto roundedCorners = std::make_shared<const mglass::shapes::sdf::RoundedRectangle>(
+        mglass::shapes::sdf::RoundedRectangle{ 40, 20, 8 });
+
+    // the same bounds, but different radii
+    const RoundedRectangleShape rounded{ {10, 10}, 80, 40, roundedCorners };
+    const RoundedRectangleShape sharp{ {10, 10}, 80, 40, { 40, 20, 0 } };
+
+    const auto roundedMask = cache.getMaskOf(rounded);
+    const auto sharpMask = cache.getMaskOf(sharp);
+
+    EXPECT_EQ(cache.getSize(), 2U);
+    EXPECT_NE(&roundedMask.getMask(), &sharpMask.getMask());
+
+    // the translated shape shares the distance function, so it shares the mask
+    const RoundedRectangleShape moved{ {-30, 45}, 80, 40, roundedCorners };
+
+    EXPECT_EQ(&cache.getMaskOf(moved).getMask(), &roundedMask.getMask());
+    EXPECT_EQ(cache.getSize(), 2U);
+}
+
+TEST(MGLASS_SDF_SHAPE, MASK_CACHE_COMPARES_DISTANCE_FUNCTIONS_BY_VALUE)
+{
+    mglass::ShapeMaskCache cache;
+
+    // the shape is rebuilt for each frame
+    const auto firstMask = cache.getMaskOf(RoundedRectangleShape{ {10, 10}, 80, 40, { 40, 20, 8 } });
+
+    for (mglass::int_type frame = 1; frame < 4; ++frame)
+    {
+        const mglass::float_type x = static_cast<mglass::float_type>(10 + frame * 7);
+        const auto mask = cache.getMaskOf(RoundedRectangleShape{ {x, 10}, 80, 40, { 40, 20, 8 } });
+
+        EXPECT_EQ(&mask.getMask(), &firstMask.getMask());
+        EXPECT_EQ(mask.getOffset(), (mglass::Point<mglass::int_type>{ frame * 7, 0 }));
+    }
+
+    EXPECT_EQ(cache.getSize(), 1U);
+
+    // the functions without operator== are the same only if they are shared
+    const mglass::float_type radius = 20;
+    const auto circle = [radius](const mglass::Point<mglass::float_type> p) noexcept { return std::sqrt(p.x * p.x + p.y * p.y) - radius; };
+    using CircleShape = mglass::shapes::SdfShape<decltype(circle)>;
+
+    const auto sharedCircle = std::make_shared<const decltype(circle)>(circle);
+    const auto circleMask = cache.getMaskOf(CircleShape{ {0, 0}, 40, 40, sharedCircle });
+
+    EXPECT_EQ(&cache.getMaskOf(CircleShape{ {5, 5}, 40, 40, sharedCircle }).getMask(), &circleMask.getMask());
+    EXPECT_NE(&cache.getMaskOf(CircleShape{ {5, 5}, 40, 40, circle }).getMask(), &circleMask.getMask());
+    EXPECT_EQ(cache.getSize(), 3U);
+}
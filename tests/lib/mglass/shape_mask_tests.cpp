@@ -0,0 +1,270 @@
+#include "mglass/mglass.h"          // mglass::*
+#include "mglass/shape_mask.h"      // mglass::ShapeMask, mglass::ShapeMaskCache
+#include "mglass/magnifiers.h"      // mglass::magnifiers::*
+#include "mglass/shapes.h"          // mglass::shapes::*
+#include "gtest/gtest.h"
+#include <algorithm>                // std::min
+#include <cstddef>                  // std::size_t
+#include <cstdlib>                  // std::abs
+#include <map>                      // std::map
+#include <memory>                   // std::weak_ptr, std::make_shared
+#include <utility>                  // std::pair
+
+
+namespace
+{
+    // the colors must be the same, the alpha channels can differ by 1 (the coverages of a mask are 8-bit)
+    void checkImagesAreCloseEnough(const mglass::Image& actual, const mglass::Image& expected)
+    {
+        ASSERT_EQ(actual.getWidth(), expected.getWidth());
+        ASSERT_EQ(actual.getHeight(), expected.getHeight());
+
+        for (mglass::size_type y = 0; y < actual.getHeight(); ++y)
+        {
+            for (mglass::size_type x = 0; x < actual.getWidth(); ++x)
+            {
+                const mglass::ARGB actualPixel = actual.getPixelAt(x, y);
+                const mglass::ARGB expectedPixel = expected.getPixelAt(x, y);
+
+                ASSERT_EQ(actualPixel.r, expectedPixel.r);
+                ASSERT_EQ(actualPixel.g, expectedPixel.g);
+                ASSERT_EQ(actualPixel.b, expectedPixel.b);
+                ASSERT_LE(std::abs(static_cast<int>(actualPixel.a) - static_cast<int>(expectedPixel.a)), 1);
+            }
+        }
+    }
+
+
+    template<typename ShapeImpl, typename RastrCtx>
+    void checkMaskEqualsShape(
+        const mglass::Image& imageSrc,
+        const mglass::Shape<ShapeImpl, RastrCtx>& shape,
+        const mglass::Shape<mglass::PlacedShapeMask, mglass::detail::RasterizedPointContext>& mask,
+        const mglass::float_type scaleFactor)
+    {
+        ASSERT_EQ(mglass::getShapeIntegralBounds(mask), mglass::getShapeIntegralBounds(shape));
+
+        mglass::Image expectedOutputImg;
+        mglass::Image actualOutputImg;
+
+        // without alpha-blending only the spans are used
+        mglass::magnifiers::nearestNeighbor(shape, scaleFactor, imageSrc, {0, 0}, expectedOutputImg, false);
+        mglass::magnifiers::nearestNeighbor(mask, scaleFactor, imageSrc, {0, 0}, actualOutputImg, false);
+        ASSERT_EQ(actualOutputImg, expectedOutputImg);
+
+        mglass::magnifiers::nearestNeighbor(shape, scaleFactor, imageSrc, {0, 0}, expectedOutputImg, true);
+        mglass::magnifiers::nearestNeighbor(mask, scaleFactor, imageSrc, {0, 0}, actualOutputImg, true);
+        checkImagesAreCloseEnough(actualOutputImg, expectedOutputImg);
+
+        mglass::magnifiers::nearestNeighborInterpolated(shape, scaleFactor, imageSrc, {0, 0}, expectedOutputImg, true);
+        mglass::magnifiers::nearestNeighborInterpolated(mask, scaleFactor, imageSrc, {0, 0}, actualOutputImg, true);
+        checkImagesAreCloseEnough(actualOutputImg, expectedOutputImg);
+    }
+
+
+    // Checks that the blocks of the stored spans are classified exactly:
+    //  Inside if all their pixels have the density 1, Outside if they have no pixels and Edge otherwise.
+    template<typename ShapeImpl, typename RastrCtx>
+    void checkBlocksAreClassifiedExactly(const mglass::Shape<ShapeImpl, RastrCtx>& shape)
+    {
+        const mglass::IntegralRectArea bounds = mglass::getShapeIntegralBounds(shape);
+        const mglass::IntegralRectArea area{
+            { bounds.topLeft.x - 20, bounds.topLeft.y + 20 }, bounds.width + 40, bounds.height + 40
+        };
+
+        std::map<std::pair<mglass::int_type, mglass::int_type>, mglass::float_type> densities;
+        shape.rasterizeOnto(area, [&densities](const RastrCtx& rstCtx) {
+            densities[{ rstCtx.getRasterizedPoint().x, rstCtx.getRasterizedPoint().y }] = rstCtx.getPixelDensity();
+        });
+
+        std::size_t insideCount = 0;
+
+        for (const mglass::size_type blockSize : { 1, 5, 16 })
+        {
+            for (mglass::size_type row = 0; row < area.height; row += blockSize)
+            {
+                for (mglass::size_type column = 0; column < area.width; column += blockSize)
+                {
+                    const mglass::IntegralRectArea block{
+                        { area.topLeft.x + static_cast<mglass::int_type>(column), area.topLeft.y - static_cast<mglass::int_type>(row) },
+                        (std::min)(blockSize, area.width - column),
+                        (std::min)(blockSize, area.height - row)
+                    };
+
+                    std::size_t pixelsCount = 0;
+                    std::size_t solidPixelsCount = 0;
+
+                    for (mglass::int_type y = block.topLeft.y; y > block.topLeft.y - static_cast<mglass::int_type>(block.height); --y)
+                    {
+                        for (mglass::int_type x = block.topLeft.x; x < block.topLeft.x + static_cast<mglass::int_type>(block.width); ++x)
+                        {
+                            const auto it = densities.find({ x, y });
+                            pixelsCount += (it != densities.end()) ? 1 : 0;
+                            solidPixelsCount += ((it != densities.end()) && (it->second == 1)) ? 1 : 0;
+                        }
+                    }
+
+                    mglass::BlockCoverage expected = mglass::BlockCoverage::Edge;
+                    if (pixelsCount == 0)
+                        expected = mglass::BlockCoverage::Outside;
+                    else if (solidPixelsCount == block.width * block.height)
+                        expected = mglass::BlockCoverage::Inside;
+
+                    ASSERT_EQ(shape.classifyBlock(block), expected) << block.topLeft.x << ", " << block.topLeft.y;
+
+                    insideCount += (expected == mglass::BlockCoverage::Inside) ? 1 : 0;
+                }
+            }
+        }
+
+        EXPECT_GT(insideCount, 0U);
+    }
+} // namespace
+
+
+TEST(MGLASS_SHAPE_MASK, CTOR_DEFAULT)
+{
+    const mglass::ShapeMask mask;
+
+    EXPECT_EQ(mask.getIntegralBounds().width, 0);
+    EXPECT_EQ(mask.getIntegralBounds().height, 0);
+}
+
+TEST(MGLASS_SHAPE_MASK, EQUALS_SHAPE)
+{
+    // please make sure you are running this tests at "magnifying-glass/tests" working directory
+
+    const auto lenna = mglass::Image::fromPNGFile("resources/Lenna.png");
+
+    const mglass::shapes::Ellipse ellipse{ {256, -256}, 250, 100 };
+    const mglass::shapes::Rectangle rectangle{ {200.5f, -300.5f}, 189, 130 };
+
+    mglass::ShapeMaskCache cache;
+
+    for (const mglass::float_type scaleFactor : { 0.7f, 2.5f, 13.7f })
+    {
+        checkMaskEqualsShape(lenna, ellipse, cache.getMaskOf(ellipse), scaleFactor);
+        checkMaskEqualsShape(lenna, rectangle, cache.getMaskOf(rectangle), scaleFactor);
+    }
+}
+
+TEST(MGLASS_SHAPE_MASK, CLASSIFY_BLOCKS_MATCH_SPANS)
+{
+    const mglass::shapes::Ellipse ellipse{ {10.5f, -20}, 150, 90 };
+    const mglass::shapes::Polygon polygon{ {-30, 45}, { {-60, 40}, {60, 40}, {0, -10}, {60, -40}, {-60, -40} } };
+    const mglass::shapes::Ellipse fadingEllipse{ {0, 0}, 120, 120, mglass::FalloffProfile::linear() };
+
+    const mglass::ShapeMask ellipseMask{ellipse};
+    const mglass::ShapeMask polygonMask{polygon};
+    const mglass::ShapeMask fadingEllipseMask{fadingEllipse};
+
+    checkBlocksAreClassifiedExactly(ellipseMask.movedBy({0, 0}));
+    checkBlocksAreClassifiedExactly(polygonMask.movedBy({-7, 13}));
+    checkBlocksAreClassifiedExactly(mglass::PlacedShapeMask{ std::make_shared<const mglass::ShapeMask>(ellipse), {3, -5} });
+
+    // the densities without the stored values are 1
+    const mglass::detail::RasterizedSpans<mglass::float_type> ellipseSpans{ ellipse, false, [](mglass::float_type) { return 0; } };
+    checkBlocksAreClassifiedExactly(mglass::detail::MovedRasterizedSpans<mglass::float_type>{ ellipseSpans, {1, 1} });
+
+    // only the center of the linear profile has the density 1
+    const mglass::IntegralRectArea fadingBounds = fadingEllipseMask.getIntegralBounds();
+    for (mglass::int_type top = fadingBounds.topLeft.y; top > fadingBounds.topLeft.y - 120; top -= 16)
+    {
+        for (mglass::int_type left = fadingBounds.topLeft.x; left < fadingBounds.topLeft.x + 120; left += 16)
+            EXPECT_NE(fadingEllipseMask.movedBy({0, 0}).classifyBlock({ {left, top}, 16, 16 }), mglass::BlockCoverage::Inside);
+    }
+}
+
+TEST(MGLASS_SHAPE_MASK_CACHE, REUSES_MASKS_OF_MOVED_SHAPES)
+{
+    // please make sure you are running this tests at "magnifying-glass/tests" working directory
+
+    const auto lenna = mglass::Image::fromPNGFile("resources/Lenna.png");
+
+    mglass::ShapeMaskCache cache;
+
+    const auto firstMask = cache.getMaskOf(mglass::shapes::Ellipse{ {0, 0}, 250, 100 });
+    EXPECT_EQ(firstMask.getOffset(), (mglass::Point<mglass::int_type>{0, 0}));
+
+    for (const mglass::Point<mglass::int_type> offset : { mglass::Point<mglass::int_type>{1, -1}, {37, -211}, {256, -256} })
+    {
+        const mglass::shapes::Ellipse movedShape{
+            { static_cast<mglass::float_type>(offset.x), static_cast<mglass::float_type>(offset.y) }, 250, 100
+        };
+
+        const auto mask = cache.getMaskOf(movedShape);
+
+        EXPECT_EQ(&mask.getMask(), &firstMask.getMask());
+        EXPECT_EQ(mask.getOffset(), offset);
+        EXPECT_EQ(cache.getSize(), 1);
+
+        checkMaskEqualsShape(lenna, movedShape, mask, 2.5f);
+    }
+
+    // the centers are the same after quantization
+    const auto nearlySameMask = cache.getMaskOf(mglass::shapes::Ellipse{ {0.01f, -0.01f}, 250, 100 });
+    EXPECT_EQ(&nearlySameMask.getMask(), &firstMask.getMask());
+    EXPECT_EQ(cache.getSize(), 1);
+}
+
+TEST(MGLASS_SHAPE_MASK_CACHE, KEYS)
+{
+    mglass::ShapeMaskCache cache{3};
+
+    const auto ellipseMask = cache.getMaskOf(mglass::shapes::Ellipse{ {0, 0}, 250, 100 });
+
+    // another size
+    const auto smallerEllipseMask = cache.getMaskOf(mglass::shapes::Ellipse{ {0, 0}, 249, 100 });
+    EXPECT_NE(&smallerEllipseMask.getMask(), &ellipseMask.getMask());
+    EXPECT_EQ(cache.getSize(), 2);
+
+    // another type
+    const auto rectangleMask = cache.getMaskOf(mglass::shapes::Rectangle{ {0, 0}, 250, 100 });
+    EXPECT_NE(&rectangleMask.getMask(), &ellipseMask.getMask());
+    EXPECT_EQ(cache.getSize(), 3);
+
+    // another fractional part of the center, evicts the least recently used mask
+    const auto halfMovedEllipseMask = cache.getMaskOf(mglass::shapes::Ellipse{ {0.5f, 0}, 250, 100 });
+    EXPECT_NE(&halfMovedEllipseMask.getMask(), &ellipseMask.getMask());
+    EXPECT_EQ(cache.getSize(), 3);
+
+    // the evicted mask is still valid
+    EXPECT_EQ(ellipseMask.getMask().getIntegralBounds(), mglass::getShapeIntegralBounds(mglass::shapes::Ellipse{ {0, 0}, 250, 100 }));
+
+    EXPECT_NE(&cache.getMaskOf(mglass::shapes::Ellipse{ {0, 0}, 250, 100 }).getMask(), &ellipseMask.getMask());
+
+    cache.clear();
+    EXPECT_EQ(cache.getSize(), 0);
+}
+
+TEST(MGLASS_SHAPE_MASK_CACHE, KEEPS_OUTLINES_ALIVE)
+{
+    // please make sure you are running this tests at "magnifying-glass/tests" working directory
+
+    const auto lenna = mglass::Image::fromPNGFile("resources/Lenna.png");
+
+    mglass::ShapeMaskCache cache;
+
+    std::weak_ptr<const mglass::shapes::PolygonOutline> upOutline;
+    {
+        const mglass::shapes::Polygon up{ {100, -100}, { {-50, 50}, {50, 50}, {0, -50} } };
+        upOutline = up.getSharedOutline();
+
+        (void)cache.getMaskOf(up);
+    }
+
+    // the cached mask keeps the outline of the destroyed shape, so a new outline can not take its address
+    //  and get its mask
+    ASSERT_FALSE(upOutline.expired());
+
+    const mglass::shapes::Polygon down{ {100, -100}, { {-50, -50}, {0, 50}, {50, -50} } };
+    ASSERT_NE(down.getSharedOutline(), upOutline.lock());
+
+    const auto downMask = cache.getMaskOf(down);
+    EXPECT_EQ(cache.getSize(), 2);
+
+    checkMaskEqualsShape(lenna, down, downMask, 2.5f);
+
+    cache.clear();
+    EXPECT_TRUE(upOutline.expired());
+}
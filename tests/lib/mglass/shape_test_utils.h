@@ -0,0 +1,40 @@
+#ifndef MAGNIFYING_GLASS_TESTS_SHAPE_TEST_UTILS_H
+#define MAGNIFYING_GLASS_TESTS_SHAPE_TEST_UTILS_H
+
+#include "mglass/primitives.h"  // mglass::Point, mglass::IntegralRectArea, mglass::int_type, mglass::float_type
+#include "gtest/gtest.h"
+#include <cstddef>              // std::size_t
+#include <functional>           // std::hash
+#include <unordered_map>        // std::unordered_map
+
+
+// The helpers shared by the tests of the shapes.
+namespace shape_test_utils
+{
+    struct PointHash
+    {
+        template<typename T>
+        std::size_t operator()(const mglass::Point<T> p) const noexcept
+        {
+            return (std::hash<T>{}(p.x) ^ std::hash<T>{}(p.y));
+        }
+    };
+
+    using IntPoint = mglass::Point<mglass::int_type>;
+    using IntPointDensities = std::unordered_map<IntPoint, mglass::float_type, PointHash>;
+
+    // the points rasterized by the `shape` onto the `area` and their densities (each point must be rasterized once)
+    template<typename ShapeT>
+    IntPointDensities rasterizePointsOf(const ShapeT& shape, const mglass::IntegralRectArea& area)
+    {
+        IntPointDensities result;
+
+        shape.rasterizeOnto(area, [&result](const typename ShapeT::RasterizationContext& rstCtx) {
+            ASSERT_TRUE(result.emplace(rstCtx.getRasterizedPoint(), rstCtx.getPixelDensity()).second);
+        });
+
+        return result;
+    }
+} // namespace shape_test_utils
+
+#endif // ndef MAGNIFYING_GLASS_TESTS_SHAPE_TEST_UTILS_H
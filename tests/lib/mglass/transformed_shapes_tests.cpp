@@ -0,0 +1,327 @@
+#include "mglass/shapes.h"          // mglass::shapes::TransformedEllipse, mglass::shapes::TransformedRectangle
+#include "mglass/shape_mask.h"      // mglass::ShapeMaskCache
+#include "gtest/gtest.h"
+#include <algorithm>                // std::min
+#include <cmath>                    // std::abs, std::cos, std::sin, std::sqrt
+#include <cstddef>                  // std::size_t
+#include <unordered_set>            // std::unordered_set
+#include <utility>                  // std::pair
+#include <vector>                   // std::vector
+
+
+namespace
+{
+    struct PointHash
+    {
+        template<typename T>
+        std::size_t operator()(const mglass::Point<T> p) const noexcept
+        {
+            return (std::hash<T>{}(p.x) ^ std::hash<T>{}(p.y));
+        }
+    };
+
+    using IntPoint = mglass::Point<mglass::int_type>;
+    using IntPointSet = std::unordered_set<IntPoint, PointHash>;
+
+    constexpr double pi = 3.14159265358979323846;
+
+    // the point (`x`, `y`) in the coordinate system of the unit shape rotated by `angle`,
+    //  scaled by `width` x `height` and placed at `center`
+    mglass::Point<double> toUnitShape(
+        const mglass::Point<mglass::float_type> center,
+        const double width,
+        const double height,
+        const double angle,
+        const double x,
+        const double y)
+    {
+        const double relX = x - center.x;
+        const double relY = y - center.y;
+
+        // rotation by -angle
+        const double rotatedX = relX * std::cos(angle) + relY * std::sin(angle);
+        const double rotatedY = -relX * std::sin(angle) + relY * std::cos(angle);
+
+        return { rotatedX * 2 / width, rotatedY * 2 / height };
+    }
+
+    struct RotatedShapeParams
+    {
+        mglass::Point<mglass::float_type> center;
+        mglass::float_type width;
+        mglass::float_type height;
+        double angle;
+    };
+
+    const std::vector<RotatedShapeParams> rotatedShapes{
+        { {0, 0}, 60, 20, 0 },
+        { {0.5f, -0.5f}, 60, 20, pi / 6 },
+        { {-17.3f, 4.9f}, 45.7f, 80.2f, pi / 4 },
+        { {3.1f, -7.7f}, 33.3f, 10.1f, 2.1 },
+        { {0, 0}, 60, 20, pi / 2 },
+    };
+
+    // Checks the pixels rasterized by the `shape` against the `isInside`(unit shape coordinates of the pixel)
+    //  skipping the pixels whose centers are close to the boundary (`distanceToBoundary` < 1e-3).
+    template<typename ShapeT, typename IsInside, typename DistanceToBoundary>
+    void checkRasterizedPixels(
+        const ShapeT& shape,
+        const RotatedShapeParams& params,
+        const IsInside& isInside,
+        const DistanceToBoundary& distanceToBoundary)
+    {
+        const mglass::IntegralRectArea bounds = mglass::getShapeIntegralBounds(shape);
+        const mglass::IntegralRectArea area{
+            { bounds.topLeft.x - 2, bounds.topLeft.y + 2 },
+            bounds.width + 4,
+            bounds.height + 4
+        };
+
+        IntPointSet points;
+        shape.rasterizeOnto(area, [&](const typename ShapeT::RasterizationContext& rstCtx) {
+            ASSERT_TRUE(points.emplace(rstCtx.getRasterizedPoint()).second);
+            ASSERT_GE(rstCtx.getPixelDensity(), 0);
+            ASSERT_LE(rstCtx.getPixelDensity(), 1);
+        });
+
+        std::size_t insideCount = 0;
+
+        for (mglass::size_type row = 0; row < area.height; ++row)
+        {
+            for (mglass::size_type column = 0; column < area.width; ++column)
+            {
+                const IntPoint point{
+                    area.topLeft.x + static_cast<mglass::int_type>(column),
+                    area.topLeft.y - static_cast<mglass::int_type>(row)
+                };
+                const auto unitPoint = toUnitShape(
+                    params.center, params.width, params.height, params.angle, point.x + 0.5, point.y + 0.5);
+
+                if (distanceToBoundary(unitPoint) < 1e-3)
+                    continue;
+
+                const bool inside = isInside(unitPoint);
+                insideCount += inside ? 1 : 0;
+
+                ASSERT_EQ(points.count(point) > 0, inside) << point.x << ", " << point.y;
+            }
+        }
+
+        EXPECT_GT(insideCount, 0U);
+    }
+
+    template<typename ShapeT>
+    void checkSpansMatchPoints(const ShapeT& shape)
+    {
+        const mglass::IntegralRectArea rasterizeOntoAreas[] {
+            { {-50, 50}, 100, 100 },
+            { {0, 98}, 100, 100 },
+            { {-13, 20}, 7, 200 },
+            { {-5, 5}, 10, 10 },
+        };
+
+        for (const auto& area : rasterizeOntoAreas)
+        {
+            std::vector<std::pair<IntPoint, mglass::float_type>> expectedPoints;
+            shape.rasterizeOnto(area, [&expectedPoints](const typename ShapeT::RasterizationContext& rstCtx) {
+                expectedPoints.emplace_back(rstCtx.getRasterizedPoint(), rstCtx.getPixelDensity());
+            });
+
+            std::vector<std::pair<IntPoint, mglass::float_type>> actualPoints;
+            IntPoint prevEnd{ area.topLeft.x - 1, area.topLeft.y + 1 };
+
+            shape.rasterizeSpansOnto(area, [&](const typename ShapeT::RasterizationSpan& span) {
+                ASSERT_LT(span.getXBegin(), span.getXEnd());
+                ASSERT_TRUE( (span.getY() < prevEnd.y) || ((span.getY() == prevEnd.y) && (span.getXBegin() >= prevEnd.x)) )
+                    << "The shape should emit the spans from the top to the bottom and from the left to the right.";
+                prevEnd = { span.getXEnd(), span.getY() };
+
+                std::vector<mglass::float_type> densities(static_cast<std::size_t>(span.getXEnd() - span.getXBegin()));
+                span.getPixelDensitiesOf(span.getXBegin(), span.getXEnd(), densities.data());
+
+                for (auto x = span.getXBegin(); x < span.getXEnd(); ++x)
+                {
+                    ASSERT_EQ(densities[static_cast<std::size_t>(x - span.getXBegin())], span.getPixelDensityAt(x));
+                    actualPoints.emplace_back(IntPoint{x, span.getY()}, span.getPixelDensityAt(x));
+                }
+            });
+
+            ASSERT_EQ(actualPoints, expectedPoints);
+        }
+    }
+} // namespace
+
+
+// ====================================================================================================================
+// AffineTransform
+// ====================================================================================================================
+
+TEST(MGLASS_TRANSFORMED_SHAPES, AFFINE_TRANSFORM)
+{
+    const auto t = mglass::AffineTransform::translation(3, -2) * mglass::AffineTransform::rotation(static_cast<float>(pi / 2));
+
+    const mglass::Point<mglass::float_type> p = t.apply({1, 0});
+    EXPECT_NEAR(p.x, 3, 1e-6);
+    EXPECT_NEAR(p.y, -1, 1e-6);
+
+    const mglass::Point<mglass::float_type> back = t.inversed().apply(p);
+    EXPECT_NEAR(back.x, 1, 1e-6);
+    EXPECT_NEAR(back.y, 0, 1e-6);
+
+    EXPECT_TRUE( (mglass::AffineTransform{} == mglass::AffineTransform::scaling(1, 1)) );
+    EXPECT_TRUE( (t.getLinearPart() != t) );
+}
+
+
+// ====================================================================================================================
+// getBounds()
+// ====================================================================================================================
+
+TEST(MGLASS_TRANSFORMED_SHAPES, BOUNDS)
+{
+    const auto quarterTurn = mglass::AffineTransform::rotation(static_cast<float>(pi / 2));
+
+    // the axes are swapped by the rotation, the translation moves the center
+    const mglass::shapes::TransformedEllipse e{ {10, 20}, 60, 20, mglass::AffineTransform::translation(1, 2) * quarterTurn };
+    const mglass::ShapeRectArea ellipseBounds = e.getBounds();
+
+    EXPECT_NEAR(ellipseBounds.topLeft.x, 1, 1e-4);
+    EXPECT_NEAR(ellipseBounds.topLeft.y, 52, 1e-4);
+    EXPECT_NEAR(ellipseBounds.width, 20, 1e-4);
+    EXPECT_NEAR(ellipseBounds.height, 60, 1e-4);
+
+    // the corners of the rotated square are at the sides of its bounds
+    const mglass::shapes::TransformedRectangle r{
+        {0, 0}, 20, 20, mglass::AffineTransform::rotation(static_cast<float>(pi / 4))
+    };
+    const mglass::ShapeRectArea rectangleBounds = r.getBounds();
+
+    EXPECT_NEAR(rectangleBounds.topLeft.x, -10 * std::sqrt(2.0), 1e-4);
+    EXPECT_NEAR(rectangleBounds.width, 20 * std::sqrt(2.0), 1e-4);
+    EXPECT_NEAR(rectangleBounds.height, 20 * std::sqrt(2.0), 1e-4);
+}
+
+
+// ====================================================================================================================
+// rasterizeOnto, rasterizeSpansOnto
+// ====================================================================================================================
+
+TEST(MGLASS_TRANSFORMED_SHAPES, RASTERIZE_DEGENERATE)
+{
+    const mglass::shapes::TransformedEllipse ellipses[] {
+        mglass::shapes::TransformedEllipse{},
+        mglass::shapes::TransformedEllipse{ {0, 0}, 10, 0, mglass::AffineTransform::rotation(1) },
+        mglass::shapes::TransformedEllipse{ {0, 0}, 10, 10, mglass::AffineTransform{ 1, 2, 2, 4, 0, 0 } },
+    };
+
+    for (const auto& e : ellipses)
+    {
+        bool gotCalled = false;
+        e.rasterizeOnto({ {-50, 50}, 100, 100 }, [&gotCalled](const mglass::shapes::TransformedEllipse::RasterizationContext&) {
+            gotCalled = true;
+        });
+
+        ASSERT_FALSE(gotCalled) << "Degenerate ellipse should rasterize no points.";
+    }
+
+    bool gotCalled = false;
+    mglass::shapes::TransformedRectangle{ {0, 0}, 0, 10 }.rasterizeOnto(
+        { {-50, 50}, 100, 100 },
+        [&gotCalled](const mglass::shapes::TransformedRectangle::RasterizationContext&) { gotCalled = true; }
+    );
+
+    ASSERT_FALSE(gotCalled) << "Degenerate rectangle should rasterize no points.";
+}
+
+TEST(MGLASS_TRANSFORMED_SHAPES, ELLIPSE_MATCHES_PIXEL_CENTERS)
+{
+    for (const auto& params : rotatedShapes)
+    {
+        const mglass::shapes::TransformedEllipse e{
+            params.center, params.width, params.height, mglass::AffineTransform::rotation(static_cast<float>(params.angle))
+        };
+
+        checkRasterizedPixels(
+            e,
+            params,
+            [](const mglass::Point<double> p) { return (p.x * p.x + p.y * p.y) <= 1; },
+            [](const mglass::Point<double> p) { return std::abs(p.x * p.x + p.y * p.y - 1); }
+        );
+    }
+}
+
+TEST(MGLASS_TRANSFORMED_SHAPES, RECTANGLE_MATCHES_PIXEL_CENTERS)
+{
+    for (const auto& params : rotatedShapes)
+    {
+        const mglass::shapes::TransformedRectangle r{
+            params.center, params.width, params.height, mglass::AffineTransform::rotation(static_cast<float>(params.angle))
+        };
+
+        checkRasterizedPixels(
+            r,
+            params,
+            [](const mglass::Point<double> p) { return (std::abs(p.x) <= 1) && (std::abs(p.y) <= 1); },
+            [](const mglass::Point<double> p) { return (std::min)(std::abs(std::abs(p.x) - 1), std::abs(std::abs(p.y) - 1)); }
+        );
+    }
+}
+
+TEST(MGLASS_TRANSFORMED_SHAPES, IDENTITY_ELLIPSE_DENSITIES_ARE_ELLIPSE_ONES)
+{
+    const mglass::shapes::Ellipse e{ {0.3f, -0.8f}, 61, 27, mglass::FalloffProfile::linear() };
+    const mglass::shapes::TransformedEllipse te{ {0.3f, -0.8f}, 61, 27, {}, mglass::FalloffProfile::linear() };
+
+    std::vector<std::pair<IntPoint, mglass::float_type>> expected;
+    e.rasterizeOnto(mglass::getShapeIntegralBounds(e), [&expected](const mglass::shapes::Ellipse::RasterizationContext& rstCtx) {
+        expected.emplace_back(rstCtx.getRasterizedPoint(), rstCtx.getPixelDensity());
+    });
+
+    std::size_t index = 0;
+    te.rasterizeOnto(mglass::getShapeIntegralBounds(te), [&](const mglass::shapes::TransformedEllipse::RasterizationContext& rstCtx) {
+        ASSERT_LT(index, expected.size());
+        ASSERT_EQ(rstCtx.getRasterizedPoint(), expected[index].first);
+        ASSERT_NEAR(rstCtx.getPixelDensity(), expected[index].second, 1e-4);
+        ++index;
+    });
+
+    EXPECT_EQ(index, expected.size());
+}
+
+TEST(MGLASS_TRANSFORMED_SHAPES, RASTERIZE_SPANS_MATCH_POINTS)
+{
+    const auto transform = mglass::AffineTransform::rotation(0.7f) * mglass::AffineTransform{ 1, 0.4f, 0, 1, 0, 0 };
+
+    checkSpansMatchPoints(mglass::shapes::TransformedEllipse{ {0.3f, -0.8f}, 70, 40, transform });
+    checkSpansMatchPoints(mglass::shapes::TransformedRectangle{ {0.3f, -0.8f}, 70, 40, transform });
+}
+
+
+// ====================================================================================================================
+// ShapeMaskCache
+// ====================================================================================================================
+
+TEST(MGLASS_TRANSFORMED_SHAPES, MASK_CACHE_DISTINGUISHES_TRANSFORMS)
+{
+    mglass::ShapeMaskCache cache;
+
+    // the same bounds, but different shapes
+    const mglass::shapes::TransformedRectangle wide{ {10, 10}, 40, 20 };
+    const mglass::shapes::TransformedRectangle rotated{
+        {10, 10}, 20, 40, mglass::AffineTransform{ 0, -1, 1, 0, 0, 0 }
+    };
+
+    const auto wideMask = cache.getMaskOf(wide);
+    const auto rotatedMask = cache.getMaskOf(rotated);
+
+    EXPECT_EQ(cache.getSize(), 2U);
+    EXPECT_NE(&wideMask.getMask(), &rotatedMask.getMask());
+
+    // the translated shape shares the mask
+    const mglass::shapes::TransformedRectangle moved{
+        {-30, 45}, 20, 40, mglass::AffineTransform{ 0, -1, 1, 0, 5, 7 }
+    };
+
+    EXPECT_EQ(&cache.getMaskOf(moved).getMask(), &rotatedMask.getMask());
+    EXPECT_EQ(cache.getSize(), 2U);
+}